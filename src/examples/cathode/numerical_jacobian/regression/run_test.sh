@@ -0,0 +1,37 @@
+#!/bin/bash
+
+##############################
+#
+# Note: This script is expected to be run from /test
+# folder, not its current location.
+#
+# The Jacobian is assembled numerically with the columns
+# split among the processes, hence at least two processes
+# are used.
+#
+##############################
+
+# Define name of test:
+test_name="AppCathode>>NumericalJacobian"
+
+# Define relative (or absolute path to Install) from testing folder above:
+path=$FCST_DIR
+
+# Enter testing folder
+cd $path/examples/cathode/numerical_jacobian
+rm polarization_curve.dat
+
+#Get number of cores to use
+argnumcores=`echo "$*" | perl -n -e 'm/--cores=(\S+)/; print $1'`
+if [ "$argnumcores" == "" ] || [ "$argnumcores" -lt 2 ];then
+  argnumcores=2
+fi
+
+# Load the test function:
+. "$path/test/test_function_polarization.sh"
+
+# Call application:
+mpirun -np $argnumcores $path/bin/fuel_cell-2d.bin main.prm
+
+# Run test function:
+test_function_polarization $test_name $path
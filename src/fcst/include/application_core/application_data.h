@@ -53,7 +53,7 @@ enum class LinearSolver {UMFPACK,CG,ILU_GMRES,MUMPS,BICGSTAB};
 /**
  * Enumeration class for Non-linear solvers
  */
-enum class NonLinearSolver {NONE,NEWTONBASIC,NEWTON3PP,NEWTONLINESEARCH,PICARD};
+enum class NonLinearSolver {NONE,NEWTONBASIC,NEWTON3PP,NEWTONLINESEARCH,PICARD,PSEUDOTRANSIENT,SEGREGATED};
 
 /**
  * Enumeration class for refinement types
@@ -278,6 +278,10 @@ public:
             this->nonlin_solver = FuelCell::ApplicationCore::NonLinearSolver::NEWTONLINESEARCH;
         else if ( name.compare("Picard") == 0 )
             this->nonlin_solver = FuelCell::ApplicationCore::NonLinearSolver::PICARD;
+        else if ( name.compare("PseudoTransient") == 0 )
+            this->nonlin_solver = FuelCell::ApplicationCore::NonLinearSolver::PSEUDOTRANSIENT;
+        else if ( name.compare("Segregated") == 0 )
+            this->nonlin_solver = FuelCell::ApplicationCore::NonLinearSolver::SEGREGATED;
         else
             throw(ExcNotFound("nonlinear_solver", name));
     }
@@ -293,12 +297,23 @@ public:
             throw(ExcNotFound("refinement_solver", name));
     }
     
+    /**
+     * Function to return \p true if the non-linear solver \p in solves for Newton updates, i.e., the equation
+     * classes assemble the Jacobian and the residual, and \p false if it solves for the solution itself, i.e.,
+     * for Picard or without non-linear solver. A new Newton-type solver therefore only needs to be added to
+     * set_nonlinear_solver() and to the solver factory, SimulationSelector::select_solver().
+     */
+    bool is_newton_solver(FuelCell::ApplicationCore::NonLinearSolver in) const
+    {
+        return (in != FuelCell::ApplicationCore::NonLinearSolver::PICARD) && (in != FuelCell::ApplicationCore::NonLinearSolver::NONE);
+    }
+    
     /**
      * Function to return solution vector name in the FEVectors object
      */  
     std::string get_solution_vector_name(FuelCell::ApplicationCore::NonLinearSolver in)
     {
-        if ((in == FuelCell::ApplicationCore::NonLinearSolver::NEWTONBASIC) || (in == FuelCell::ApplicationCore::NonLinearSolver::NEWTON3PP) || (in == FuelCell::ApplicationCore::NonLinearSolver::NEWTONLINESEARCH))
+        if (is_newton_solver(in))
             return "Newton iterate";
         else if ((in == FuelCell::ApplicationCore::NonLinearSolver::PICARD) || (in == FuelCell::ApplicationCore::NonLinearSolver::NONE))
             return "Solution";         
@@ -309,7 +324,7 @@ public:
      */
     std::string get_residual_vector_name(FuelCell::ApplicationCore::NonLinearSolver in)
     {
-        if ((in == FuelCell::ApplicationCore::NonLinearSolver::NEWTONBASIC) || (in == FuelCell::ApplicationCore::NonLinearSolver::NEWTON3PP) || (in == FuelCell::ApplicationCore::NonLinearSolver::NEWTONLINESEARCH))
+        if (is_newton_solver(in))
             return "Newton residual";
         else if ((in == FuelCell::ApplicationCore::NonLinearSolver::PICARD) || (in == FuelCell::ApplicationCore::NonLinearSolver::NONE))
             return "residual";         
@@ -0,0 +1,108 @@
+// ----------------------------------------------------------------------------
+//
+// FCST: Fuel Cell Simulation Toolbox
+//
+// Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+// This software is distributed under the MIT License
+// For more information, see the README file in /doc/LICENSE
+//
+// - Class: assembly_batch.h
+// - Description: Interface of objects whose cell computations are performed for the whole mesh at once
+// - Developers: OpenFCST contributors, University of Alberta
+//
+// ----------------------------------------------------------------------------
+
+#ifndef _FUEL_CELL_APPLICATION_CORE_ASSEMBLY_BATCH_H_
+#define _FUEL_CELL_APPLICATION_CORE_ASSEMBLY_BATCH_H_
+
+namespace FuelCell
+{
+namespace ApplicationCore
+{
+
+/**
+ * Interface of objects, usually layers, whose expensive cell computations are collected over the
+ * whole mesh and then performed together, instead of one cell at a time while the cells are assembled.
+ *
+ * If an object registered with DoFApplication::add_assembly_batch() is enabled, the application
+ * assembles the cells of the object twice:
+ * - After begin_collect(), the cells whose material id belongs to the object, see batch_material(), are
+ *   assembled once and the object only records the computations it is asked for. The values it returns during this pass are placeholders and the local matrices
+ *   and residuals are discarded.
+ * - evaluate() then performs all recorded computations, e.g., in parallel.
+ * - The cells are assembled again and the object returns the results of evaluate(). Computations that
+ *   were not recorded are performed as usual.
+ * - end_batch() discards the results. It is also called if the assembly throws an exception.
+ *
+ * Objects that are not registered are never collected, hence they should reject being enabled, see
+ * batch_registered().
+ */
+class AssemblyBatch
+{
+public:
+  /**
+   * Constructor
+   */
+  AssemblyBatch()
+  :
+  registered(false)
+  {}
+
+  /**
+   * Destructor
+   */
+  virtual ~AssemblyBatch()
+  {}
+
+  /**
+   * Returns true if the cell computations should be collected before the assembly.
+   */
+  virtual bool batch_enabled() const = 0;
+
+  /**
+   * Returns true if the cells with material id \p material_id have computations to collect.
+   */
+  virtual bool batch_material(const unsigned int material_id) const = 0;
+
+  /**
+   * Start recording the cell computations instead of performing them.
+   */
+  virtual void begin_collect() = 0;
+
+  /**
+   * Perform all computations recorded since begin_collect(). The results are used by the next assembly pass.
+   */
+  virtual void evaluate() = 0;
+
+  /**
+   * Discard the recorded computations and their results. Must not throw, since it is called while
+   * an exception propagates.
+   */
+  virtual void end_batch() = 0;
+
+  /**
+   * Called by DoFApplication::add_assembly_batch().
+   */
+  void set_batch_registered()
+  {
+    registered = true;
+  }
+
+  /**
+   * Returns true if the object was registered with an application that collects its computations.
+   */
+  bool batch_registered() const
+  {
+    return registered;
+  }
+
+private:
+  /** The object was registered with DoFApplication::add_assembly_batch() */
+  bool registered;
+};
+
+}
+}
+
+#endif
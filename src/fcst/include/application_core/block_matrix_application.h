@@ -24,6 +24,7 @@
 #include <deal.II/lac/petsc_parallel_block_sparse_matrix.h>
 #include <deal.II/lac/petsc_precondition.h>
 #include <deal.II/lac/block_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_tools.h>
 #include <deal.II/lac/solver_bicgstab.h>
 #include <deal.II/lac/solver_cg.h>
 #include <deal.II/numerics/matrix_tools.h>
@@ -191,6 +192,24 @@ namespace FuelCell
              * in the parameter file.
              */
             virtual void remesh();
+
+            /**
+             * Couplings between blocks used to build the sparsity pattern of the system
+             * matrix in remesh_matrices(). By default, #cell_couplings is returned.
+             * Applications that never assemble some of the blocks in #cell_couplings, e.g.,
+             * when solving with NewtonSegregated, can redefine this function
+             * to reduce the size of the system matrix.
+             */
+            virtual Table<2, DoFTools::Coupling> matrix_couplings() const;
+
+            /**
+             * Blocks of the unknowns computed by solve(). By default, an empty vector is returned and the whole
+             * linear system is solved. Applications solved with NewtonSegregated redefine this function to return
+             * the blocks of the stage being solved. In this case, solve() extracts the rows and columns of these
+             * blocks from the assembled #matrix, solves this smaller system and sets the other blocks of the
+             * solution to zero, see serial_stage_solve() and PETSc_stage_solve().
+             */
+            virtual std::vector<unsigned int> stage_blocks() const;
             
             /**
              * Loop over all cells and  assemble the system
@@ -220,10 +239,50 @@ namespace FuelCell
              * requires src to contain a field named "Newton iterate" with the solution at the
              * previous Newton step.
              *
+             * In the PETSc implementation, see PETSc_assemble_numerically(), several degrees of
+             * freedom are perturbed at the same time.
+             *
              * \author M. Secanell, 2013
              */
             void assemble_numerically(const FEVectors& src,
                                       const double delta = 1e-6);
+
+            #ifdef OPENFCST_WITH_PETSC
+            /**
+             * PETSc implementation of assemble_numerically(). The columns of the Jacobian, i.e., the degrees of freedom
+             * that are not constrained by hanging nodes, are split into groups such that no row of the sparsity pattern of #matrix
+             * has entries in two columns of the same group, see jacobian_column_groups(). All the degrees of freedom in a group are
+             * perturbed at the same time and a single evaluation of the distributed residual gives one column of the Jacobian
+             * for each of them. Therefore, the number of residual evaluations is the number of groups, which depends
+             * on the number of couplings per degree of freedom rather than on the size of the mesh.
+             *
+             * Each process inserts the entries of the rows of #matrix it stores, i.e., the contiguous range of rows
+             * returned by PETScWrappers::MatrixBase::local_range(). The constraints due to hanging nodes
+             * are applied to the perturbed solution before the residual is evaluated and the rows of the constrained degrees
+             * of freedom only have a unit diagonal. As in assemble(), the Dirichlet boundary conditions are applied
+             * in PETSc_solve().
+             */
+            void PETSc_assemble_numerically(const FEVectors& src,
+                                            const double delta);
+
+            /**
+             * Split the columns of #matrix that are not constrained by hanging nodes into groups of structurally orthogonal
+             * columns, i.e., columns that do not have entries in the same row, and return the number of groups.
+             * \p row_columns are the columns of the sparsity pattern in each row of the local range of #matrix. A column
+             * is owned by the process that stores the row with the same index.
+             *
+             * A column is an interface column if it has an entry in a row that also has columns owned by other processes.
+             * The remaining columns of all processes are colored independently and the colors are used as groups. Two processes
+             * that own columns in the same row cannot perturb interface columns at the same time. Therefore, the processes are colored
+             * using the graph of these conflicts, and the interface columns are grouped by the color of their process and
+             * by their color on the process. The colors on each process are computed using a greedy distance-2 coloring.
+             *
+             * On return, \p column_groups contains the group number plus one for all the degrees of freedom and zero for the
+             * constrained degrees of freedom.
+             */
+            unsigned int jacobian_column_groups(const std::vector< std::vector<types::global_dof_index> >& row_columns,
+                                                FEVector& column_groups) const;
+            #endif
             
             /**
              * Redefinition of residual_constraints() in
@@ -234,8 +293,25 @@ namespace FuelCell
              */
             void residual_constraints(FEVector& dst) const;
 
+            /**
+             * Compute the lumped mass vector, i.e., the integral of each shape function over the domain,
+             * stored in #lumped_mass. The lumped mass is computed the first time add_pseudo_time_term()
+             * is called after remesh_matrices().
+             */
+            void compute_lumped_mass();
+
+            /**
+             * Add \p shift times the lumped mass, #lumped_mass, to the diagonal of the system matrix. The
+             * rows of Dirichlet boundary values and hanging nodes are not modified.
+             *
+             * This routine is used in solve() to add the pseudo-transient term \f$ \frac{1}{\Delta \tau} \mathbf{M} \f$
+             * required by pseudo-transient continuation (see NewtonPseudoTransient) whenever the scalar
+             * "Pseudo time step inverse" is registered in ApplicationData.
+             */
+            void add_pseudo_time_term(const double shift);
+
             #ifdef OPENFCST_WITH_PETSC
-                void residual_constraints(PETScWrappers::MPI::Vector& dst, const std::vector<unsigned int>& idx_list) const;
+                void residual_constraints(PETScWrappers::MPI::Vector& dst) const;
             #endif
             
             //@}
@@ -285,8 +361,26 @@ namespace FuelCell
 
             #ifdef OPENFCST_WITH_PETSC
                 void PETSc_solve(FuelCell::ApplicationCore::FEVector system_rhs, FEVector& solution, const FEVectors& src);
+
+                /**
+                 * Solve the linear system restricted to the \p blocks returned by stage_blocks(). The rows of these
+                 * blocks owned by this process are copied from #matrix into a matrix with the size of the stage, which
+                 * is distributed among the processes in the same way as #matrix. The other blocks of \p solution are set to zero.
+                 */
+                void PETSc_stage_solve(const std::vector<unsigned int>& blocks,
+                                       const FuelCell::ApplicationCore::FEVector& system_rhs,
+                                       FEVector& solution);
             #else
                 void serial_solve(FuelCell::ApplicationCore::FEVector system_rhs, FEVector& solution);
+
+                /**
+                 * Solve the linear system restricted to the \p blocks returned by stage_blocks(). The diagonal blocks
+                 * of the stage are copied from #matrix into a BlockSparseMatrix with the size of the stage. The other
+                 * blocks of \p solution are set to zero.
+                 */
+                void serial_stage_solve(const std::vector<unsigned int>& blocks,
+                                        const FuelCell::ApplicationCore::FEVector& system_rhs,
+                                        FEVector& solution);
             #endif
 
 
@@ -326,6 +420,23 @@ namespace FuelCell
              * Sparsity patterns.
              */
             BlockSparsityPattern sparsities;
+
+            #ifdef OPENFCST_WITH_PETSC
+                /**
+                 * Solve \p system_matrix \p solution = \p system_rhs with the linear solver selected in ApplicationData.
+                 */
+                void PETSc_linear_solve(PETScWrappers::MPI::SparseMatrix& system_matrix,
+                                        PETScWrappers::MPI::Vector&       solution,
+                                        PETScWrappers::MPI::Vector&       system_rhs);
+            #else
+                /**
+                 * Solve \p system_matrix \p solution = \p system_rhs with the linear solver selected in ApplicationData.
+                 * If UMFPACK is used, the stored factorization is reused as long as #factorization_valid is true.
+                 */
+                void serial_linear_solve(const BlockSparseMatrix<double>& system_matrix,
+                                         FEVector&                        solution,
+                                         FEVector&                        system_rhs);
+            #endif
                    
             ///@name Auxiliary data:
             //@{
@@ -359,6 +470,32 @@ namespace FuelCell
              */
             SolverControl solver_control;
 
+            #ifndef OPENFCST_WITH_PETSC
+                /**
+                 * LU factorization of #matrix computed by UMFPACK. The factorization
+                 * is only recomputed after the matrix has been assembled anew, so that
+                 * several right hand sides (e.g. Newton steps with a frozen Jacobian)
+                 * can be solved with a single factorization.
+                 */
+                SparseDirectUMFPACK umfpack_factorization;
+            #endif
+
+            /**
+             * Flag stating if the stored factorization corresponds to the current #matrix.
+             */
+            bool factorization_valid;
+
+            /**
+             * Lumped mass vector, i.e., integral of each shape function over the domain.
+             */
+            Vector<double> lumped_mass;
+
+            /**
+             * Multiple of #lumped_mass currently added to the diagonal of #matrix, i.e., the
+             * inverse of the pseudo time step used in pseudo-transient continuation.
+             */
+            double pseudo_time_shift;
+
 
             //@}
             
@@ -43,6 +43,9 @@
 #include <deal.II/numerics/solution_transfer.h>
 #include <deal.II/numerics/error_estimator.h>
 #include <deal.II/distributed/solution_transfer.h>
+#include <deal.II/base/index_set.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/lac/sparsity_tools.h>
 
 //-- OpenFCST
 #include <grid/geometry.h>
@@ -51,6 +54,8 @@
 #include <application_core/mesh_loop_info_objects.h>
 #include <utils/fcst_utilities.h>
 #include <application_core/initial_and_boundary_data.h>
+#include <application_core/subdomain_data_out.h>
+#include <application_core/assembly_batch.h>
 
 //--C++ Standard Libraries
 #include <iostream>
@@ -58,6 +63,7 @@
 #include <string>
 #include <sstream>
 #include <typeinfo>
+#include <limits>
 
 using namespace dealii;
 using namespace FuelCell::ApplicationCore;
@@ -70,6 +76,15 @@ namespace dealii
     template<int, int> class DoFHandler;
 }
 
+//Friend class for testing
+namespace FuelCell
+{
+    namespace UnitTest
+    {
+        class DoFApplicationTest;
+    }
+}
+
 namespace FuelCell
 {
     namespace ApplicationCore
@@ -295,6 +310,7 @@ namespace FuelCell
             /**
              * Estimate the error. By default, the KellyErrorEstimator is used in order to estimate the error
              * in every cell. The error for all components of the solution is added.
+             * The function returns the global error estimate, i.e., the l2-norm of the cell error indicators.
              *
              * In general, here a loop over all cells and faces, using the virtual local functions
              * - cell_residual(),
@@ -336,7 +352,11 @@ namespace FuelCell
             virtual void residual_constraints(FEVector& dst) const;
 
             #ifdef OPENFCST_WITH_PETSC
-            virtual void residual_constraints(PETScWrappers::MPI::Vector& dst, const std::vector<unsigned int>&) const;
+            /**
+             * Same as above for the distributed residual assembled in parallel runs. Only the entries of
+             * the #locally_owned_dofs should be modified.
+             */
+            virtual void residual_constraints(PETScWrappers::MPI::Vector& dst) const;
             #endif
 
             /**
@@ -410,6 +430,17 @@ namespace FuelCell
              */
             bool use_predefined_solution;
 
+            /**
+             * Improve the pre-defined initial solution using a one-dimensional through-plane model of the MEA,
+             * see FuelCell::InitialSolution::ThroughPlaneMEAModel. Only used by applications that support it.
+             */
+            bool use_through_plane_solution;
+
+            /**
+             * Number of cells per layer in the one-dimensional through-plane model.
+             */
+            unsigned int n_through_plane_cells;
+
             /**
              * Bool flag used to specify if the final solution should be stored in the coarse mesh
              * in order to be used later as an initial solution to solve another problem using the
@@ -514,6 +545,23 @@ namespace FuelCell
              */
             bool print_postprocessing;
 
+            /**
+             * @p true, if every MPI process writes the data on its own cells to a separate file and
+             * process zero writes a master record, i.e., a <tt>.pvtu</tt> file for vtu output and a <tt>.visit</tt> file,
+             * that ties the files together. This flag is specified in the input file using:
+             * @code
+             * subsection Output
+             *   subsection Data
+             *     set Parallel output = false
+             *   end
+             * end
+             * @endcode
+             * In serial runs, the flag is ignored.
+             *
+             * @p false, if process zero writes the complete solution to a single file.
+             */
+            bool parallel_output;
+
             /**
              * The indices of the @p FEVector @p solution
              * to be printed to a text file.
@@ -581,6 +629,75 @@ namespace FuelCell
              */
             virtual void initialize_triangulation(ParameterHandler& param);
 
+            /**
+             * Partition the mesh among the MPI processes, i.e., set the subdomain id of each cell.
+             *
+             * If no cell weights are given, see #partition_weights, the mesh is partitioned using METIS such
+             * that each process owns the same number of cells. Otherwise, the cells are ordered using the
+             * Cuthill-McKee algorithm on the cell connectivity graph and the ordered cells are split into
+             * contiguous groups with the same total weight. Therefore, a process that owns expensive cells, e.g.,
+             * multiscale catalyst layer cells, owns fewer cells.
+             */
+            void partition_mesh();
+
+            /**
+             * Add the time spent assembling a cell with material id \p material_id to the measured
+             * assembly cost. If #measured_partition_weights is set, the average cost per cell of each material
+             * is used as the cell weight the next time the mesh is partitioned.
+             */
+            void record_cell_cost(const unsigned int material_id,
+                                  const double       time);
+
+            /**
+             * Register an object whose cell computations are collected over the mesh before the cells are
+             * assembled, see AssemblyBatch. Usually called in #initialize with the layers of the application.
+             * A NULL pointer is ignored, i.e., the result of a \p dynamic_cast can be passed directly.
+             */
+            void add_assembly_batch(AssemblyBatch* batch);
+
+            /**
+             * Call AssemblyBatch::begin_collect() for all enabled objects in #assembly_batches. Returns false if
+             * no object is enabled, in which case the cells are only assembled once.
+             */
+            bool begin_assembly_batches();
+
+            /**
+             * Returns true if a cell with material id \p material_id belongs to an enabled object in #assembly_batches,
+             * i.e., if the cell is assembled in the collect pass.
+             */
+            bool assembly_batch_material(const unsigned int material_id) const;
+
+            /**
+             * Call AssemblyBatch::evaluate() for all enabled objects in #assembly_batches.
+             */
+            void evaluate_assembly_batches();
+
+            /**
+             * Call AssemblyBatch::end_batch() for all objects in #assembly_batches.
+             */
+            void end_assembly_batches();
+
+            /**
+             * Calls #end_assembly_batches when it goes out of scope, so that the objects in #assembly_batches
+             * leave batch mode even if the assembly throws an exception.
+             */
+            class AssemblyBatchGuard
+            {
+            public:
+                AssemblyBatchGuard(DoFApplication<dim>& app)
+                :
+                app(app)
+                {}
+
+                ~AssemblyBatchGuard()
+                {
+                    app.end_assembly_batches();
+                }
+
+            private:
+                DoFApplication<dim>& app;
+            };
+
             /**
              * Create a mesh and assign it to object #tr. This member function is usually called by #initialize
              */
@@ -628,6 +745,27 @@ namespace FuelCell
                                        const FaceInfo& face1,
                                        const FaceInfo& face2);
 
+            /**
+             * Compute the residual of \p cell, i.e., cell_residual() plus bdry_residual() on its boundary faces if
+             * #boundary_fluxes is set, in \p local_residual. This function is used by residual().
+             */
+            void cell_and_bdry_residual(FEVector&                                             local_residual,
+                                        CellInfo&                                             cell_info,
+                                        FaceInfo&                                             bdry_info,
+                                        const typename DoFHandler<dim>::active_cell_iterator& cell);
+
+            #ifdef OPENFCST_WITH_PETSC
+            /**
+             * Return \p true if a cell with degrees of freedom \p indices only contributes to the #locally_owned_dofs, i.e.,
+             * its degrees of freedom and the masters of the hanging nodes among them are owned by this process. In parallel runs,
+             * residual() first assembles the other cells and sends their contributions to the owner processes while
+             * the interior cells are assembled. Since the degrees of freedom are sorted by component after they are
+             * sorted by subdomain, the degrees of freedom of a subdomain are split among several owners and few cells are interior
+             * for finite elements with several components.
+             */
+            bool is_interior_cell(const std::vector<types::global_dof_index>& indices) const;
+            #endif
+
             /**
              * Local estimation.
              */
@@ -690,7 +828,7 @@ namespace FuelCell
             /**
              * The object for writing data.
              */
-            DataOut<dim, DoFHandler<dim> > d_out;
+            SubdomainDataOut<dim> d_out;
 
             /**
              * This routine is used to write data in the format specified by the ParameterHandler.
@@ -808,6 +946,55 @@ namespace FuelCell
              */
             ConstraintMatrix hanging_node_constraints;
 
+            #ifdef OPENFCST_WITH_PETSC
+            /**
+             * Degrees of freedom owned by this MPI process, i.e., the contiguous range of rows of the PETSc vectors and
+             * matrices stored by this process. Its size is the number of degrees of freedom associated with the subdomain
+             * of the process, but, since the degrees of freedom are sorted by component after they are sorted by subdomain,
+             * it is in general not the set of degrees of freedom of the cells of the subdomain.
+             */
+            IndexSet locally_owned_dofs;
+
+            /**
+             * Indices of #locally_owned_dofs, used to copy vectors to and from PETSc vectors in a single call.
+             */
+            std::vector<types::global_dof_index> locally_owned_dof_indices;
+            #endif
+
+            #ifdef OPENFCST_WITH_PETSC
+            /**
+             * Copy the distributed vector \p src to \p dst, i.e., \p src is localized and the complete
+             * vector is copied to every process.
+             */
+            void import_distributed_vector(const PETScWrappers::MPI::Vector& src,
+                                           FEVector& dst) const;
+
+            /**
+             * Copy the entries of the #locally_owned_dofs of \p src to the distributed vector \p dst, which
+             * must have been initialized. All entries are inserted in a single call.
+             */
+            void export_to_distributed_vector(const FEVector& src,
+                                              PETScWrappers::MPI::Vector& dst) const;
+            #endif
+
+            /**
+             * Return \p true if data_out() writes one file per MPI process, see #parallel_output.
+             */
+            bool write_data_in_parallel() const;
+
+            /**
+             * Name of the file written by data_out() for \p basename. If the data is written in parallel,
+             * each process writes the cells it owns and the number of the process is appended to \p basename.
+             */
+            std::string data_out_filename(const std::string& basename) const;
+
+            /**
+             * Write the master record that ties the files written in parallel by data_out() for \p basename,
+             * i.e., <tt>basename.pvtu</tt> for vtu output and <tt>basename.visit</tt>. Only process zero writes the
+             * files. This function must be called after the patches in #d_out have been built.
+             */
+            void write_data_out_master_record(const std::string& basename) const;
+
             /**
              * The mapping used for the
              * transformation of mesh
@@ -892,6 +1079,44 @@ namespace FuelCell
              */
             bool sort_cuthill;
 
+            /**
+             * Relative cost of the cells of each material id used to balance the partitioning of the mesh.
+             * Cells of materials that are not in the map have weight one.
+             *
+             * @note Read from parameter file and updated with the measured cost if
+             * #measured_partition_weights is set.
+             */
+            std::map<unsigned int, double> partition_weights;
+
+            /**
+             * Use the measured assembly time per cell of each material as the partition weights.
+             *
+             * @note Read from parameter file
+             */
+            bool measured_partition_weights;
+
+            /**
+             * Repartition the mesh after each refinement.
+             *
+             * @note Read from parameter file
+             */
+            bool repartition_after_refinement;
+
+            ///@name Measured assembly cost
+            //@{
+            /** Time spent assembling the cells of each material id [s] */
+            std::map<unsigned int, double> measured_material_time;
+
+            /** Number of cells of each material id included in #measured_material_time */
+            std::map<unsigned int, unsigned int> measured_material_cells;
+            //@}
+
+            /**
+             * Objects whose cell computations are collected over the mesh before the cells are assembled,
+             * see #add_assembly_batch.
+             */
+            std::vector<AssemblyBatch*> assembly_batches;
+
             /**
              * Direction for downstream sorting. No downstream
              * sorting if this vector is zero.
@@ -1011,6 +1236,19 @@ namespace FuelCell
              * return value.
              */
             virtual double global_from_local_errors() const;
+
+            /**
+             * Weight of a cell used to partition the mesh, see #partition_weights.
+             */
+            double cell_weight(const unsigned int material_id) const;
+
+            /**
+             * Replace #partition_weights by the measured assembly cost per cell, summed over all
+             * processes and scaled by the cost of the cheapest material. The measured cost is then reset.
+             */
+            void update_measured_partition_weights();
+
+            friend class FuelCell::UnitTest::DoFApplicationTest;
             
             /**
              * Number of refinements.
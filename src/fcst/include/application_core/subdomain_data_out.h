@@ -0,0 +1,109 @@
+// ----------------------------------------------------------------------------
+//
+// FCST: Fuel Cell Simulation Toolbox
+//
+// Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+// This software is distributed under the MIT License
+// For more information, see the README file in /doc/LICENSE
+//
+// - Class: subdomain_data_out.h
+// - Description: DataOut restricted to the cells of a subdomain
+// - Developers: OpenFCST contributors, University of Alberta
+//
+// ----------------------------------------------------------------------------
+
+#ifndef _FUELCELL__SUBDOMAIN_DATA_OUT__H
+#define _FUELCELL__SUBDOMAIN_DATA_OUT__H
+
+//-- deal.II
+#include <deal.II/base/types.h>
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/numerics/data_out.h>
+
+using namespace dealii;
+
+namespace FuelCell
+{
+    namespace ApplicationCore
+    {
+        /**
+         * DataOut class that only builds patches on the cells of a given subdomain. It is used by
+         * DoFApplication::data_out() in parallel runs so that each MPI process writes the part of the solution
+         * on its own cells, i.e., the postprocessors added to the object are only evaluated on these cells.
+         *
+         * If the subdomain is numbers::invalid_subdomain_id, which is the default, all the cells used by
+         * DataOut are written.
+         *
+         * See step-18 in the deal.II tutorial for more details.
+         */
+        template <int dim>
+        class SubdomainDataOut
+        :
+        public DataOut<dim, DoFHandler<dim> >
+        {
+        public:
+            /**
+             * Shortcut.
+             */
+            typedef typename DataOut<dim, DoFHandler<dim> >::cell_iterator cell_iterator;
+
+            /**
+             * Constructor.
+             */
+            SubdomainDataOut ()
+            :
+            subdomain_id (numbers::invalid_subdomain_id)
+            {}
+
+            /**
+             * Only write the cells with subdomain id \p id. Use numbers::invalid_subdomain_id to write all cells.
+             */
+            void set_subdomain_id (const types::subdomain_id id)
+            {
+                subdomain_id = id;
+            }
+
+            /**
+             * First cell in the subdomain.
+             */
+            virtual cell_iterator first_cell ()
+            {
+                if (subdomain_id == numbers::invalid_subdomain_id)
+                    return DataOut<dim, DoFHandler<dim> >::first_cell();
+
+                typename DoFHandler<dim>::active_cell_iterator cell = this->dofs->begin_active();
+                while ((cell != this->dofs->end()) && (cell->subdomain_id() != subdomain_id))
+                    ++cell;
+
+                return cell;
+            }
+
+            /**
+             * Cell following \p old_cell in the subdomain.
+             */
+            virtual cell_iterator next_cell (const cell_iterator& old_cell)
+            {
+                if (subdomain_id == numbers::invalid_subdomain_id)
+                    return DataOut<dim, DoFHandler<dim> >::next_cell(old_cell);
+
+                if (old_cell != this->dofs->end())
+                {
+                    const IteratorFilters::SubdomainEqualTo predicate(subdomain_id);
+                    return ++(FilteredIterator<typename DoFHandler<dim>::active_cell_iterator>(predicate, old_cell));
+                }
+                else
+                    return old_cell;
+            }
+
+        private:
+            /**
+             * Subdomain written to file.
+             */
+            types::subdomain_id subdomain_id;
+        };
+    }
+}
+
+#endif
@@ -18,6 +18,7 @@
 //-- OpenFCST
 #include <application_core/optimization_block_matrix_application.h>
 #include <utils/operating_conditions.h>
+#include <utils/through_plane_mea_model.h>
 #include <layers/design_MPL.h>
 #include <materials/PureGas.h>
 #include <materials/PureLiquid.h>
@@ -20,6 +20,7 @@
 //-- OpenFCST
 #include <application_core/optimization_block_matrix_application.h>
 #include <utils/operating_conditions.h>
+#include <utils/through_plane_mea_model.h>
 
 #include <layers/gas_diffusion_layer.h>
 #include <layers/micro_porous_layer.h>
@@ -108,6 +109,17 @@ namespace FuelCell
         * - M. Secanell et al. "Numerical Optimization of Proton Exchange Membrane Fuel Cell Cathode Electrodes", Electrochimica Acta, 52(7):2668-2682, February 2007.
         *
         * If using this application, please cite the article above as references.
+        *
+        * <h3> Segregated solution </h3>
+        * If the nonlinear solver is set to \p Segregated (see NewtonSegregated), the application splits the unknowns into
+        * two stages: stage 0 contains the isothermal unknowns (species, potentials and membrane water content) and stage 1 contains
+        * the temperature, i.e., the ThermalTransportEquation. While the scalar "Segregated solve stage" is registered in
+        * ApplicationData, the unknowns of the other stage are frozen: the equations of the other stage are not assembled, except the
+        * source terms that also contribute to the thermal equation, and their residual is set to zero. stage_blocks() returns the blocks
+        * of the stage, so only the linear system of the stage is solved, see BlockMatrixApplication::stage_blocks(). The blocks
+        * coupling the temperature to the isothermal unknowns are removed from the sparsity pattern of the system matrix in this mode.
+        * The residual of the coupled problem is assembled when no stage is registered, so the converged solution is the same as for
+        * the monolithic solvers. The ThermalTransportEquation and the temperature have to use the same block.
         * 
         * @author Madhur Bhaiya (bhaiya@ualberta.ca); 2013-14
         */
@@ -204,6 +216,18 @@ namespace FuelCell
             virtual void bdry_residual(FuelCell::ApplicationCore::FEVector& bdry_vector,
                                        const typename DoFApplication<dim>::FaceInfo& bdry_info);
             //@}
+
+            /**
+            * Couplings used for the sparsity pattern of the system matrix. In segregated mode, the blocks
+            * coupling the temperature and the isothermal unknowns are removed.
+            */
+            virtual Table<2, DoFTools::Coupling> matrix_couplings() const;
+
+            /**
+            * Blocks solved in the current stage of NewtonSegregated, i.e., all blocks except the temperature
+            * in stage 0 and the temperature in stage 1. An empty vector is returned if the coupled problem is solved.
+            */
+            virtual std::vector<unsigned int> stage_blocks() const;
         
             /**
             * Member function used to set dirichlet boundary conditions.
@@ -399,6 +423,46 @@ namespace FuelCell
             * Time constant for sorption isotherm [\p 1/s]
             */
             double time_k;
+
+            ///@name Segregated solution
+            //@{
+            /**
+            * \p true if the problem is solved using NewtonSegregated.
+            */
+            bool segregated;
+
+            /**
+            * Number of stages used by NewtonSegregated, registered in ApplicationData as "Number of segregated stages".
+            */
+            double n_segregated_stages;
+
+            /**
+            * Index of the ThermalTransportEquation block.
+            */
+            unsigned int thermal_equation_block;
+
+            /**
+            * Index of the temperature solution block.
+            */
+            unsigned int temperature_block;
+
+            /**
+            * Return the stage currently solved by NewtonSegregated, i.e., 0 for the isothermal
+            * unknowns and 1 for the temperature, or -1 if the coupled problem is assembled.
+            */
+            int segregated_stage() const;
+
+            /**
+            * Zero the local matrices that are not needed in segregated mode, i.e., the blocks coupling
+            * temperature and the isothermal unknowns and the blocks of the frozen stage.
+            */
+            void mask_segregated_matrices(FuelCell::ApplicationCore::MatrixVector& matrices) const;
+
+            /**
+            * Zero the local residual of the equations in the frozen stage.
+            */
+            void mask_segregated_residual(FuelCell::ApplicationCore::FEVector& vector) const;
+            //@}
             
              /**
              * Function to modify the default values of the data file in order to make sure that the equations
@@ -15,12 +15,10 @@
 
 #include <stdio.h>
 #include <stdexcept>
-
-#ifdef _OPENMP
-	#include <omp.h>
-#else
-	#define omp_get_thread_num() 0
-#endif
+#include <mutex>
+#include <map>
+#include <ostream>
+#include <vector>
 
 //Load COLDAE subroutines
 extern "C" {
@@ -49,6 +47,13 @@ namespace ApplicationCore
 	typedef void (*dgsub_ptr)(int &, double [], double []);
 	typedef void (*guess_ptr)(double &, double [], double [], double []);
 
+	//Types of the user-supplied functions with a user context, see DAESolver
+	typedef void (*fsub_context_ptr)(void *, double &, double [], double [], double []);
+	typedef void (*dfsub_context_ptr)(void *, double &, double [], double [], double []);
+	typedef void (*gsub_context_ptr)(void *, int &, double [], double &);
+	typedef void (*dgsub_context_ptr)(void *, int &, double [], double []);
+	typedef void (*guess_context_ptr)(void *, double &, double [], double [], double []);
+
 	//functions
 
 	/**
@@ -79,7 +84,142 @@ namespace ApplicationCore
 	*/
 	void c_to_for_matrix(int rows, int cols, double ** cmat, double *fmat);
 
+	/**
+	* Pool of the integer and double work arrays used by COLDAE.
+	*
+	* The size of the COLDAE work arrays limits the number of mesh subintervals, hence they are usually
+	* several megabytes. The microscale problems create a new DAESolver for every solve, i.e., for every
+	* quadrature point and Newton iteration, so allocating new arrays for each solver spends most of the time
+	* allocating and paging in memory. Instead, the arrays released by a DAESolver are kept by the thread
+	* and handed to the next DAESolver created on the same thread. An array is only reallocated when a larger
+	* array is requested, and the free arrays of a thread are freed when the thread finishes.
+	*
+	* The arrays used by the solvers are shared by all threads, so a solver may be destroyed on another thread
+	* than the one that created it: its arrays are then kept by the thread that destroys it. Releasing an array that
+	* was not obtained from the pool is reported on std::cerr and ignored, since it is done by the destructor of DAESolver.
+	*
+	* The pool also records, over all threads, the largest arrays requested, the largest part of them used by
+	* COLDAE and the memory allocated. These statistics are written by print_statistics().
+	*/
+	class DAEWorkspacePool
+	{
+		public:
+		/** Get an integer array with at least \p size entries from the pool of the calling thread. */
+		static int *acquire_integer_space(int size);
+		/** Get a double array with at least \p size entries from the pool of the calling thread. */
+		static double *acquire_float_space(int size);
+		/** Return an array obtained with acquire_integer_space() on any thread to the pool of the calling thread. Does not throw. */
+		static void release(int *space);
+		/** Return an array obtained with acquire_float_space() on any thread to the pool of the calling thread. Does not throw. */
+		static void release(double *space);
+		/** Record the number of entries of the integer and double arrays used by a solve. */
+		static void record_use(int ispace_used, int fspace_used);
+		/** Write the peak workspace use, if any solve was recorded. */
+		template <class STREAM>
+		static void print_statistics(STREAM &out)
+		{
+			std::lock_guard<std::mutex> lock(statistics_mutex);
+			if (n_solves == 0) return;
+
+			out << "COLDAE workspace: " << n_solves << " solves, "
+			    << n_allocated << " of " << n_acquired << " work arrays allocated, "
+			    << allocated_bytes/1048576. << " MB allocated over all threads" << std::endl;
+			out << "COLDAE workspace peak use: integer array " << peak_ispace_used << " of " << peak_ispace_requested
+			    << " entries, double array " << peak_fspace_used << " of " << peak_fspace_requested << " entries" << std::endl;
+		}
+
+		private:
+		/** Arrays kept by one thread */
+		template <typename T>
+		struct Buffers
+		{
+			/** Free arrays kept by the thread */
+			std::vector< std::vector<T> > arrays;
+			/** Arrays used by the solvers of all threads, by address, protected by statistics_mutex */
+			static std::map<const T*, std::vector<T> > lent;
+			/** Get a free array with at least \p size entries, it is grown if needed, and move it to #lent */
+			T *acquire(int size);
+			/** Move the array from #lent to the free arrays, or report it if it is not in #lent */
+			void release(T *space);
+		};
+
+		/** Integer arrays kept by this thread */
+		static thread_local Buffers<int> integer_buffers;
+		/** Double arrays kept by this thread */
+		static thread_local Buffers<double> float_buffers;
+
+		/** Protects the statistics below and the arrays lent by all threads */
+		static std::mutex statistics_mutex;
+		/** Number of arrays handed to the solvers */
+		static unsigned long n_acquired;
+		/** Number of arrays allocated or reallocated */
+		static unsigned long n_allocated;
+		/** Memory allocated over all threads, in bytes */
+		static unsigned long allocated_bytes;
+		/** Largest integer and double arrays requested */
+		static int peak_ispace_requested, peak_fspace_requested;
+		/** Largest part of the integer and double arrays used by COLDAE */
+		static int peak_ispace_used, peak_fspace_used;
+		/** Number of solves recorded */
+		static unsigned long n_solves;
+	};
+
+
+
+	/**
+	* Coefficients of a converged COLDAE solution, i.e., the part of the work arrays used to evaluate the solution.
+	*
+	* COLDAE can start from a former solution instead of a guess (simple continuation, see ipar(9) = 2 in COLDAE).
+	* The former solution is defined by its mesh and collocation coefficients, stored in ispace(1), ..., ispace(8+ncomp)
+	* and fspace(1), ..., fspace(ispace(8)). These entries are copied by DAESolver::get_solution_coefficients() and
+	* given back to another solver of the same problem by DAESolver::set_initial_solution().
+	*/
+	struct DAESolutionCoefficients
+	{
+		/** Used part of the integer work array */
+		std::vector<int> ispace;
+		/** Used part of the double work array, i.e., the mesh and the collocation coefficients */
+		std::vector<double> fspace;
+		/** Inputs of the problem, e.g., boundary values and parameters, at which the solution was obtained.
+		* Set by the user of the solver, empty if unknown. */
+		std::vector<double> inputs;
+
+		/** Returns true if no solution is stored */
+		inline bool empty() const { return ispace.empty(); }
+
+		/** Remove the stored solution */
+		inline void clear() { ispace.clear(); fspace.clear(); inputs.clear(); }
+	};
 
+	/**
+	* Interface of the solvers of the boundary-value problems defined by the user-supplied functions of DAESolver,
+	* i.e., COLDAE (DAESolver) and the native collocation solver (CollocationBVPSolver). The members are
+	* documented in DAESolver; a solver may ignore the settings that do not apply to its method.
+	*/
+	class BVPSolver
+	{
+		public:
+		/** Destructor */
+		virtual ~BVPSolver() {}
+
+		virtual void set_tolerance(int ltol_size = 0, int *ltol  = NULL, double *tol = NULL) = 0;
+		virtual void set_linear(void) = 0;
+		virtual void set_collocation_points(int pnts) = 0;
+		virtual void set_initial_mesh_size(int pnts) = 0;
+		virtual void set_max_mesh_size(int nmax) = 0;
+		virtual void set_output(int level) = 0;
+		virtual void set_fixpnts(int fixpnt_size= 1, double *fixpnt = NULL) = 0;
+		virtual void set_solver_control(int control) = 0;
+		virtual void use_simple_cont(void) = 0;
+		virtual int get_ODE_order(void) = 0;
+		virtual int DAE_solve(void) = 0;
+		virtual void DAE_solution(double x, double z[], double y[]) = 0;
+		virtual int get_size_final_mesh(void) = 0;
+		virtual void get_copy_final_mesh (double *mesh) = 0;
+		virtual void get_solution_coefficients (DAESolutionCoefficients &coefficients) const = 0;
+		virtual bool set_initial_solution (const DAESolutionCoefficients &coefficients) = 0;
+		virtual bool set_fixed_mesh (int n_intervals, const double *mesh) = 0;
+	};
 
 	/**
 	* This class provides an interface to the Fortran 77 code COLDAE.
@@ -101,8 +241,22 @@ namespace ApplicationCore
 	* \f[ u_{i}^{(m_{i})} \f]
 	*is the ith derivative of
 	* \f[ u_{i}. \f]
+	*
+	* The user-supplied functions can either be plain functions, or functions that receive a user context
+	* pointer as first argument, e.g., the object that defines the problem. The second form is reentrant: COLDAE
+	* does not forward any user data, hence DAE_solve() passes static functions to COLDAE that find the
+	* solver through a thread-local pointer to the solver being run on the calling thread. The pointer is
+	* reset when DAE_solve() returns or throws, so solvers can be run on any number of threads and from any thread pool.
+	* A user-supplied function cannot run another solver on the same thread, since COLDAE keeps the state of the
+	* solve in its common blocks, and DAE_solve() throws std::logic_error in that case.
+	*
+	* @note Concurrent solves require COLDAE to be compiled with its common blocks private to each thread,
+	* i.e., with COLDAE_USE_OPENMP.
+	*
+	* The work arrays of COLDAE are taken from the DAEWorkspacePool of the calling thread and returned to it by
+	* the destructor. They should be sized with set_max_mesh_size() from the largest mesh the problem needs.
 	*/
-	class DAESolver
+	class DAESolver : public BVPSolver
 	{
 		public:
 
@@ -128,6 +282,18 @@ namespace ApplicationCore
 		void (*dgsub)(int &, double [], double []),
 		void (*guess)(double &, double [], double [], double [])=NULL);
 
+		/** Constructor for user-supplied functions with a user context.
+		* @param context is the pointer passed as first argument to all the user-supplied functions.
+		* See the constructor above for the other parameters.
+		*/
+		DAESolver(int m_comp, int ny, int m[], double a, double b, double zeta[],
+		void *context,
+		fsub_context_ptr fsub,
+		dfsub_context_ptr dfsub,
+		gsub_context_ptr gsub,
+		dgsub_context_ptr dgsub,
+		guess_context_ptr guess=NULL);
+
 		/**
 		 * Destructor - clear all data
 		 */
@@ -166,6 +332,13 @@ namespace ApplicationCore
 		* @note Must be used before a call to DAE_solve().
 		*/
 		void set_float_space(int fspace_size= 0, double *fspace = NULL);
+		/** Sets the size of the integer and double arrays used by COLDAE from the maximum number of mesh
+		* subintervals, using the formulas in COLDAE.  The arrays are then sized when DAE_solve() is called,
+		* i.e., once the number of collocation points is known.
+		* @param nmax is the maximum number of subintervals in the mesh.
+		* @note Must be used before a call to DAE_solve().  Any array size set before is discarded.
+		*/
+		void set_max_mesh_size(int nmax);
 		/** Set output level for COLDAE.
 		* @param level is the desired output level where
 			level = -1 is for full output, level = 0 is for selected output, and level=1 is for no output.
@@ -215,6 +388,7 @@ namespace ApplicationCore
 		* -1 indicates the expected number of subintervals exceeds storage specifications,
 		* -2 indicates the nonlinear iteration has not converged, and
 		* -3 indicates there is an input data error.
+		* @note Throws std::logic_error if another solve runs on the calling thread, i.e., if it is called from a user-supplied function.
 		 */
 		int DAE_solve(void);
 
@@ -252,6 +426,33 @@ namespace ApplicationCore
 		*/
 		void get_copy_final_mesh (double *mesh);
 
+		/** Copies the mesh and collocation coefficients of the solution.
+		* @note This function should only be used after a successful call
+		*	to DAE_solve().
+		*/
+		void get_solution_coefficients (DAESolutionCoefficients &coefficients) const;
+
+		/** Use a solution of the same problem, e.g., with other boundary values or parameters, as first
+		* approximation in the next call to DAE_solve() instead of the guess function. The next solve starts
+		* on the mesh of this solution.
+		* @param coefficients is a solution obtained from get_solution_coefficients() by a solver with
+		*	the same number of ODEs, orders and collocation points.
+		* @return False if the work arrays can not hold the mesh of the solution, in which case the guess
+		*	function is used.
+		* @note The work arrays must be sized, e.g., with set_max_mesh_size(), before this function is called.
+		*/
+		bool set_initial_solution (const DAESolutionCoefficients &coefficients);
+
+		/** Solve on the given mesh without adaptive mesh selection (ipar(8) = 2 in COLDAE). COLDAE still
+		* solves once more on the mesh with every subinterval halved to estimate the error, so the work arrays
+		* must hold twice as many subintervals.
+		* @param n_intervals is the number of subintervals of the mesh.
+		* @param mesh is an array with the n_intervals+1 mesh points, e.g., from get_copy_final_mesh().
+		* @return False if the work arrays can not hold the mesh.
+		* @note The work arrays must be sized, e.g., with set_max_mesh_size(), before this function is called.
+		*/
+		bool set_fixed_mesh (int n_intervals, const double *mesh);
+
 		/** Overloads delete operator */
 // 		void operator delete (void *p);
 
@@ -296,6 +497,35 @@ namespace ApplicationCore
 		/** Pointer to geuss function */
 		void (*DAE_guess) (double &, double [], double [], double []);
 
+		/** User context passed to the user-supplied functions with a context */
+		void *context;
+		/** Pointer to DAE function with a user context */
+		fsub_context_ptr context_fsub;
+		/** Pointer to jacobian of fsub with a user context */
+		dfsub_context_ptr context_dfsub;
+		/** Pointer to boundary condition function with a user context */
+		gsub_context_ptr context_gsub;
+		/** Pointer to jacobian of boundary condition function with a user context */
+		dgsub_context_ptr context_dgsub;
+		/** Pointer to guess function with a user context */
+		guess_context_ptr context_guess;
+		/** Flag stating if the user-supplied functions take a user context */
+		bool use_context;
+
+		/** Solver being run by DAE_solve() on this thread, used by the functions passed to COLDAE below */
+		static thread_local DAESolver *active_solver;
+
+		/** Functions passed to COLDAE for user-supplied functions with a user context */
+		static void context_fsub_call (double &, double [], double [], double []);
+		static void context_dfsub_call (double &, double [], double [], double []);
+		static void context_gsub_call (int &, double [], double &);
+		static void context_dgsub_call (int &, double [], double []);
+		static void context_guess_call (double &, double [], double [], double []);
+
+		/** Sets the default options, the problem size, the boundary points and the side conditions.
+		* Used by both constructors, see the constructors for the parameters.
+		*/
+		void init(int m_comp, int ny, int m[], double a, double b, double zeta[]);
 		/** Sets the problem size.
 		* @param num_ODEs is the number of ODE.
 		* @param num_Alg_Const is the number of algebraic constraints.
@@ -318,9 +548,14 @@ namespace ApplicationCore
 			solve the DAE.*/
 		void set_ipar(void);
 
-		/** Deletes dynamic memory */
+		/** Deletes dynamic memory and returns the work arrays to the DAEWorkspacePool */
 		void clear_mem(void);
 
+		/** Computes the fixed part and the part per mesh subinterval of the integer and
+		* double arrays used by COLDAE, see the description of ispace and fspace in COLDAE.
+		*/
+		void get_workspace_sizes(int &nfixi, int &nsizei, int &nfixf, int &nsizef) const;
+
 
 		// user-supllied subroutines flags
 		/** Boolian for DAE function */
@@ -386,6 +621,8 @@ namespace ApplicationCore
 		bool set_fspace;
 		/** USer old fspace for continuation */
 		bool use_old_fspace;
+		/** Maximum number of mesh subintervals, zero if the array sizes are given directly */
+		int max_mesh_size;
 
 		/**  Output level */
 		int output_level;
@@ -418,6 +655,10 @@ namespace ApplicationCore
 		double b;
 		/** use simple continuation */
 		bool use_cont;
+		/** Start the next solve from the solution given to set_initial_solution() */
+		bool use_initial_solution;
+		/** Number of subintervals of the mesh given to set_fixed_mesh(), zero if COLDAE selects the mesh */
+		int fixed_mesh_size;
 	};
 
 
@@ -18,6 +18,8 @@
 // STD DECLARATIONS
 //------------------------------
 #include <iostream>
+#include <vector>
+#include <cmath>
 
 
 #include <boost/shared_ptr.hpp>
@@ -35,20 +37,9 @@
 // FUEL CELL DECLARATIONS
 //------------------------------
 #include <contribs/DAE_solver.h>
+#include <contribs/collocation_BVP_solver.h>
 #include <utils/logging.h>
 
-/** \file */
-
-// Must be very careful with this... it is now 'declared' as a global variable within FCST
-// The 'definition' of the pointer in included in the .cc file.
-// The implementation (assignment) of an object to the pointer should be within the derived class
-#ifdef _OPENMP
-	#include <omp.h>
-#else
-	#define omp_get_thread_num() 0
-#endif
-extern void *ptr_DAE_object[20];
-
 using namespace dealii;
 using namespace alglib;
 
@@ -63,19 +54,17 @@ namespace ApplicationCore
 	* 	in a derived class.  The functions here are define a Differential Algebraic Equation,
 	* 	more specifically in this case, a system of ODE's.
 	*
-	* The derived classes must have the specific implementation of the functions and
-	* 	static wrapper functions that point to the implementation.  This is so that
-	* 	the DAESolver can be used in a generic form and interface with COLDAE.
+	* The derived classes must have the specific implementation of the functions. The solver
+	* 	is created in setup_DAE_solver() with the object itself as user context and the static
+	* 	callback functions of this class, which call the virtual functions of the object:
 	*
-	* The static wrapper functions should take the form:
-	*
-	* 	\code static void fsub_wrapper (double &, double [], double [], double [])
-	* 			DerivedClass *ptr_to_class = (DerivedClass*) ptr_DAE_object;
-	*			ptr_to_class->fsub(x, z, y, f);
+	* 	\code prob = create_BVP_solver(native_BVP_solver,
+	*                               &fsub_callback, &dfsub_callback,
+	*                               &gsub_callback, &dgsub_callback,
+	*                               &guess_callback);
 	*	\endcode
 	*
-	* 	where ptr_DAE_object is a void globally defined variable that can take any form.
-	* 	This must be used with caution.
+	* 	Therefore, each object solves its own problem and objects can be solved concurrently on any thread.
 	*
 	* \author Peter Dobson
 	*/
@@ -105,7 +94,7 @@ namespace ApplicationCore
 	 *
 	 * The points returned in @param X are transformed to be points between @param lb and @param ub.
 	 */
-	void get_quadrature_points (double lb, double ub, std::vector<double>& X, std::vector<double>& W, FuelCell::ApplicationCore::DAESolver* prob);
+	void get_quadrature_points (double lb, double ub, std::vector<double>& X, std::vector<double>& W, FuelCell::ApplicationCore::BVPSolver* prob);
 
 	/** Setup the variables in the problem required by the DAE Solver */
 	virtual void setup_DAE_solver () = 0;
@@ -152,6 +141,65 @@ namespace ApplicationCore
 	*/
 	virtual void guess (double &, double [], double [], double []) = 0;
 
+	///@name Callbacks passed to the DAESolver, \p context is the DAEWrapper object
+	//@{
+	static void fsub_callback (void *context, double &x, double z[], double y[], double f[])
+	{ static_cast<DAEWrapper*>(context)->fsub(x, z, y, f); }
+
+	static void dfsub_callback (void *context, double &x, double z[], double y[], double df[])
+	{ static_cast<DAEWrapper*>(context)->dfsub(x, z, y, df); }
+
+	static void gsub_callback (void *context, int &i, double z[], double &g)
+	{ static_cast<DAEWrapper*>(context)->gsub(i, z, g); }
+
+	static void dgsub_callback (void *context, int &i, double z[], double dg[])
+	{ static_cast<DAEWrapper*>(context)->dgsub(i, z, dg); }
+
+	static void guess_callback (void *context, double &x, double z[], double y[], double df[])
+	{ static_cast<DAEWrapper*>(context)->guess(x, z, y, df); }
+	//@}
+
+	///@name Derivatives of the solution with respect to a parameter
+	//@{
+	/**
+	* Solve the linearized problem for the derivative \f$ s = \partial z / \partial p \f$ of the solution in #prob
+	* with respect to a parameter \f$ p \f$ of fsub and gsub, i.e.,
+	* \f[ s' = \frac{\partial f}{\partial z} s + \frac{\partial f}{\partial p}, \quad
+	*     \frac{\partial g_j}{\partial z} s(\zeta_j) + \frac{\partial g_j}{\partial p} = 0. \f]
+	* The Jacobians are given by dfsub and dgsub at the converged solution, i.e., they are the ones used by the last
+	* Newton iteration, and the derivatives with respect to \f$ p \f$ are computed by central differences of fsub and gsub.
+	* The problem is linear and it is solved on the final mesh of #prob without mesh selection, hence it costs about as
+	* much as two Newton iterations of the original problem.
+	*
+	* @param parameter is the member variable used by fsub and gsub for \f$ p \f$. It is restored on return.
+	* @return A solver of the same type as #prob holding the derivative, which must be deleted by the caller, or NULL if
+	*	the linear problem could not be solved.
+	* @note #prob must hold a converged solution. Only ODEs of first order without algebraic constraints are supported.
+	*/
+	FuelCell::ApplicationCore::BVPSolver* solve_sensitivity (double &parameter);
+
+	/**
+	* Compute the derivative with respect to \p parameter of the integral of integrand() over the subintervals of the final
+	* mesh of #prob in \f$ [\tt{boundary\_0}, \tt{upper}] \f$, using the same quadrature as get_quadrature_points().
+	* The derivative of the solution is obtained with solve_sensitivity().
+	*
+	* @return False if the linearized problem could not be solved, in which case \p derivative is not modified.
+	*/
+	bool integral_derivative (double &parameter, const double upper, double &derivative);
+
+	/**
+	* Integrand of the quantity differentiated by integral_derivative(), e.g., the volumetric current of an agglomerate,
+	* at the point \p x for the solution \p z. It may depend on the parameters of fsub and gsub.
+	*
+	* Must be reimplemented in the derived classes that use integral_derivative().
+	*/
+	virtual double integrand (const double &, double [])
+	{
+		Assert(false, ExcPureFunctionCalled());
+		return 0.0;
+	}
+	//@}
+
 	/** Set the verbosity variable (controls output to screen) */
 	inline void verbosity(int i)
 	{n_output = i;}
@@ -171,15 +219,22 @@ namespace ApplicationCore
 		delete [] tol;
 		delete [] ltol;
 		delete prob;
-		if (ptr_DAE_object[omp_get_thread_num()] != NULL)
-		{
-			ptr_DAE_object[omp_get_thread_num()] = NULL;
-			//delete ptr_DAE_object;
-		}
 	}
 
 	protected:
 
+	/**
+	* Create the solver of the problem defined by #n_comp, #n_y, #mm, #boundary_0, #boundary_1 and #zeta, with this
+	* object as user context of the user-supplied functions. It is COLDAE (DAESolver) or, if \p native is true, the
+	* CollocationBVPSolver for #m_star unknowns, which is instantiated for up to 8 unknowns.
+	*/
+	FuelCell::ApplicationCore::BVPSolver* create_BVP_solver (const bool native,
+	                                                         fsub_context_ptr fsub,
+	                                                         dfsub_context_ptr dfsub,
+	                                                         gsub_context_ptr gsub,
+	                                                         dgsub_context_ptr dgsub,
+	                                                         guess_context_ptr guess = NULL);
+
 	/** Number of mesh points */
 	int n_mesh;
 
@@ -216,7 +271,7 @@ namespace ApplicationCore
 	double *zeta;
 
 	/** DAE problem solver object */
-	FuelCell::ApplicationCore::DAESolver *prob;
+	FuelCell::ApplicationCore::BVPSolver *prob;
 
 	/** Array of fixed points on the mesh */
 	double *fixpnt;
@@ -233,6 +288,41 @@ namespace ApplicationCore
 
 	/** Convert from centimetres cubed to metres cubed. */
 	double cm3_to_m3;
+
+	private:
+	///@name Linearized problem solved by solve_sensitivity()
+	//@{
+	/** Right-hand side, Jacobian and boundary conditions of the linearized problem */
+	void sensitivity_fsub (double &x, double s[], double f[]);
+	void sensitivity_dfsub (double &x, double df[]);
+	void sensitivity_gsub (int &i, double s[], double &g);
+	void sensitivity_dgsub (int &i, double dg[]);
+
+	static void sensitivity_fsub_callback (void *context, double &x, double s[], double [], double f[])
+	{ static_cast<DAEWrapper*>(context)->sensitivity_fsub(x, s, f); }
+
+	static void sensitivity_dfsub_callback (void *context, double &x, double [], double [], double df[])
+	{ static_cast<DAEWrapper*>(context)->sensitivity_dfsub(x, df); }
+
+	static void sensitivity_gsub_callback (void *context, int &i, double s[], double &g)
+	{ static_cast<DAEWrapper*>(context)->sensitivity_gsub(i, s, g); }
+
+	static void sensitivity_dgsub_callback (void *context, int &i, double [], double dg[])
+	{ static_cast<DAEWrapper*>(context)->sensitivity_dgsub(i, dg); }
+
+	/** Evaluate the solution, the Jacobian of fsub and the derivative of fsub with respect to the parameter at x */
+	void linearize_at (const double &x);
+
+	/** Step used for the central differences with respect to the parameter \p p */
+	static double parameter_step (const double p)
+	{ return (p != 0.0) ? 1.e-6*std::fabs(p) : 1.e-6; }
+
+	/** Parameter of the linearized problem being solved */
+	double *sensitivity_parameter;
+	/** Point of the last linearization, its solution, Jacobian and derivative with respect to the parameter */
+	double linearization_x;
+	std::vector<double> linearization_z, linearization_df, linearization_dfdp;
+	//@}
 	};
 
 }
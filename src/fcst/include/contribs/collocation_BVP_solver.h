@@ -0,0 +1,992 @@
+//---------------------------------------------------------------------------
+// C++ Interface: collocation_BVP_solver.h
+//
+// Description: Native collocation solver for the boundary-value problems
+//				defined for the DAESolver, templated on the problem size.
+//
+// Copyright: See COPYING file that comes with this distribution
+//
+//---------------------------------------------------------------------------
+
+#ifndef FUEL_CELL__COLLOCATION_BVP_SOLVER__H
+#define FUEL_CELL__COLLOCATION_BVP_SOLVER__H
+
+//------------------------------
+// STD DECLARATIONS
+//------------------------------
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+//------------------------------
+// FUEL CELL DECLARATIONS
+//------------------------------
+#include <contribs/DAE_solver.h>
+
+namespace FuelCell
+{
+namespace ApplicationCore
+{
+	/**
+	* Band matrix factorized by Gaussian elimination with partial pivoting, i.e., LINPACK dgbfa and dgbsl.
+	*
+	* The matrix has \p ml subdiagonals and \p mu superdiagonals. Each column is stored in a fixed-size array of
+	* \p rows entries, which must be at least 2 ml + mu + 1 to make room for the fill-in of the pivoting.
+	*/
+	template <int rows>
+	class BandLU
+	{
+		public:
+		/** Set the size and bandwidths of the matrix and zero all entries. */
+		void reinit(const int size, const int lower, const int upper)
+		{
+			if (2*lower + upper + 1 > rows)
+				throw std::invalid_argument("The bandwidths of the matrix exceed the storage of BandLU");
+			n = size;
+			ml = lower;
+			mu = upper;
+			std::array<double, rows> zero;
+			zero.fill(0.0);
+			columns.assign(n, zero);
+			pivots.resize(n);
+		}
+
+		/** Entry \p i, \p j of the matrix, numbered from zero. It must be within the bandwidths. */
+		inline double &operator()(const int i, const int j)
+		{ return columns[j][i - j + ml + mu]; }
+
+		/** LU factorization, returns false if the matrix is singular. */
+		bool factorize()
+		{
+			const int m = ml + mu + 1;
+			int ju = 0;
+			for (int k = 1; k <= n - 1; ++k)
+			{
+				const int lm = std::min(ml, n - k);
+
+				//Find the pivot
+				int l = m;
+				double amax = std::fabs(abd(m, k));
+				for (int i = m + 1; i <= m + lm; ++i)
+					if (std::fabs(abd(i, k)) > amax)
+					{
+						amax = std::fabs(abd(i, k));
+						l = i;
+					}
+				pivots[k-1] = l + k - m;
+				if (amax == 0.0)
+					return false;
+
+				if (l != m)
+					std::swap(abd(l, k), abd(m, k));
+
+				//Compute the multipliers
+				const double t = -1.0/abd(m, k);
+				for (int i = m + 1; i <= m + lm; ++i)
+					abd(i, k) *= t;
+
+				//Eliminate with column indexing
+				ju = std::min(std::max(ju, mu + pivots[k-1]), n);
+				int mm = m;
+				for (int j = k + 1; j <= ju; ++j)
+				{
+					--l;
+					--mm;
+					const double s = abd(l, j);
+					if (l != mm)
+					{
+						abd(l, j) = abd(mm, j);
+						abd(mm, j) = s;
+					}
+					for (int i = 1; i <= lm; ++i)
+						abd(mm + i, j) += s*abd(m + i, k);
+				}
+			}
+			pivots[n-1] = n;
+			return abd(m, n) != 0.0;
+		}
+
+		/** Solve the factorized system, \p b is overwritten by the solution. */
+		void solve(std::vector<double> &b)
+		{
+			const int m = ml + mu + 1;
+			//Solve L y = b
+			for (int k = 1; k <= n - 1; ++k)
+			{
+				const int lm = std::min(ml, n - k);
+				const int l = pivots[k-1];
+				const double t = b[l-1];
+				if (l != k)
+				{
+					b[l-1] = b[k-1];
+					b[k-1] = t;
+				}
+				for (int i = 1; i <= lm; ++i)
+					b[k-1+i] += t*abd(m + i, k);
+			}
+			//Solve U x = y
+			for (int k = n; k >= 1; --k)
+			{
+				b[k-1] /= abd(m, k);
+				const int lm = std::min(k, m) - 1;
+				const int la = m - lm;
+				const int lb = k - lm;
+				const double t = -b[k-1];
+				for (int i = 0; i < lm; ++i)
+					b[lb-1+i] += t*abd(la + i, k);
+			}
+		}
+
+		private:
+		/** Entry of the band storage of LINPACK, numbered from one */
+		inline double &abd(const int i, const int j)
+		{ return columns[j-1][i-1]; }
+
+		/** Size and bandwidths of the matrix */
+		int n, ml, mu;
+		/** Columns of the band storage */
+		std::vector< std::array<double, rows> > columns;
+		/** Pivot rows, numbered from one */
+		std::vector<int> pivots;
+	};
+
+	/**
+	* Native collocation solver for the boundary-value problems defined by the user-supplied functions of DAESolver,
+	* for \p n_z \f$ = m^{*} \f$ unknowns \f$ z(u(x)) \f$. It avoids the setup of COLDAE and of its work arrays for
+	* the small problems solved at every quadrature point by the numerical agglomerates.
+	*
+	* The ODEs are written as the first-order system \f$ z' = F(x, z) \f$, where the last entry of \f$ z \f$ of each
+	* component is given by fsub and the others are the derivatives stored in \f$ z \f$. The system is discretized by
+	* collocation at the three Gauss points of each subinterval, i.e., the solution is a piecewise polynomial of degree
+	* three and it is of order six at the mesh points. As in COLDAE, fsub is never evaluated at the mesh points, e.g., at
+	* the centre of a spherical agglomerate. The derivatives at the collocation points are eliminated in each subinterval
+	* with a dense LU factorization of fixed size \f$ 3 n_z \f$, hence the Jacobian of the values at the mesh points is a
+	* band matrix assembled from \f$ n_z \times n_z \f$ blocks and factorized with BandLU. The nonlinear problem is
+	* solved by a damped Newton method.
+	*
+	* The mesh is selected by comparing the solution on the mesh with the solution on the mesh with every subinterval
+	* bisected. Since the solution is of order four between the mesh points, the difference is about 15 times the error
+	* of the solution on the finer mesh. This solution is accepted when the estimated error satisfies the tolerances at
+	* every mesh point and midpoint, otherwise the subintervals where it does not are subdivided.
+	*
+	* Only boundary conditions at \p a or \p b and problems without algebraic constraints are supported. The number of
+	* collocation points, the output level and the Newton control of DAESolver are ignored.
+	*/
+	template <int n_z>
+	class CollocationBVPSolver : public BVPSolver
+	{
+		public:
+		/**
+		* Constructor, see the constructor of DAESolver with a user context.
+		* @note \p ny must be zero and the orders in \p m must add up to \p n_z.
+		*/
+		CollocationBVPSolver(int m_comp, int ny, int m[], double a, double b, double zeta[],
+		void *context,
+		fsub_context_ptr fsub,
+		dfsub_context_ptr dfsub,
+		gsub_context_ptr gsub,
+		dgsub_context_ptr dgsub,
+		guess_context_ptr guess=NULL)
+		:
+		n_comp(m_comp),
+		orders(m, m + m_comp),
+		boundary_a(a),
+		boundary_b(b),
+		zeta(zeta, zeta + n_z),
+		context(context),
+		fsub(fsub),
+		dfsub(dfsub),
+		gsub(gsub),
+		dgsub(dgsub),
+		guess(guess),
+		n_tol(0),
+		ltol(NULL),
+		tol(NULL),
+		linear(false),
+		initial_mesh_size(5),
+		max_mesh_size(20000),
+		fixed_mesh(false),
+		restart(false),
+		use_initial_solution(false)
+		{
+			int sum = 0;
+			for (int comp = 0; comp < n_comp; ++comp)
+				sum += orders[comp];
+			if (ny != 0 || sum != n_z)
+				throw std::invalid_argument("CollocationBVPSolver requires ODEs without algebraic constraints and n_z unknowns");
+
+			n_left = 0;
+			for (int j = 0; j < n_z; ++j)
+			{
+				if (this->zeta[j] == boundary_a)
+					++n_left;
+				else if (this->zeta[j] != boundary_b)
+					throw std::invalid_argument("CollocationBVPSolver only supports boundary conditions at a and b");
+			}
+
+			//Gauss points on [0, 1] and the coefficients of the collocation method
+			c[0] = 0.5 - std::sqrt(15.0)/10.0;
+			c[1] = 0.5;
+			c[2] = 0.5 + std::sqrt(15.0)/10.0;
+			for (int s = 0; s < n_stages; ++s)
+			{
+				for (int t = 0; t < n_stages; ++t)
+					a_coefficients[s][t] = beta(t, c[s]);
+				b_coefficients[s] = beta(s, 1.0);
+			}
+		}
+
+		/** Tolerances on the components \p ltol, numbered from one. The arrays are not copied, so
+		* changes to them apply to the next solve. The default is 1e-6 on all components. */
+		void set_tolerance(int ltol_size = 0, int *ltol  = NULL, double *tol = NULL)
+		{
+			if (ltol != NULL && tol != NULL)
+			{
+				n_tol = ltol_size;
+				this->ltol = ltol;
+				this->tol = tol;
+			}
+			else
+			{
+				n_tol = 0;
+				this->ltol = NULL;
+				this->tol = NULL;
+			}
+		}
+
+		/** A single Newton iteration is performed on each mesh. */
+		void set_linear(void) { linear = true; }
+
+		/** Ignored, three Gauss points are used. */
+		void set_collocation_points(int) {}
+
+		/** Number of subintervals of the initial mesh. */
+		void set_initial_mesh_size(int pnts) { initial_mesh_size = std::max(pnts, 1); }
+
+		/** Maximum number of subintervals. */
+		void set_max_mesh_size(int nmax) { max_mesh_size = nmax; }
+
+		/** Ignored. */
+		void set_output(int) {}
+
+		/** Points inside (a, b) which are kept in every mesh. */
+		void set_fixpnts(int fixpnt_size= 1, double *fixpnt = NULL)
+		{
+			fixpnts.clear();
+			if (fixpnt != NULL)
+				fixpnts.assign(fixpnt, fixpnt + fixpnt_size);
+		}
+
+		/** Ignored. */
+		void set_solver_control(int) {}
+
+		/** Start the next solves from the last solution, on every other point of its mesh and the fixed points, instead of the guess. */
+		void use_simple_cont(void) { restart = true; }
+
+		int get_ODE_order(void) { return orders[0]; }
+
+		/**
+		* Solve the problem.
+		* @return 1 for a normal return, 0 if a Jacobian is singular, -1 if the mesh exceeds the maximum
+		* number of subintervals and -2 if the Newton iteration does not converge, as DAESolver::DAE_solve().
+		*/
+		int DAE_solve(void)
+		{
+			set_component_tolerances();
+
+			std::vector<double> coarse_mesh, coarse_values, coarse_stages;
+			if (fixed_mesh)
+			{
+				fixed_mesh = false;
+				coarse_mesh = fixed_mesh_points;
+				initial_values(coarse_mesh, coarse_values, coarse_stages);
+				const int flag = newton(coarse_mesh, coarse_values, coarse_stages);
+				if (flag == 1)
+					store_solution(coarse_mesh, coarse_values, coarse_stages);
+				return flag;
+			}
+
+			//The solution given to set_initial_solution() is only used by the next solve, as in DAESolver
+			const bool from_solution = (restart || use_initial_solution) && !mesh.empty();
+			use_initial_solution = false;
+
+			if (from_solution)
+			{
+				for (unsigned int i = 0; i < mesh.size(); i += 2)
+					coarse_mesh.push_back(mesh[i]);
+				if (coarse_mesh.back() != mesh.back())
+					coarse_mesh.push_back(mesh.back());
+				//The fixed points might be at odd indices of the last mesh
+				add_fixpnts(coarse_mesh);
+				transfer(mesh, values, stages, coarse_mesh, coarse_values, coarse_stages);
+			}
+			else
+			{
+				initial_mesh(coarse_mesh);
+				initial_values(coarse_mesh, coarse_values, coarse_stages);
+			}
+
+			int flag = newton(coarse_mesh, coarse_values, coarse_stages);
+			if (flag != 1)
+				return flag;
+
+			std::vector<double> fine_mesh, fine_values, fine_stages, errors, refined_mesh;
+			for (;;)
+			{
+				const int n_coarse = coarse_mesh.size() - 1;
+				if (2*n_coarse > max_mesh_size)
+					return -1;
+
+				//Solve on the bisected mesh, starting from the coarse solution
+				fine_mesh.resize(2*n_coarse + 1);
+				for (int i = 0; i < n_coarse; ++i)
+				{
+					fine_mesh[2*i] = coarse_mesh[i];
+					fine_mesh[2*i+1] = 0.5*(coarse_mesh[i] + coarse_mesh[i+1]);
+				}
+				fine_mesh[2*n_coarse] = coarse_mesh[n_coarse];
+				transfer(coarse_mesh, coarse_values, coarse_stages, fine_mesh, fine_values, fine_stages);
+
+				flag = newton(fine_mesh, fine_values, fine_stages);
+				if (flag != 1)
+					return flag;
+
+				//Error of the fine solution in each subinterval of the coarse mesh, at its ends and midpoint
+				errors.assign(n_coarse, 0.0);
+				double max_error = 0.0;
+				Vector z;
+				for (int i = 0; i < n_coarse; ++i)
+				{
+					const double h = coarse_mesh[i+1] - coarse_mesh[i];
+					for (int p = 0; p < 3; ++p)
+					{
+						polynomial(h, 0.5*p, &coarse_values[i*n_z], &coarse_stages[i*n_local], z);
+						const double *fine = &fine_values[(2*i+p)*n_z];
+						for (int k = 0; k < n_z; ++k)
+							if (error_component[k])
+								errors[i] = std::max(errors[i],
+								                     std::fabs(z[k] - fine[k])/(15.0*component_tol[k]*(1.0 + std::fabs(fine[k]))));
+					}
+					max_error = std::max(max_error, errors[i]);
+				}
+
+				if (max_error <= 1.0)
+				{
+					store_solution(fine_mesh, fine_values, fine_stages);
+					return 1;
+				}
+
+				//Subdivide the subintervals with large errors so that their error is about half of the tolerance on the next fine mesh
+				refined_mesh.assign(1, coarse_mesh[0]);
+				for (int i = 0; i < n_coarse; ++i)
+				{
+					int parts = 1;
+					if (errors[i] > 1.0)
+						parts = std::min(std::max(int(std::ceil(1.2*std::pow(errors[i], 0.25))), 2), 8);
+					const double h = (coarse_mesh[i+1] - coarse_mesh[i])/parts;
+					for (int p = 1; p < parts; ++p)
+						refined_mesh.push_back(coarse_mesh[i] + p*h);
+					refined_mesh.push_back(coarse_mesh[i+1]);
+				}
+				if (int(refined_mesh.size()) - 1 > max_mesh_size)
+					return -1;
+
+				transfer(fine_mesh, fine_values, fine_stages, refined_mesh, coarse_values, coarse_stages);
+				coarse_mesh.swap(refined_mesh);
+
+				flag = newton(coarse_mesh, coarse_values, coarse_stages);
+				if (flag != 1)
+					return flag;
+			}
+		}
+
+		/** Solution \p z at \p x. \p y is not used. */
+		void DAE_solution(double x, double z[], double [])
+		{
+			if (mesh.empty())
+			{
+				std::fill(z, z + n_z, 0.0);
+				return;
+			}
+			Vector w;
+			solution_at(mesh, values, stages, x, w);
+			std::copy(w.begin(), w.end(), z);
+		}
+
+		int get_size_final_mesh(void) { return mesh.size(); }
+
+		void get_copy_final_mesh (double *copy)
+		{ std::copy(mesh.begin(), mesh.end(), copy); }
+
+		/** The coefficients are the number of subintervals and \p n_z in \p ispace, followed by the mesh, the values
+		* at the mesh points and the derivatives at the collocation points in \p fspace. */
+		void get_solution_coefficients (DAESolutionCoefficients &coefficients) const
+		{
+			coefficients.clear();
+			if (mesh.empty())
+				return;
+			coefficients.ispace.push_back(mesh.size() - 1);
+			coefficients.ispace.push_back(n_z);
+			coefficients.fspace = mesh;
+			coefficients.fspace.insert(coefficients.fspace.end(), values.begin(), values.end());
+			coefficients.fspace.insert(coefficients.fspace.end(), stages.begin(), stages.end());
+		}
+
+		bool set_initial_solution (const DAESolutionCoefficients &coefficients)
+		{
+			if (coefficients.ispace.size() != 2 || coefficients.ispace[1] != n_z)
+				return false;
+			const int n_intervals = coefficients.ispace[0];
+			if (n_intervals < 1 || n_intervals > max_mesh_size
+			    || int(coefficients.fspace.size()) != (n_intervals + 1)*(n_z + 1) + n_intervals*n_local)
+				return false;
+
+			std::vector<double>::const_iterator begin = coefficients.fspace.begin();
+			mesh.assign(begin, begin + n_intervals + 1);
+			begin += n_intervals + 1;
+			values.assign(begin, begin + (n_intervals + 1)*n_z);
+			begin += (n_intervals + 1)*n_z;
+			stages.assign(begin, coefficients.fspace.end());
+			use_initial_solution = true;
+			return true;
+		}
+
+		bool set_fixed_mesh (int n_intervals, const double *points)
+		{
+			if (n_intervals < 1 || n_intervals > max_mesh_size)
+				return false;
+			fixed_mesh_points.assign(points, points + n_intervals + 1);
+			fixed_mesh = true;
+			return true;
+		}
+
+		private:
+		/** Number of collocation points in each subinterval */
+		static const int n_stages = 3;
+		/** Number of derivatives at the collocation points of a subinterval */
+		static const int n_local = n_stages*n_z;
+
+		/** Vector and matrix of the first-order system, the matrices are stored by rows */
+		typedef std::array<double, n_z> Vector;
+		typedef std::array<double, n_z*n_z> Matrix;
+		typedef std::array<double, n_local*n_local> LocalMatrix;
+		typedef std::array<int, n_local> LocalPivots;
+
+		/** Right-hand side \p F of the first-order system at \p x. */
+		void evaluate(double x, const double *w, Vector &F)
+		{
+			Vector z, f, y;
+			std::copy(w, w + n_z, z.begin());
+			fsub(context, x, &z[0], &y[0], &f[0]);
+			int comp = 0;
+			int last = orders[0] - 1;
+			for (int slot = 0; slot < n_z; ++slot)
+			{
+				if (slot < last && slot + 1 < n_z)
+					F[slot] = z[slot+1];
+				else
+				{
+					F[slot] = f[comp];
+					if (++comp < n_comp)
+						last += orders[comp];
+				}
+			}
+		}
+
+		/** Right-hand side \p F of the first-order system and its Jacobian \p A at \p x. */
+		void linearize(double x, const double *w, Vector &F, Matrix &A)
+		{
+			evaluate(x, w, F);
+
+			Vector z, y;
+			Matrix df;
+			std::copy(w, w + n_z, z.begin());
+			df.fill(0.0);
+			dfsub(context, x, &z[0], &y[0], &df[0]);
+			A.fill(0.0);
+			int comp = 0;
+			int last = orders[0] - 1;
+			for (int slot = 0; slot < n_z; ++slot)
+			{
+				if (slot < last && slot + 1 < n_z)
+					A[slot*n_z + slot + 1] = 1.0;
+				else
+				{
+					//dfsub is stored by columns with n_comp rows
+					for (int j = 0; j < n_z; ++j)
+						A[slot*n_z + j] = df[comp + j*n_comp];
+					if (++comp < n_comp)
+						last += orders[comp];
+				}
+			}
+		}
+
+		/** Integral over [0, \p t] of the Lagrange polynomial of the collocation point \p s. */
+		double beta(const int s, const double t) const
+		{
+			const int p = (s + 1) % n_stages;
+			const int q = (s + 2) % n_stages;
+			return (t*t*t/3.0 - 0.5*(c[p] + c[q])*t*t + c[p]*c[q]*t)/((c[s] - c[p])*(c[s] - c[q]));
+		}
+
+		/** Value \p z at the collocation point \p s of a subinterval of length \p h. */
+		void stage_value(const double h, const double *w, const double *K, const int s, Vector &z) const
+		{
+			for (int k = 0; k < n_z; ++k)
+			{
+				z[k] = w[k];
+				for (int t = 0; t < n_stages; ++t)
+					z[k] += h*a_coefficients[s][t]*K[t*n_z+k];
+			}
+		}
+
+		/** Value \p z at the relative position \p t of a subinterval of length \p h. */
+		void polynomial(const double h, const double t, const double *w, const double *K, Vector &z) const
+		{
+			double weights[n_stages];
+			for (int s = 0; s < n_stages; ++s)
+				weights[s] = h*beta(s, t);
+			for (int k = 0; k < n_z; ++k)
+			{
+				z[k] = w[k];
+				for (int s = 0; s < n_stages; ++s)
+					z[k] += weights[s]*K[s*n_z+k];
+			}
+		}
+
+		/** Value \p z at \p point of the solution given by \p W and \p K on the mesh \p x. */
+		void solution_at(const std::vector<double> &x, const std::vector<double> &W, const std::vector<double> &K,
+		                 const double point, Vector &z) const
+		{
+			const int n = x.size() - 1;
+			const int i = std::min(std::max(int(std::upper_bound(x.begin(), x.end(), point) - x.begin()) - 1, 0), n - 1);
+			const double h = x[i+1] - x[i];
+			polynomial(h, (point - x[i])/h, &W[i*n_z], &K[i*n_local], z);
+		}
+
+		/** LU factorization with partial pivoting of a local matrix, returns false if it is singular. */
+		static bool local_factorize(LocalMatrix &M, LocalPivots &pivots)
+		{
+			for (int k = 0; k < n_local; ++k)
+			{
+				int p = k;
+				double amax = std::fabs(M[k*n_local+k]);
+				for (int i = k + 1; i < n_local; ++i)
+					if (std::fabs(M[i*n_local+k]) > amax)
+					{
+						amax = std::fabs(M[i*n_local+k]);
+						p = i;
+					}
+				pivots[k] = p;
+				if (amax == 0.0)
+					return false;
+				if (p != k)
+					for (int j = 0; j < n_local; ++j)
+						std::swap(M[k*n_local+j], M[p*n_local+j]);
+				for (int i = k + 1; i < n_local; ++i)
+				{
+					M[i*n_local+k] /= M[k*n_local+k];
+					for (int j = k + 1; j < n_local; ++j)
+						M[i*n_local+j] -= M[i*n_local+k]*M[k*n_local+j];
+				}
+			}
+			return true;
+		}
+
+		/** Solve with a matrix factorized by local_factorize(), \p b is overwritten by the solution. */
+		static void local_solve(const LocalMatrix &M, const LocalPivots &pivots, double *b)
+		{
+			for (int k = 0; k < n_local; ++k)
+				if (pivots[k] != k)
+					std::swap(b[k], b[pivots[k]]);
+			for (int k = 0; k < n_local; ++k)
+				for (int i = k + 1; i < n_local; ++i)
+					b[i] -= M[i*n_local+k]*b[k];
+			for (int k = n_local - 1; k >= 0; --k)
+			{
+				for (int j = k + 1; j < n_local; ++j)
+					b[k] -= M[k*n_local+j]*b[j];
+				b[k] /= M[k*n_local+k];
+			}
+		}
+
+		/**
+		* Assemble the Jacobian of the values \p W at the mesh points \p x in #jacobian and the right-hand side \p R,
+		* after eliminating the corrections of the derivatives \p K at the collocation points, which are
+		* #stage_corrections plus #stage_sensitivities times the correction at the left end of their subinterval.
+		* The equations are the boundary conditions at \p a, the continuity conditions of each subinterval and the
+		* boundary conditions at \p b.
+		* @return False if a local matrix is singular. \p merit is half of the squared norm of all residuals.
+		*/
+		bool assemble(const std::vector<double> &x, const std::vector<double> &W, const std::vector<double> &K,
+		              std::vector<double> &R, double &merit)
+		{
+			const int n = x.size() - 1;
+			const int size = (n + 1)*n_z;
+			R.resize(size);
+			jacobian.reinit(size, n_left + n_z - 1, 2*n_z - 1 - n_left);
+			stage_corrections.resize(n*n_local);
+			stage_sensitivities.resize(n*n_local*n_z);
+			merit = boundary_residuals(x, W, R, true);
+
+			Vector z, F;
+			Matrix A[n_stages];
+			LocalMatrix G;
+			LocalPivots pivots;
+			double rhs[n_local];
+			for (int i = 0; i < n; ++i)
+			{
+				const double h = x[i+1] - x[i];
+				const double *w_0 = &W[i*n_z];
+				const double *w_1 = &W[(i+1)*n_z];
+				const double *K_i = &K[i*n_local];
+				double *p = &stage_corrections[i*n_local];
+				double *Q = &stage_sensitivities[i*n_local*n_z];
+
+				//Collocation conditions K_s = F(z_s) and their Jacobian G with respect to K
+				for (int s = 0; s < n_stages; ++s)
+				{
+					stage_value(h, w_0, K_i, s, z);
+					linearize(x[i] + c[s]*h, &z[0], F, A[s]);
+					for (int k = 0; k < n_z; ++k)
+					{
+						p[s*n_z+k] = F[k] - K_i[s*n_z+k];
+						merit += 0.5*p[s*n_z+k]*p[s*n_z+k];
+					}
+				}
+				for (int s = 0; s < n_stages; ++s)
+					for (int k = 0; k < n_z; ++k)
+						for (int t = 0; t < n_stages; ++t)
+							for (int j = 0; j < n_z; ++j)
+								G[(s*n_z+k)*n_local + t*n_z+j] = ((s == t && k == j) ? 1.0 : 0.0)
+								                                 - h*a_coefficients[s][t]*A[s][k*n_z+j];
+				if (!local_factorize(G, pivots))
+					return false;
+				local_solve(G, pivots, p);
+				for (int j = 0; j < n_z; ++j)
+				{
+					for (int s = 0; s < n_stages; ++s)
+						for (int k = 0; k < n_z; ++k)
+							rhs[s*n_z+k] = A[s][k*n_z+j];
+					local_solve(G, pivots, rhs);
+					for (int r = 0; r < n_local; ++r)
+						Q[r*n_z+j] = rhs[r];
+				}
+
+				//Continuity conditions w_1 = w_0 + h sum_s b_s K_s
+				const int row = n_left + i*n_z;
+				for (int k = 0; k < n_z; ++k)
+				{
+					double residual = w_1[k] - w_0[k];
+					double condensed = 0.0;
+					for (int s = 0; s < n_stages; ++s)
+					{
+						residual -= h*b_coefficients[s]*K_i[s*n_z+k];
+						condensed += h*b_coefficients[s]*p[s*n_z+k];
+					}
+					merit += 0.5*residual*residual;
+					R[row+k] = residual - condensed;
+					for (int j = 0; j < n_z; ++j)
+					{
+						double entry = (k == j) ? -1.0 : 0.0;
+						for (int s = 0; s < n_stages; ++s)
+							entry -= h*b_coefficients[s]*Q[(s*n_z+k)*n_z+j];
+						jacobian(row+k, i*n_z+j) = entry;
+						jacobian(row+k, (i+1)*n_z+j) = (k == j) ? 1.0 : 0.0;
+					}
+				}
+			}
+			return true;
+		}
+
+		/** Half of the squared norm of all residuals for the values \p W and derivatives \p K. */
+		double merit_function(const std::vector<double> &x, const std::vector<double> &W, const std::vector<double> &K)
+		{
+			const int n = x.size() - 1;
+			std::vector<double> R((n + 1)*n_z);
+			double merit = boundary_residuals(x, W, R, false);
+
+			Vector z, F;
+			for (int i = 0; i < n; ++i)
+			{
+				const double h = x[i+1] - x[i];
+				const double *w_0 = &W[i*n_z];
+				const double *K_i = &K[i*n_local];
+				for (int s = 0; s < n_stages; ++s)
+				{
+					stage_value(h, w_0, K_i, s, z);
+					evaluate(x[i] + c[s]*h, &z[0], F);
+					for (int k = 0; k < n_z; ++k)
+						merit += 0.5*(F[k] - K_i[s*n_z+k])*(F[k] - K_i[s*n_z+k]);
+				}
+				for (int k = 0; k < n_z; ++k)
+				{
+					double residual = W[(i+1)*n_z+k] - w_0[k];
+					for (int s = 0; s < n_stages; ++s)
+						residual -= h*b_coefficients[s]*K_i[s*n_z+k];
+					merit += 0.5*residual*residual;
+				}
+			}
+			return merit;
+		}
+
+		/** Residuals of the boundary conditions in \p R, and their Jacobian in #jacobian if \p assemble_jacobian is true.
+		* @return Half of the squared norm of the residuals. */
+		double boundary_residuals(const std::vector<double> &x, const std::vector<double> &W, std::vector<double> &R,
+		                          const bool assemble_jacobian)
+		{
+			const int n = x.size() - 1;
+			double merit = 0.0;
+			Vector z, dg;
+			for (int j = 0; j < n_z; ++j)
+			{
+				const bool left = (j < n_left);
+				const int node = left ? 0 : n;
+				const int row = left ? j : n*n_z + j;
+				int i = j + 1;
+				std::copy(&W[node*n_z], &W[node*n_z] + n_z, z.begin());
+				gsub(context, i, &z[0], R[row]);
+				merit += 0.5*R[row]*R[row];
+				if (assemble_jacobian)
+				{
+					dg.fill(0.0);
+					dgsub(context, i, &z[0], &dg[0]);
+					for (int k = 0; k < n_z; ++k)
+						jacobian(row, node*n_z + k) = dg[k];
+				}
+			}
+			return merit;
+		}
+
+		/** Largest Newton correction \p dW relative to the tolerances of the values \p W. */
+		double correction_norm(const std::vector<double> &dW, const std::vector<double> &W) const
+		{
+			double norm = 0.0;
+			for (unsigned int i = 0; i < W.size(); ++i)
+			{
+				const int k = i % n_z;
+				norm = std::max(norm, std::fabs(dW[i])/(component_tol[k]*(1.0 + std::fabs(W[i]))));
+			}
+			return norm;
+		}
+
+		/**
+		* Solve the discrete problem on \p x by the damped Newton method, starting from \p W and \p K. The step is
+		* halved until the residuals decrease.
+		* @return 1 if converged, 0 if a Jacobian is singular and -2 otherwise.
+		*/
+		int newton(const std::vector<double> &x, std::vector<double> &W, std::vector<double> &K)
+		{
+			const int max_iterations = 40;
+			const double min_damping = 1.e-4;
+			const int n = x.size() - 1;
+			std::vector<double> R, dW, dK(K.size()), trial_W, trial_K;
+			double previous_norm = 0.0;
+			for (int iteration = 0; iteration < max_iterations; ++iteration)
+			{
+				double merit;
+				if (!assemble(x, W, K, R, merit) || !jacobian.factorize())
+					return 0;
+				dW.resize(R.size());
+				for (unsigned int i = 0; i < R.size(); ++i)
+					dW[i] = -R[i];
+				jacobian.solve(dW);
+				for (int i = 0; i < n; ++i)
+					for (int r = 0; r < n_local; ++r)
+					{
+						double &correction = dK[i*n_local+r];
+						correction = stage_corrections[i*n_local+r];
+						for (int j = 0; j < n_z; ++j)
+							correction += stage_sensitivities[(i*n_local+r)*n_z+j]*dW[i*n_z+j];
+					}
+
+				//Full steps are taken once the correction is below the tolerances
+				const double norm = correction_norm(dW, W);
+				double lambda = 1.0;
+				if (!linear && norm > 1.0)
+				{
+					for (;;)
+					{
+						trial_W = W;
+						trial_K = K;
+						for (unsigned int i = 0; i < W.size(); ++i)
+							trial_W[i] += lambda*dW[i];
+						for (unsigned int i = 0; i < K.size(); ++i)
+							trial_K[i] += lambda*dK[i];
+						if (merit_function(x, trial_W, trial_K) <= (1.0 - 1.e-4*lambda)*merit)
+							break;
+						lambda *= 0.5;
+						if (lambda < min_damping)
+							return -2;
+					}
+				}
+
+				for (unsigned int i = 0; i < W.size(); ++i)
+					W[i] += lambda*dW[i];
+				for (unsigned int i = 0; i < K.size(); ++i)
+					K[i] += lambda*dK[i];
+				//Converged if the correction, or the next one estimated from the contraction of the last two, is small
+				if (linear || lambda*norm <= 0.01
+				    || (lambda == 1.0 && previous_norm > 0.0 && norm*norm/previous_norm <= 0.01))
+					return 1;
+				previous_norm = (lambda == 1.0) ? norm : 0.0;
+			}
+			return -2;
+		}
+
+		/** Tolerance of each unknown, the unknowns without tolerance use the smallest one. */
+		void set_component_tolerances()
+		{
+			error_component.fill(n_tol == 0);
+			component_tol.fill(1.e-6);
+			if (n_tol == 0)
+				return;
+			const double smallest = *std::min_element(tol, tol + n_tol);
+			component_tol.fill(smallest);
+			for (int j = 0; j < n_tol; ++j)
+			{
+				error_component[ltol[j]-1] = true;
+				component_tol[ltol[j]-1] = tol[j];
+			}
+		}
+
+		/** Uniform mesh with #initial_mesh_size subintervals and the fixed points. */
+		void initial_mesh(std::vector<double> &x) const
+		{
+			x.resize(initial_mesh_size + 1);
+			for (int i = 0; i <= initial_mesh_size; ++i)
+				x[i] = boundary_a + (boundary_b - boundary_a)*i/initial_mesh_size;
+			x.back() = boundary_b;
+			add_fixpnts(x);
+		}
+
+		/** Add the fixed points inside (a, b) to the sorted mesh \p x. */
+		void add_fixpnts(std::vector<double> &x) const
+		{
+			for (unsigned int i = 0; i < fixpnts.size(); ++i)
+				if (fixpnts[i] > boundary_a && fixpnts[i] < boundary_b)
+					x.push_back(fixpnts[i]);
+			std::sort(x.begin(), x.end());
+			x.erase(std::unique(x.begin(), x.end()), x.end());
+		}
+
+		/** Guess of the solution, zero if there is no guess. */
+		void guess_at(double x, Vector &z)
+		{
+			z.fill(0.0);
+			if (guess == NULL)
+				return;
+			Vector y, dmval;
+			guess(context, x, &z[0], &y[0], &dmval[0]);
+		}
+
+		/** Values \p W at the mesh points \p x and derivatives \p K at the collocation points from the guess. */
+		void initial_values(const std::vector<double> &x, std::vector<double> &W, std::vector<double> &K)
+		{
+			const int n = x.size() - 1;
+			W.resize((n + 1)*n_z);
+			K.resize(n*n_local);
+			Vector z, F;
+			for (int i = 0; i <= n; ++i)
+			{
+				guess_at(x[i], z);
+				std::copy(z.begin(), z.end(), &W[i*n_z]);
+			}
+			for (int i = 0; i < n; ++i)
+				for (int s = 0; s < n_stages; ++s)
+				{
+					const double point = x[i] + c[s]*(x[i+1] - x[i]);
+					guess_at(point, z);
+					evaluate(point, &z[0], F);
+					std::copy(F.begin(), F.end(), &K[(i*n_stages+s)*n_z]);
+				}
+		}
+
+		/** Values \p W and derivatives \p K on the mesh \p x from the solution given by \p W_0 and \p K_0 on \p x_0. */
+		void transfer(const std::vector<double> &x_0, const std::vector<double> &W_0, const std::vector<double> &K_0,
+		              const std::vector<double> &x, std::vector<double> &W, std::vector<double> &K)
+		{
+			const int n = x.size() - 1;
+			W.resize((n + 1)*n_z);
+			K.resize(n*n_local);
+			Vector z, F;
+			for (int i = 0; i <= n; ++i)
+			{
+				solution_at(x_0, W_0, K_0, x[i], z);
+				std::copy(z.begin(), z.end(), &W[i*n_z]);
+			}
+			for (int i = 0; i < n; ++i)
+				for (int s = 0; s < n_stages; ++s)
+				{
+					const double point = x[i] + c[s]*(x[i+1] - x[i]);
+					solution_at(x_0, W_0, K_0, point, z);
+					evaluate(point, &z[0], F);
+					std::copy(F.begin(), F.end(), &K[(i*n_stages+s)*n_z]);
+				}
+		}
+
+		/** Keep the solution for DAE_solution() and continuation. */
+		void store_solution(const std::vector<double> &x, const std::vector<double> &W, const std::vector<double> &K)
+		{
+			mesh = x;
+			values = W;
+			stages = K;
+		}
+
+		///@name Problem definition
+		//@{
+		int n_comp;
+		std::vector<int> orders;
+		double boundary_a, boundary_b;
+		std::vector<double> zeta;
+		/** Number of boundary conditions at \p a, they come first in \p zeta */
+		int n_left;
+		void *context;
+		fsub_context_ptr fsub;
+		dfsub_context_ptr dfsub;
+		gsub_context_ptr gsub;
+		dgsub_context_ptr dgsub;
+		guess_context_ptr guess;
+		//@}
+
+		///@name Settings
+		//@{
+		int n_tol;
+		int *ltol;
+		double *tol;
+		bool linear;
+		int initial_mesh_size;
+		int max_mesh_size;
+		std::vector<double> fixpnts;
+		bool fixed_mesh;
+		std::vector<double> fixed_mesh_points;
+		/** Start every solve from the last solution instead of the guess, see use_simple_cont() */
+		bool restart;
+		/** Start the next solve from the solution given to set_initial_solution() */
+		bool use_initial_solution;
+		//@}
+
+		/** Collocation points on [0, 1] and coefficients of the collocation method */
+		double c[n_stages];
+		double a_coefficients[n_stages][n_stages];
+		double b_coefficients[n_stages];
+
+		/** Tolerance of each unknown and flag stating if the mesh is selected from its error */
+		Vector component_tol;
+		std::array<bool, n_z> error_component;
+
+		/** Jacobian of the values at the mesh points, the band storage needs at most 5 n_z - 2 entries */
+		BandLU<5*n_z-2> jacobian;
+		/** Corrections of the derivatives at the collocation points for a zero correction of the values, and their
+		* derivatives with respect to the correction of the values at the left end of the subinterval */
+		std::vector<double> stage_corrections, stage_sensitivities;
+
+		/** Mesh, values at the mesh points and derivatives at the collocation points of the solution */
+		std::vector<double> mesh, values, stages;
+	};
+}
+}
+
+#endif
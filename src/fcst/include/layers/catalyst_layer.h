@@ -17,6 +17,7 @@
 #define _FUELCELLSHOP__LAYER_CATALYST_LAYER_H
 
 // Include deal.II classes
+#include <deal.II/dofs/dof_handler.h>
 
 // Include FCST classes
 #include <utils/fcst_constants.h>
@@ -280,6 +281,13 @@ namespace FuelCellShop
              */
             virtual void set_solution(const std::vector< SolutionVariable >&);
             
+            /**
+             * Return the solution variables last set with #set_solution, in the format expected by #set_solution. Concentrations are
+             * converted back to gas phase concentrations. This member function is used to restore the state of the layer after it has been
+             * evaluated outside of the assembly. An empty vector is returned if #set_solution has not been called.
+             */
+            std::vector< SolutionVariable > get_solution() const;
+            
             /**
              * Method used to set the variables for which you would like to compute the derivatives in the catalyst layer. It takes vector of
              * #VariableNames as an input argument. It also sets the derivative flags in the kinetics and electrolyte object of the catalyst layer.
@@ -376,6 +384,17 @@ namespace FuelCellShop
                         << info.name() << std::endl;
             }
 
+            /**
+             * Function for setting the current cell from applications. By default, the cell_id is set to the index of the cell.
+             *
+             * - \param cell is the current cell from the application's perspective
+             *
+             * @note Reimplemented by classes that store data at the quadrature points of each cell: MultiScaleCL
+             */
+            virtual void set_cell(const typename DoFHandler<dim>::active_cell_iterator& cell){
+                set_cell_id(cell->index());
+            }
+
             ///@name Effective property calculators
             //@{
 
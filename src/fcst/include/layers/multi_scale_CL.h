@@ -24,10 +24,18 @@
 #include <utils/fcst_utilities.h>
 #include <layers/conventional_CL.h>
 #include <microscale/micro_scale_base.h>
+#include <microscale/agglomerate_surrogate.h>
+#include <contribs/DAE_solver.h>
+#include <application_core/assembly_batch.h>
+
+//Include Boost classes
+#include <boost/signals2.hpp>
 
 //Include STL
 #include <stdexcept>
 #include <map>
+#include <mutex>
+#include <vector>
 
 
 namespace FuelCellShop
@@ -38,6 +46,12 @@ namespace FuelCellShop
          * This class characterizes a catalyst layer and uses this information
          * to compute effective transport properties and interfacial areas for phase
          * change or electrochemical reactions.
+         *
+         * If the parameter <tt>Batch microscale solves</tt> is set and the application registers the layer
+         * with FuelCell::ApplicationCore::DoFApplication::add_assembly_batch(), the microscale problems at the quadrature
+         * points of all cells are collected in a first assembly pass and solved together, see #evaluate, instead of a few
+         * quadrature points at a time while each cell is assembled. Only the cells of the layer are assembled in the first pass.
+         * If the layer is not registered, #current_density stops with an error.
          * 
          * @author M. Secanell, 2009-13
          * @author P. Dobson, 2009-11
@@ -48,7 +62,8 @@ namespace FuelCellShop
          */
         template <int dim>
         class MultiScaleCL :
-        public ConventionalCL<dim>
+        public ConventionalCL<dim>,
+        public FuelCell::ApplicationCore::AssemblyBatch
         {
         public:
             /**
@@ -67,6 +82,15 @@ namespace FuelCellShop
              * \endcode
              */
             static const std::string concrete_name;
+
+            ///@name Friend class for Unit Testing
+            //@{
+
+            /**
+             * Friend class for testing purposes.
+             */
+            friend class ::MultiScaleCLTest;
+            //@}
             
 	    
             /**
@@ -78,8 +102,15 @@ namespace FuelCellShop
              */
             virtual void set_cell_id(const unsigned int& id){
                 cell_id_ = id;
+                active_cell_index_ = numbers::invalid_unsigned_int;
             }
 
+            /**
+             * Function for setting the current cell from applications. Sets the cell_id and the active cell index used to store
+             * the warm starts of the microscale solves at each quadrature point of the cell.
+             */
+            virtual void set_cell(const typename DoFHandler<dim>::active_cell_iterator& cell);
+
             /**
              * Destructor
              */
@@ -120,7 +151,41 @@ namespace FuelCellShop
              *
              */
             virtual void derivative_current_density ( std::map< VariableNames, std::vector<double> >& );
-            
+            //@}
+
+            ///@name Batched microscale solves, see FuelCell::ApplicationCore::AssemblyBatch
+            //@{
+            /**
+             * Returns true if the parameter <tt>Batch microscale solves</tt> is set and the current is not averaged in each cell.
+             */
+            virtual bool batch_enabled() const;
+
+            /**
+             * Returns true if \p material_id is one of the material ids of the layer.
+             */
+            virtual bool batch_material(const unsigned int material_id) const;
+
+            /**
+             * Start recording the microscale problems at the quadrature points of each cell set with #set_cell. Until #evaluate is called,
+             * #current_density and #derivative_current_density return zero for these cells.
+             */
+            virtual void begin_collect();
+
+            /**
+             * Solve all recorded microscale problems. The problems are distributed among the threads one at a time, starting
+             * with the problems that took longest in the previous assembly, so that the threads do not wait for each other
+             * at the end of each cell.
+             */
+            virtual void evaluate();
+
+            /**
+             * Discard the recorded microscale problems and their solutions.
+             */
+            virtual void end_batch();
+            //@}
+
+            ///@name Accessors and info
+            //@{
             /**
              * Print out composition and micro-structural properties of the catalyst layer
              */
@@ -301,6 +366,11 @@ namespace FuelCellShop
              *     (...)
              *     subsection MultiScaleCL                 <- This is the subsection specified by concrete_name
              *      set Average current in cell = false     # Decide whether to take the average current density in the cell
+             *      set Warm start microscale solves = false  # Start each numerical agglomerate solve from the previous solution at the quadrature point
+             *      set Batch microscale solves = false     # Collect the microscale problems of all cells and solve them before assembling the cells
+             *      subsection Surrogate table             # See FuelCellShop::MicroScale::AgglomerateSurrogate
+             *        set Use surrogate table = false
+             *      end
              *     end
              *   end
              * end
@@ -331,6 +401,34 @@ namespace FuelCellShop
             static MultiScaleCL<dim> const* PROTOTYPE;
             //@}
             
+            /** Microscale problems are not batched, are being recorded, or have been solved by #evaluate */
+            enum BatchState
+            {
+                batch_off,
+                batch_collecting,
+                batch_evaluated
+            };
+
+            /**
+             * Microscale problem at a quadrature point recorded by #begin_collect and solved by #evaluate.
+             */
+            struct BatchPoint
+            {
+                BatchPoint() : material_id(0), derivatives(false) {}
+
+                /** Material id of the cell */
+                unsigned int material_id;
+                /** Solution variables at the quadrature point */
+                std::map<VariableNames, SolutionVariable> solution;
+                /** Compute the derivatives of the current density with respect to #derivative_flags */
+                bool derivatives;
+                std::vector<VariableNames> derivative_flags;
+                /** Current density, effectiveness and coverages */
+                SolutionMap answer;
+                /** Derivatives of the current density */
+                std::map<VariableNames, double> Dcurrent;
+            };
+
             ///@name Internal member functions
             //@{
             /**
@@ -343,10 +441,54 @@ namespace FuelCellShop
              */
             void initialize_micro_scale(ParameterHandler &param);
             
+            /**
+             * Use of the warm start of a quadrature point in micro_scale_current():
+             * - \p warm_start_none: the microscale problem is solved from its default initial solution, e.g., for cell averaged values,
+             * - \p warm_start_read: the stored solution is used as initial solution but it is not replaced, e.g., for finite difference perturbations,
+             * - \p warm_start_store: the stored solution is used as initial solution and replaced by the new solution.
+             */
+            enum WarmStartMode {warm_start_none, warm_start_read, warm_start_store};
+
             /**
              * Private member functions for solving current density given an microscale.
+             * If the surrogate table is used, the values are interpolated in the table where possible.
+             * Only the solutions at the unperturbed quadrature points, i.e., \p warm_start_store, are stored as warm starts.
+             */
+            SolutionMap micro_scale_current(std::map<VariableNames ,SolutionVariable>& solutionMap, const unsigned int& sol_index, const unsigned int& thread_index,
+                                            const WarmStartMode warm_start_mode = warm_start_store);
+
+            /**
+             * Private member function solving the microscale problem, i.e., without the surrogate table.
+             */
+            SolutionMap micro_scale_solve(std::map<VariableNames ,SolutionVariable>& solutionMap, const unsigned int& sol_index, const unsigned int& thread_index,
+                                          FuelCell::ApplicationCore::DAESolutionCoefficients* warm_start = NULL);
+
+            /**
+             * Private member function returning the warm start of the microscale solve at quadrature point \p sol_index of the current cell,
+             * or NULL if warm starts are not used or the cell is not known.
+             */
+            FuelCell::ApplicationCore::DAESolutionCoefficients* warm_start_at(const unsigned int& sol_index);
+
+            /**
+             * Private member function returning the warm start of the microscale solve at quadrature point \p sol_index of the cell
+             * with active cell index \p cell_index, or NULL if warm starts are not used.
+             */
+            FuelCell::ApplicationCore::DAESolutionCoefficients* warm_start_at(const unsigned int& cell_index, const unsigned int& sol_index);
+
+            /**
+             * Private member function removing the warm starts and the batch costs of all quadrature points, since both are
+             * indexed by active cell. Called whenever the mesh changes.
+             */
+            void clear_point_data();
+
+            /**
+             * Private member function interpolating current density, effectiveness and coverages in the surrogate table. If \p gradients
+             * is not NULL, it is filled with the derivatives of each value with respect to the reactant molar fraction, protonic potential,
+             * electronic potential, membrane water content and temperature. Only the outputs supplied by the microscale object are
+             * returned. Returns \p false if the point cannot be interpolated.
              */
-            SolutionMap micro_scale_current(std::map<VariableNames ,SolutionVariable>& solutionMap, const unsigned int& sol_index, const unsigned int& thread_index);
+            bool surrogate_current(std::map<VariableNames ,SolutionVariable>& solutionMap, const unsigned int& sol_index, const unsigned int& thread_index,
+                                   SolutionMap& answer, std::vector< std::vector<double> >* gradients = NULL);
             
             
             /**
@@ -358,6 +500,70 @@ namespace FuelCellShop
              * Private member functions for solving for current derivatives in a per node approach.
              */
             void solve_current_derivatives_at_each_node(std::map< VariableNames, std::vector<double> >& Dcurrent);
+
+            /**
+             * Private member function computing the current derivatives at quadrature point \p sol_index by forward differences.
+             * Used where the microscale model could not compute them, see MicroScaleBase::compute_derivative_current().
+             */
+            void solve_current_derivatives_fd_at_node(const unsigned int& sol_index, const unsigned int& thread_index,
+                                                      std::map< VariableNames, std::vector<double> >& Dcurrent);
+
+            /**
+             * Private member function recording the microscale problems at the quadrature points of the current cell in #batch_points.
+             * If \p derivatives is true, the derivatives with respect to the current derivative flags are also computed.
+             */
+            void collect_batch_points(const bool derivatives);
+
+            /**
+             * Private member function returning the solved problem recorded at quadrature point \p sol_index of the current cell,
+             * or NULL if the point was not recorded or its solution variables changed since it was recorded.
+             */
+            const BatchPoint* batch_point(const unsigned int& sol_index) const;
+
+            /**
+             * Private member function filling \p Dcurrent with the derivatives computed by #evaluate at all quadrature points of the
+             * current cell. Returns false if the derivatives are not available for all points.
+             */
+            bool batch_derivatives(std::map< VariableNames, std::vector<double> >& Dcurrent) const;
+
+            /**
+             * Private member function solving a microscale problem recorded in #batch_points with the microscale object of
+             * thread \p thread_index.
+             */
+            void solve_batch_point(const std::pair<unsigned int, unsigned int>& key, BatchPoint& point, const unsigned int& thread_index);
+
+            /**
+             * Private member function solving the microscale problems recorded in #batch_points at \p points with a single call to
+             * micro_scale_batch, and micro_scale_batch_derivatives if derivatives were requested.
+             */
+            void solve_batch_points(const std::vector<BatchPoint*>& points, const unsigned int& thread_index);
+            //@}
+
+            ///@name Batched evaluation of closed form microscale models
+            //@{
+            /**
+             * Private member function returning the microscale object of thread \p thread_index for the current material id if it
+             * evaluates several points at once, see FuelCellShop::MicroScale::MicroScaleBase::has_batch_current, or NULL otherwise.
+             * NULL is also returned if the current density is interpolated from the surrogate table.
+             */
+            FuelCellShop::MicroScale::MicroScaleBase* batch_micro_scale(const unsigned int& thread_index);
+
+            /**
+             * Private member function computing the current density, effectiveness and coverages at all points of \p solutionMap with a
+             * single call to the microscale object of thread \p thread_index. The current density is scaled as in micro_scale_solve.
+             * Returns \p false, without computing anything, if batch_micro_scale returns NULL.
+             */
+            bool micro_scale_batch(const std::map<VariableNames ,SolutionVariable>& solutionMap, const unsigned int& thread_index, SolutionMap& answer);
+
+            /**
+             * Private member function computing the derivatives of the current density at all points of \p solutionMap with respect to the
+             * reactant, protonic and electronic potentials, in this order. If the microscale object does not compute derivatives, the variables
+             * in \p flags are differentiated by forward differences from \p answer, which is computed by micro_scale_batch if NULL.
+             * Returns \p false, without computing anything, if batch_micro_scale returns NULL.
+             */
+            bool micro_scale_batch_derivatives(const std::map<VariableNames ,SolutionVariable>& solutionMap, const unsigned int& thread_index,
+                                               const std::vector<VariableNames>& flags, std::vector< std::vector<double> >& dcurrent,
+                                               SolutionMap* answer = NULL);
             //@}
 
             /** Boolean value to choose whether to average the current over the cell */
@@ -367,12 +573,51 @@ namespace FuelCellShop
              */
 
             std::map<unsigned int, std::vector<boost::shared_ptr<FuelCellShop::MicroScale::MicroScaleBase>>> micro;
+
+            /**
+             * Surrogate table for the microscale objects of each material id, shared by all threads
+             */
+            std::map<unsigned int, boost::shared_ptr<FuelCellShop::MicroScale::AgglomerateSurrogate>> surrogate;
             
             /*Solution map used for storing coverages */
             SolutionMap coverage_map;
 
             unsigned int cell_id_;
 
+            /** Active cell index of the current cell, numbers::invalid_unsigned_int if only the cell_id is known */
+            unsigned int active_cell_index_;
+
+            /** Boolean value to choose whether to warm start the microscale solves at each quadrature point */
+            bool use_warm_start;
+
+            /**
+             * Solution converged by the last microscale solve at each quadrature point, indexed by active cell index and quadrature point.
+             * Numerical agglomerates start the next solve at the same point from this solution instead of their guess.
+             */
+            std::map<std::pair<unsigned int, unsigned int>, FuelCell::ApplicationCore::DAESolutionCoefficients> warm_starts;
+
+            /** Protects #warm_starts while the quadrature points are solved by several threads */
+            std::mutex warm_start_mutex;
+
+            /** Triangulation of the cells indexed in #warm_starts and #batch_cost, and connection clearing them when it changes */
+            const Triangulation<dim>* warm_start_tria;
+            boost::signals2::connection warm_start_connection;
+
+            /** Boolean value to choose whether to collect the microscale problems of all cells before solving them */
+            bool use_batch;
+
+            /** State of the batched microscale solves */
+            BatchState batch_state;
+
+            /** Recorded microscale problems, indexed by active cell index and quadrature point */
+            std::map<std::pair<unsigned int, unsigned int>, BatchPoint> batch_points;
+
+            /**
+             * Time spent solving the problem at each quadrature point in the last #evaluate [s], indexed as #batch_points.
+             * Used to solve the most expensive problems first.
+             */
+            std::map<std::pair<unsigned int, unsigned int>, double> batch_cost;
+
         };
         
     } // Layer
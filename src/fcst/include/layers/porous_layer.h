@@ -167,6 +167,14 @@ namespace Layer
             this->T_vector = T_in;
         }
         
+        /**
+         * Return the temperature solution variable set with #set_temperature.
+         */
+        inline const SolutionVariable& get_temperature() const
+        {
+            return this->T_vector;
+        }
+        
         /**
          * Member function used to set the liquid water saturation at every quadrature point inside
          * the cell. This function should particulary be used in the case of multi-phase application.
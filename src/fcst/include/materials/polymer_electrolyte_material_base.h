@@ -514,6 +514,22 @@ namespace FuelCellShop
                     lambda_var = FuelCellShop::SolutionVariable(lambda, T_var.size(), membrane_water_content);
             }
             
+            /**
+             * Return the membrane water content solution variable set with #set_membrane_water_content.
+             */
+            inline const FuelCellShop::SolutionVariable& get_membrane_water_content() const
+            {
+                return lambda_var;
+            }
+            
+            /**
+             * Return the temperature solution variable set with #set_temperature.
+             */
+            inline const FuelCellShop::SolutionVariable& get_temperature() const
+            {
+                return T_var;
+            }
+            
             /**
              * Set the solution variable, water vapor molar fraction \f$ x_{H_2O} \f$. It also initializes the temperature solution variable, if it
              * isn't initialized yet. This will help in the case of isothermal applications. #set_T method should be used in the initialization of the
@@ -85,6 +85,21 @@ namespace FuelCellShop
              */
             virtual SolutionMap compute_current ( );
 
+            /**
+             * The current density only requires the solution of a scalar equation at each point,
+             * hence all points of a cell are evaluated at once.
+             */
+            virtual bool has_batch_current(){
+                return true;
+            }
+
+            /**
+             * Function used to compute the current density produced by the micro structure at all points
+             * of the solution map. The Newton iterations of compute_current are performed for all points
+             * together, evaluating the kinetics once per iteration for all points.
+             */
+            virtual SolutionMap compute_current_batch (const std::map<VariableNames,SolutionVariable>& sols, const VariableNames& react);
+
             /**
              * Returns true if the class instance can calculate
              * current density derivatives. In this case it will return false.
@@ -178,6 +193,14 @@ namespace FuelCellShop
              */
             double residual(const double & c_inner, const double & c_outer);
 
+            /**
+             * Compute the residual functions at all points of compute_current_batch, where \p D_R is the
+             * diffusivity of the reactant in the electrolyte at each point. The potentials and temperature
+             * at the points must have been passed to the kinetics.
+             */
+            void residual(const std::vector<double> & c_inner, const std::vector<double> & c_outer,
+                          const std::vector<double> & D_R, std::vector<double> & answer);
+
 
             //Stored solutions
             std::vector<SolutionVariable> reactants;
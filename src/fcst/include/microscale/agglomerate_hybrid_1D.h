@@ -89,11 +89,8 @@ protected:
      * -virtual double get_film_thickness()
      * -virtual double get_radius()
      * -void gsub ( int &, double [], double & )
-     * -static void gsub_wrapper ( int &, double [], double & )
      * -void dgsub ( int &, double [], double [] )
-     * -static void dgsub_wrapper ( int &, double [], double [] )
      * -void guess ( double &, double [], double [], double [] )
-     * -static void guess_wrapper ( double &, double [], double [], double [] )
      */
 
 
@@ -210,7 +207,6 @@ protected:
     */
     void fsub ( double &, double [], double [], double [] );
 
-    static void fsub_wrapper ( double &, double [], double [], double [] );
 
     /**
     * The Jacobian of fsub.  Until we decide on how to get AD support in FCST,
@@ -221,7 +217,6 @@ protected:
     */
     void dfsub ( double &, double [], double [], double [] );
 
-    static void dfsub_wrapper ( double &, double [], double [], double [] );
 
 
 
@@ -95,6 +95,26 @@ namespace FuelCellShop
              * Function to compute the derivative of the current density at the local operating conditions;
              */
             virtual std::vector<double> compute_derivative_current ();
+
+            /**
+             * The current density is given in closed form, hence all points of a cell are evaluated at once.
+             */
+            virtual bool has_batch_current(){
+                return true;
+            }
+
+            /**
+             * Function to compute the current density and effectiveness at all points of the solution map.
+             * The kinetics are evaluated once for all points and the effectiveness factors are computed in a
+             * single loop over arrays of the point values, which the compiler vectorizes.
+             */
+            virtual SolutionMap compute_current_batch (const std::map<VariableNames,SolutionVariable>& sols, const VariableNames& react);
+
+            /**
+             * Function to compute the derivatives of the current density at all points of the solution map,
+             * see compute_current_batch.
+             */
+            virtual std::vector< std::vector<double> > compute_derivative_current_batch (const std::map<VariableNames,SolutionVariable>& sols, const VariableNames& react);
             
             /**
              * Return name of class instance, i.e. concrete name.
@@ -184,6 +204,14 @@ namespace FuelCellShop
             
             /** Function to compute the derivative of the effectiveness of the agglomerate core */
             double compute_dEr (const double k_c,const double dk_c, const double D);
+
+            /**
+             * Function to compute the diffusivity \p D and Henry's constant \p H of the reactant in the electrolyte
+             * at all points of the solution map set by set_solution, and to pass the solution at these points to the
+             * kinetics. \p c_R is filled with the reactant concentration. Returns the number of electrons transferred
+             * per molecule of reactant.
+             */
+            double set_batch_kinetics (std::vector<double>& c_R, std::vector<double>& D, std::vector<double>& H);
             
             /* Private member function to check kinetics are appropriate for analytical formulation.
              * Throws exception in event of inappropriate kinetic conditions.
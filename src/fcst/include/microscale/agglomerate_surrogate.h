@@ -0,0 +1,237 @@
+// ----------------------------------------------------------------------------
+//
+// FCST: Fuel Cell Simulation Toolbox
+//
+// Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+// This software is distributed under the MIT License
+// For more information, see the README file in /doc/LICENSE
+//
+// - Class: AgglomerateSurrogate
+// - Description: Adaptive interpolation table for the results of micro scale solves
+// - Developers: OpenFCST contributors, University of Alberta
+//
+// ----------------------------------------------------------------------------
+
+#ifndef _FUELCELLSHOP__MICROSCALE__AGGLOMERATE_SURROGATE_H
+#define _FUELCELLSHOP__MICROSCALE__AGGLOMERATE_SURROGATE_H
+
+//deal.II
+#include <deal.II/base/parameter_handler.h>
+
+//STD
+#include <vector>
+#include <map>
+#include <mutex>
+#include <functional>
+#include <string>
+
+using namespace dealii;
+
+//Friend class for testing
+class AgglomerateSurrogateTest;
+
+namespace FuelCellShop
+{
+    namespace MicroScale
+    {
+        /**
+         * @brief Adaptively refined interpolation table for the results of a micro scale object.
+         *
+         * Numerical agglomerates solve a 1D boundary value problem at every quadrature point in every assembly, yet the current density,
+         * effectiveness and coverages they return depend smoothly on a handful of inputs, i.e., reactant molar fraction, protonic and
+         * electronic potentials, membrane water content and temperature. This class replaces most of these solves with a multilinear
+         * interpolation on a kd-tree of boxes covering the trusted region of the inputs.
+         *
+         * The table is built lazily from actual micro scale solves. A box is only used once the values at its corners are known and the
+         * interpolated values agree with micro scale solves at the midpoints of its edges, the centres of its faces and its centre within
+         * the tolerances. Otherwise, the box is
+         * bisected in its widest input (relative to the trusted region) and the process is repeated in the half containing the point.
+         * Boxes are bisected on a dyadic lattice, hence the corners of neighbouring boxes coincide and each micro scale solve is reused
+         * by all boxes sharing the corner.
+         *
+         * The interpolated values and their derivatives with respect to each input are returned. The derivatives are those of the
+         * interpolant, i.e., they are consistent with the values used in the residual. Points outside the trusted region, or in boxes that
+         * still fail the tolerance at the maximum refinement level, are not interpolated and the caller must solve the micro scale problem.
+         *
+         * The table is shared by all threads. The micro scale solves needed to refine the table are performed by the thread that needs
+         * them, using the function passed to value(), and without holding the lock, so that threads refining different boxes do not wait
+         * for each other.
+         *
+         * <h3> Input parameters </h3>
+         * @code
+         * subsection Surrogate table
+         *   set Use surrogate table = false
+         *   set Relative tolerance = 1e-3               # Interpolation error allowed relative to the micro scale value
+         *   set Absolute tolerance = 1e-6               # Interpolation error allowed for values close to zero
+         *   set Maximum refinement level = 12           # Maximum number of bisections of each input range
+         *   set Reactant molar fraction range = 0.0, 1.0
+         *   set Protonic potential range = -0.5, 0.5    # [V]
+         *   set Electronic potential range = 0.0, 1.2   # [V]
+         *   set Membrane water content range = 0.0, 25.0
+         *   set Temperature range = 273.0, 373.0        # [K]
+         * end
+         * @endcode
+         *
+         * An input whose range has the same lower and upper bound is not interpolated, i.e., the table is only used when the input
+         * equals this value.
+         *
+         * Checking a box requires the values at its \f$ 3^n \f$ corners, edge midpoints, face centres and centre, where \f$ n \f$ is the
+         * number of interpolated inputs. Corners are shared with the neighbouring boxes, yet with the default ranges, i.e., five interpolated
+         * inputs, the first box alone needs 243 micro scale solves. The inputs that are constant in a simulation, e.g., the temperature in
+         * isothermal simulations or the membrane water content if it is not solved, should therefore be fixed with a single value range.
+         *
+         * If a micro scale solve needed to check a box fails, i.e., returns values that are not finite, the values solved before are kept
+         * and the box is rejected, so the points in it are solved by the caller from then on.
+         *
+         * @note The table assumes that the properties of the micro scale object, e.g., its structure and the layer pressure, do not
+         * change while it is used. Call clear() if they do.
+         */
+        class AgglomerateSurrogate
+        {
+        public:
+            /**
+             * Function solving the micro scale problem at the given inputs, and returning the values to interpolate.
+             */
+            typedef std::function<std::vector<double>(const std::vector<double>&)> Model;
+
+            /**
+             * Constructor.
+             */
+            AgglomerateSurrogate();
+
+            /**
+             * Declare the parameters in subsection <tt>Surrogate table</tt>.
+             */
+            static void declare_parameters(ParameterHandler& param);
+
+            /**
+             * Read the parameters in subsection <tt>Surrogate table</tt> and clear the table.
+             */
+            void initialize(ParameterHandler& param);
+
+            /**
+             * Set the trusted region and the tolerances directly, and clear the table.
+             */
+            void initialize(const std::vector<double>& lower,
+                            const std::vector<double>& upper,
+                            const double rel_tol,
+                            const double abs_tol,
+                            const unsigned int max_level);
+
+            /**
+             * Returns \p true if the table is used.
+             */
+            inline bool active() const
+            {
+                return use_table;
+            }
+
+            /**
+             * Lower bound of the range of input \p d. Callers set the inputs they do not know to this value.
+             */
+            inline double lower_bound(const unsigned int d) const
+            {
+                return lower[d];
+            }
+
+            /**
+             * Interpolate the values of the micro scale object at the point \p x, whose entries are in the order of the ranges
+             * given to initialize(). The table is refined using \p model where needed.
+             *
+             * If \p gradients is not NULL, it is filled with the derivative of each value with respect to each input, i.e.,
+             * <tt>(*gradients)[i][d]</tt> is the derivative of value \p i with respect to input \p d.
+             *
+             * Returns \p false if the point cannot be interpolated within the tolerances, in which case \p values is not modified.
+             */
+            bool value(const std::vector<double>& x,
+                       const Model& model,
+                       std::vector<double>& values,
+                       std::vector< std::vector<double> >* gradients = NULL);
+
+            /**
+             * Remove all the entries in the table.
+             */
+            void clear();
+
+            /**
+             * Print the number of micro scale solves stored and the number of points interpolated.
+             */
+            void print_statistics() const;
+
+        private:
+            /** Point of the dyadic lattice covering the trusted region */
+            typedef std::vector<unsigned int> LatticePoint;
+
+            /**
+             * Box of the kd-tree. The corners are given on the dyadic lattice.
+             */
+            struct Box
+            {
+                /** Lower and upper corners */
+                LatticePoint lower, upper;
+                /** Children after bisection, or -1 */
+                int children[2];
+                /** Input bisected */
+                unsigned int split_dim;
+                /** The interpolation satisfies the tolerances */
+                bool trusted;
+                /** The box can not be bisected any further and does not satisfy the tolerances */
+                bool rejected;
+            };
+
+            /** Convert between lattice points and inputs */
+            double to_input(const unsigned int d, const unsigned int i) const;
+
+            /** Leaf box containing the lattice coordinates \p xi, must be called with the lock held */
+            unsigned int find_leaf(const std::vector<double>& xi) const;
+
+            /** Lattice points whose values are needed to check the box, i.e., the corners followed by the midpoints of the edges, the centres of the faces and the centre */
+            void check_points(const Box& box, std::vector<LatticePoint>& points) const;
+
+            /** Multilinear interpolation in the box, must be called with the lock held */
+            void interpolate(const Box& box,
+                             const std::vector<double>& xi,
+                             std::vector<double>& values,
+                             std::vector< std::vector<double> >* gradients) const;
+
+            /** Check the tolerances at the points of check_points() that are not corners and bisect the box if needed, must be called with the lock held */
+            void refine(const unsigned int b);
+
+            /** Returns \p true if the values at \p a and \p b agree within the tolerances */
+            bool within_tolerance(const std::vector<double>& a,
+                                  const std::vector<double>& b) const;
+
+            /** Use the table */
+            bool use_table;
+
+            /** Trusted region */
+            std::vector<double> lower, upper;
+
+            /** Tolerances */
+            double rel_tol, abs_tol;
+
+            /** Maximum number of bisections of each input */
+            unsigned int max_level;
+
+            /** Number of lattice intervals in each input, i.e., 2^max_level or zero for inputs that are not interpolated */
+            std::vector<unsigned int> n_intervals;
+
+            /** kd-tree, the root is the first box */
+            std::vector<Box> boxes;
+
+            /** Values of the micro scale object at the lattice points solved */
+            std::map<LatticePoint, std::vector<double> > samples;
+
+            /** Number of points interpolated and not interpolated */
+            unsigned long n_hits, n_misses;
+
+            /** Protects the members above */
+            mutable std::mutex table_mutex;
+
+            friend class ::AgglomerateSurrogateTest;
+        };
+    }
+}
+
+#endif
@@ -80,6 +80,19 @@ public:
     */
     virtual SolutionMap compute_current ( );
 
+    /**
+     * Function to compute the derivatives of the current density with respect to the reactant molar fraction,
+     * protonic and electronic potentials at the local operating conditions.
+     *
+     * The derivatives are obtained from the problem linearized at the converged solution, see
+     * FuelCell::ApplicationCore::DAEWrapper::integral_derivative(). If the last compute_current() at these operating
+     * conditions converged, its solution (or the warm start it updated) is reused and only the linearized problems
+     * are solved; otherwise the agglomerate problem is solved first as in compute_current().
+     *
+     * An empty vector is returned if the agglomerate problem or its linearization could not be solved.
+     */
+    virtual std::vector<double> compute_derivative_current ();
+
 
     /**
      * Return name of class instance, i.e. concrete name.
@@ -123,6 +136,17 @@ protected:
     /** Setup the variables in the problem required by the DAE Solver */
     void setup_DAE_solver ();
 
+    /**
+     * Solve the agglomerate problem and integrate the current. If \p dI is not NULL, it is filled with the derivatives
+     * of the current with respect to the reactant molar fraction, protonic and electronic potentials.
+     */
+    SolutionMap solve_current (std::vector<double>* dI);
+
+    /**
+     * Volumetric current at the point \p x for the solution \p z, used to differentiate the current of the agglomerate.
+     */
+    virtual double integrand (const double &x, double z[]);
+
 
     /*
      * Virtual function for returning film thickness in nano meters.
@@ -247,7 +271,6 @@ protected:
     */
     void fsub ( double &, double [], double [], double [] );
 
-    static void fsub_wrapper ( double &, double [], double [], double [] );
 
     /**
     * The Jacobian of fsub.  Until we decide on how to get AD support in FCST,
@@ -258,7 +281,6 @@ protected:
     */
     void dfsub ( double &, double [], double [], double [] );
 
-    static void dfsub_wrapper ( double &, double [], double [], double [] );
 
     /**
     * Define the boundary conditions.
@@ -268,7 +290,6 @@ protected:
     */
     void gsub ( int &, double [], double & );
 
-    static void gsub_wrapper ( int &, double [], double & );
 
     /**
     * The derivatives of the boundary conditions.
@@ -277,7 +298,6 @@ protected:
     */
     void dgsub ( int &, double [], double [] );
 
-    static void dgsub_wrapper ( int &, double [], double [] );
 
     /**
     * The initial guess.
@@ -287,7 +307,6 @@ protected:
     */
     void guess ( double &, double [], double [], double [] );
 
-    static void guess_wrapper ( double &, double [], double [], double [] );
 
 
 
@@ -34,6 +34,13 @@ namespace FuelCellShop
         class MultiScaleCL;
     }
 }
+namespace FuelCell
+{
+    namespace ApplicationCore
+    {
+        struct DAESolutionCoefficients;
+    }
+}
 
 
 
@@ -266,6 +273,17 @@ namespace FuelCellShop
             *
             */
             virtual void set_solution(const std::map<VariableNames,SolutionVariable>&,const VariableNames&, const int&) = 0;
+
+            /**
+            * Function for setting the warm start of the next solves, i.e., the solution converged by the last
+            * solve at the same point of the macro scale mesh. Micro scale objects solving a boundary value problem
+            * start from this solution if it is not empty, and replace it by the new solution once converged.
+            * Pass NULL to solve without warm start. The default implementation ignores it.
+            *
+            * This function should be called before <b>set_solution</b>.
+            */
+            virtual void set_warm_start(FuelCell::ApplicationCore::DAESolutionCoefficients*)
+            {}
             //@}
 
             /**
@@ -285,7 +303,8 @@ namespace FuelCellShop
             * Solves for solution variables set by the last call to <b>set_solution</b>.
             *
             * <h3> Usage details</h3>
-            * Call <b>has_derivatives</b> to check if it is OK to call this function.
+            * Call <b>has_derivatives</b> to check if it is OK to call this function. Numerical microscale models
+            * return an empty vector if the derivatives could not be computed, in which case the caller should use finite differences.
             *
             */
             virtual std::vector<double> compute_derivative_current ()
@@ -304,6 +323,52 @@ namespace FuelCellShop
             */
             virtual bool has_derivatives() = 0;
 
+            ///@name Batched evaluation
+            //@{
+            /**
+            * Returns true if the class instance can compute the current density at all points of a
+            * solution map at once, i.e., if <b>compute_current_batch</b> is implemented. This is the case
+            * for closed form models, whose cost is dominated by the overhead of solving one point at a time.
+            */
+            virtual bool has_batch_current()
+            {
+                return false;
+            }
+
+            /**
+            * Function used to compute the current density, the effectiveness and, if available, the coverages
+            * at all points of the solution map, e.g., at all quadrature points of a cell or of several cells.
+            * The arguments are the same as those of <b>set_solution</b>, without the index. The values of the
+            * returned SolutionVariable objects are ordered as the points of the solution map, and each value is
+            * the one that <b>set_solution</b> and <b>compute_current</b> would return at that point.
+            *
+            * <h3> Usage details</h3>
+            * Call <b>has_batch_current</b> to check if it is OK to call this function.
+            *
+            */
+            virtual SolutionMap compute_current_batch (const std::map<VariableNames,SolutionVariable>&, const VariableNames&)
+            {
+                Assert(false, ExcPureFunctionCalled());
+                return SolutionMap();
+            }
+
+            /**
+            * Function to compute the derivatives of the current density at all points of the solution map.
+            * Returns the derivatives with respect to the reactant, the protonic and the electronic potential,
+            * in this order, each one with one value per point, i.e., the values of <b>compute_derivative_current</b>
+            * stored by variable.
+            *
+            * <h3> Usage details</h3>
+            * Call <b>has_batch_current</b> and <b>has_derivatives</b> to check if it is OK to call this function.
+            *
+            */
+            virtual std::vector< std::vector<double> > compute_derivative_current_batch (const std::map<VariableNames,SolutionVariable>&, const VariableNames&)
+            {
+                Assert(false, ExcPureFunctionCalled());
+                return std::vector< std::vector<double> >(3);
+            }
+            //@}
+
             /**
             * Return name of class instance, i.e. concrete name.
             */
@@ -17,6 +17,8 @@
 #include <microscale/agglomerate_base.h>
 #include <utils/fcst_db.h>
 
+#include <mutex>
+
 
 #ifndef NUMERICAL_AGGLOMERATE_BASE_H_
 #define NUMERICAL_AGGLOMERATE_BASE_H_
@@ -91,6 +93,9 @@ namespace FuelCellShop
              *
              * <h3> Usage </h3>
              * Should be called after successfully solving system of equations.
+             *
+             * The size classes of a PolyAgglomerate are solved concurrently and each class
+             * writes through its own connection, hence the writes are serialized by #db_mutex.
              */
             void save_initial_solution();
 
@@ -146,6 +151,38 @@ namespace FuelCellShop
 
             virtual void make_thread_safe(ParameterHandler &param, unsigned int thread_index);
 
+            /*
+             * Set the converged solution used as first approximation by the next solve and updated once it converges,
+             * see MicroScaleBase::set_warm_start.
+             */
+            virtual void set_warm_start(FuelCell::ApplicationCore::DAESolutionCoefficients* coefficients)
+            {
+                warm_start = coefficients;
+            }
+
+            /*
+             * Warm start of the current solve, NULL if none.
+             */
+            FuelCell::ApplicationCore::DAESolutionCoefficients* warm_start;
+
+            /*
+             * Last converged solution if no warm start is set. Together with the warm start, it is tagged with
+             * local_inputs() so that compute_derivative_current() can linearize the problem at the solution of
+             * the last compute_current() at the same point instead of solving it again.
+             */
+            FuelCell::ApplicationCore::DAESolutionCoefficients converged_solution;
+
+            /*
+             * Values of the solution variables at #sol_index followed by the pressure, i.e., the inputs of the
+             * agglomerate problem at the local operating conditions.
+             */
+            std::vector<double> local_inputs() const;
+
+            /*
+             * Solve with the native CollocationBVPSolver instead of COLDAE, see DAEWrapper::create_BVP_solver.
+             */
+            bool native_BVP_solver;
+
         private:
 
             /*
@@ -202,6 +239,11 @@ namespace FuelCellShop
 
             unsigned int thread_id;
 
+            /*
+             * Serializes the writes of all numerical agglomerates to the initial solution database.
+             */
+            static std::mutex db_mutex;
+
         }; //class
     }
 } //namespace
@@ -138,7 +138,7 @@ public:
 
     static const std::string concrete_name;
     PolyAgglomerate(std::string);
-    PolyAgglomerate(){};
+    PolyAgglomerate(): thread_safe(false){};
     virtual ~PolyAgglomerate();
 
 
@@ -167,6 +167,17 @@ public:
      */
     virtual SolutionMap compute_current ( );
 
+    /**
+     * Returns true if all size classes evaluate several points at once, see MicroScaleBase::has_batch_current.
+     */
+    virtual bool has_batch_current();
+
+    /**
+     * Function used to compute the current density produced by the micro structure at all points of the solution map,
+     * adding the contributions that each size class computes for all points at once.
+     */
+    virtual SolutionMap compute_current_batch (const std::map<VariableNames,SolutionVariable>& sols, const VariableNames& name);
+
     /**
      * Function to compute the derivative of the current density at the local operating conditions.
      * Returns current density derivatives
@@ -228,6 +239,10 @@ public:
     virtual double aux_volume_fraction();
 
 
+    /**
+     * Gives each size class its own copies of the materials and kinetics. The size classes are then solved
+     * concurrently by compute_current.
+     */
     virtual void make_thread_safe(ParameterHandler &param, unsigned int thread_index);
 
 protected:
@@ -277,9 +292,20 @@ protected:
     //@}
 
 private:
+    /*
+     * Solves the size classes of compute_current. If make_thread_safe was called, the size classes are solved by
+     * a parallel loop or, if this object is already used by a parallel loop over the quadrature points of a cell,
+     * as OpenMP tasks picked up by the threads of that loop once they are idle. Hence the threads share the size
+     * classes of all quadrature points instead of solving the size classes of each point one after another.
+     */
+    void solve_classes(std::vector<SolutionMap>& class_sols);
+
     //The micro scale objects are stored within the following convenient contianer
     MicroSet micro;
 
+    //True once make_thread_safe has given each size class its own materials and kinetics
+    bool thread_safe;
+
     //loop preventor to control how parameter subsections are declared
     static bool inf_loop_preventor;
 
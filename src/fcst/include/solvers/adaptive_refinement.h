@@ -26,13 +26,24 @@
 // Fuel cell include files
 #include <application_core/application_wrapper.h>
 #include <application_core/optimization_block_matrix_application.h>
+#include <solvers/newton_base.h>
 #include <utils/fcst_utilities.h>
 
 // STD include files
 #include <string>
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
 
+//Friend class for testing
+namespace FuelCell
+{
+    namespace UnitTest
+    {
+        class NewtonTest;
+    }
+}
+
 namespace FuelCell
 {
     namespace ApplicationCore
@@ -95,9 +106,27 @@ namespace FuelCell
              *   set Output final solution = true                # Output final solution to a file named fuel_cell-sol-cycleX where X is the cycle name.
              *   set Output solution for transfer = false        # Check whether a solution on a refined grid should be output to file on a coarse mesh
              *   set Read in initial solution from file = false  # Check whether a stored solution should be read from file and applied to the grid
+             *   subsection Nonlinear tolerance schedule
+             *     set Use tolerance schedule = false            # Solve intermediate cycles to a looser Newton tolerance
+             *     set Initial cycle tolerance = 1e-4            # Newton tolerance used in the first cycle
+             *     set Error estimate scaling = 1e-2             # Intermediate tolerance = scaling * estimated discretization error
+             *     set Maximum intermediate tolerance = 1e-3     # Upper bound for the intermediate Newton tolerances
+             *   end
              * end
              * @endcode
              *
+             * <h3>Nonlinear tolerance schedule</h3>
+             * The solutions on intermediate meshes are only used to drive the error estimator and to provide an initial
+             * guess on the next mesh, therefore they do not need to be computed to the final Newton tolerance. If
+             * <tt>Use tolerance schedule</tt> is true and the nonlinear solver is derived from newtonBase, the Newton tolerance for cycle
+             * \f$ k < n_{ref} - 1 \f$ is set to
+             * \f[
+             * \tau_k = \max \left( \tau, \min \left( \tau_{max}, c \, \eta_{k-1} \right) \right)
+             * \f]
+             * where \f$ \tau \f$ is the tolerance in subsection Newton, \f$ \eta_{k-1} \f$ is the global error estimate returned by estimate()
+             * on the previous mesh and \f$ c \f$ is the error estimate scaling. The first cycle uses the initial cycle tolerance, and
+             * the last cycle always uses \f$ \tau \f$.
+             *
              */
             void declare_parameters ( ParameterHandler& param ) const;
             
@@ -181,6 +210,18 @@ namespace FuelCell
         private:
             /** */
             void print_convergence_table();
+
+            /**
+             * Newton tolerance for refinement cycle \p cycle if #tolerance_schedule is true, see
+             * declare_parameters(). \p final_tolerance is the tolerance in subsection Newton and
+             * \p error_estimate is the global error estimate on the previous mesh.
+             */
+            double cycle_tolerance(const unsigned int cycle,
+                                   const bool         last_cycle,
+                                   const double       final_tolerance,
+                                   const double       error_estimate) const;
+
+            friend class FuelCell::UnitTest::NewtonTest;
             
             /** 
              * Filename where to output the initial grid 
@@ -261,6 +302,26 @@ namespace FuelCell
              */
             bool nonlinear_solver_for_linear_problem;
             
+            /**
+             * Use a looser Newton tolerance on the intermediate refinement cycles?
+             */
+            bool tolerance_schedule;
+
+            /**
+             * Newton tolerance used in the first cycle if #tolerance_schedule is true.
+             */
+            double initial_cycle_tolerance;
+
+            /**
+             * Factor multiplying the global error estimate to obtain the Newton tolerance of the intermediate cycles.
+             */
+            double error_estimate_scaling;
+
+            /**
+             * Upper bound of the Newton tolerance in the intermediate cycles.
+             */
+            double max_intermediate_tolerance;
+
             /**
              * Number of initial refinements for the original mesh
              *
@@ -0,0 +1,145 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: newton_pseudo_transient.h
+//    - Description: Pseudo-transient continuation variant of the Newton-Raphson solver
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#ifndef __deal2__appframe__newton_pseudo_transient_h
+#define __deal2__appframe__newton_pseudo_transient_h
+
+#include <solvers/newton_base.h>
+
+namespace FuelCell
+{
+namespace ApplicationCore
+{
+    /**
+     * Application class performing pseudo-transient continuation (\f$ \Psi tc \f$) iterations, see newtonBase
+     * for the notation.
+     *
+     * Instead of solving the steady-state problem directly, the solver marches the pseudo-transient problem
+     * \f[
+     * \mathbf{M} \frac{\partial \mathbf{x}}{\partial \tau} + \mathbf{F}(\mathbf{x}) = 0
+     * \f]
+     * to steady state using backward Euler with a single Newton step per pseudo time step, i.e.,
+     * \f[
+     * \left( \frac{1}{\Delta \tau_i} \mathbf{M} + \frac{\partial \mathbf{F}(\mathbf{x}_{i-1})}{\partial \mathbf{x}} \right) \delta \mathbf{x} = - \mathbf{F}(\mathbf{x}_{i-1})
+     * \f]
+     * where \f$ \mathbf{M} \f$ is a lumped mass matrix, i.e., a diagonal matrix whose entries are the integrals of the shape
+     * functions. The diagonal term is added to the system matrix by BlockMatrixApplication when the scalar
+     * "Pseudo time step inverse" is registered in ApplicationData.
+     *
+     * The pseudo time step is increased as the residual decreases using the switched evolution relaxation (SER) strategy,
+     * \f[
+     * \Delta \tau_i = \Delta \tau_{i-1} \left( \frac{\| \mathbf{F}(\mathbf{x}_{i-2}) \|}{\| \mathbf{F}(\mathbf{x}_{i-1}) \|} \right)^p
+     * \f]
+     * limited to the range [Minimum time step, Maximum time step]. For large time steps the method reduces to Newton's method
+     * and therefore converges quadratically close to the solution, while for small time steps the iterates follow the
+     * pseudo-transient path from the initial guess, which is considerably more robust than a damped Newton method for poor initial
+     * guesses. If a step produces a residual larger than "Maximum residual growth" times the previous one, or a NaN,
+     * the step is rejected and the time step is reduced by "Time step reduction".
+     *
+     * <h3> Parameters </h3>
+     *
+     * In addition to the parameters in newtonBase, the following parameters are used:
+     * \code
+     * subsection Newton
+     *   subsection Pseudo-transient continuation
+     *     set Initial time step       = 1e-3   # Initial pseudo time step
+     *     set Minimum time step       = 1e-12  # If the time step falls below this value, the solver stops
+     *     set Maximum time step       = 1e12   # Upper limit for the pseudo time step
+     *     set SER exponent            = 1.0    # Exponent p in the SER time step update
+     *     set Maximum residual growth = 10.0   # Steps increasing the residual by more than this factor are rejected
+     *     set Time step reduction     = 0.1    # Factor applied to the time step after a rejected step
+     *   end
+     * end
+     * \endcode
+     *
+     * <h3> References </h3>
+     *
+     * [1] C. T. Kelley and D. E. Keyes. Convergence analysis of pseudo-transient continuation. SIAM Journal on Numerical Analysis,
+     * 35(2):508–523, 1998.
+     */
+    class NewtonPseudoTransient : public newtonBase
+    {
+    public:
+        /**
+         * The Event set by NewtonPseudoTransient if
+         * convergence is becoming bad
+         * and a new matrix should be
+         * assembled.
+         */
+        static const FuelCell::ApplicationCore::Event bad_derivative;
+
+        /**
+         * Constructor, receiving the application computing the residual and
+         * solving the linear problem.
+         */
+        NewtonPseudoTransient (ApplicationBase& app);
+
+        /** Declare the input parameters. */
+        virtual void declare_parameters (ParameterHandler& param);
+
+        /** Read the parameters local to NewtonPseudoTransient. */
+        void _initialize (ParameterHandler& param);
+
+        /** Read the parameters */
+        virtual void initialize (ParameterHandler& param);
+
+        /**
+         * The actual pseudo-transient continuation solver.
+         */
+        virtual void solve(FuelCell::ApplicationCore::FEVector& u,
+                           const FuelCell::ApplicationCore::FEVectors& in_vectors);
+
+    private:
+        /**
+         * Initial pseudo time step.
+         */
+        double initial_time_step;
+
+        /**
+         * Smallest time step allowed. If a rejected step reduces the time step below this value, the solver fails.
+         */
+        double min_time_step;
+
+        /**
+         * Largest time step allowed.
+         */
+        double max_time_step;
+
+        /**
+         * Exponent used in the SER time step update.
+         */
+        double ser_exponent;
+
+        /**
+         * Steps that increase the residual by more than this factor are rejected.
+         */
+        double max_residual_growth;
+
+        /**
+         * Factor used to reduce the time step after a rejected step.
+         */
+        double time_step_reduction;
+
+        /**
+         * Inverse of the current pseudo time step. This value is registered in ApplicationData as
+         * "Pseudo time step inverse" during solve() so that BlockMatrixApplication can add the
+         * pseudo-transient term to the system matrix.
+         */
+        double inv_time_step;
+    };
+}
+}
+
+#endif
@@ -0,0 +1,153 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: newton_segregated.h
+//    - Description: Segregated (nonlinear block Gauss-Seidel) variant of the Newton-Raphson solver
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#ifndef __deal2__appframe__newton_segregated_h
+#define __deal2__appframe__newton_segregated_h
+
+#include <solvers/newton_base.h>
+
+namespace FuelCell
+{
+namespace ApplicationCore
+{
+    /**
+     * Application class performing a segregated, or nonlinear block Gauss-Seidel, solution of the
+     * nonlinear problem, see newtonBase for the notation.
+     *
+     * The application splits its unknowns into \f$ n \f$ groups (stages). The number of stages is
+     * registered by the application in ApplicationData as the scalar "Number of segregated stages".
+     * At every outer iteration the solver sweeps over the stages; for stage \f$ s \f$ it registers the scalar
+     * "Segregated solve stage" with value \f$ s \f$ and performs Newton iterations in which the
+     * residual and Jacobian of the unknowns of the other stages are zero, i.e., these unknowns are frozen at their
+     * latest values. Each linear system only couples the unknowns of one stage. The stage is registered while a sweep
+     * is performed, and it is removed when the sweep ends, also if it ends with an exception.
+     *
+     * @note The size of the linear systems depends on the application. A BlockMatrixApplication only solves the
+     * system of the unknowns of the stage if it redefines BlockMatrixApplication::stage_blocks(), and it only saves
+     * the assembly of the frozen equations if it skips them while the stage is registered.
+     *
+     * After a sweep, the update \f$ \mathbf{d}_k = G(\mathbf{x}_{k}) - \mathbf{x}_{k} \f$, where \f$ G \f$ is the
+     * Gauss-Seidel sweep, is relaxed using Aitken's dynamic relaxation,
+     * \f[
+     * \omega_k = -\omega_{k-1} \frac{\mathbf{d}_{k-1} \cdot (\mathbf{d}_k - \mathbf{d}_{k-1})}{\| \mathbf{d}_k - \mathbf{d}_{k-1} \|^2}, \qquad
+     * \mathbf{x}_{k+1} = \mathbf{x}_k + \omega_k \mathbf{d}_k
+     * \f]
+     * with \f$ \omega_k \f$ limited to [Minimum relaxation, Maximum relaxation]. Convergence of the outer iterations
+     * is checked using the residual of the fully coupled problem, which the application computes when the stage scalar is
+     * not registered. Hence, the converged solution is the solution of the coupled problem.
+     *
+     * <h3> Parameters </h3>
+     *
+     * In addition to the parameters in newtonBase, the following parameters are used:
+     * \code
+     * subsection Newton
+     *   subsection Segregated solve
+     *     set Maximum inner iterations = 5     # Newton iterations performed for each stage at every outer iteration
+     *     set Inner residual reduction = 1e-2  # Stage iterations stop once the stage residual is reduced by this factor
+     *     set Aitken relaxation        = true  # Accelerate the outer iterations using Aitken's dynamic relaxation
+     *     set Initial relaxation       = 1.0   # Relaxation factor used in the first outer iteration
+     *     set Minimum relaxation       = 0.1   # Lower limit for the Aitken relaxation factor
+     *     set Maximum relaxation       = 1.5   # Upper limit for the Aitken relaxation factor
+     *   end
+     * end
+     * \endcode
+     * The maximum number of outer iterations and the tolerance are given by the newtonBase parameters.
+     *
+     * <h3> References </h3>
+     *
+     * [1] U. Küttler and W. A. Wall. Fixed-point fluid-structure interaction solvers with dynamic relaxation.
+     * Computational Mechanics, 43(1):61-72, 2008.
+     */
+    class NewtonSegregated : public newtonBase
+    {
+    public:
+        /**
+         * The Event set by NewtonSegregated if
+         * convergence is becoming bad
+         * and a new matrix should be
+         * assembled.
+         */
+        static const FuelCell::ApplicationCore::Event bad_derivative;
+
+        /**
+         * Constructor, receiving the application computing the residual and
+         * solving the linear problem.
+         */
+        NewtonSegregated (ApplicationBase& app);
+
+        /** Declare the input parameters. */
+        virtual void declare_parameters (ParameterHandler& param);
+
+        /** Read the parameters local to NewtonSegregated. */
+        void _initialize (ParameterHandler& param);
+
+        /** Read the parameters */
+        virtual void initialize (ParameterHandler& param);
+
+        /**
+         * The actual segregated solver.
+         */
+        virtual void solve(FuelCell::ApplicationCore::FEVector& u,
+                           const FuelCell::ApplicationCore::FEVectors& in_vectors);
+
+    private:
+        /**
+         * Newton iterations for a single stage in the sweep over the stages.
+         */
+        void solve_stage(FuelCell::ApplicationCore::FEVector& u,
+                         FuelCell::ApplicationCore::FEVector& res,
+                         const FuelCell::ApplicationCore::FEVectors& src1,
+                         const FuelCell::ApplicationCore::FEVectors& src2);
+
+        /**
+         * Maximum number of Newton iterations for each stage at every outer iteration.
+         */
+        unsigned int max_inner_steps;
+
+        /**
+         * Stage iterations stop once the stage residual is reduced by this factor.
+         */
+        double inner_reduction;
+
+        /**
+         * Use Aitken's dynamic relaxation between outer iterations.
+         */
+        bool aitken;
+
+        /**
+         * Relaxation factor for the first outer iteration.
+         */
+        double initial_relaxation;
+
+        /**
+         * Lower limit for the relaxation factor.
+         */
+        double min_relaxation;
+
+        /**
+         * Upper limit for the relaxation factor.
+         */
+        double max_relaxation;
+
+        /**
+         * Index of the stage being solved. This value is registered in ApplicationData as
+         * "Segregated solve stage" while the stage is solved.
+         */
+        double stage;
+    };
+}
+}
+
+#endif
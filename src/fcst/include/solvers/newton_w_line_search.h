@@ -71,6 +71,26 @@ namespace ApplicationCore
      * At each iteration a line search is performed by evaluating the L2 norm of the residual for each
      * \f$ h_i \f$ and then the best step size is selected.
      *
+     * @note The trial points are evaluated one after another. They cannot be evaluated concurrently because
+     * ApplicationBase::residual() is not reentrant: the equation classes, the layers and the microscale solvers of
+     * MultiScaleCL store the data of the cell being assembled in shared members, and the assembly loops use the user
+     * flags of the triangulation.
+     *
+     *
+     * <h3>Broyden updates between Jacobian assemblies</h3>
+     *
+     * If "Assemble threshold" is larger than zero, the Jacobian is only reassembled when the residual reduction
+     * is poor, and the remaining steps reuse the last assembled matrix (and, with UMFPACK, its factorization).
+     * If "Broyden updates" is set to true, these frozen-Jacobian steps are improved by rank-one (good) Broyden updates
+     * of the inverse Jacobian applied on top of the stored matrix, i.e.
+     * \f[
+     * H_{k+1} = \left( I + \frac{(\mathbf{s}_k - H_k \mathbf{y}_k) \mathbf{s}_k^T}{\mathbf{s}_k^T H_k \mathbf{y}_k} \right) H_k
+     * \f]
+     * where \f$ \mathbf{s}_k \f$ is the last solution update, \f$ \mathbf{y}_k \f$ the corresponding change in the residual, and
+     * \f$ H_0 \f$ is the inverse of the last assembled Jacobian. The updates are stored in product form, so that each
+     * step only requires one solve with the frozen matrix and two vectors per stored update (see C. T. Kelley [1], Section 7.3).
+     * The stored updates are discarded every time the Jacobian is assembled. The Jacobian is also reassembled if
+     * "Max Broyden updates" updates have been stored, or if a Broyden step fails to reduce the residual.
      *
      * <h3> Parameters </h3>
      *
@@ -82,6 +102,8 @@ namespace ApplicationCore
      *  set Line search = false                # Specify if the code should perform a line search
      *  set Initial Overrelaxation = 1         # Specify the over-relaxation length, \alpha, for the initial step, i.e. u_i = u_{i-1} + \alpha \delta u
      *  set Number of iterations with overrelaxation = 1 # Specify for how many steps should the code overrelax the update ()
+     *  set Broyden updates = false            # Use Broyden updates of the frozen Jacobian when the matrix is not reassembled
+     *  set Max Broyden updates = 10           # Number of Broyden updates stored before the Jacobian is reassembled
      *  // All the parameters below are from NetwonBase:
      *  set Max steps          = 100           # Maximum number of iterations
      *  set Tolerance          = 1.e-8         # Absolute tolerance
@@ -160,6 +182,36 @@ namespace ApplicationCore
          * 
          */
         bool find_negative_values(const FEVector& u);
+
+        /**
+         * Routine used to modify the update \p Du, computed using the last assembled Jacobian, with the stored Broyden updates.
+         * On input, \p Du contains \f$ H_0 \mathbf{F}(\mathbf{x}_k) \f$; \p Du_old and \p s_old are the update direction
+         * and the actual solution change of the previous iteration. On output, \p Du contains
+         * \f$ H_k \mathbf{F}(\mathbf{x}_k) \f$ and the update corresponding to the previous step has been stored.
+         */
+        void broyden_update(FEVector& Du,
+                            const FEVector& Du_old,
+                            const FEVector& s_old);
+
+        /**
+         * Use Broyden updates on steps where the Jacobian is not reassembled?
+         */
+        bool broyden;
+
+        /**
+         * Maximum number of stored Broyden updates before a new Jacobian is assembled.
+         */
+        unsigned int max_broyden_updates;
+
+        /**
+         * Vectors \f$ (\mathbf{s}_k - H_k \mathbf{y}_k)/(\mathbf{s}_k^T H_k \mathbf{y}_k) \f$ of the stored Broyden updates.
+         */
+        std::vector<FEVector> broyden_u;
+
+        /**
+         * Solution changes \f$ \mathbf{s}_k \f$ of the stored Broyden updates.
+         */
+        std::vector<FEVector> broyden_s;
     };
 }
 }
@@ -18,6 +18,8 @@
 
 #include <solvers/picard_base.h>
 
+#include <deque>
+
 namespace FuelCell
 {
 namespace ApplicationCore
@@ -46,7 +48,33 @@ namespace ApplicationCore
      * \f]
      * In addition if the solution starts to diverge then the parameter &gamma;<SUB>min</SUB> is scaled down to minimize divergence.
      * 
+     * <h3> Anderson acceleration </h3>
+     * As an alternative to under-relaxation, the fixed-point map \f$ G(u) = \left( K(u) \right)^{-1} F(u) \f$ can be accelerated
+     * using Anderson mixing of depth \f$ m \f$ [2]. The last \f$ m \f$ differences of the fixed-point residual
+     * \f$ f^N = G(u^N) - u^N \f$ and of the map \f$ G(u^N) \f$ are stored and the new iterate is computed as,
+     * \f[
+     * u^{N+1} = G(u^N) - \Delta G \, \gamma - (1-\beta) \left( f^N - \Delta F \, \gamma \right)
+     * \f]
+     * where \f$ \gamma \f$ minimizes \f$ \| f^N - \Delta F \gamma \|_2 \f$ (solved using regularized normal equations) and
+     * \f$ \beta \f$ is the mixing parameter. The scheme is safeguarded: if the norm of the fixed-point residual grows by more than
+     * a given factor, or if the mixing coefficients become too large, the history is discarded and a plain (mixed) Picard step is taken.
+     * The history can also be restarted every time it reaches depth \f$ m \f$ instead of discarding only the oldest entry.
+     *
+     * The following parameters are used in subsection Picard:
+     * \code
+     * subsection Picard
+     *  set Anderson acceleration     = false  # Use Anderson acceleration (ignored if Under-relaxation = true)
+     *  set Anderson depth            = 5      # Number of stored residual differences m
+     *  set Anderson mixing           = 1.0    # Mixing parameter beta
+     *  set Anderson restart          = false  # Clear the whole history when it reaches the depth m
+     *  set Anderson safeguard factor = 2.0    # Restart if the fixed-point residual grows by more than this factor
+     *  set Anderson regularization   = 1e-10  # Relative Tikhonov regularization of the least-squares problem
+     * end
+     * \endcode
+     *
      * <EM> [1] Durbin, Timothy, and David Delemos. "Adaptive underrelaxation of Picard iterations in ground water models." Groundwater 45.5 (2007): 648-651.</EM>
+     *
+     * <EM> [2] Walker, Homer F., and Peng Ni. "Anderson acceleration for fixed-point iterations." SIAM Journal on Numerical Analysis 49.4 (2011): 1715-1735.</EM>
      * 
      * 
      * @author Mayank Sabharwal, 2015
@@ -90,6 +118,80 @@ namespace ApplicationCore
         
         void compute_errors ( FEVector &u, FEVector &u_n, FEVector &error, double &abs_error, double &rel_error, double &delta);
 
+        /**
+         * Compute the Anderson accelerated iterate. On input, \p u is the current iterate and \p u_n is
+         * the result of the fixed-point map, i.e. \f$ G(u) \f$. On output, \p u contains the new iterate.
+         * The residual history is updated, and restarted if the safeguard is triggered.
+         */
+        void anderson_update(FEVector& u, const FEVector& u_n);
+
+        /**
+         * Discard the stored Anderson history.
+         */
+        void anderson_restart();
+
+        /**
+         * Flag for using Anderson acceleration
+         */
+        bool anderson;
+
+        /**
+         * Maximum number of residual differences stored for Anderson acceleration
+         */
+        unsigned int anderson_depth;
+
+        /**
+         * Mixing parameter &beta; used in Anderson acceleration
+         */
+        double anderson_mixing;
+
+        /**
+         * If true, the history is cleared completely once it holds #anderson_depth entries, before the newest
+         * difference is stored, otherwise only the oldest entry is discarded.
+         */
+        bool anderson_restart_when_full;
+
+        /**
+         * The history is discarded if the norm of the fixed-point residual grows by more than this factor
+         * between two consecutive iterations.
+         */
+        double anderson_safeguard;
+
+        /**
+         * Relative Tikhonov regularization added to the diagonal of the least-squares normal equations.
+         */
+        double anderson_regularization;
+
+        /**
+         * Differences of the fixed-point residuals, \f$ f^{k+1} - f^k \f$
+         */
+        std::deque<FEVector> anderson_dF;
+
+        /**
+         * Differences of the fixed-point map, \f$ G(u^{k+1}) - G(u^k) \f$
+         */
+        std::deque<FEVector> anderson_dG;
+
+        /**
+         * Fixed-point residual of the previous iteration
+         */
+        FEVector anderson_f_old;
+
+        /**
+         * Fixed-point map of the previous iteration
+         */
+        FEVector anderson_g_old;
+
+        /**
+         * L2-norm of #anderson_f_old
+         */
+        double anderson_f_old_norm;
+
+        /**
+         * True if #anderson_f_old and #anderson_g_old hold valid data
+         */
+        bool anderson_has_previous;
+
 
     };
 }
@@ -33,6 +33,7 @@
 #include <chrono>
 #include <thread>
 #include <random>
+#include <map>
 
 //Deal.ii
 
@@ -41,6 +42,9 @@
 //Boost
 #include <boost/algorithm/string.hpp>
 
+//Friend class for testing
+class FCSTdatabaseTest;
+
 namespace FcstUtilities
 {
    /**
@@ -59,6 +63,19 @@ namespace FcstUtilities
      * This class provides a database interface for storing generic numerical data to disc.
      * It provides tolerance based selection of data based upon explicit operating conditions.
      *
+     * <h3> Storage details</h3>
+     * Each data set is stored in its own table, whose name is given by the <tt>HEAD</tt> table
+     * together with the model name and the operating conditions of the data set. The operating conditions are also
+     * stored one per row in table <tt>HEAD_PARAM</tt>, with numerical values in a REAL column. This table is indexed
+     * by model name, operating condition name and value, hence tolerance based lookups are performed as range queries on the
+     * index instead of reading the whole <tt>HEAD</tt> table. <tt>HEAD_PARAM</tt> is created, and filled from
+     * <tt>HEAD</tt>, when connecting to databases created by older versions of this class.
+     *
+     * The statements used to look up and store data sets are prepared once per connection and reused with bound
+     * parameters, and data sets are committed in a single transaction. Databases are opened in WAL mode, so that
+     * several processes can read a database while one of them writes to it. Lookups are therefore cheap as long as the
+     * connection is kept open, e.g., by objects that query the database at each quadrature point.
+     *
      *
      * @code
      *
@@ -160,6 +177,14 @@ namespace FcstUtilities
             */
             bool disconnect();
 
+            /**
+             * Returns true if a connection to a database is established.
+             */
+            inline bool is_connected() const
+            {
+                return connected;
+            }
+
             /**
             * Function for testing if db that you are connected to has data for a given model and operating conditions.
             * Takes model name and operating conditions as arguments. OC is an object of DatabaseOC type.
@@ -299,6 +324,44 @@ namespace FcstUtilities
                 return 0;
             }
 
+            /*
+             * Prepared statements kept for the duration of the connection, indexed by their SQL command
+             */
+            std::map<std::string, sqlite3_stmt*> statements;
+
+            /*
+             * Function for preparing a SQL statement with placeholders for bound parameters.
+             * If keep is true, the statement is kept for the duration of the connection and the same statement, reset and with
+             * cleared bindings, is returned by later calls with the same command. Otherwise the caller must finalize it.
+             * Returns NULL if the statement cannot be prepared.
+             */
+            sqlite3_stmt* prepare(const std::string& sqlCmd, const bool& keep = true);
+
+            /*
+             * Function for executing a prepared statement until the next row, reattempting in the event of a database lock.
+             * Returns the sqlite status, i.e., SQLITE_ROW, SQLITE_DONE or an error code.
+             */
+            int step(sqlite3_stmt* stmt);
+
+            /*
+             * Function for finalizing the kept statements, required before closing the connection
+             */
+            void finalize_statements();
+
+            /*
+             * Function for creating the HEAD_PARAM table and its indexes if they do not exist, and for adding the
+             * operating conditions of the HEAD entries missing from it, e.g., those created by older versions of this class.
+             * Required by connect and create_new_db
+             */
+            bool index_head();
+
+            /*
+             * Function for adding the operating conditions of a HEAD entry to the HEAD_PARAM table
+             * Required by make_new_head_entry and index_head
+             */
+            bool add_head_params(const std::string& model_name, const std::string& table_ref,
+                                 const std::vector<std::vector<std::string>>& param_data);
+
             /*
              * Function for creating new entry in HEAD table
              * Required by public function commit_data
@@ -326,9 +389,6 @@ namespace FcstUtilities
             std::string find_table(const std::string&  model_name, const DatabaseOC& OC, const double& tolerance);
 
 
-            bool find_matching_head_term(const std::vector<std::string>& OC, const std::vector<std::string>& head_line, const double& tolerance);
-
-
             /*
              * Private wrapper function for making requests that don't require an answer other than a yes or no
              * The main difference between this function and request is that here callback is simply 0, i.e. we do not read the returned data
@@ -343,6 +403,16 @@ namespace FcstUtilities
             unsigned int max_milli;
             double lock_time;
 
+            /*
+             * Function for waiting a random time, of up to max_milli milliseconds, before reattempting a locked request
+             */
+            void wait_for_lock();
+
+            /*
+             * True while cleanUp is running, so that errors in cleanUp do not call it again
+             */
+            bool cleaning_up;
+
             /*
              * Private function that implements the all request functionality.
              * Request(sqlCmd) and request_no_callback functions rely on this function.
@@ -357,6 +427,8 @@ namespace FcstUtilities
              * Function for creating a new default db.
              */
             bool create_new_db(const std::string& filePath);
+
+            friend class ::FCSTdatabaseTest;
     };
 
 
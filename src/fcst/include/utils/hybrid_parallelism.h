@@ -0,0 +1,75 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: hybrid_parallelism.h
+//    - Description: Number of threads per MPI process and thread pinning for hybrid MPI + threads runs
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#ifndef _FCST_HYBRID_PARALLELISM_H
+#define _FCST_HYBRID_PARALLELISM_H
+
+//-- deal.II
+#include <deal.II/base/parameter_handler.h>
+
+using namespace dealii;
+
+namespace FcstUtilities
+{
+    /**
+     * Declare the parameters in subsection <tt>Simulator > Parallel execution</tt>.
+     */
+    void declare_thread_parameters (ParameterHandler& param);
+
+    /**
+     * Read the parameters in subsection <tt>Simulator > Parallel execution</tt>, compute the number of threads
+     * per MPI process, limit the deal.II and OpenMP thread pools to this number and pin the threads if requested.
+     *
+     * OpenFCST uses two kinds of threads within each MPI process: the deal.II thread pool (TBB), used for instance by
+     * DataOut::build_patches during postprocessing, and the OpenMP threads used by FuelCellShop::Layer::MultiScaleCL to solve the
+     * microscale problems at the quadrature points during assembly. Unless both use the same number of threads, and this number
+     * is consistent with the number of MPI processes on the node, the threads of the different processes compete for the same cores.
+     *
+     * The number of threads per MPI process is computed as the number of cores of the node divided by the number of MPI processes
+     * running on the node and it is applied to both thread pools. Optionally, the threads of each process are pinned to a
+     * contiguous block of cores, i.e., process \f$ r \f$ on the node uses cores \f$ [r n_t, (r+1) n_t) \f$ where \f$ n_t \f$ is the number
+     * of threads per process. The OpenMP threads are pinned to one core each, while the deal.II threads can run on any core in the block.
+     *
+     * @note Only the work inside the cells is threaded. The macroscale cell loops of the applications, e.g., the assembly of the
+     * residual and of the Jacobian, remain serial within each MPI process because the cell routines of the applications and the
+     * layers store the data of the current cell in member variables, i.e., they cannot be called concurrently. Therefore, the
+     * threads only reduce the assembly time of the cells with microscale problems.
+     *
+     * <h3> Parameters </h3>
+     * \code
+     * subsection Simulator
+     *   subsection Parallel execution
+     *     set Ranks per node       = 0      # 0: detect the MPI processes sharing the node
+     *     set Threads per rank     = 0      # 0: cores on the node / ranks per node
+     *     set Pin threads to cores = false
+     *   end
+     * end
+     * \endcode
+     *
+     * If <tt>Ranks per node</tt> is given, the processes are assumed to be placed on the nodes by blocks, i.e., ranks
+     * \f$ [0, n) \f$ on the first node, \f$ [n, 2n) \f$ on the second node and so on. Pinning is only available on Linux.
+     *
+     * This function is called by SimulatorBuilder before the application is created, so that the objects that allocate one
+     * microscale object per thread see the final number of threads.
+     */
+    void initialize_threads (ParameterHandler& param);
+
+    /**
+     * Number of threads used by each MPI process. It is one until initialize_threads() is called.
+     */
+    unsigned int n_threads ();
+}
+
+#endif
@@ -32,6 +32,8 @@
 #include <solvers/newton_basic.h>
 #include <solvers/newton_w_line_search.h>
 #include <solvers/newton_w_3pp.h>
+#include <solvers/newton_pseudo_transient.h>
+#include <solvers/newton_segregated.h>
 #include <solvers/picard.h>
 
 /////////////////////////////////////////////////////////////////
@@ -200,7 +202,11 @@ protected:
                      << " | "
                      << "Newton3pp"
 		     << " | "
-                     << "Picard";
+                     << "Picard"
+                     << " | "
+                     << "PseudoTransient"
+                     << " | "
+                     << "Segregated";
 
               return result.str();
        }
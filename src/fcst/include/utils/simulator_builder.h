@@ -41,6 +41,7 @@
 #include <reactions/tafel_kinetics.h>
 #include "FCST_TEST_SUITE.h"
 #include <utils/fcst_utilities.h>
+#include <utils/hybrid_parallelism.h>
 
 #include "contribs/dakota_interface.h"
 // These files can only be used if DAKOTA is linked to our package:
@@ -0,0 +1,241 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: through_plane_mea_model.h
+//    - Description: One-dimensional through-plane MEA model used to generate initial solutions
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#ifndef _FUELCELL__THROUGH_PLANE_MEA_MODEL__H
+#define _FUELCELL__THROUGH_PLANE_MEA_MODEL__H
+
+//-- deal.II
+#include <deal.II/base/function.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/full_matrix.h>
+
+//-- OpenFCST
+#include <application_core/system_management.h>
+#include <application_core/fcst_variables.h>
+#include <utils/operating_conditions.h>
+#include <utils/logging.h>
+#include <utils/fcst_constants.h>
+#include <utils/fcst_units.h>
+#include <grid/geometry.h>
+#include <layers/gas_diffusion_layer.h>
+#include <layers/micro_porous_layer.h>
+#include <layers/catalyst_layer.h>
+#include <layers/membrane_layer.h>
+#include <materials/PureGas.h>
+
+#include <boost/shared_ptr.hpp>
+#include <memory>
+#include <vector>
+
+using namespace dealii;
+
+namespace FuelCell
+{
+    namespace InitialSolution
+    {
+        /**
+         * This class is used to provide a physics-based initial solution for membrane electrode assembly applications.
+         *
+         * Before the initial solution is interpolated, solve() discretizes a one-dimensional through-plane model of the MEA,
+         * i.e., anode GDL, anode MPL, anode CL, membrane, cathode CL, cathode MPL and cathode GDL, using a cell-centered
+         * finite volume method. The model solves for
+         * - the electronic potential in the GDLs, MPLs and CLs with the cell voltage applied at the cathode boundary,
+         * - the protonic potential in the CLs and membrane,
+         * - the oxygen molar fraction in the cathode GDL, MPL and CL,
+         *
+         * using the effective transport properties and the reaction kinetics of the layer objects used by the application
+         * and the data in OperatingConditions. The membrane water content and temperature are taken from the initial
+         * solution of the application, i.e., the base function. The nonlinear problem is solved using a damped Newton method.
+         * Since the residual of a cell only depends on the cell and its two neighbours, the Jacobian is block tridiagonal. It is
+         * computed by finite differences perturbing every third cell at once, i.e., with \f$ 3 \times 3 \f$ residual evaluations
+         * independently of the number of cells, and the linear system is solved with the block Thomas algorithm.
+         *
+         * The layer objects are shared with the application. The solution, temperature and membrane water content set in the
+         * layers by the one-dimensional model are restored to their previous values when solve() returns.
+         *
+         * The one-dimensional solution is then extruded onto the 2D/3D mesh, i.e., for a point \p p, the solution at the
+         * through-plane coordinate \p p(0) is returned for the variables above in the layers where they are solved. All other
+         * values are given by the base function. If the one-dimensional problem does not converge, the base function is used.
+         *
+         * The through-plane coordinate is assumed to be the first coordinate with the anode GDL/channel interface at \f$ x = 0 \f$,
+         * as in the grids used by AppPemfc and AppPemfcNIThermal.
+         *
+         * <h3> Usage </h3>
+         * In the application, the object is created in initialize_solution and passed to DoFApplication:
+         * @code
+         * std::shared_ptr< Function<dim> > base_solution (new FuelCell::InitialSolution::AppPemfcIC<dim> (&OC, this->mesh_generator));
+         * std::shared_ptr< FuelCell::InitialSolution::ThroughPlaneMEAModel<dim> > initial_solution
+         *   (new FuelCell::InitialSolution::ThroughPlaneMEAModel<dim> (&OC, this->mesh_generator, &this->system_management, base_solution,
+         *                                                               AGDL.get(), AMPL.get(), ACL.get(), ML.get(), CCL.get(), CMPL.get(), CGDL.get(),
+         *                                                               &oxygen, &nitrogen, 20));
+         * initial_solution->solve();
+         * DoFApplication<dim>::initialize_solution(initial_guess, initial_solution);
+         * @endcode
+         */
+        template <int dim>
+        class ThroughPlaneMEAModel
+        :
+        public Function<dim>
+        {
+        public:
+            /**
+             * Constructor. The microporous layers can be \p NULL, or have zero thickness, if they are not present in the MEA.
+             * \p n_cells_per_layer is the number of finite volume cells used in each layer of the one-dimensional model.
+             */
+            ThroughPlaneMEAModel (FuelCell::OperatingConditions* OC,
+                                  boost::shared_ptr< FuelCellShop::Geometry::GridBase<dim> > grid,
+                                  FuelCell::SystemManagement* system_mgmt,
+                                  std::shared_ptr< Function<dim> > base_function,
+                                  FuelCellShop::Layer::GasDiffusionLayer<dim>* AGDL,
+                                  FuelCellShop::Layer::MicroPorousLayer<dim>* AMPL,
+                                  FuelCellShop::Layer::CatalystLayer<dim>* ACL,
+                                  FuelCellShop::Layer::MembraneLayer<dim>* ML,
+                                  FuelCellShop::Layer::CatalystLayer<dim>* CCL,
+                                  FuelCellShop::Layer::MicroPorousLayer<dim>* CMPL,
+                                  FuelCellShop::Layer::GasDiffusionLayer<dim>* CGDL,
+                                  FuelCellShop::Material::PureGas* oxygen,
+                                  FuelCellShop::Material::PureGas* nitrogen,
+                                  const unsigned int n_cells_per_layer);
+
+            /**
+             * Destructor
+             */
+            ~ThroughPlaneMEAModel ();
+
+            /**
+             * Solve the one-dimensional through-plane model. Returns \p true if the model converged. Otherwise,
+             * vector_value() returns the base function. The state of the layers is restored before returning.
+             */
+            bool solve ();
+
+            /**
+             * Value of the initial solution at point \p p.
+             */
+            void vector_value (const Point<dim> &p,
+                               Vector<double> &v) const;
+
+        private:
+            /**
+             * Layers in the one-dimensional model, ordered from the anode to the cathode.
+             */
+            enum Region {AGDL_region, AMPL_region, ACL_region, ML_region, CCL_region, CMPL_region, CGDL_region};
+
+            /**
+             * Unknowns of the one-dimensional model at each cell.
+             */
+            enum Unknown {phi_s = 0, phi_m = 1, x_o2 = 2, n_unknowns = 3};
+
+            /**
+             * Create the finite volume cells and evaluate the effective transport properties in each cell.
+             */
+            void make_cells ();
+
+            /**
+             * Return \p true if \p unknown is solved for in \p region.
+             */
+            bool is_active (const Unknown unknown,
+                            const Region region) const;
+
+            /**
+             * Compute the volumetric current density in the catalyst layer cells for the solution \p u.
+             * The current density is stored in \p current for all cells; it is zero outside the catalyst layers.
+             */
+            void current_density (const std::vector<double>& u,
+                                  std::vector<double>& current);
+
+            /**
+             * Compute the residual of the finite volume equations for the solution \p u.
+             */
+            void residual (const std::vector<double>& u,
+                           std::vector<double>& res);
+
+            /** Operating conditions */
+            FuelCell::OperatingConditions* OC;
+
+            /** Geometry */
+            boost::shared_ptr< FuelCellShop::Geometry::GridBase<dim> > grid;
+
+            /** System management object of the application */
+            FuelCell::SystemManagement* system;
+
+            /** Initial solution used outside the layers where the one-dimensional model is solved */
+            std::shared_ptr< Function<dim> > base_function;
+
+            ///@name Layers
+            //@{
+            FuelCellShop::Layer::GasDiffusionLayer<dim>* AGDL;
+            FuelCellShop::Layer::MicroPorousLayer<dim>* AMPL;
+            FuelCellShop::Layer::CatalystLayer<dim>* ACL;
+            FuelCellShop::Layer::MembraneLayer<dim>* ML;
+            FuelCellShop::Layer::CatalystLayer<dim>* CCL;
+            FuelCellShop::Layer::MicroPorousLayer<dim>* CMPL;
+            FuelCellShop::Layer::GasDiffusionLayer<dim>* CGDL;
+            //@}
+
+            /** Oxygen, i.e., the solute in the cathode */
+            FuelCellShop::Material::PureGas* oxygen;
+
+            /** Nitrogen, i.e., the solvent in the cathode */
+            FuelCellShop::Material::PureGas* nitrogen;
+
+            /** Number of cells in each layer */
+            unsigned int n_cells_per_layer;
+
+            /** \p true if solve() converged */
+            bool solved;
+
+            /** \p true if the membrane water content is a solution variable of the application */
+            bool has_lambda;
+
+            /** \p true if the temperature is a solution variable of the application */
+            bool has_temperature;
+
+            /** Index of each unknown of the one-dimensional model in the solution of the application, -1 if it is not solved for */
+            std::vector<int> component_index;
+
+            ///@name One-dimensional discretization
+            //@{
+            /** Region of each cell */
+            std::vector<Region> cell_region;
+
+            /** Material id of each cell */
+            std::vector<unsigned int> cell_material_id;
+
+            /** Width of each cell [cm] */
+            std::vector<double> cell_width;
+
+            /** Center of each cell [cm] */
+            std::vector<double> cell_center;
+
+            /** Temperature at each cell, taken from the base function [K] */
+            std::vector<double> cell_temperature;
+
+            /** Membrane water content at each cell, taken from the base function */
+            std::vector<double> cell_lambda;
+
+            /** Hydrogen molar fraction at each cell, taken from the base function */
+            std::vector<double> cell_x_h2;
+
+            /** Effective transport property of each unknown at each cell, i.e., conductivities [S/cm] and \f$ c_{tot} D_{eff} \f$ [mol/(cm s)] */
+            std::vector< std::vector<double> > cell_property;
+
+            /** Solution of the one-dimensional model, stored as u[n_unknowns*cell + unknown] */
+            std::vector<double> solution;
+            //@}
+        };
+    }
+}
+
+#endif
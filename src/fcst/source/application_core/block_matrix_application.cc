@@ -17,6 +17,12 @@
 
 #include <application_core/block_matrix_application.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <set>
+
 //------------------------------
 template<int dim>
 BlockMatrixApplication<dim>::BlockMatrixApplication(
@@ -24,6 +30,8 @@ BlockMatrixApplication<dim>::BlockMatrixApplication(
         DoFApplication<dim>(data)
 {
     repair_diagonal = false; //false as standard unless set by child
+    factorization_valid = false;
+    pseudo_time_shift = 0.0;
     FcstUtilities::log << "->BlockMatrix";
 }
 
@@ -34,6 +42,8 @@ BlockMatrixApplication<dim>::BlockMatrixApplication(DoFApplication<dim>& other,
         DoFApplication<dim>(other, triangulation_only)
 {
     repair_diagonal = false; //false as standard unless set by child
+    factorization_valid = false;
+    pseudo_time_shift = 0.0;
     FcstUtilities::log << "->BlockMatrix";
 }
 
@@ -169,8 +179,11 @@ void BlockMatrixApplication<dim>::remesh_matrices()
     
     this->block_info.initialize_local(*this->dof);
 
+    const Table<2, DoFTools::Coupling> couplings = this->matrix_couplings();
+
     // clear matrices
     matrix.clear();
+    factorization_valid = false;
     // Make the list of constraints associated with hanging nodes
     this->hanging_node_constraints.clear();
     DoFTools::make_hanging_node_constraints(*this->dof, this->hanging_node_constraints);
@@ -179,11 +192,11 @@ void BlockMatrixApplication<dim>::remesh_matrices()
 #ifdef OPENFCST_WITH_PETSC
     #if deal_II_dimension < 3 //For 2D simulations can use SparsityPattern for computation speed up
         SparsityPattern sparsity(this->dof->n_dofs(), this->dof->n_dofs(),this->dof->max_couplings_between_dofs());
-        DoFTools::make_sparsity_pattern(*this->dof, this->cell_couplings, sparsity);
+        DoFTools::make_sparsity_pattern(*this->dof, couplings, sparsity);
         this->hanging_node_constraints.condense(sparsity);
     #else //Due to memory allocation issues for 3D problems use CompressedSimpleSparsityPattern instead
         CompressedSimpleSparsityPattern compressed_pattern(this->dof->n_dofs());
-        DoFTools::make_sparsity_pattern(*this->dof, compressed_pattern);
+        DoFTools::make_sparsity_pattern(*this->dof, couplings, compressed_pattern);
         this->hanging_node_constraints.condense(compressed_pattern);
         
         SparsityPattern sparsity;
@@ -217,9 +230,9 @@ void BlockMatrixApplication<dim>::remesh_matrices()
     c_sparsity.collect_sizes();
 
     if (this->interior_fluxes)
-        DoFTools::make_flux_sparsity_pattern(*this->dof, c_sparsity, this->cell_couplings, this->flux_couplings);
+        DoFTools::make_flux_sparsity_pattern(*this->dof, c_sparsity, couplings, this->flux_couplings);
     else
-        DoFTools::make_sparsity_pattern(*this->dof, this->cell_couplings, c_sparsity);
+        DoFTools::make_sparsity_pattern(*this->dof, couplings, c_sparsity);
 
     // Condense sparsity pattern to account for hanging nodes
     this->hanging_node_constraints.condense(c_sparsity);
@@ -237,6 +250,21 @@ void BlockMatrixApplication<dim>::remesh_matrices()
 
 #endif
 
+    // Lumped mass is only computed if pseudo-transient continuation is used:
+    pseudo_time_shift = 0.0;
+    lumped_mass.reinit(0);
+}
+
+//----------------------------
+template<int dim>
+Table<2, DoFTools::Coupling> BlockMatrixApplication<dim>::matrix_couplings() const {
+    return this->cell_couplings;
+}
+
+//----------------------------
+template<int dim>
+std::vector<unsigned int> BlockMatrixApplication<dim>::stage_blocks() const {
+    return std::vector<unsigned int>();
 }
 
 //----------------------------
@@ -257,66 +285,151 @@ void BlockMatrixApplication<dim>::PETSc_solve(FuelCell::ApplicationCore::FEVecto
     //Make parallel copies of serial vectors
     PETScWrappers::MPI::Vector del_sol, sys_rhs;
     
-    const types::global_dof_index n_local_dofs = DoFTools::count_dofs_with_subdomain_association (*this->dof,this->this_mpi_process);
+    const types::global_dof_index n_local_dofs = this->locally_owned_dofs.n_elements();
     del_sol.reinit(this->mpi_communicator, this->dof->n_dofs(), n_local_dofs);
     sys_rhs.reinit(this->mpi_communicator, this->dof->n_dofs(), n_local_dofs);
     
-    FEValues<dim>*     fe_values      = 0;
-    FuelCell::ApplicationCore::IntegrationInfo< dim, FEValuesBase<dim> >  cell_info(src, this->block_info);
- 
-    cell_info.initialize(
-        fe_values,
-        *this->element,
-        *this->mapping,
-        this->quadrature_residual_cell,
-        UpdateFlags(update_q_points | update_values | update_gradients | update_JxW_values)
-    );
+    // Copy the entries owned by this process in a single call:
+    this->export_to_distributed_vector(solution, del_sol);
+    this->export_to_distributed_vector(system_rhs, sys_rhs);
+        
+    MatrixTools::apply_boundary_values (boundary_values, matrix, del_sol, sys_rhs, false);
     
-    typename DoFHandler<dim>::active_cell_iterator
-    cell = this->dof->begin_active(),
-    endc = this->dof->end();
+    this->print_matrix_and_rhs(sys_rhs);
     
-    for( ; cell != endc; ++cell)
+    PETSc_linear_solve(this->matrix, del_sol, sys_rhs);
+    
+    this->hanging_node_constraints.distribute(del_sol);
+    
+    //Copy to linear dealii vector
+    this->import_distributed_vector(del_sol, solution);
+                                                  
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void BlockMatrixApplication<dim>::PETSc_stage_solve(const std::vector<unsigned int>& blocks,
+                                                    const FuelCell::ApplicationCore::FEVector& system_rhs,
+                                                    FEVector& solution)
+{
+    // Number the dofs of the stage in the order of the global numbering:
+    const types::global_dof_index invalid_index = numbers::invalid_dof_index;
+    std::vector<types::global_dof_index> stage_index(this->dof->n_dofs(), invalid_index);
+    types::global_dof_index n_stage_dofs = 0;
+    for (unsigned int b = 0; b < this->block_info.global.size(); ++b)
+        if (std::find(blocks.begin(), blocks.end(), b) != blocks.end())
+            for (types::global_dof_index i = 0; i < this->block_info.global.block_size(b); ++i)
+                stage_index[this->block_info.global.local_to_global(b, i)] = n_stage_dofs++;
+
+    // The stage rows are distributed among the processes in the same way as the rows of the matrix:
+    const std::pair<types::global_dof_index, types::global_dof_index> range = this->matrix.local_range();
+    types::global_dof_index first_stage_row = 0;
+    for (types::global_dof_index row = 0; row < range.first; ++row)
+        if (stage_index[row] != invalid_index)
+            ++first_stage_row;
+    types::global_dof_index n_local_stage_rows = 0;
+    for (types::global_dof_index row = range.first; row < range.second; ++row)
+        if (stage_index[row] != invalid_index)
+            ++n_local_stage_rows;
+
+    // Preallocate the stage matrix using the entries of the local rows of the matrix:
+    std::vector<types::global_dof_index> row_lengths(n_local_stage_rows, 0);
+    std::vector<types::global_dof_index> offdiag_row_lengths(n_local_stage_rows, 0);
+    for (types::global_dof_index row = range.first; row < range.second; ++row)
     {
-        cell_info.reinit(cell);      
-        
-        if(cell->subdomain_id() == this->this_mpi_process){            
-            for(unsigned int i = 0; i < this->element->dofs_per_cell; ++i)
-            {
-                del_sol(cell_info.indices[i]) = solution(cell_info.indices[i]);
-                sys_rhs(cell_info.indices[i]) = system_rhs(cell_info.indices[i]);
-            }
-            
+        if (stage_index[row] == invalid_index)
+            continue;
+
+        const types::global_dof_index local_row = stage_index[row] - first_stage_row;
+        for (PETScWrappers::MatrixBase::const_iterator entry = this->matrix.begin(row); entry != this->matrix.end(row); ++entry)
+        {
+            const types::global_dof_index column = stage_index[entry->column()];
+            if (column == invalid_index)
+                continue;
+
+            if (column >= first_stage_row && column < first_stage_row + n_local_stage_rows)
+                ++row_lengths[local_row];
+            else
+                ++offdiag_row_lengths[local_row];
         }
     }
-    
+
+    PETScWrappers::MPI::SparseMatrix stage_matrix;
+    stage_matrix.reinit(this->mpi_communicator,
+                        n_stage_dofs,
+                        n_stage_dofs,
+                        n_local_stage_rows,
+                        n_local_stage_rows,
+                        row_lengths,
+                        false,
+                        offdiag_row_lengths);
+
+    PETScWrappers::MPI::Vector del_sol(this->mpi_communicator, n_stage_dofs, n_local_stage_rows);
+    PETScWrappers::MPI::Vector sys_rhs(this->mpi_communicator, n_stage_dofs, n_local_stage_rows);
+
+    for (types::global_dof_index row = range.first; row < range.second; ++row)
+    {
+        if (stage_index[row] == invalid_index)
+            continue;
+
+        for (PETScWrappers::MatrixBase::const_iterator entry = this->matrix.begin(row); entry != this->matrix.end(row); ++entry)
+            if (stage_index[entry->column()] != invalid_index)
+                stage_matrix.set(stage_index[row], stage_index[entry->column()], entry->value());
+
+        del_sol(stage_index[row]) = solution(row);
+        sys_rhs(stage_index[row]) = system_rhs(row);
+    }
+    stage_matrix.compress(VectorOperation::insert);
     del_sol.compress(VectorOperation::insert);
     sys_rhs.compress(VectorOperation::insert);
-        
-    MatrixTools::apply_boundary_values (boundary_values, matrix, del_sol, sys_rhs, false);
-    
-    this->print_matrix_and_rhs(sys_rhs);
-    
+
+    // Boundary values of the stage dofs:
+    std::map<unsigned int, double> stage_boundary_values;
+    for (std::map<unsigned int, double>::const_iterator value = boundary_values.begin(); value != boundary_values.end(); ++value)
+        if (stage_index[value->first] != invalid_index)
+            stage_boundary_values[stage_index[value->first]] = value->second;
+
+    MatrixTools::apply_boundary_values (stage_boundary_values, stage_matrix, del_sol, sys_rhs, false);
+
+    FcstUtilities::log << "Solving the linear system of the stage with " << n_stage_dofs << " of " << this->dof->n_dofs() << " unknowns" << std::endl;
+    PETSc_linear_solve(stage_matrix, del_sol, sys_rhs);
+
+    // Copy the stage solution back, the other blocks are not updated:
+    const PETScWrappers::Vector localized_solution(del_sol);
+    solution = 0;
+    for (types::global_dof_index i = 0; i < this->dof->n_dofs(); ++i)
+        if (stage_index[i] != invalid_index)
+            solution(i) = localized_solution(stage_index[i]);
+
+    this->hanging_node_constraints.distribute(solution);
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void BlockMatrixApplication<dim>::PETSc_linear_solve(PETScWrappers::MPI::SparseMatrix& system_matrix,
+                                                     PETScWrappers::MPI::Vector&       del_sol,
+                                                     PETScWrappers::MPI::Vector&       sys_rhs)
+{
     if (this->data->get_linear_solver() == FuelCell::ApplicationCore::LinearSolver::CG) {
         FcstUtilities::log << "Solving linear system with CG..." << std::endl;
         
-        PETScWrappers::PreconditionJacobi prec(matrix);        
+        PETScWrappers::PreconditionJacobi prec(system_matrix);        
         PETScWrappers::SolverCG solver(solver_control, this->mpi_communicator);        
-        solver.solve(this->matrix, del_sol, sys_rhs, prec);
+        solver.solve(system_matrix, del_sol, sys_rhs, prec);
     }
     else if (this->data->get_linear_solver() == FuelCell::ApplicationCore::LinearSolver::BICGSTAB) {
         FcstUtilities::log << "Solving linear system with Bicgstab..." << std::endl;
         
-        PETScWrappers::PreconditionJacobi prec(matrix);        
+        PETScWrappers::PreconditionJacobi prec(system_matrix);        
         PETScWrappers::SolverBicgstab solver(solver_control, this->mpi_communicator);        
-        solver.solve(this->matrix, del_sol, sys_rhs, prec);
+        solver.solve(system_matrix, del_sol, sys_rhs, prec);
     }
     else if (this->data->get_linear_solver() == FuelCell::ApplicationCore::LinearSolver::ILU_GMRES) {
         FcstUtilities::log << "Solving linear system with ILU-GMRES..." << std::endl;
         
-        PETScWrappers::PreconditionNone prec(matrix);
+        PETScWrappers::PreconditionNone prec(system_matrix);
         PETScWrappers::SolverGMRES solver(solver_control, this->mpi_communicator);
-        solver.solve(this->matrix,
+        solver.solve(system_matrix,
                      del_sol,
                      sys_rhs,
                      prec);
@@ -330,7 +443,7 @@ void BlockMatrixApplication<dim>::PETSc_solve(FuelCell::ApplicationCore::FEVecto
         if (mumps_additional_mem)
             solver.set_prefix(std::string("mat_mumps_icntl_14 100"));
         
-        solver.solve(this->matrix,
+        solver.solve(system_matrix,
                      del_sol,
                      sys_rhs);
     }
@@ -340,13 +453,6 @@ void BlockMatrixApplication<dim>::PETSc_solve(FuelCell::ApplicationCore::FEVecto
         FcstUtilities::log << "Solver not implemented in class " << info.name() << " member function solve()" << std::endl;
         abort();
     }   
-    
-    this->hanging_node_constraints.distribute(del_sol);
-    
-    //Copy to linear dealii vector
-    const PETScWrappers::Vector localized_solution(del_sol);
-    solution = localized_solution;
-                                                  
 }
 #else
 //---------------------------------------------------------------------------
@@ -359,29 +465,127 @@ void BlockMatrixApplication<dim>::serial_solve(FuelCell::ApplicationCore::FEVect
 
     this->print_matrix_and_rhs(system_rhs);
 
-            
+    serial_linear_solve(this->matrix, solution, system_rhs);
+
+    // --- Finally apply hanging node constraints to solution ---
+    this->hanging_node_constraints.distribute(solution);
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void BlockMatrixApplication<dim>::serial_stage_solve(const std::vector<unsigned int>& blocks,
+                                                     const FuelCell::ApplicationCore::FEVector& system_rhs,
+                                                     FEVector& solution)
+{
+    const unsigned int n_stage_blocks = blocks.size();
+
+    // Sparsity pattern of the diagonal blocks of the stage:
+    BlockCompressedSparsityPattern c_sparsity(n_stage_blocks, n_stage_blocks);
+    for (unsigned int i = 0; i < n_stage_blocks; ++i)
+        for (unsigned int j = 0; j < n_stage_blocks; ++j)
+            c_sparsity.block(i, j).reinit(this->block_info.global.block_size(blocks[i]), this->block_info.global.block_size(blocks[j]));
+    c_sparsity.collect_sizes();
+
+    for (unsigned int i = 0; i < n_stage_blocks; ++i)
+        for (unsigned int j = 0; j < n_stage_blocks; ++j)
+        {
+            const SparsityPattern& block_sparsity = sparsities.block(blocks[i], blocks[j]);
+            for (SparsityPattern::const_iterator entry = block_sparsity.begin(); entry != block_sparsity.end(); ++entry)
+                c_sparsity.block(i, j).add(entry->row(), entry->column());
+        }
+
+    BlockSparsityPattern stage_sparsities;
+    stage_sparsities.copy_from(c_sparsity);
+
+    BlockSparseMatrix<double> stage_matrix(stage_sparsities);
+    for (unsigned int i = 0; i < n_stage_blocks; ++i)
+        for (unsigned int j = 0; j < n_stage_blocks; ++j)
+        {
+            const SparseMatrix<double>& block = this->matrix.block(blocks[i], blocks[j]);
+            for (SparseMatrix<double>::const_iterator entry = block.begin(); entry != block.end(); ++entry)
+                stage_matrix.block(i, j).set(entry->row(), entry->column(), entry->value());
+        }
+
+    // Right hand side, solution and boundary values of the stage:
+    std::vector<types::global_dof_index> block_sizes(n_stage_blocks);
+    for (unsigned int i = 0; i < n_stage_blocks; ++i)
+        block_sizes[i] = this->block_info.global.block_size(blocks[i]);
+    const BlockIndices stage_indices(block_sizes);
+
+    FEVector stage_rhs(block_sizes);
+    FEVector stage_solution(block_sizes);
+    for (unsigned int i = 0; i < n_stage_blocks; ++i)
+    {
+        stage_rhs.block(i) = system_rhs.block(blocks[i]);
+        stage_solution.block(i) = solution.block(blocks[i]);
+    }
+
+    std::map<unsigned int, double> stage_boundary_values;
+    for (std::map<unsigned int, double>::const_iterator value = boundary_values.begin(); value != boundary_values.end(); ++value)
+    {
+        const std::pair<unsigned int, types::global_dof_index> index = this->block_info.global.global_to_local(value->first);
+        const std::vector<unsigned int>::const_iterator stage_block = std::find(blocks.begin(), blocks.end(), index.first);
+        if (stage_block != blocks.end())
+            stage_boundary_values[stage_indices.local_to_global(stage_block - blocks.begin(), index.second)] = value->second;
+    }
+
+    MatrixTools::apply_boundary_values(stage_boundary_values, stage_matrix, stage_solution, stage_rhs, false);
+
+    FcstUtilities::log << "Solving the linear system of the stage with " << stage_matrix.m() << " of " << this->matrix.m() << " unknowns" << std::endl;
+
+    // The UMFPACK factorization is computed for the stage matrix, hence it is not valid for #matrix before or after:
+    factorization_valid = false;
+    serial_linear_solve(stage_matrix, stage_solution, stage_rhs);
+    factorization_valid = false;
+
+    // Copy the stage solution back, the other blocks are not updated:
+    solution = 0;
+    for (unsigned int i = 0; i < n_stage_blocks; ++i)
+        solution.block(blocks[i]) = stage_solution.block(i);
+
+    this->hanging_node_constraints.distribute(solution);
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void BlockMatrixApplication<dim>::serial_linear_solve(const BlockSparseMatrix<double>& system_matrix,
+                                                      FEVector&                        solution,
+                                                      FEVector&                        system_rhs)
+{
     if (this->data->get_linear_solver() == FuelCell::ApplicationCore::LinearSolver::CG) {
         
         SolverCG<FEVector> solver(solver_control, this->data->block_vector_pool);
-        solver.solve(this->matrix, solution, system_rhs, PreconditionIdentity());
+        solver.solve(system_matrix, solution, system_rhs, PreconditionIdentity());
 
     }
     else if (this->data->get_linear_solver() == FuelCell::ApplicationCore::LinearSolver::BICGSTAB) {
 
         SolverBicgstab<FEVector> solver(solver_control, this->data->block_vector_pool);
-        solver.solve(this->matrix, solution, system_rhs, PreconditionIdentity());
+        solver.solve(system_matrix, solution, system_rhs, PreconditionIdentity());
 
     }
     else if (this->data->get_linear_solver() == FuelCell::ApplicationCore::LinearSolver::ILU_GMRES) {
 
-        LinearSolvers::ILUPreconditioner prec(this->matrix);
+        LinearSolvers::ILUPreconditioner prec(system_matrix);
         LinearSolvers::GMRESSolver solver;
-        solver.solve(solver_control, this->matrix, solution, system_rhs, prec.preconditioner);
+        solver.solve(solver_control, system_matrix, solution, system_rhs, prec.preconditioner);
     }
     else if (this->data->get_linear_solver() == FuelCell::ApplicationCore::LinearSolver::UMFPACK) {
         
-        LinearSolvers::SparseDirectUMFPACKSolver solver;
-        solver.solve(this->matrix, solution, system_rhs);
+        // Factorize only if the matrix changed since the last solve:
+        if (!factorization_valid)
+        {
+            FcstUtilities::log << "Solving the linear system using UMFPACK" << std::endl;
+            umfpack_factorization.initialize(system_matrix);
+            factorization_valid = true;
+        }
+        else
+            FcstUtilities::log << "Solving the linear system using the stored UMFPACK factorization" << std::endl;
+
+        Vector<double> tmp;
+        tmp = system_rhs;
+        umfpack_factorization.solve(tmp);
+        solution = tmp;
     }
     
     else {
@@ -389,9 +593,6 @@ void BlockMatrixApplication<dim>::serial_solve(FuelCell::ApplicationCore::FEVect
         FcstUtilities::log << "Linear Solver" <<"not implemented in class " << info.name() << " member function solve()" << std::endl;
         abort();
     }
-
-    // --- Finally apply hanging node constraints to solution ---
-    this->hanging_node_constraints.distribute(solution);
 }
 #endif
 
@@ -423,6 +624,8 @@ void BlockMatrixApplication<dim>::solve(FEVector& solution,
                     "cannot find solution from FEVectors& src.");
 
         // --- Assemble ---
+        factorization_valid = false;
+        pseudo_time_shift = 0.0;
         if (this->assemble_numerically_flag)
             this->assemble_numerically(sol);
         else
@@ -449,6 +652,16 @@ void BlockMatrixApplication<dim>::solve(FEVector& solution,
     // --- Repair diagonal elements ---
     if (repair_diagonal)
         SolverUtils::repair_diagonal(matrix);
+
+    // --- Pseudo-transient continuation term ---
+    const double* inv_time_step = this->data->scalar("Pseudo time step inverse");
+    const double shift = (inv_time_step != NULL) ? *inv_time_step : 0.0;
+    if (shift != pseudo_time_shift)
+    {
+        this->add_pseudo_time_term(shift - pseudo_time_shift);
+        pseudo_time_shift = shift;
+        factorization_valid = false;
+    }
 /*
      FcstUtilities::log<<"== PRINTING MATRIX =="<<std::endl;
      std::ofstream file;
@@ -483,10 +696,17 @@ void BlockMatrixApplication<dim>::solve(FEVector& solution,
             this->notifications.clear();
 
     // --- solve ---
+    const std::vector<unsigned int> blocks = this->stage_blocks();
     #ifdef OPENFCST_WITH_PETSC
-        PETSc_solve(system_rhs, solution, src);
+        if (blocks.empty())
+            PETSc_solve(system_rhs, solution, src);
+        else
+            PETSc_stage_solve(blocks, system_rhs, solution);
     #else
-        serial_solve(system_rhs, solution);
+        if (blocks.empty())
+            serial_solve(system_rhs, solution);
+        else
+            serial_stage_solve(blocks, system_rhs, solution);
     #endif
 
 
@@ -595,6 +815,23 @@ void BlockMatrixApplication<dim>::serial_assemble(const FEVectors& src) {
     this->tr->clear_user_flags();
 
     typename DoFHandler<dim>::active_cell_iterator c;
+
+    // Collect the expensive cell computations of the whole mesh and perform them before the assembly, see AssemblyBatch.
+    // Only the cells of the objects collecting are assembled and the local matrices of this first pass are discarded:
+    typename DoFApplication<dim>::AssemblyBatchGuard batch_guard(*this);
+    if (this->begin_assembly_batches()) {
+        for (c = begin; c != end; ++c) {
+            if (!this->assembly_batch_material(c->material_id()))
+                continue;
+
+            cell_info.reinit(c);
+            cell_info.fill_local_data(cell_info.values, true);
+            cell_info.fill_local_data(cell_info.derivatives, true);
+            cell_matrix(intint, cell_info);
+        }
+        this->evaluate_assembly_batches();
+    }
+
     for (c = begin; c != end; ++c) {
         for (unsigned int i = 0; i < intint.size(); ++i)
             intint[i].matrix = 0.;
@@ -626,6 +863,7 @@ void BlockMatrixApplication<dim>::serial_assemble(const FEVectors& src) {
                     }
         }
     }
+    this->end_assembly_batches();
     this->post_cell_assemble();
 
 
@@ -892,6 +1130,28 @@ void BlockMatrixApplication<dim>::PETSc_assemble(const FEVectors& src)
 
     // Start loops over cells
     typename DoFHandler<dim>::active_cell_iterator c;
+
+    // Collect the expensive cell computations of the cells of this process and perform them before the assembly,
+    // see AssemblyBatch. Only the cells of the objects collecting are assembled and the local matrices of this first
+    // pass are discarded:
+    typename DoFApplication<dim>::AssemblyBatchGuard batch_guard(*this);
+    if (this->begin_assembly_batches())
+    {
+        for (c = begin ; c != end ; ++c)
+        {
+            if(c->subdomain_id() != this->this_mpi_process)
+                continue;
+
+            if (!this->assembly_batch_material(c->material_id()))
+                continue;
+
+            cell_info.reinit(c);
+            cell_info.fill_local_data(cell_info.values, true);
+            cell_info.fill_local_data(cell_info.derivatives, true);
+            cell_matrix(intint, cell_info);
+        }
+        this->evaluate_assembly_batches();
+    }
     
     // First loop over cells:
     for (c = begin ; c != end ; ++c)
@@ -901,6 +1161,8 @@ void BlockMatrixApplication<dim>::PETSc_assemble(const FEVectors& src)
             for (unsigned int i=0;i<intint.size();++i)
                 intint[i].matrix = 0.;
 
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
             // Initialize local structures
             cell_info.reinit(c);
 
@@ -909,6 +1171,11 @@ void BlockMatrixApplication<dim>::PETSc_assemble(const FEVectors& src)
             cell_info.fill_local_data(cell_info.derivatives, true);
             cell_matrix(intint, cell_info);
 
+            // Assembly cost used to balance the partitioning of the mesh:
+            if (this->measured_partition_weights)
+                this->record_cell_cost(c->material_id(),
+                                       std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
             //Local matrices are created assembled above and put in block in below loop
             for (unsigned int i=0;i<intint.size();++i)
             {
@@ -934,6 +1201,7 @@ void BlockMatrixApplication<dim>::PETSc_assemble(const FEVectors& src)
         }
     }
 
+    this->end_assembly_batches();
     this->post_cell_assemble();
     
 #if deal_II_dimension > 1
@@ -1020,7 +1288,7 @@ template<int dim>
 void BlockMatrixApplication<dim>::assemble_numerically(const FEVectors& src, const double delta) 
 {
     #ifdef OPENFCST_WITH_PETSC
-        throw std::runtime_error("BlockMatrixApplication<dim>::assemble_numerically are not implemented for PETSc implementation.");
+        PETSc_assemble_numerically(src, delta);
     #else
         this->matrix = 0.0;
 
@@ -1126,6 +1394,361 @@ void BlockMatrixApplication<dim>::assemble_numerically(const FEVectors& src, con
 
 }
 
+//------------------------------
+#ifdef OPENFCST_WITH_PETSC
+template<int dim>
+void BlockMatrixApplication<dim>::PETSc_assemble_numerically(const FEVectors& src, const double delta)
+{
+    this->matrix = 0.0;
+
+    // Rows of #matrix stored by this process, only these can be read and the columns are owned by the same process:
+    const std::pair<types::global_dof_index, types::global_dof_index> range = this->matrix.local_range();
+    const unsigned int n_owned = range.second - range.first;
+
+    // Columns of the sparsity pattern in each row owned by this process:
+    std::vector< std::vector<types::global_dof_index> > row_columns(n_owned);
+    for (unsigned int i = 0; i < n_owned; ++i)
+    {
+        const types::global_dof_index row = range.first + i;
+        for (PETScWrappers::MatrixBase::const_iterator p = matrix.begin(row); p != matrix.end(row); ++p)
+            row_columns[i].push_back(p->column());
+    }
+
+    FEVector column_groups;
+    const unsigned int n_groups = jacobian_column_groups(row_columns, column_groups);
+
+    // Degrees of freedom perturbed and entries of the Jacobian computed with each group:
+    std::vector< std::vector<types::global_dof_index> > group_dofs(n_groups);
+    std::vector< std::vector< std::pair<types::global_dof_index, types::global_dof_index> > > group_entries(n_groups);
+
+    for (types::global_dof_index k = 0; k < this->dof->n_dofs(); ++k)
+    {
+        const unsigned int group = static_cast<unsigned int>(column_groups(k));
+        if (group > 0)
+            group_dofs[group - 1].push_back(k);
+    }
+
+    for (unsigned int i = 0; i < n_owned; ++i)
+        for (unsigned int j = 0; j < row_columns[i].size(); ++j)
+        {
+            const unsigned int group = static_cast<unsigned int>(column_groups(row_columns[i][j]));
+            if (group > 0)
+                group_entries[group - 1].push_back(std::make_pair(range.first + i, row_columns[i][j]));
+        }
+
+    // All processes evaluate the residual for the groups perturbed by any process:
+    std::vector<int> local_group_used(n_groups, 0);
+    std::vector<int> group_used(n_groups, 0);
+    for (unsigned int g = 0; g < n_groups; ++g)
+        local_group_used[g] = group_dofs[g].empty() ? 0 : 1;
+    MPI_Allreduce(local_group_used.data(), group_used.data(), n_groups, MPI_INT, MPI_MAX, this->mpi_communicator);
+
+    // Find the index where the solution vector is stored:
+    unsigned int ind = src.find_vector(this->data->get_solution_vector_name(this->data->get_nonlinear_solver()));
+
+    // Solution with the hanging nodes consistent with the other degrees of freedom:
+    FEVector solution;
+    solution = src.vector(ind);
+    this->hanging_node_constraints.distribute(solution);
+
+    // Vector where the perturbed solution is stored:
+    FEVector solution_delta;
+    solution_delta = solution;
+
+    // FEVectors object that is passed to residual and that includes the perturbed solution:
+    FEVectors solution_copy;
+    solution_copy.add_vector(solution_delta, this->data->get_solution_vector_name(this->data->get_nonlinear_solver()));
+
+    FEVector residual;
+    residual.reinit(solution);
+    this->residual(residual, solution_copy, false);
+
+    FEVector residual_copy;
+    residual_copy.reinit(solution);
+
+    unsigned int n_residuals = 1;
+
+    for (unsigned int g = 0; g < n_groups; ++g)
+    {
+        if (group_used[g] == 0)
+            continue;
+
+        // Perturb all the degrees of freedom in the group:
+        for (unsigned int k = 0; k < group_dofs[g].size(); ++k)
+            solution_delta(group_dofs[g][k]) += delta;
+        this->hanging_node_constraints.distribute(solution_delta);
+
+        this->residual(residual_copy, solution_copy, false);
+        ++n_residuals;
+
+        // Each row has at most one column in the group:
+        for (unsigned int k = 0; k < group_entries[g].size(); ++k)
+        {
+            const types::global_dof_index row = group_entries[g][k].first;
+            this->matrix.set(row, group_entries[g][k].second, (residual_copy(row) - residual(row)) / delta);
+        }
+
+        // Remove perturbation:
+        solution_delta = solution;
+    }
+
+    // Constrained rows only have a unit diagonal:
+    for (types::global_dof_index row = range.first; row < range.second; ++row)
+        if (this->hanging_node_constraints.is_constrained(row))
+            this->matrix.set(row, row, 1.0);
+
+    this->matrix.compress(VectorOperation::insert);
+
+    FcstUtilities::log << "Numerical Jacobian computed using " << n_residuals << " residual evaluations." << std::endl;
+}
+
+//------------------------------
+template<int dim>
+unsigned int
+BlockMatrixApplication<dim>::jacobian_column_groups(const std::vector< std::vector<types::global_dof_index> >& row_columns,
+                                                    FEVector& column_groups) const
+{
+    const unsigned int n_processes = this->n_mpi_processes;
+
+    // A column is owned by the process that stores the row with the same index in #matrix:
+    const std::pair<types::global_dof_index, types::global_dof_index> range = this->matrix.local_range();
+    const unsigned int n_owned = range.second - range.first;
+    const types::global_dof_index first_owned = range.first;
+
+    // Last row (plus one) owned by each process, used to find the owner of a column:
+    unsigned long long local_end = range.second;
+    std::vector<unsigned long long> owned_end(n_processes);
+    MPI_Allgather(&local_end, 1, MPI_UNSIGNED_LONG_LONG, owned_end.data(), 1, MPI_UNSIGNED_LONG_LONG, this->mpi_communicator);
+    for (unsigned int p = 1; p < n_processes; ++p)
+        owned_end[p] = std::max(owned_end[p], owned_end[p-1]);
+
+    // Rows containing each owned column and columns sharing a row with columns of other processes:
+    std::vector< std::vector<types::global_dof_index> > column_rows(n_owned);
+    std::vector<bool> interface_column(n_owned, false);
+    std::set< std::pair<unsigned int, unsigned int> > process_conflicts;
+    std::vector< std::vector<unsigned long long> > send_data(n_processes);
+
+    for (unsigned int i = 0; i < n_owned; ++i)
+    {
+        const types::global_dof_index row = first_owned + i;
+
+        std::vector<unsigned int> owners(row_columns[i].size());
+        for (unsigned int j = 0; j < row_columns[i].size(); ++j)
+            owners[j] = std::upper_bound(owned_end.begin(), owned_end.end(), row_columns[i][j]) - owned_end.begin();
+
+        std::set<unsigned int> row_owners(owners.begin(), owners.end());
+        const bool shared_row = (row_owners.size() > 1);
+
+        for (std::set<unsigned int>::const_iterator p = row_owners.begin(); p != row_owners.end(); ++p)
+            for (std::set<unsigned int>::const_iterator q = std::next(p); q != row_owners.end(); ++q)
+                process_conflicts.insert(std::make_pair(*p, *q));
+
+        for (unsigned int j = 0; j < row_columns[i].size(); ++j)
+        {
+            if (owners[j] == this->this_mpi_process)
+            {
+                column_rows[row_columns[i][j] - first_owned].push_back(row);
+                if (shared_row)
+                    interface_column[row_columns[i][j] - first_owned] = true;
+            }
+            else
+            {
+                send_data[owners[j]].push_back(row);
+                send_data[owners[j]].push_back(row_columns[i][j]);
+                send_data[owners[j]].push_back(shared_row ? 1 : 0);
+            }
+        }
+    }
+
+    // Send the rows containing columns owned by other processes to their owners:
+    std::vector<int> send_counts(n_processes), receive_counts(n_processes);
+    std::vector<int> send_offsets(n_processes, 0), receive_offsets(n_processes, 0);
+    std::vector<unsigned long long> send_buffer;
+    for (unsigned int p = 0; p < n_processes; ++p)
+    {
+        send_counts[p] = send_data[p].size();
+        send_offsets[p] = send_buffer.size();
+        send_buffer.insert(send_buffer.end(), send_data[p].begin(), send_data[p].end());
+    }
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, receive_counts.data(), 1, MPI_INT, this->mpi_communicator);
+
+    for (unsigned int p = 1; p < n_processes; ++p)
+        receive_offsets[p] = receive_offsets[p-1] + receive_counts[p-1];
+    std::vector<unsigned long long> receive_buffer(receive_offsets[n_processes-1] + receive_counts[n_processes-1]);
+
+    MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_offsets.data(), MPI_UNSIGNED_LONG_LONG,
+                  receive_buffer.data(), receive_counts.data(), receive_offsets.data(), MPI_UNSIGNED_LONG_LONG,
+                  this->mpi_communicator);
+
+    for (unsigned int k = 0; k < receive_buffer.size(); k += 3)
+    {
+        const unsigned int j = receive_buffer[k+1] - first_owned;
+        column_rows[j].push_back(receive_buffer[k]);
+        if (receive_buffer[k+2] == 1)
+            interface_column[j] = true;
+    }
+
+    // Color the processes using the conflicts of all processes:
+    std::vector<unsigned int> local_conflicts;
+    for (std::set< std::pair<unsigned int, unsigned int> >::const_iterator c = process_conflicts.begin(); c != process_conflicts.end(); ++c)
+    {
+        local_conflicts.push_back(c->first);
+        local_conflicts.push_back(c->second);
+    }
+
+    int n_local_conflicts = local_conflicts.size();
+    std::vector<int> conflict_counts(n_processes), conflict_offsets(n_processes, 0);
+    MPI_Allgather(&n_local_conflicts, 1, MPI_INT, conflict_counts.data(), 1, MPI_INT, this->mpi_communicator);
+    for (unsigned int p = 1; p < n_processes; ++p)
+        conflict_offsets[p] = conflict_offsets[p-1] + conflict_counts[p-1];
+    std::vector<unsigned int> conflicts(conflict_offsets[n_processes-1] + conflict_counts[n_processes-1]);
+    MPI_Allgatherv(local_conflicts.data(), n_local_conflicts, MPI_UNSIGNED,
+                   conflicts.data(), conflict_counts.data(), conflict_offsets.data(), MPI_UNSIGNED,
+                   this->mpi_communicator);
+
+    std::vector< std::set<unsigned int> > process_neighbors(n_processes);
+    for (unsigned int k = 0; k < conflicts.size(); k += 2)
+    {
+        process_neighbors[conflicts[k]].insert(conflicts[k+1]);
+        process_neighbors[conflicts[k+1]].insert(conflicts[k]);
+    }
+
+    std::vector<int> process_color(n_processes, -1);
+    unsigned int n_process_colors = 0;
+    for (unsigned int p = 0; p < n_processes; ++p)
+    {
+        std::set<int> used_colors;
+        for (std::set<unsigned int>::const_iterator q = process_neighbors[p].begin(); q != process_neighbors[p].end(); ++q)
+            used_colors.insert(process_color[*q]);
+
+        int color = 0;
+        while (used_colors.count(color) > 0)
+            ++color;
+        process_color[p] = color;
+        n_process_colors = std::max(n_process_colors, static_cast<unsigned int>(color + 1));
+    }
+
+    // Color the columns owned by this process, interior and interface columns separately:
+    std::map< types::global_dof_index, std::vector<unsigned int> > row_owned_columns;
+    for (unsigned int j = 0; j < n_owned; ++j)
+        for (unsigned int k = 0; k < column_rows[j].size(); ++k)
+            row_owned_columns[column_rows[j][k]].push_back(j);
+
+    std::vector<int> column_color(n_owned, -1);
+    unsigned int n_colors[2] = {0, 0};
+
+    for (unsigned int j = 0; j < n_owned; ++j)
+    {
+        if (this->hanging_node_constraints.is_constrained(first_owned + j))
+            continue;
+
+        std::set<int> used_colors;
+        for (unsigned int k = 0; k < column_rows[j].size(); ++k)
+        {
+            const std::vector<unsigned int>& neighbors = row_owned_columns[column_rows[j][k]];
+            for (unsigned int l = 0; l < neighbors.size(); ++l)
+                if (interface_column[neighbors[l]] == interface_column[j])
+                    used_colors.insert(column_color[neighbors[l]]);
+        }
+
+        int color = 0;
+        while (used_colors.count(color) > 0)
+            ++color;
+        column_color[j] = color;
+        n_colors[interface_column[j]] = std::max(n_colors[interface_column[j]], static_cast<unsigned int>(color + 1));
+    }
+
+    const unsigned int n_interior_colors = Utilities::MPI::max(n_colors[0], this->mpi_communicator);
+    const unsigned int n_interface_colors = Utilities::MPI::max(n_colors[1], this->mpi_communicator);
+
+    // Group numbers plus one of the owned columns, zero for the constrained degrees of freedom:
+    std::vector<types::global_dof_index> owned_indices(n_owned);
+    std::vector<double> owned_groups(n_owned, 0.0);
+    for (unsigned int j = 0; j < n_owned; ++j)
+    {
+        owned_indices[j] = first_owned + j;
+
+        if (column_color[j] < 0)
+            continue;
+
+        if (interface_column[j])
+            owned_groups[j] = n_interior_colors + process_color[this->this_mpi_process]*n_interface_colors + column_color[j] + 1;
+        else
+            owned_groups[j] = column_color[j] + 1;
+    }
+
+    // Use the same layout as #matrix such that each process only sets its own entries:
+    PETScWrappers::MPI::Vector distributed_groups(this->mpi_communicator, this->dof->n_dofs(), n_owned);
+    distributed_groups.set(owned_indices, owned_groups);
+    distributed_groups.compress(VectorOperation::insert);
+
+    column_groups.reinit(this->block_info.global);
+    this->import_distributed_vector(distributed_groups, column_groups);
+
+    return n_interior_colors + n_process_colors*n_interface_colors;
+}
+#endif
+
+//------------------------------
+template<int dim>
+void BlockMatrixApplication<dim>::compute_lumped_mass()
+{
+    lumped_mass.reinit(this->dof->n_dofs());
+
+    FEValues<dim> fe_values(*this->mapping,
+                            *this->element,
+                            *quadrature_assemble_cell,
+                            UpdateFlags(update_values | update_JxW_values));
+
+    const unsigned int dofs_per_cell = this->element->dofs_per_cell;
+    std::vector<types::global_dof_index> local_dof_indices(dofs_per_cell);
+
+    typename DoFHandler<dim>::active_cell_iterator
+    cell = this->dof->begin_active(),
+    endc = this->dof->end();
+
+    for (; cell != endc; ++cell)
+    {
+        fe_values.reinit(cell);
+        cell->get_dof_indices(local_dof_indices);
+
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        {
+            double value = 0.0;
+            for (unsigned int q = 0; q < fe_values.n_quadrature_points; ++q)
+                value += fe_values.shape_value(i, q)*fe_values.JxW(q);
+
+            lumped_mass(local_dof_indices[i]) += value;
+        }
+    }
+}
+
+//------------------------------
+template<int dim>
+void BlockMatrixApplication<dim>::add_pseudo_time_term(const double shift)
+{
+    if (lumped_mass.size() != this->dof->n_dofs())
+        compute_lumped_mass();
+
+    #ifdef OPENFCST_WITH_PETSC
+        const std::pair<unsigned int, unsigned int> range = matrix.local_range();
+    #else
+        const std::pair<unsigned int, unsigned int> range(0, matrix.m());
+    #endif
+
+    for (unsigned int i = range.first; i < range.second; ++i)
+    {
+        if (boundary_values.find(i) != boundary_values.end() || this->hanging_node_constraints.is_constrained(i))
+            continue;
+
+        matrix.add(i, i, shift*lumped_mass(i));
+    }
+
+    #ifdef OPENFCST_WITH_PETSC
+        matrix.compress(VectorOperation::add);
+    #endif
+}
+
 //------------------------------
 template<int dim>
 void BlockMatrixApplication<dim>::residual_constraints(FEVector& dst) const {
@@ -1145,12 +1768,12 @@ void BlockMatrixApplication<dim>::residual_constraints(FEVector& dst) const {
 //------------------------------
 #ifdef OPENFCST_WITH_PETSC
 template<int dim>
-void BlockMatrixApplication<dim>::residual_constraints(PETScWrappers::MPI::Vector& dst, const std::vector<unsigned int>& idx_list) const {
+void BlockMatrixApplication<dim>::residual_constraints(PETScWrappers::MPI::Vector& dst) const {
 
-	//Only modify the dofs in local process (idx_list)
-    for(auto i: idx_list)
-        if (boundary_values.count(i))
-            dst(i) = boundary_values.at(i);
+    //Only modify the dofs owned by this process
+    for(auto m: boundary_values)
+        if (this->locally_owned_dofs.is_element(m.first))
+            dst(m.first) = m.second;
 }
 #endif
 
@@ -42,7 +42,10 @@ system_management(this->block_info,
 output_materials_and_levels(true),
 output_actual_degree(true),
 print_solution(false),
-print_postprocessing(false)
+print_postprocessing(false),
+parallel_output(false),
+measured_partition_weights(false),
+repartition_after_refinement(false)
 {
     FcstUtilities::log << "->DoF";
     boost::shared_ptr<DoFHandler<dim> >
@@ -65,7 +68,10 @@ system_management(this->block_info,
 output_materials_and_levels(true),
 output_actual_degree(true),
 print_solution(false),
-print_postprocessing(false)
+print_postprocessing(false),
+parallel_output(false),
+measured_partition_weights(false),
+repartition_after_refinement(false)
 {
     FcstUtilities::log << "->DoF";
     boost::shared_ptr<DoFHandler<dim> >
@@ -86,7 +92,11 @@ system_management(this->block_info,
                   flux_couplings  ),
 output_actual_degree(true),
 print_solution(false),
-print_postprocessing(false)
+print_postprocessing(false),
+parallel_output(other.parallel_output),
+partition_weights(other.partition_weights),
+measured_partition_weights(other.measured_partition_weights),
+repartition_after_refinement(other.repartition_after_refinement)
 {
     tr = other.tr;
     if (triangulation_only)
@@ -134,6 +144,22 @@ DoFApplication<dim>::declare_parameters(ParameterHandler& param)
                             "false", 
                             Patterns::Bool(),
                             "Organize the degree of freedom numbering for the mesh using the Cuthill-McKee algorithm");        
+        param.declare_entry("Partition cell weights",
+                            "",
+                            Patterns::Map( Patterns::Integer(0,255), Patterns::Double(0) ),
+                            "In parallel runs, relative cost of the cells of each material id used to balance the partitioning "
+                            "of the mesh, e.g., 4:100, 6:100 for catalyst layers that are 100 times more expensive than the "
+                            "other layers. Cells of materials not in the list have weight 1. If empty, each process owns "
+                            "the same number of cells.");
+        param.declare_entry("Measured partition weights",
+                            "false",
+                            Patterns::Bool(),
+                            "Use the measured assembly time per cell of each material as the partition weights. "
+                            "The weights are only available after the first assembly, i.e., when the mesh is repartitioned.");
+        param.declare_entry("Repartition after refinement",
+                            "false",
+                            Patterns::Bool(),
+                            "Repartition the mesh after each refinement.");
     }
     param.leave_subsection();
     param.enter_subsection("Adaptive refinement");
@@ -221,6 +247,15 @@ DoFApplication<dim>::declare_parameters(ParameterHandler& param)
                             "Use a developer pre-defined routine to setup initial solution instead"
                             "of using the piece-wise function defined using Equations>>Initial Data."
                             "This might be beneficial in some cases as a more appropriate initial solution might be used.");
+        param.declare_entry("Use through-plane model initial solution",
+                            "false",
+                            Patterns::Bool(),
+                            "Applications that support it solve a one-dimensional through-plane model of the MEA "
+                            "and extrude its solution onto the mesh to improve the pre-defined initial solution.");
+        param.declare_entry("Through-plane model cells per layer",
+                            "20",
+                            Patterns::Integer(1),
+                            "Number of finite volume cells per layer in the one-dimensional through-plane model.");
         param.declare_entry("Output solution for transfer",
                             "false",
                             Patterns::Bool(),
@@ -268,6 +303,12 @@ DoFApplication<dim>::declare_parameters(ParameterHandler& param)
             param.declare_entry("Print blocks instead of indices",
                                 "false",
                                 Patterns::Bool());
+            param.declare_entry("Parallel output",
+                                "false",
+                                Patterns::Bool(),
+                                "In parallel runs, every process writes the data on its own cells to a separate file and "
+                                "a master record (.pvtu and .visit) ties the files together. Otherwise, process zero "
+                                "writes the complete solution.");
             DataOutInterface<dim>::declare_parameters(param);
             // Default output format for openFCST is vtu not gnuplot
             param.set("Output format","vtu");
@@ -288,6 +329,9 @@ template <int dim>
 void
 DoFApplication<dim>::initialize (ParameterHandler& param)
 {
+    // The layers registered by a previous initialization are replaced by the derived application:
+    assembly_batches.clear();
+
     _initialize(param);
 }
 
@@ -302,6 +346,9 @@ DoFApplication<dim>::_initialize (ParameterHandler& param)
     {        
         initial_refinement = param.get_integer("Initial refinement");             
         sort_cuthill = param.get_bool("Sort Cuthill-McKee");
+        partition_weights = FcstUtilities::string_to_map<unsigned int, double>( Utilities::split_string_list( param.get("Partition cell weights") ) );
+        measured_partition_weights = param.get_bool("Measured partition weights");
+        repartition_after_refinement = param.get_bool("Repartition after refinement");
     }
     param.leave_subsection();
     param.enter_subsection("Adaptive refinement");
@@ -379,6 +426,8 @@ DoFApplication<dim>::_initialize (ParameterHandler& param)
     {
         read_in_initial_solution = param.get_bool("Read in initial solution from file");
         use_predefined_solution = param.get_bool("Use pre-defined initial solution");
+        use_through_plane_solution = param.get_bool("Use through-plane model initial solution");
+        n_through_plane_cells = param.get_integer("Through-plane model cells per layer");
         filename_initial_sol = param.get("Initial solution output filename");
         output_initial_sol = param.get_bool("Output initial solution");
         output_coarse_solution = param.get_bool("Output solution for transfer");
@@ -400,6 +449,7 @@ DoFApplication<dim>::_initialize (ParameterHandler& param)
             print_solution       = param.get_bool("Print solution");
             print_postprocessing = param.get_bool("Print postprocessing");
             print_blocks_instead_of_indices = param.get_bool("Print blocks instead of indices");
+            parallel_output = param.get_bool("Parallel output");
 
             if( !param.get("Solution printing indices").empty() )
             {
@@ -483,12 +533,184 @@ DoFApplication<dim>::initialize_triangulation(ParameterHandler& param)
         data->field_data=mesh_generator->grid_in->field_data;
     
     // If running in parallel, then subdivide the mesh by DOF.
+    partition_mesh();
+
+}
+
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+void
+DoFApplication<dim>::partition_mesh()
+{
 #ifdef OPENFCST_WITH_PETSC
-    GridTools::partition_triangulation (n_mpi_processes, *tr);
+    if (measured_partition_weights)
+        update_measured_partition_weights();
+
+    if (partition_weights.empty())
+    {
+        GridTools::partition_triangulation (n_mpi_processes, *tr);
+        return;
+    }
+
+    // Order the cells such that neighboring cells are close in the list:
+    SparsityPattern cell_connectivity;
+    GridTools::get_face_connectivity_of_cells(*tr, cell_connectivity);
+
+    std::vector<SparsityPattern::size_type> new_indices(tr->n_active_cells());
+    SparsityTools::reorder_Cuthill_McKee(cell_connectivity, new_indices);
+
+    std::vector<typename Triangulation<dim>::active_cell_iterator> ordered_cells(tr->n_active_cells());
+    double total_weight = 0.;
+    unsigned int index = 0;
+    for (typename Triangulation<dim>::active_cell_iterator cell = tr->begin_active(); cell != tr->end(); ++cell, ++index)
+    {
+        ordered_cells[new_indices[index]] = cell;
+        total_weight += cell_weight(cell->material_id());
+    }
+
+    // Split the ordered cells into groups with the same weight:
+    double accumulated_weight = 0.;
+    for (unsigned int i = 0; i < ordered_cells.size(); ++i)
+    {
+        const double weight = cell_weight(ordered_cells[i]->material_id());
+        const unsigned int subdomain = static_cast<unsigned int>( (accumulated_weight + 0.5*weight)*n_mpi_processes/total_weight );
+        ordered_cells[i]->set_subdomain_id( std::min(subdomain, n_mpi_processes - 1) );
+        accumulated_weight += weight;
+    }
+
+    FcstUtilities::log << "Mesh partitioned using the partition cell weights" << std::endl;
 #endif
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+double
+DoFApplication<dim>::cell_weight(const unsigned int material_id) const
+{
+    std::map<unsigned int, double>::const_iterator weight = partition_weights.find(material_id);
+    return (weight != partition_weights.end()) ? weight->second : 1.0;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+void
+DoFApplication<dim>::record_cell_cost(const unsigned int material_id,
+                                      const double       time)
+{
+    measured_material_time[material_id] += time;
+    ++measured_material_cells[material_id];
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+void
+DoFApplication<dim>::add_assembly_batch(AssemblyBatch* batch)
+{
+    if (batch != NULL)
+    {
+        batch->set_batch_registered();
+        assembly_batches.push_back(batch);
+    }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+bool
+DoFApplication<dim>::begin_assembly_batches()
+{
+    bool enabled = false;
+
+    for (unsigned int i = 0; i < assembly_batches.size(); ++i)
+        if (assembly_batches[i]->batch_enabled())
+        {
+            assembly_batches[i]->begin_collect();
+            enabled = true;
+        }
+
+    return enabled;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+bool
+DoFApplication<dim>::assembly_batch_material(const unsigned int material_id) const
+{
+    for (unsigned int i = 0; i < assembly_batches.size(); ++i)
+        if (assembly_batches[i]->batch_enabled() && assembly_batches[i]->batch_material(material_id))
+            return true;
+
+    return false;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+template <int dim>
+void
+DoFApplication<dim>::evaluate_assembly_batches()
+{
+    for (unsigned int i = 0; i < assembly_batches.size(); ++i)
+        if (assembly_batches[i]->batch_enabled())
+            assembly_batches[i]->evaluate();
 }
 
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+void
+DoFApplication<dim>::end_assembly_batches()
+{
+    for (unsigned int i = 0; i < assembly_batches.size(); ++i)
+        assembly_batches[i]->end_batch();
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+void
+DoFApplication<dim>::update_measured_partition_weights()
+{
+    // Material ids are in [0, 255]:
+    const unsigned int n_materials = 256;
+    std::vector<double> time(n_materials, 0.);
+    std::vector<double> n_cells(n_materials, 0.);
+
+    for (std::map<unsigned int, double>::const_iterator m = measured_material_time.begin(); m != measured_material_time.end(); ++m)
+    {
+        time[m->first] = m->second;
+        n_cells[m->first] = measured_material_cells[m->first];
+    }
+
+#ifdef OPENFCST_WITH_PETSC
+    MPI_Allreduce(MPI_IN_PLACE, &time[0], n_materials, MPI_DOUBLE, MPI_SUM, mpi_communicator);
+    MPI_Allreduce(MPI_IN_PLACE, &n_cells[0], n_materials, MPI_DOUBLE, MPI_SUM, mpi_communicator);
+#endif
+
+    double min_cost = std::numeric_limits<double>::max();
+    for (unsigned int m = 0; m < n_materials; ++m)
+        if (n_cells[m] > 0. && time[m] > 0.)
+            min_cost = std::min(min_cost, time[m]/n_cells[m]);
+
+    // No assembly has been timed yet:
+    if (min_cost == std::numeric_limits<double>::max())
+        return;
+
+    for (unsigned int m = 0; m < n_materials; ++m)
+        if (n_cells[m] > 0. && time[m] > 0.)
+        {
+            partition_weights[m] = time[m]/n_cells[m]/min_cost;
+            FcstUtilities::log << "Measured partition weight for material " << m << ": " << partition_weights[m] << std::endl;
+        }
+
+    measured_material_time.clear();
+    measured_material_cells.clear();
+}
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
@@ -664,6 +886,9 @@ DoFApplication<dim>::remesh()
         // Exectue refinement
         tr->execute_coarsening_and_refinement();
         
+        if (repartition_after_refinement)
+            partition_mesh();
+
         // Apply to vectors
         remesh_dofs();
         
@@ -686,12 +911,98 @@ DoFApplication<dim>::remesh()
     {
         tr->prepare_coarsening_and_refinement ();
         tr->execute_coarsening_and_refinement();
+
+        if (repartition_after_refinement)
+            partition_mesh();
+
         remesh_dofs();
     }
 }
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
+#ifdef OPENFCST_WITH_PETSC
+template <int dim>
+void
+DoFApplication<dim>::import_distributed_vector(const PETScWrappers::MPI::Vector& src,
+                                               FEVector& dst) const
+{
+    const PETScWrappers::Vector localized_vector(src);
+    dst = localized_vector;
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+void
+DoFApplication<dim>::export_to_distributed_vector(const FEVector& src,
+                                                  PETScWrappers::MPI::Vector& dst) const
+{
+    std::vector<double> values(locally_owned_dof_indices.size());
+    src.extract_subvector_to(locally_owned_dof_indices, values);
+
+    dst.set(locally_owned_dof_indices, values);
+    dst.compress(VectorOperation::insert);
+}
+#endif
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+bool
+DoFApplication<dim>::write_data_in_parallel() const
+{
+#ifdef OPENFCST_WITH_PETSC
+    return parallel_output;
+#else
+    return false;
+#endif
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+std::string
+DoFApplication<dim>::data_out_filename(const std::string& basename) const
+{
+#ifdef OPENFCST_WITH_PETSC
+    if (write_data_in_parallel())
+        return basename + "." + Utilities::int_to_string(this_mpi_process, 4) + d_out.default_suffix();
+#endif
+    return basename + d_out.default_suffix();
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template <int dim>
+void
+DoFApplication<dim>::write_data_out_master_record(const std::string& basename) const
+{
+#ifdef OPENFCST_WITH_PETSC
+    if (this_mpi_process != 0)
+        return;
+
+    // The pieces are referenced relative to the location of the master record:
+    std::vector<std::string> filenames;
+    for (unsigned int i = 0; i < n_mpi_processes; ++i)
+    {
+        const std::string filename = basename + "." + Utilities::int_to_string(i, 4) + d_out.default_suffix();
+        filenames.push_back( filename.substr(filename.find_last_of('/') + 1) );
+    }
+
+    if (d_out.default_suffix() == std::string(".vtu"))
+    {
+        std::ofstream pvtu_output( (basename + ".pvtu").c_str() );
+        d_out.write_pvtu_record(pvtu_output, filenames);
+    }
+
+    std::ofstream visit_output( (basename + ".visit").c_str() );
+    DataOutBase::write_visit_record(visit_output, filenames);
+#endif
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
 template <int dim>
 void
 DoFApplication<dim>::grid_out(const std::string& name)
@@ -771,9 +1082,15 @@ DoFApplication<dim>::data_out(const std::string&              basename,
     #endif
     //--
 
-    //-- Then, assemble data_out vector only for zero_mpi_process:
-    if (zero_mpi_process)
+    //-- Then, assemble data_out vector only for zero_mpi_process. In parallel output,
+    // every process writes the cells it owns:
+    const bool parallel = write_data_in_parallel();
+
+    if (zero_mpi_process || parallel)
     {
+        #ifdef OPENFCST_WITH_PETSC
+        d_out.set_subdomain_id(parallel ? this->this_mpi_process : numbers::invalid_subdomain_id);
+        #endif
         d_out.attach_dof_handler(*this->dof);
         d_out.add_data_vector(solution,
                               solution_names,
@@ -820,18 +1137,22 @@ DoFApplication<dim>::data_out(const std::string&              basename,
             else
                 d_out.build_patches();
 
-            std::ofstream output( (basename + d_out.default_suffix()).c_str() );
+            std::ofstream output( data_out_filename(basename).c_str() );
             d_out.write(output);
+
+            if( parallel )
+                write_data_out_master_record(basename);
+
             d_out.clear();
 
-            if( print_solution )
+            if( print_solution && zero_mpi_process )
             {
                 print("solution.dat",
                 solution,
                 solution_printing_indices);
             }
 
-            if( print_postprocessing )
+            if( print_postprocessing && zero_mpi_process )
             {
                 print("postprocessing.dat",
                 postprocessing,
@@ -859,8 +1180,14 @@ DoFApplication<dim>::data_out(const std::string&                            base
     }
     #endif
 
-    if (zero_mpi_process)
+    // In parallel output, every process writes the cells it owns:
+    const bool parallel = write_data_in_parallel();
+
+    if (zero_mpi_process || parallel)
     {
+        #ifdef OPENFCST_WITH_PETSC
+        d_out.set_subdomain_id(parallel ? this->this_mpi_process : numbers::invalid_subdomain_id);
+        #endif
         d_out.attach_dof_handler(*this->dof);
         d_out.add_data_vector(solution,
                               solution_names,
@@ -902,11 +1229,15 @@ DoFApplication<dim>::data_out(const std::string&                            base
             else
                 d_out.build_patches();
 
-            std::ofstream output( (basename + d_out.default_suffix()).c_str() );
+            std::ofstream output( data_out_filename(basename).c_str() );
             d_out.write(output);
+
+            if( parallel )
+                write_data_out_master_record(basename);
+
             d_out.clear();
             
-            if( print_solution )
+            if( print_solution && zero_mpi_process )
             {
                 print("solution.dat",
                 solution,
@@ -979,6 +1310,29 @@ DoFApplication<dim>::remesh_dofs()
 
     sort_dofs(dof.get());
 
+#ifdef OPENFCST_WITH_PETSC
+    // The PETSc objects store count_dofs_with_subdomain_association() rows on each process, in the order of the processes.
+    // After sorting by component, these rows are not the dofs of the subdomain, hence the owned range is computed from the counts:
+    std::vector<types::subdomain_id> dof_subdomains(dof->n_dofs());
+    DoFTools::get_subdomain_association(*dof, dof_subdomains);
+
+    types::global_dof_index first_owned = 0;
+    types::global_dof_index n_owned = 0;
+    for (types::global_dof_index i = 0; i < dof_subdomains.size(); ++i)
+    {
+        if (dof_subdomains[i] < this_mpi_process)
+            ++first_owned;
+        else if (dof_subdomains[i] == this_mpi_process)
+            ++n_owned;
+    }
+
+    locally_owned_dofs.clear();
+    locally_owned_dofs.set_size(dof->n_dofs());
+    locally_owned_dofs.add_range(first_owned, first_owned + n_owned);
+    locally_owned_dofs.compress();
+    locally_owned_dofs.fill_index_vector(locally_owned_dof_indices);
+#endif
+
     // Make the list of constraints associated with hanging nodes
     hanging_node_constraints.clear();
     DoFTools::make_hanging_node_constraints (*this->dof,
@@ -1036,7 +1390,6 @@ DoFApplication<dim>::transfer_solution_to_coarse_mesh(Triangulation<dim>& tr_coa
                                                       FEVector& coarse_solution,
                                                       FEVector& refined_solution)
 {
-
     // Initialize a dof handler object with the triangulation
     DoFHandler<dim> dof_handler_coarse;
     const FiniteElement<dim>& fe_coarse(*this->element);
@@ -1193,7 +1546,8 @@ DoFApplication<dim>::estimate(const FEVectors& src)
                                        this->cell_errors,
                                        component_mask);
 
-    return 0.0;
+    // Global estimate, i.e. l2-norm of the cell indicators:
+    return this->cell_errors.l2_norm();
 }
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -1250,60 +1604,86 @@ DoFApplication<dim>::residual(FEVector&        dst,
   cell = this->dof->begin_active(),
   endc = this->dof->end();
 
-
+  // Collect the expensive cell computations of the whole mesh and perform them before the assembly, see AssemblyBatch.
+  // Only the cells of the objects collecting are assembled and the residuals of this first pass are discarded:
+  AssemblyBatchGuard batch_guard(*this);
+  if (begin_assembly_batches())
+  {
+      for( ; cell != endc; ++cell)
+      {
 #ifdef OPENFCST_WITH_PETSC
-  // -- PETSc parallel global residual --
+          if(cell->subdomain_id() != this->this_mpi_process)
+              continue;
+#endif
+          if (!assembly_batch_material(cell->material_id()))
+              continue;
 
-  std::vector<unsigned int> idx_list;
+          cell_and_bdry_residual(local_residual, cell_info, bdry_info, cell);
+      }
 
-  PETScWrappers::MPI::Vector DST;
-  const types::global_dof_index n_local_dofs
-  = DoFTools::count_dofs_with_subdomain_association (*this->dof,this_mpi_process);
+      evaluate_assembly_batches();
+      cell = this->dof->begin_active();
+  }
 
 
-  DST.reinit (mpi_communicator, this->dof->n_dofs(), n_local_dofs);
+#ifdef OPENFCST_WITH_PETSC
+  // -- PETSc parallel global residual --
+
+  PETScWrappers::MPI::Vector DST;
+  DST.reinit (mpi_communicator, this->dof->n_dofs(), locally_owned_dofs.n_elements());
 
+  // The contributions to rows of DST stored by other processes are sent while the cells that
+  // only modify the locally_owned_dofs, i.e., the rows stored by this process, are assembled.
+  // The other cells are assembled first:
+  std::vector<types::global_dof_index> cell_indices(this->element->dofs_per_cell);
+  std::vector<typename DoFHandler<dim>::active_cell_iterator> interior_cells;
 
   for( ; cell != endc; ++cell)
   {
+      if(cell->subdomain_id() != this->this_mpi_process)
+          continue;
 
-      if(cell->subdomain_id() == this->this_mpi_process){
-          local_residual = 0;
-          local_residual.reinit(this->block_info.local);
+      cell->get_dof_indices(cell_indices);
 
-          cell_info.reinit(cell);
+      if (is_interior_cell(cell_indices))
+      {
+          interior_cells.push_back(cell);
+          continue;
+      }
 
-          cell_residual(local_residual, cell_info);
+      cell_and_bdry_residual(local_residual, cell_info, bdry_info, cell);
+      hanging_node_constraints.distribute_local_to_global(local_residual,cell_info.indices, DST);
+  }
 
-          if( this->boundary_fluxes )
-          {
-              for(unsigned int no_face = 0; no_face < GeometryInfo<dim>::faces_per_cell; ++no_face)
-              {
-
-                  typename DoFHandler<dim>::face_iterator face = cell->face(no_face);
-                  if( face->at_boundary() )
-                  {
-                      bdry_info.reinit(cell,
-                              face,
-                              no_face);
-
-                      bdry_residual(local_residual,
-                              bdry_info);
-                  }
-              }
-          }
+  // Start sending the contributions to other processes. The wrapper of deal.II 8.4 only offers compress(),
+  // which starts and finishes the assembly at once, hence PETSc is called directly. This is safe because
+  // DST is only modified with add() before and after, so the last action recorded by the wrapper is
+  // still VectorOperation::add, and compress() below finishes the assembly of the entries added afterwards:
+  PetscErrorCode ierr = VecAssemblyBegin(static_cast<const Vec&>(DST));
+  AssertThrow(ierr == 0, ExcMessage("VecAssemblyBegin failed in DoFApplication::residual"));
 
-          hanging_node_constraints.distribute_local_to_global(local_residual,cell_info.indices, DST);
+  // Interior cells are added to dst, a serial vector that is not used for communication:
+  for (unsigned int c = 0; c < interior_cells.size(); ++c)
+  {
+      cell_and_bdry_residual(local_residual, cell_info, bdry_info, interior_cells[c]);
+      hanging_node_constraints.distribute_local_to_global(local_residual,cell_info.indices, dst);
+  }
 
-          for (auto i: cell_info.indices)
-              idx_list.push_back(i);
-      }
+  ierr = VecAssemblyEnd(static_cast<const Vec&>(DST));
+  AssertThrow(ierr == 0, ExcMessage("VecAssemblyEnd failed in DoFApplication::residual"));
+
+  end_assembly_batches();
+
+  // The interior cells only contribute to the rows stored by this process, so no entry is sent:
+  std::vector<double> interior_values(locally_owned_dof_indices.size());
+  for (unsigned int k = 0; k < locally_owned_dof_indices.size(); ++k)
+      interior_values[k] = dst(locally_owned_dof_indices[k]);
+  DST.add(locally_owned_dof_indices, interior_values);
 
-  }
   DST.compress(VectorOperation::add);
 
   if( apply_boundaries == true )
-      residual_constraints(DST, idx_list);
+      residual_constraints(DST);
 
   DST.compress(VectorOperation::insert);
 
@@ -1313,44 +1693,85 @@ DoFApplication<dim>::residual(FEVector&        dst,
 #else
   for( ; cell != endc; ++cell)
   {
-      local_residual = 0;
-      local_residual.reinit(this->block_info.local);
+      cell_and_bdry_residual(local_residual, cell_info, bdry_info, cell);
+
+      for(unsigned int i = 0; i < this->element->dofs_per_cell; ++i)
+          dst(cell_info.indices[i]) += local_residual(i);
+  }
+
+  end_assembly_batches();
+
+  if( apply_boundaries == true )
+      residual_constraints(dst);
+
+#endif
+
+  return dst.l2_norm();
 
-      cell_info.reinit(cell);
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+template<int dim>
+void
+DoFApplication<dim>::cell_and_bdry_residual(FEVector&                                             local_residual,
+                                            CellInfo&                                             cell_info,
+                                            FaceInfo&                                             bdry_info,
+                                            const typename DoFHandler<dim>::active_cell_iterator& cell)
+{
+  local_residual = 0;
+  local_residual.reinit(this->block_info.local);
+
+  cell_info.reinit(cell);
 
-      cell_residual(local_residual,
-              cell_info);
+  cell_residual(local_residual,
+                cell_info);
 
-      if( this->boundary_fluxes )
+  if( this->boundary_fluxes )
+  {
+      for(unsigned int no_face = 0; no_face < GeometryInfo<dim>::faces_per_cell; ++no_face)
       {
-          for(unsigned int no_face = 0; no_face < GeometryInfo<dim>::faces_per_cell; ++no_face)
-          {
 
-              typename DoFHandler<dim>::face_iterator face = cell->face(no_face);
-              if( face->at_boundary() )
-              {
-                  bdry_info.reinit(cell,
-                          face,
-                          no_face);
+          typename DoFHandler<dim>::face_iterator face = cell->face(no_face);
+          if( face->at_boundary() )
+          {
+              bdry_info.reinit(cell,
+                               face,
+                               no_face);
 
-                  bdry_residual(local_residual,
-                          bdry_info);
-              }
+              bdry_residual(local_residual,
+                            bdry_info);
           }
       }
-
-      for(unsigned int i = 0; i < this->element->dofs_per_cell; ++i)
-          dst(cell_info.indices[i]) += local_residual(i);
   }
+}
 
-  if( apply_boundaries == true )
-      residual_constraints(dst);
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
-#endif
+#ifdef OPENFCST_WITH_PETSC
+template<int dim>
+bool
+DoFApplication<dim>::is_interior_cell(const std::vector<types::global_dof_index>& indices) const
+{
+  for (unsigned int i = 0; i < indices.size(); ++i)
+  {
+      if (!locally_owned_dofs.is_element(indices[i]))
+          return false;
 
-  return dst.l2_norm();
+      if (hanging_node_constraints.is_constrained(indices[i]))
+      {
+          const std::vector< std::pair<types::global_dof_index, double> >* entries
+          = hanging_node_constraints.get_constraint_entries(indices[i]);
 
+          for (unsigned int j = 0; j < entries->size(); ++j)
+              if (!locally_owned_dofs.is_element((*entries)[j].first))
+                  return false;
+      }
+  }
+
+  return true;
 }
+#endif
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 
@@ -1364,7 +1785,7 @@ DoFApplication<dim>::residual_constraints(FEVector&) const
 #ifdef OPENFCST_WITH_PETSC
 template <int dim>
 void
-DoFApplication<dim>::residual_constraints(PETScWrappers::MPI::Vector&, const std::vector<unsigned int>&) const
+DoFApplication<dim>::residual_constraints(PETScWrappers::MPI::Vector&) const
 {}
 #endif
 
@@ -157,6 +157,7 @@ NAME::AppCathode<dim>::initialize(ParameterHandler& param)
     
     CCL  = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("Catalyst layer", param);
     CCL->set_gases_and_compute(gases, pressure, OC.get_T());
+    this->add_assembly_batch(dynamic_cast<FuelCell::ApplicationCore::AssemblyBatch*>(CCL.get()));
     
     // Initialize the necessary kinetics parameters in CCL.
     ReactionNames name = ORR;
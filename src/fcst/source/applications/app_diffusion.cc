@@ -265,9 +265,7 @@ void
 NAME::AppDiffusion<dim>::cell_residual(FuelCell::ApplicationCore::FEVector&                                     cell_res,
                                        const typename FuelCell::ApplicationCore::DoFApplication<dim>::CellInfo& cell_info)
 {
-    if ((this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::NEWTONBASIC) || 
-        (this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::NEWTON3PP) || 
-        (this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::NEWTONLINESEARCH))
+    if (this->data->is_newton_solver(this->data->get_nonlinear_solver()))
     {
         ficks_transport_equation.assemble_cell_residual(cell_res,cell_info,CGDL.get());
     }
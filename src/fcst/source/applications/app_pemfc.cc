@@ -113,11 +113,13 @@ NAME::AppPemfc<dim>::initialize(ParameterHandler& param)
     
     ACL = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("Anode catalyst layer", param);
     ACL->set_gases_and_compute (anode_gases, OC.get_pa_atm (), OC.get_T());
+    this->add_assembly_batch(dynamic_cast<FuelCell::ApplicationCore::AssemblyBatch*>(ACL.get()));
     
     ML = FuelCellShop::Layer::MembraneLayer<dim>::create_MembraneLayer("Membrane layer", param);
     
     CCL = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("Cathode catalyst layer", param);
     CCL->set_gases_and_compute (cathode_gases, OC.get_pc_atm (), OC.get_T());
+    this->add_assembly_batch(dynamic_cast<FuelCell::ApplicationCore::AssemblyBatch*>(CCL.get()));
     
     CMPL = FuelCellShop::Layer::MicroPorousLayer<dim>::create_MicroPorousLayer("Cathode microporous layer",param);
     CMPL->set_gases_and_compute(cathode_gases, OC.get_pc_atm (), OC.get_T());
@@ -209,6 +211,17 @@ NAME::AppPemfc<dim>::initialize_solution(FuelCell::ApplicationCore::FEVector& in
                                          std::shared_ptr<Function<dim> > initial_function)
 {
     std::shared_ptr< Function<dim> > initial_solution (new FuelCell::InitialSolution::AppPemfcIC<dim> (&OC, this->mesh_generator));
+
+    // Improve the initial solution using the one-dimensional through-plane model:
+    if (this->use_through_plane_solution)
+    {
+        std::shared_ptr< FuelCell::InitialSolution::ThroughPlaneMEAModel<dim> > through_plane_solution
+            (new FuelCell::InitialSolution::ThroughPlaneMEAModel<dim> (&OC, this->mesh_generator, &this->system_management, initial_solution,
+                                                                        AGDL.get(), AMPL.get(), ACL.get(), ML.get(), CCL.get(), CMPL.get(), CGDL.get(),
+                                                                        &oxygen, &nitrogen, this->n_through_plane_cells));
+        through_plane_solution->solve();
+        initial_solution = through_plane_solution;
+    }
     
     DoFApplication<dim>::initialize_solution(initial_guess, initial_solution);
 }
@@ -599,7 +612,7 @@ NAME::AppPemfc<dim>::data_out(const std::string &basename,
     }
     //construct the full filename, where basename is given by the adaptive refinement loop and suffix is the file extension (i.e. .vtk)
     const std::string fileName = basename + filename1;
-    FcstUtilities::log << "Datafile:" << fileName + this->d_out.default_suffix() << std::endl;
+    FcstUtilities::log << "Datafile:" << this->data_out_filename(fileName) << std::endl;
     
     // --- Find solution and do post-processing, otherwise skip:
     FuelCell::ApplicationCore::FEVector solution;
@@ -44,6 +44,8 @@ anReactionHeat(this->system_management, &reaction_source_terms),
 waterSorption(this->system_management, &sorption_source_terms)
 {
     this->repair_diagonal = true;
+    segregated = false;
+    n_segregated_stages = 2.0;
     FcstUtilities::log << "FuelCell::Application::AppPemfc_NonIsothermal-" << dim<<"d"<<std::endl;
 }
 
@@ -51,6 +53,8 @@ waterSorption(this->system_management, &sorption_source_terms)
 template <int dim>
 NAME::AppPemfcNIThermal<dim>::~AppPemfcNIThermal()
 { 
+    if (segregated)
+        this->data->erase_scalar("Number of segregated stages");
 }
      
 //---------------------------------------------------------------------------
@@ -129,11 +133,13 @@ NAME::AppPemfcNIThermal<dim>::_initialize(ParameterHandler& param)
 
     CCL = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("Cathode catalyst layer", param);
     CCL->set_gases (cathode_gases, OC.get_pc_atm());
+    this->add_assembly_batch(dynamic_cast<FuelCell::ApplicationCore::AssemblyBatch*>(CCL.get()));
     
     ML = FuelCellShop::Layer::MembraneLayer<dim>::create_MembraneLayer("Membrane layer", param);
     
     ACL = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("Anode catalyst layer", param);
     ACL->set_gases (anode_gases, OC.get_pa_atm());
+    this->add_assembly_batch(dynamic_cast<FuelCell::ApplicationCore::AssemblyBatch*>(ACL.get()));
 
     AMPL = FuelCellShop::Layer::MicroPorousLayer<dim>::create_MicroPorousLayer("Anode microporous layer",param);
     AMPL->set_gases (anode_gases, OC.get_pa_atm());
@@ -183,6 +189,18 @@ NAME::AppPemfcNIThermal<dim>::_initialize(ParameterHandler& param)
     //
     this->system_management.make_cell_couplings(tmp);
 
+    // Segregated solution, see NewtonSegregated:
+    segregated = (this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::SEGREGATED);
+    thermal_equation_block = this->system_management.equation_name_to_index(thermal_transport.get_equation_name());
+    temperature_block = this->system_management.solution_name_to_index("temperature_of_REV");
+    if (segregated)
+    {
+        AssertThrow(thermal_equation_block == temperature_block,
+                    ExcMessage("The segregated solver requires the ThermalTransportEquation and temperature_of_REV to be listed at the same position "
+                               "in the equations and in the solution variables."));
+        this->data->enter("Number of segregated stages", n_segregated_stages);
+    }
+
     // Now, initialize object that are used to setup initial solution and boundary conditions:    
     this->component_materialID_value_maps.push_back( ficks_oxygen_nitrogen.get_component_materialID_value()    );
     this->component_materialID_value_maps.push_back( ficks_water_hydrogen.get_component_materialID_value() );
@@ -236,6 +254,17 @@ NAME::AppPemfcNIThermal<dim>::initialize_solution(FuelCell::ApplicationCore::FEV
                                                   std::shared_ptr<Function<dim> > initial_function)
 {
     std::shared_ptr< Function<dim> > initial_solution (new FuelCell::InitialSolution::AppPemfcNIThermalIC<dim> (&OC, this->mesh_generator, &this->system_management));
+
+    // Improve the initial solution using the one-dimensional through-plane model:
+    if (this->use_through_plane_solution)
+    {
+        std::shared_ptr< FuelCell::InitialSolution::ThroughPlaneMEAModel<dim> > through_plane_solution
+            (new FuelCell::InitialSolution::ThroughPlaneMEAModel<dim> (&OC, this->mesh_generator, &this->system_management, initial_solution,
+                                                                        AGDL.get(), AMPL.get(), ACL.get(), ML.get(), CCL.get(), CMPL.get(), CGDL.get(),
+                                                                        &oxygen, &nitrogen, this->n_through_plane_cells));
+        through_plane_solution->solve();
+        initial_solution = through_plane_solution;
+    }
     
     DoFApplication<dim>::initialize_solution(initial_guess, initial_solution);
 }
@@ -249,62 +278,70 @@ NAME::AppPemfcNIThermal<dim>::cell_matrix(FuelCell::ApplicationCore::MatrixVecto
     // -- Find out what material is the cell made of, i.e. MEA layer)
     const unsigned int material_id = info.dof_active_cell->material_id();
 
+    // In segregated mode, the equations of the frozen stage are not assembled:
+    const int stage = segregated_stage();
+    const bool isothermal_equations = (stage != 1);
+    const bool thermal_equation = (stage != 0);
+
     //---- Equation Classes -----------------------------------------------------------
     if ( CGDL->belongs_to_material(material_id) )
     {
-        ficks_oxygen_nitrogen.assemble_cell_matrix(cell_matrices, info, CGDL.get());
-        ficks_water_nitrogen.assemble_cell_matrix(cell_matrices, info, CGDL.get());
-        thermal_transport.assemble_cell_matrix(cell_matrices, info, CGDL.get());
-        electron_transport.assemble_cell_matrix(cell_matrices, info, CGDL.get());
+        if (isothermal_equations) ficks_oxygen_nitrogen.assemble_cell_matrix(cell_matrices, info, CGDL.get());
+        if (isothermal_equations) ficks_water_nitrogen.assemble_cell_matrix(cell_matrices, info, CGDL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_matrix(cell_matrices, info, CGDL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_matrix(cell_matrices, info, CGDL.get());
     }
     else if ( CMPL->belongs_to_material(material_id) )
     {
-        ficks_oxygen_nitrogen.assemble_cell_matrix(cell_matrices, info, CMPL.get());
-        ficks_water_nitrogen.assemble_cell_matrix(cell_matrices, info, CMPL.get());
-        thermal_transport.assemble_cell_matrix(cell_matrices, info, CMPL.get());
-        electron_transport.assemble_cell_matrix(cell_matrices, info, CMPL.get());
+        if (isothermal_equations) ficks_oxygen_nitrogen.assemble_cell_matrix(cell_matrices, info, CMPL.get());
+        if (isothermal_equations) ficks_water_nitrogen.assemble_cell_matrix(cell_matrices, info, CMPL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_matrix(cell_matrices, info, CMPL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_matrix(cell_matrices, info, CMPL.get());
     }
     else if ( CCL->belongs_to_material(material_id) )
     {
-        ficks_oxygen_nitrogen.assemble_cell_matrix(cell_matrices, info, CCL.get());
-        ficks_water_nitrogen.assemble_cell_matrix(cell_matrices, info, CCL.get());
-        thermal_transport.assemble_cell_matrix(cell_matrices, info, CCL.get());
-        proton_transport.assemble_cell_matrix(cell_matrices, info, CCL.get());
-        lambda_transport.assemble_cell_matrix(cell_matrices, info, CCL.get());
-        electron_transport.assemble_cell_matrix(cell_matrices, info, CCL.get());
+        if (isothermal_equations) ficks_oxygen_nitrogen.assemble_cell_matrix(cell_matrices, info, CCL.get());
+        if (isothermal_equations) ficks_water_nitrogen.assemble_cell_matrix(cell_matrices, info, CCL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_matrix(cell_matrices, info, CCL.get());
+        if (isothermal_equations) proton_transport.assemble_cell_matrix(cell_matrices, info, CCL.get());
+        if (isothermal_equations) lambda_transport.assemble_cell_matrix(cell_matrices, info, CCL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_matrix(cell_matrices, info, CCL.get());
         reaction_source_terms.assemble_cell_matrix(cell_matrices, info, CCL.get());
         sorption_source_terms.assemble_cell_matrix(cell_matrices, info, CCL.get());
     }
     else if ( ML->belongs_to_material(material_id) )
     {
-        thermal_transport.assemble_cell_matrix(cell_matrices, info, ML.get());
-        proton_transport.assemble_cell_matrix(cell_matrices, info, ML.get());
-        lambda_transport.assemble_cell_matrix(cell_matrices, info, ML.get());
+        if (thermal_equation) thermal_transport.assemble_cell_matrix(cell_matrices, info, ML.get());
+        if (isothermal_equations) proton_transport.assemble_cell_matrix(cell_matrices, info, ML.get());
+        if (isothermal_equations) lambda_transport.assemble_cell_matrix(cell_matrices, info, ML.get());
     }
     else if ( ACL->belongs_to_material(material_id) )
     {
-        ficks_water_hydrogen.assemble_cell_matrix(cell_matrices, info, ACL.get());
-        thermal_transport.assemble_cell_matrix(cell_matrices, info, ACL.get());
-        proton_transport.assemble_cell_matrix(cell_matrices, info, ACL.get());
-        lambda_transport.assemble_cell_matrix(cell_matrices, info, ACL.get());
-        electron_transport.assemble_cell_matrix(cell_matrices, info, ACL.get());
+        if (isothermal_equations) ficks_water_hydrogen.assemble_cell_matrix(cell_matrices, info, ACL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_matrix(cell_matrices, info, ACL.get());
+        if (isothermal_equations) proton_transport.assemble_cell_matrix(cell_matrices, info, ACL.get());
+        if (isothermal_equations) lambda_transport.assemble_cell_matrix(cell_matrices, info, ACL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_matrix(cell_matrices, info, ACL.get());
         reaction_source_terms.assemble_cell_matrix(cell_matrices, info, ACL.get());
         sorption_source_terms.assemble_cell_matrix(cell_matrices, info, ACL.get());
     }
     else if ( AMPL->belongs_to_material(material_id) )
     {
-        ficks_water_hydrogen.assemble_cell_matrix(cell_matrices, info, AMPL.get());
-        thermal_transport.assemble_cell_matrix(cell_matrices, info, AMPL.get());
-        electron_transport.assemble_cell_matrix(cell_matrices, info, AMPL.get());
+        if (isothermal_equations) ficks_water_hydrogen.assemble_cell_matrix(cell_matrices, info, AMPL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_matrix(cell_matrices, info, AMPL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_matrix(cell_matrices, info, AMPL.get());
     }
     else if ( AGDL->belongs_to_material(material_id) )
     {
-        ficks_water_hydrogen.assemble_cell_matrix(cell_matrices, info, AGDL.get());
-        thermal_transport.assemble_cell_matrix(cell_matrices, info, AGDL.get());
-        electron_transport.assemble_cell_matrix(cell_matrices, info, AGDL.get());
+        if (isothermal_equations) ficks_water_hydrogen.assemble_cell_matrix(cell_matrices, info, AGDL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_matrix(cell_matrices, info, AGDL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_matrix(cell_matrices, info, AGDL.get());
     }
     else
         AssertThrow(false, ExcNotImplemented());
+
+    if (segregated)
+        mask_segregated_matrices(cell_matrices);
     }
      
 //---------------------------------------------------------------------------
@@ -321,62 +358,70 @@ NAME::AppPemfcNIThermal<dim>::cell_residual(FuelCell::ApplicationCore::FEVector&
     // -- Find out what material is the cell made of, i.e. MEA layer)
     const unsigned int material_id = info.dof_active_cell->material_id();
 
+    // In segregated mode, the equations of the frozen stage are not assembled:
+    const int stage = segregated_stage();
+    const bool isothermal_equations = (stage != 1);
+    const bool thermal_equation = (stage != 0);
+
     //---- Equation Classes -----------------------------------------------------------
     if ( CGDL->belongs_to_material(material_id) )
     {
-        ficks_oxygen_nitrogen.assemble_cell_residual(cell_vector, info, CGDL.get());
-        ficks_water_nitrogen.assemble_cell_residual(cell_vector, info, CGDL.get());
-        thermal_transport.assemble_cell_residual(cell_vector, info, CGDL.get());
-        electron_transport.assemble_cell_residual(cell_vector, info, CGDL.get());
+        if (isothermal_equations) ficks_oxygen_nitrogen.assemble_cell_residual(cell_vector, info, CGDL.get());
+        if (isothermal_equations) ficks_water_nitrogen.assemble_cell_residual(cell_vector, info, CGDL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_residual(cell_vector, info, CGDL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_residual(cell_vector, info, CGDL.get());
     }
     else if ( CMPL->belongs_to_material(material_id) )
     {
-        ficks_oxygen_nitrogen.assemble_cell_residual(cell_vector, info, CMPL.get());
-        ficks_water_nitrogen.assemble_cell_residual(cell_vector, info, CMPL.get());
-        thermal_transport.assemble_cell_residual(cell_vector, info, CMPL.get());
-        electron_transport.assemble_cell_residual(cell_vector, info, CMPL.get());
+        if (isothermal_equations) ficks_oxygen_nitrogen.assemble_cell_residual(cell_vector, info, CMPL.get());
+        if (isothermal_equations) ficks_water_nitrogen.assemble_cell_residual(cell_vector, info, CMPL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_residual(cell_vector, info, CMPL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_residual(cell_vector, info, CMPL.get());
     }
     else if ( CCL->belongs_to_material(material_id) )
     {
-        ficks_oxygen_nitrogen.assemble_cell_residual(cell_vector, info, CCL.get());
-        ficks_water_nitrogen.assemble_cell_residual(cell_vector, info, CCL.get());
-        thermal_transport.assemble_cell_residual(cell_vector, info, CCL.get());
-        proton_transport.assemble_cell_residual(cell_vector, info, CCL.get());
-        lambda_transport.assemble_cell_residual(cell_vector, info, CCL.get());
-        electron_transport.assemble_cell_residual(cell_vector, info, CCL.get());
+        if (isothermal_equations) ficks_oxygen_nitrogen.assemble_cell_residual(cell_vector, info, CCL.get());
+        if (isothermal_equations) ficks_water_nitrogen.assemble_cell_residual(cell_vector, info, CCL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_residual(cell_vector, info, CCL.get());
+        if (isothermal_equations) proton_transport.assemble_cell_residual(cell_vector, info, CCL.get());
+        if (isothermal_equations) lambda_transport.assemble_cell_residual(cell_vector, info, CCL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_residual(cell_vector, info, CCL.get());
         reaction_source_terms.assemble_cell_residual(cell_vector, info, CCL.get());
         sorption_source_terms.assemble_cell_residual(cell_vector, info, CCL.get());
     }
     else if ( ML->belongs_to_material(material_id) )
     {
-        thermal_transport.assemble_cell_residual(cell_vector, info, ML.get());
-        proton_transport.assemble_cell_residual(cell_vector, info, ML.get());
-        lambda_transport.assemble_cell_residual(cell_vector, info, ML.get());
+        if (thermal_equation) thermal_transport.assemble_cell_residual(cell_vector, info, ML.get());
+        if (isothermal_equations) proton_transport.assemble_cell_residual(cell_vector, info, ML.get());
+        if (isothermal_equations) lambda_transport.assemble_cell_residual(cell_vector, info, ML.get());
     }
     else if ( ACL->belongs_to_material(material_id) )
     {
-        ficks_water_hydrogen.assemble_cell_residual(cell_vector, info, ACL.get());
-        thermal_transport.assemble_cell_residual(cell_vector, info, ACL.get());
-        proton_transport.assemble_cell_residual(cell_vector, info, ACL.get());
-        lambda_transport.assemble_cell_residual(cell_vector, info, ACL.get());
-        electron_transport.assemble_cell_residual(cell_vector, info, ACL.get());
+        if (isothermal_equations) ficks_water_hydrogen.assemble_cell_residual(cell_vector, info, ACL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_residual(cell_vector, info, ACL.get());
+        if (isothermal_equations) proton_transport.assemble_cell_residual(cell_vector, info, ACL.get());
+        if (isothermal_equations) lambda_transport.assemble_cell_residual(cell_vector, info, ACL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_residual(cell_vector, info, ACL.get());
         reaction_source_terms.assemble_cell_residual(cell_vector, info, ACL.get());
         sorption_source_terms.assemble_cell_residual(cell_vector, info, ACL.get());
     }
     else if ( AMPL->belongs_to_material(material_id) )
     {
-        ficks_water_hydrogen.assemble_cell_residual(cell_vector, info, AMPL.get());
-        thermal_transport.assemble_cell_residual(cell_vector, info, AMPL.get());
-        electron_transport.assemble_cell_residual(cell_vector, info, AMPL.get());
+        if (isothermal_equations) ficks_water_hydrogen.assemble_cell_residual(cell_vector, info, AMPL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_residual(cell_vector, info, AMPL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_residual(cell_vector, info, AMPL.get());
     }
     else if ( AGDL->belongs_to_material(material_id) )
     {
-        ficks_water_hydrogen.assemble_cell_residual(cell_vector, info, AGDL.get());
-        thermal_transport.assemble_cell_residual(cell_vector, info, AGDL.get());
-        electron_transport.assemble_cell_residual(cell_vector, info, AGDL.get());
+        if (isothermal_equations) ficks_water_hydrogen.assemble_cell_residual(cell_vector, info, AGDL.get());
+        if (thermal_equation) thermal_transport.assemble_cell_residual(cell_vector, info, AGDL.get());
+        if (isothermal_equations) electron_transport.assemble_cell_residual(cell_vector, info, AGDL.get());
     }
     else
         AssertThrow(false, ExcNotImplemented());
+
+    if (segregated)
+        mask_segregated_residual(cell_vector);
 }
 
 //---------------------------------------------------------------------------
@@ -386,43 +431,51 @@ NAME::AppPemfcNIThermal<dim>::bdry_matrix(FuelCell::ApplicationCore::MatrixVecto
                                                         const typename DoFApplication<dim>::FaceInfo& bdry_info)
 {
     const unsigned int material_id = bdry_info.dof_active_cell->material_id();
+
+    // In segregated mode, the equations of the frozen stage are not assembled:
+    const int stage = segregated_stage();
+    const bool isothermal_equations = (stage != 1);
+    const bool thermal_equation = (stage != 0);
     
     if ( CGDL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CGDL.get());
-        thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CGDL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CGDL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CGDL.get());
     }
     else if ( CMPL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CMPL.get());
-        thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CMPL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CMPL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CMPL.get());
     }
     else if ( CCL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CCL.get());
-        thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CCL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CCL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, CCL.get());
     }
     else if ( ML->belongs_to_material(material_id) )
     {
-        thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, ML.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, ML.get());
     }
     else if ( ACL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, ACL.get());
-        thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, ACL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, ACL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, ACL.get());
     }
     else if ( AMPL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, AMPL.get());
-        thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, AMPL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, AMPL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, AMPL.get());
     }
     else if ( AGDL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, AGDL.get());
-        thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, AGDL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, AGDL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_matrix(bdry_matrices, bdry_info, AGDL.get());
     }
     else
         AssertThrow(false, ExcNotImplemented());
+
+    if (segregated)
+        mask_segregated_matrices(bdry_matrices);
 }
 
 //---------------------------------------------------------------------------
@@ -432,43 +485,131 @@ NAME::AppPemfcNIThermal<dim>::bdry_residual(FuelCell::ApplicationCore::FEVector&
                                                             const typename DoFApplication<dim>::FaceInfo& bdry_info)
 {
     const unsigned int material_id = bdry_info.dof_active_cell->material_id();
+
+    // In segregated mode, the equations of the frozen stage are not assembled:
+    const int stage = segregated_stage();
+    const bool isothermal_equations = (stage != 1);
+    const bool thermal_equation = (stage != 0);
     
     if ( CGDL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, CGDL.get());
-        thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, CGDL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, CGDL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, CGDL.get());
     }
     else if ( CMPL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, CMPL.get());
-        thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, CMPL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, CMPL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, CMPL.get());
     }
     else if ( CCL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, CCL.get());
-        thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, CCL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, CCL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, CCL.get());
     }
     else if ( ML->belongs_to_material(material_id) )
     {
-        thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, ML.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, ML.get());
     }
     else if ( ACL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, ACL.get());
-        thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, ACL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, ACL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, ACL.get());
     }
     else if ( AMPL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, AMPL.get());
-        thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, AMPL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, AMPL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, AMPL.get());
     }
     else if ( AGDL->belongs_to_material(material_id) )
     {
-        electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, AGDL.get());
-        thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, AGDL.get());
+        if (isothermal_equations) electron_transport.assemble_bdry_residual(bdry_vector, bdry_info, AGDL.get());
+        if (thermal_equation) thermal_transport.assemble_bdry_residual(bdry_vector, bdry_info, AGDL.get());
     }
     else
         AssertThrow(false, ExcNotImplemented());
+
+    if (segregated)
+        mask_segregated_residual(bdry_vector);
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+Table<2, DoFTools::Coupling>
+NAME::AppPemfcNIThermal<dim>::matrix_couplings() const
+{
+    Table<2, DoFTools::Coupling> couplings(this->cell_couplings);
+
+    if (segregated)
+        for (unsigned int i = 0; i < couplings.n_rows(); ++i)
+            for (unsigned int j = 0; j < couplings.n_cols(); ++j)
+                if ( (i == thermal_equation_block) != (j == temperature_block) )
+                    couplings(i,j) = DoFTools::none;
+
+    return couplings;
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+std::vector<unsigned int>
+NAME::AppPemfcNIThermal<dim>::stage_blocks() const
+{
+    std::vector<unsigned int> blocks;
+    const int stage = segregated_stage();
+
+    if (stage < 0)
+        return blocks;
+
+    for (unsigned int b = 0; b < this->element->n_blocks(); ++b)
+        if ( static_cast<int>(b == temperature_block) == stage )
+            blocks.push_back(b);
+
+    return blocks;
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+int
+NAME::AppPemfcNIThermal<dim>::segregated_stage() const
+{
+    const double* stage = this->data->scalar("Segregated solve stage");
+
+    if (!segregated || stage == NULL)
+        return -1;
+
+    return static_cast<int>(*stage + 0.5);
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+void
+NAME::AppPemfcNIThermal<dim>::mask_segregated_matrices(FuelCell::ApplicationCore::MatrixVector& matrices) const
+{
+    const int stage = segregated_stage();
+
+    for (unsigned int i = 0; i < matrices.size(); ++i)
+    {
+        const bool thermal_row = (matrices[i].row == thermal_equation_block);
+        const bool thermal_column = (matrices[i].column == temperature_block);
+
+        // Blocks coupling both stages are not in the sparsity pattern. Blocks of the frozen stage are not solved:
+        if ( (thermal_row != thermal_column) || (stage >= 0 && static_cast<int>(thermal_row) != stage) )
+            matrices[i].matrix = 0.;
+    }
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+void
+NAME::AppPemfcNIThermal<dim>::mask_segregated_residual(FuelCell::ApplicationCore::FEVector& vector) const
+{
+    const int stage = segregated_stage();
+
+    if (stage < 0)
+        return;
+
+    for (unsigned int b = 0; b < vector.n_blocks(); ++b)
+        if ( static_cast<int>(b == thermal_equation_block) != stage )
+            vector.block(b) = 0.;
 }
 
 //---------------------------------------------------------------------------
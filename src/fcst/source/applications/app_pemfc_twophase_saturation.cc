@@ -128,11 +128,13 @@ NAME::AppPemfcTPSaturation<dim>::_initialize(ParameterHandler& param)
 
     CCL = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("Cathode catalyst layer", param);
     CCL->set_gases (cathode_gases, OC.get_pc_atm());
+    this->add_assembly_batch(dynamic_cast<FuelCell::ApplicationCore::AssemblyBatch*>(CCL.get()));
     
     ML = FuelCellShop::Layer::MembraneLayer<dim>::create_MembraneLayer("Membrane layer", param);
     
     ACL = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("Anode catalyst layer", param);
     ACL->set_gases (anode_gases, OC.get_pa_atm());
+    this->add_assembly_batch(dynamic_cast<FuelCell::ApplicationCore::AssemblyBatch*>(ACL.get()));
 
     AMPL = FuelCellShop::Layer::MicroPorousLayer<dim>::create_MicroPorousLayer("Anode microporous layer",param);
     AMPL->set_gases (anode_gases, OC.get_pa_atm());
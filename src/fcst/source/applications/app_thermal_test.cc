@@ -227,7 +227,7 @@ NAME::AppThermalTest<dim>::estimate(const FuelCell::ApplicationCore::FEVectors&
                                        this->cell_errors,
                                        comp_mask);
     
-    return 0.0; 
+    return this->cell_errors.l2_norm();
 }
 
 //---------------------------------------------------------------------------
@@ -239,7 +239,7 @@ NAME::AppThermalTest<dim>::data_out(const std::string& basename,
     this->solution_interpretations.clear();
     this->solution_interpretations.resize(this->element->n_blocks(), DataComponentInterpretation::component_is_scalar);
 
-    FcstUtilities::log << "Datafile:" << basename + this->d_out.default_suffix() << std::endl;
+    FcstUtilities::log << "Datafile:" << this->data_out_filename(basename) << std::endl;
     
     // --- data out ---
     DoFApplication<dim>::data_out(basename,
@@ -13,6 +13,7 @@
 
 #include "DAE_solver.h"
 #include <iostream>
+#include <algorithm>
 
 
 using namespace FuelCell::ApplicationCore;
@@ -56,30 +57,176 @@ void FuelCell::ApplicationCore::c_to_for_matrix(int rows, int cols, double ** cm
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
-DAESolver::DAESolver (int m_comp, int ny, int m[], double a, double b, double zeta[],
-	void (*fsub)(double &, double [], double [], double []),
-	void (*dfsub)(double &, double [], double [], double []),
-	void (*gsub)(int &, double [], double &),
-	void (*dgsub)(int &, double [], double []),
-	void (*guess)(double &, double [], double [], double [])):
-	set_zeta(false),
-	set_ltol(false),
-	set_tol(false),
-	linear(false),
-	set_collpnts(false),
-	set_intialmeshsize(false),
-	set_ispace(false),
-	set_fspace(false),
-	use_old_fspace(false),
-	output_level(1),
-	set_fixpnt(false),
-	set_solvercontrol(false),
-	DAE_index(0),
-	use_cont(false)
-
-	//Assign Parameters
+
+thread_local DAEWorkspacePool::Buffers<int> DAEWorkspacePool::integer_buffers;
+thread_local DAEWorkspacePool::Buffers<double> DAEWorkspacePool::float_buffers;
+std::mutex DAEWorkspacePool::statistics_mutex;
+unsigned long DAEWorkspacePool::n_acquired = 0;
+unsigned long DAEWorkspacePool::n_allocated = 0;
+unsigned long DAEWorkspacePool::allocated_bytes = 0;
+int DAEWorkspacePool::peak_ispace_requested = 0;
+int DAEWorkspacePool::peak_fspace_requested = 0;
+int DAEWorkspacePool::peak_ispace_used = 0;
+int DAEWorkspacePool::peak_fspace_used = 0;
+unsigned long DAEWorkspacePool::n_solves = 0;
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+std::map<const T*, std::vector<T> > DAEWorkspacePool::Buffers<T>::lent;
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+T *DAEWorkspacePool::Buffers<T>::acquire(int size)
 {
-	
+	//Every array has at least one entry, so it is identified by its address
+	size = std::max(size, 1);
+
+	//Use the smallest free array that is large enough, otherwise grow the largest free array
+	int best = -1;
+	int largest = -1;
+	for (unsigned int i = 0; i < this->arrays.size(); i++)
+	{
+		const int array_size = this->arrays[i].size();
+		if (array_size >= size && (best < 0 || array_size < int(this->arrays[best].size()))) best = i;
+		if (largest < 0 || array_size > int(this->arrays[largest].size())) largest = i;
+	}
+
+	unsigned long old_bytes = 0;
+	const bool grow = (best < 0);
+	if (grow)
+	{
+		if (largest < 0)
+		{
+			largest = this->arrays.size();
+			this->arrays.push_back(std::vector<T>());
+		}
+		best = largest;
+
+		old_bytes = this->arrays[best].size()*sizeof(T);
+		//Release the old array before allocating the new one
+		std::vector<T>().swap(this->arrays[best]);
+		this->arrays[best].resize(size);
+	}
+
+	//The array is moved to the lent arrays until a solver releases it
+	std::vector<T> array;
+	array.swap(this->arrays[best]);
+	this->arrays.erase(this->arrays.begin() + best);
+	T *space = array.data();
+
+	std::lock_guard<std::mutex> lock(statistics_mutex);
+	if (grow)
+	{
+		n_allocated++;
+		allocated_bytes += size*sizeof(T) - old_bytes;
+	}
+	lent[space].swap(array);
+	return space;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename T>
+void DAEWorkspacePool::Buffers<T>::release(T *space)
+{
+	std::vector<T> array;
+	bool found = false;
+	{
+		std::lock_guard<std::mutex> lock(statistics_mutex);
+		typename std::map<const T*, std::vector<T> >::iterator p = lent.find(space);
+		if (p != lent.end())
+		{
+			array.swap(p->second);
+			lent.erase(p);
+			found = true;
+		}
+	}
+
+	//This is called from the destructor of DAESolver, hence it must not throw
+	if (!found)
+	{
+		std::cerr << "DAEWorkspacePool: the array released was not obtained from the pool, it is left to its owner" << std::endl;
+		return;
+	}
+
+	//The array is kept by the calling thread, which may differ from the thread that acquired it
+	this->arrays.push_back(std::vector<T>());
+	this->arrays.back().swap(array);
+}
+
+//------------------------------------------------------------------------------
+
+int *DAEWorkspacePool::acquire_integer_space(int size)
+{
+	{
+		std::lock_guard<std::mutex> lock(statistics_mutex);
+		n_acquired++;
+		peak_ispace_requested = std::max(peak_ispace_requested, size);
+	}
+	return integer_buffers.acquire(size);
+}
+
+//------------------------------------------------------------------------------
+
+double *DAEWorkspacePool::acquire_float_space(int size)
+{
+	{
+		std::lock_guard<std::mutex> lock(statistics_mutex);
+		n_acquired++;
+		peak_fspace_requested = std::max(peak_fspace_requested, size);
+	}
+	return float_buffers.acquire(size);
+}
+
+//------------------------------------------------------------------------------
+
+void DAEWorkspacePool::release(int *space)
+{
+	integer_buffers.release(space);
+}
+
+//------------------------------------------------------------------------------
+
+void DAEWorkspacePool::release(double *space)
+{
+	float_buffers.release(space);
+}
+
+//------------------------------------------------------------------------------
+
+void DAEWorkspacePool::record_use(int ispace_used, int fspace_used)
+{
+	std::lock_guard<std::mutex> lock(statistics_mutex);
+	n_solves++;
+	peak_ispace_used = std::max(peak_ispace_used, ispace_used);
+	peak_fspace_used = std::max(peak_fspace_used, fspace_used);
+}
+
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+void DAESolver::init(int m_comp, int ny, int m[], double a, double b, double zeta[])
+{
+	this->set_zeta = false;
+	this->set_ltol = false;
+	this->set_tol = false;
+	this->linear = false;
+	this->set_collpnts = false;
+	this->set_intialmeshsize = false;
+	this->set_ispace = false;
+	this->set_fspace = false;
+	this->use_old_fspace = false;
+	this->max_mesh_size = 0;
+	this->output_level = 1;
+	this->set_fixpnt = false;
+	this->set_solvercontrol = false;
+	this->DAE_index = 0;
+	this->use_cont = false;
+	this->use_initial_solution = false;
+	this->fixed_mesh_size = 0;
+
 	//Set info for DAE
 	this->set_prob_size(m_comp,ny,m);
 	
@@ -93,6 +240,17 @@ DAESolver::DAESolver (int m_comp, int ny, int m[], double a, double b, double ze
 			mcomp += this->ODEs_Orders[i];
 	}
 	this->set_side_conditions(mcomp,zeta);
+}
+//------------------------------------------------------------------------------
+
+DAESolver::DAESolver (int m_comp, int ny, int m[], double a, double b, double zeta[],
+	void (*fsub)(double &, double [], double [], double []),
+	void (*dfsub)(double &, double [], double [], double []),
+	void (*gsub)(int &, double [], double &),
+	void (*dgsub)(int &, double [], double []),
+	void (*guess)(double &, double [], double [], double []))
+{
+	this->init(m_comp,ny,m,a,b,zeta);
 
 	//Set the user supplied functions
 	this->set_fsub(fsub);
@@ -100,6 +258,97 @@ DAESolver::DAESolver (int m_comp, int ny, int m[], double a, double b, double ze
 	this->set_gsub(gsub);
 	this->set_dgsub(dgsub);
 	this->set_guess(guess);
+
+	this->context = NULL;
+	this->use_context = false;
+}
+//------------------------------------------------------------------------------
+
+DAESolver::DAESolver (int m_comp, int ny, int m[], double a, double b, double zeta[],
+	void *context,
+	fsub_context_ptr fsub,
+	dfsub_context_ptr dfsub,
+	gsub_context_ptr gsub,
+	dgsub_context_ptr dgsub,
+	guess_context_ptr guess)
+{
+	this->init(m_comp,ny,m,a,b,zeta);
+
+	//COLDAE calls the functions below, which forward the calls with the context
+	this->context = context;
+	this->context_fsub = fsub;
+	this->context_dfsub = dfsub;
+	this->context_gsub = gsub;
+	this->context_dgsub = dgsub;
+	this->context_guess = guess;
+	this->use_context = true;
+
+	this->set_fsub(&DAESolver::context_fsub_call);
+	this->set_dfsub(&DAESolver::context_dfsub_call);
+	this->set_gsub(&DAESolver::context_gsub_call);
+	this->set_dgsub(&DAESolver::context_dgsub_call);
+	if (guess == NULL)
+		this->set_guess(NULL);
+	else
+		this->set_guess(&DAESolver::context_guess_call);
+}
+//------------------------------------------------------------------------------
+
+thread_local DAESolver *DAESolver::active_solver = NULL;
+
+//------------------------------------------------------------------------------
+
+namespace
+{
+	/** Sets the solver being run on this thread and restores the previous one when it goes out of scope */
+	struct ActiveSolverGuard
+	{
+		ActiveSolverGuard(DAESolver *&active_solver, DAESolver *solver):
+			active_solver(active_solver),
+			previous_solver(active_solver)
+		{
+			active_solver = solver;
+		}
+
+		~ActiveSolverGuard()
+		{
+			active_solver = previous_solver;
+		}
+
+		DAESolver *&active_solver;
+		DAESolver *previous_solver;
+	};
+}
+
+//------------------------------------------------------------------------------
+
+void DAESolver::context_fsub_call(double &x, double z[], double y[], double f[])
+{
+	active_solver->context_fsub(active_solver->context, x, z, y, f);
+}
+//------------------------------------------------------------------------------
+
+void DAESolver::context_dfsub_call(double &x, double z[], double y[], double df[])
+{
+	active_solver->context_dfsub(active_solver->context, x, z, y, df);
+}
+//------------------------------------------------------------------------------
+
+void DAESolver::context_gsub_call(int &i, double z[], double &g)
+{
+	active_solver->context_gsub(active_solver->context, i, z, g);
+}
+//------------------------------------------------------------------------------
+
+void DAESolver::context_dgsub_call(int &i, double z[], double dg[])
+{
+	active_solver->context_dgsub(active_solver->context, i, z, dg);
+}
+//------------------------------------------------------------------------------
+
+void DAESolver::context_guess_call(double &x, double z[], double y[], double df[])
+{
+	active_solver->context_guess(active_solver->context, x, z, y, df);
 }
 //------------------------------------------------------------------------------
 
@@ -243,7 +492,7 @@ void DAESolver::set_integer_space(int ispace_size)
 	if(this->set_ispace ==  true)
 	{
 		//FcstUtilities::log << "Cleaning ispace" << std::endl;
-		delete [] this->ispace;
+		DAEWorkspacePool::release(this->ispace);
 		this->set_ispace = false;
 		this->ispace_size = 0;
 	} 
@@ -251,6 +500,13 @@ void DAESolver::set_integer_space(int ispace_size)
 	if(ispace_size > 0)
 	{
 		this->ispace_size = ispace_size;
+		this->max_mesh_size = 0;
+	}
+	else if(this->max_mesh_size > 0)
+	{
+		int nfixi, nsizei, nfixf, nsizef;
+		this->get_workspace_sizes(nfixi, nsizei, nfixf, nsizef);
+		this->ispace_size = nfixi + this->max_mesh_size * nsizei;
 	}
 	else
 	{
@@ -258,7 +514,7 @@ void DAESolver::set_integer_space(int ispace_size)
 		for(int i = 0; i < this->num_ODEs; i ++) mcomp += this->ODEs_Orders[i];
 		this->ispace_size = mcomp * 1000000;
 	}
-	int *tmp_ispace = new int[this->ispace_size];
+	int *tmp_ispace = DAEWorkspacePool::acquire_integer_space(this->ispace_size);
 	this->ispace = tmp_ispace;
 	this->set_ispace = true;
 }
@@ -274,27 +530,38 @@ void DAESolver::set_float_space(int fspace_size, double *fspace)
 	if(this->set_fspace ==  true)
 	{
 		//FcstUtilities::log << "Cleaning fspace" << std::endl;
-		delete [] this->fspace;
+		//An array passed from a previous run belongs to the caller
+		if (!this->use_old_fspace) DAEWorkspacePool::release(this->fspace);
 		this->set_fspace = false;
+		this->use_old_fspace = false;
 		this->fspace_size = 0;
 	} 
 
 	if (fspace != NULL)
 	{
 		this->use_old_fspace=true;
+		this->fspace_size = fspace_size;
 		tmp_fspace = fspace;
 	}
 	else if(fspace_size > 0)
 	{
 		this->fspace_size = fspace_size;
-		tmp_fspace = new double[this->fspace_size];
+		this->max_mesh_size = 0;
+		tmp_fspace = DAEWorkspacePool::acquire_float_space(this->fspace_size);
+	}
+	else if(this->max_mesh_size > 0)
+	{
+		int nfixi, nsizei, nfixf, nsizef;
+		this->get_workspace_sizes(nfixi, nsizei, nfixf, nsizef);
+		this->fspace_size = nfixf + this->max_mesh_size * nsizef;
+		tmp_fspace = DAEWorkspacePool::acquire_float_space(this->fspace_size);
 	}
 	else
 	{
 		int mcomp = 0;
 		for(int i = 0; i < this->num_ODEs; i ++) mcomp += this->ODEs_Orders[i];
 		this->fspace_size = mcomp * 10000000;
-		tmp_fspace = new double[this->fspace_size];
+		tmp_fspace = DAEWorkspacePool::acquire_float_space(this->fspace_size);
 		
 	}
 	this->fspace = tmp_fspace;
@@ -304,6 +571,54 @@ void DAESolver::set_float_space(int fspace_size, double *fspace)
 
 //------------------------------------------------------------------------------
 
+void DAESolver::set_max_mesh_size(int nmax)
+{
+	//The arrays are sized by DAE_solve() from the number of collocation points
+	if(this->set_ispace == true)
+	{
+		DAEWorkspacePool::release(this->ispace);
+		this->set_ispace = false;
+	}
+	if(this->set_fspace == true)
+	{
+		if (!this->use_old_fspace) DAEWorkspacePool::release(this->fspace);
+		this->set_fspace = false;
+		this->use_old_fspace = false;
+	}
+	this->max_mesh_size = nmax;
+}
+
+//------------------------------------------------------------------------------
+
+void DAESolver::get_workspace_sizes(int &nfixi, int &nsizei, int &nfixf, int &nsizef) const
+{
+	int mstar = 0;
+	int mmax = 0;
+	for(int i = 0; i < this->num_ODEs; i ++)
+	{
+		mstar += this->ODEs_Orders[i];
+		mmax = std::max(mmax, this->ODEs_Orders[i]);
+	}
+
+	//Default number of collocation points in COLDAE
+	int k = std::max(mmax + 1, 5 - mmax);
+	if (this->set_collpnts == true && this->collpnts > 0) k = this->collpnts;
+	const int kdy = k * (this->num_ODEs + this->num_Alg_Const);
+
+	//Number of boundary conditions at the right-most boundary point
+	int nrec = 0;
+	for(int i = 0; i < mstar; i ++)
+		if (this->zeta[mstar - 1 - i] >= this->b) nrec = i + 1;
+
+	nfixi = mstar;
+	nsizei = 3 + kdy + mstar;
+	nfixf = nrec * (2*mstar) + 5 * mstar + 3;
+	nsizef = 4 + 3 * mstar + (kdy + 5) * (kdy + mstar) + (2*mstar - nrec) * 2*mstar
+	         + (mstar + this->num_Alg_Const + 2) * this->num_ODEs + kdy;
+}
+
+//------------------------------------------------------------------------------
+
 void DAESolver::set_output(int level)
 {
 	if (level >= -1 && level <= 1) this->output_level = level;
@@ -410,6 +725,22 @@ int DAESolver::DAE_solve(void)
 	if (this->set_fixpnt == false) this->set_fixpnts();
 	if (this->use_cont == false) this->set_ipar();
 
+	//Start from the mesh and coefficients copied by set_initial_solution(), see ipar(9) = 2 in COLDAE
+	if (this->use_initial_solution == true)
+	{
+		this->ipar[8] = 2;
+		this->ipar[2] = this->ispace[0];
+		this->use_initial_solution = false;
+	}
+
+	//Solve on the mesh copied by set_fixed_mesh(), see ipar(8) = 2 in COLDAE
+	if (this->fixed_mesh_size > 0)
+	{
+		this->ipar[7] = 2;
+		this->ipar[2] = this->fixed_mesh_size;
+		this->fixed_mesh_size = 0;
+	}
+
 	//get parameters and arrays
 	int ncomp = this->num_ODEs;
 	int ny = this->num_Alg_Const;
@@ -431,14 +762,28 @@ int DAESolver::DAE_solve(void)
 	guess_ptr guess = this->DAE_guess;
 	dfsub_ptr dfsub = this->DAE_dfsub;
 
-	if (omp_get_thread_num() > 19)
-		std::out_of_range("ptr_DAE_object is out of range, modify to run more threads");
+	//COLDAE keeps its state in common blocks shared by all the solves on a thread, hence a solve
+	//cannot be started from a user-supplied function of another solve
+	if (active_solver != NULL)
+		throw std::logic_error("DAESolver::DAE_solve cannot be called while another solve runs on the same thread");
+
+	{
+		//The functions with a user context find this solver on the calling thread until COLDAE returns or throws
+		ActiveSolverGuard guard(active_solver, this);
+
+		coldae_(ncomp, ny, m, aleft, bright, zeta, ipar, ltol, tol,                  
+	                fixpnt, ispace, fspace, iflag, fsub,                         
+	                 dfsub, gsub, dgsub, guess); 
+	}
 
-	coldae_(ncomp, ny, m, aleft, bright, zeta, ipar, ltol, tol,                  
-                fixpnt, ispace, fspace, iflag, fsub,                         
-                 dfsub, gsub, dgsub, guess); 
+	//Record the part of the work arrays used by the final mesh
+	if (iflag == 1)
+	{
+		int nfixi, nsizei, nfixf, nsizef;
+		this->get_workspace_sizes(nfixi, nsizei, nfixf, nsizef);
+		DAEWorkspacePool::record_use(nfixi + this->ispace[0] * nsizei, nfixf + this->ispace[0] * nsizef);
+	}
 
-             
     return iflag;
 	
 	
@@ -477,12 +822,65 @@ void DAESolver::get_copy_final_mesh (double *mesh)
 	}
 } 
 
+//------------------------------------------------------------------------------
+void DAESolver::get_solution_coefficients (DAESolutionCoefficients &coefficients) const
+{
+	//COLDAE needs ispace(1),...,ispace(8+ncomp) and fspace(1),...,fspace(ispace(8)) to evaluate the solution
+	coefficients.ispace.assign(this->ispace, this->ispace + 8 + this->num_ODEs);
+	coefficients.fspace.assign(this->fspace, this->fspace + this->ispace[7]);
+}
+
+//------------------------------------------------------------------------------
+bool DAESolver::set_initial_solution (const DAESolutionCoefficients &coefficients)
+{
+	if (coefficients.empty()) return false;
+
+	if (this->set_ispace == false) this->set_integer_space();
+	if (this->set_fspace == false) this->set_float_space();
+
+	//The mesh of the former solution must fit in the work arrays
+	int nfixi, nsizei, nfixf, nsizef;
+	this->get_workspace_sizes(nfixi, nsizei, nfixf, nsizef);
+	const int nmax = std::min((this->ispace_size - nfixi)/nsizei, (this->fspace_size - nfixf)/nsizef);
+
+	if (coefficients.ispace.size() != (unsigned int)(8 + this->num_ODEs)
+	    || coefficients.ispace[0] > nmax
+	    || coefficients.fspace.size() > (unsigned int)(this->fspace_size))
+		return false;
+
+	std::copy(coefficients.ispace.begin(), coefficients.ispace.end(), this->ispace);
+	std::copy(coefficients.fspace.begin(), coefficients.fspace.end(), this->fspace);
+	this->use_initial_solution = true;
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+bool DAESolver::set_fixed_mesh (int n_intervals, const double *mesh)
+{
+	if (this->set_ispace == false) this->set_integer_space();
+	if (this->set_fspace == false) this->set_float_space();
+
+	//COLDAE halves the mesh once to estimate the error
+	int nfixi, nsizei, nfixf, nsizef;
+	this->get_workspace_sizes(nfixi, nsizei, nfixf, nsizef);
+	const int nmax = std::min((this->ispace_size - nfixi)/nsizei, (this->fspace_size - nfixf)/nsizef);
+
+	if (n_intervals < 1 || 2*n_intervals > nmax)
+		return false;
+
+	std::copy(mesh, mesh + n_intervals + 1, this->fspace);
+	this->fixed_mesh_size = n_intervals;
+
+	return true;
+}
+
 //------------------------------------------------------------------------------
 
 void  DAESolver::clear_mem(void)
 {
-	delete [] this->ispace;
-	delete [] this->fspace;
+	if (this->set_ispace == true) DAEWorkspacePool::release(this->ispace);
+	if (this->set_fspace == true && !this->use_old_fspace) DAEWorkspacePool::release(this->fspace);
 	delete [] this->ipar;
 }
 
@@ -13,6 +13,7 @@
 
 #include "DAE_wrapper.h"
 #include <cmath>
+#include <limits>
 
 
 
@@ -21,12 +22,11 @@ namespace NAME = FuelCell::ApplicationCore;
 
 
 
-// Must be very careful with this... it is now declared as a global variable within FCST
-// These are the definitions of the pointers required for the DAE_wrapper functions
-void *ptr_DAE_object[20]; //If you modify this please also correct DAESolver:DAE_Solve
-
 //---------------------------------------------------------------------------
 NAME::DAEWrapper::DAEWrapper ()
+:
+sensitivity_parameter(NULL),
+linearization_x(0.0)
 {
 	cm_to_m = 0.01;
 	cm2_to_m2 =  cm_to_m*cm_to_m;
@@ -49,7 +49,7 @@ return 0.5*(ub-lb) * I;
 
 //---------------------------------------------------------------------------
 void
-NAME::DAEWrapper::get_quadrature_points (double lb, double ub, std::vector<double>& X, std::vector<double>& W, FuelCell::ApplicationCore::DAESolver* prob)
+NAME::DAEWrapper::get_quadrature_points (double lb, double ub, std::vector<double>& X, std::vector<double>& W, FuelCell::ApplicationCore::BVPSolver* prob)
 {
 // Find the order of the polynomial defined given by the solution
 int orders = prob->get_ODE_order();
@@ -93,3 +93,218 @@ NAME::DAEWrapper::DAE_Error(int flag)
 				<< "=-3 if there is an input data error.\n" << std::endl;
 		//abort();
 	}
+
+//---------------------------------------------------------------------------
+FuelCell::ApplicationCore::BVPSolver*
+NAME::DAEWrapper::create_BVP_solver (const bool native,
+                                     fsub_context_ptr fsub,
+                                     dfsub_context_ptr dfsub,
+                                     gsub_context_ptr gsub,
+                                     dgsub_context_ptr dgsub,
+                                     guess_context_ptr guess)
+{
+	if (!native)
+		return new DAESolver(n_comp, n_y, mm, boundary_0, boundary_1, zeta, this, fsub, dfsub, gsub, dgsub, guess);
+
+	switch (m_star)
+	{
+		case 1:
+			return new CollocationBVPSolver<1>(n_comp, n_y, mm, boundary_0, boundary_1, zeta, this, fsub, dfsub, gsub, dgsub, guess);
+		case 2:
+			return new CollocationBVPSolver<2>(n_comp, n_y, mm, boundary_0, boundary_1, zeta, this, fsub, dfsub, gsub, dgsub, guess);
+		case 3:
+			return new CollocationBVPSolver<3>(n_comp, n_y, mm, boundary_0, boundary_1, zeta, this, fsub, dfsub, gsub, dgsub, guess);
+		case 4:
+			return new CollocationBVPSolver<4>(n_comp, n_y, mm, boundary_0, boundary_1, zeta, this, fsub, dfsub, gsub, dgsub, guess);
+		case 5:
+			return new CollocationBVPSolver<5>(n_comp, n_y, mm, boundary_0, boundary_1, zeta, this, fsub, dfsub, gsub, dgsub, guess);
+		case 6:
+			return new CollocationBVPSolver<6>(n_comp, n_y, mm, boundary_0, boundary_1, zeta, this, fsub, dfsub, gsub, dgsub, guess);
+		case 7:
+			return new CollocationBVPSolver<7>(n_comp, n_y, mm, boundary_0, boundary_1, zeta, this, fsub, dfsub, gsub, dgsub, guess);
+		case 8:
+			return new CollocationBVPSolver<8>(n_comp, n_y, mm, boundary_0, boundary_1, zeta, this, fsub, dfsub, gsub, dgsub, guess);
+		default:
+			AssertThrow (false, ExcMessage("The native BVP solver is only instantiated for up to 8 unknowns, use COLDAE."));
+	}
+	return NULL;
+}
+
+//---------------------------------------------------------------------------
+FuelCell::ApplicationCore::BVPSolver*
+NAME::DAEWrapper::solve_sensitivity (double &parameter)
+{
+	AssertThrow (n_y == 0 && m_star == n_comp, ExcMessage("The linearized problem is only implemented for first order ODEs without algebraic constraints."));
+
+	//The linearized problem has the same orders and boundary points as the problem in prob, and it is solved with the same solver
+	BVPSolver *sensitivity = create_BVP_solver(dynamic_cast<DAESolver*>(prob) == NULL,
+	                                           &sensitivity_fsub_callback, &sensitivity_dfsub_callback,
+	                                           &sensitivity_gsub_callback, &sensitivity_dgsub_callback);
+
+	const int n_intervals = prob->get_size_final_mesh() - 1;
+	std::vector<double> final_mesh(n_intervals + 1);
+	prob->get_copy_final_mesh(&final_mesh[0]);
+
+	sensitivity->set_linear();
+	sensitivity->set_collocation_points(n_colloc);
+	sensitivity->set_tolerance(n_comp, ltol, tol);
+	sensitivity->set_output(n_output);
+	//Return after the first error estimate, the derivative is not refined any further
+	sensitivity->set_solver_control(2);
+	sensitivity->set_max_mesh_size(2*n_intervals);
+
+	sensitivity_parameter = &parameter;
+	linearization_z.resize(m_star);
+	linearization_df.resize(n_comp*m_star);
+	linearization_dfdp.resize(n_comp);
+	linearization_x = std::numeric_limits<double>::quiet_NaN();
+
+	int flag = 0;
+	if (sensitivity->set_fixed_mesh(n_intervals, &final_mesh[0]))
+		flag = sensitivity->DAE_solve();
+
+	sensitivity_parameter = NULL;
+
+	if (flag != 1)
+	{
+		delete sensitivity;
+		return NULL;
+	}
+
+	return sensitivity;
+}
+
+//---------------------------------------------------------------------------
+bool
+NAME::DAEWrapper::integral_derivative (double &parameter, const double upper, double &derivative)
+{
+	BVPSolver *sensitivity = solve_sensitivity(parameter);
+	if (sensitivity == NULL)
+		return false;
+
+	const int n_points = prob->get_size_final_mesh();
+	std::vector<double> final_mesh(n_points);
+	prob->get_copy_final_mesh(&final_mesh[0]);
+
+	std::vector<double> z(m_star), s(m_star), z_h(m_star), y(n_y + 1);
+	const double p = parameter;
+	const double h = parameter_step(p);
+
+	double I = 0.0;
+	for (int j = 0; (j < n_points - 1) && (final_mesh[j+1] <= upper); ++j)
+	{
+		std::vector<double> x_quad, w_quad;
+		get_quadrature_points(final_mesh[j], final_mesh[j+1], x_quad, w_quad, prob);
+
+		std::vector<double> dF(x_quad.size(), 0.0);
+		for (unsigned int i = 0; i < x_quad.size(); ++i)
+		{
+			prob->DAE_solution(x_quad[i], &z[0], &y[0]);
+			sensitivity->DAE_solution(x_quad[i], &s[0], &y[0]);
+
+			//Derivative of the integrand along the solution, i.e., in the direction (s, 1) of (z, p)
+			for (int k = 0; k < m_star; ++k)
+				z_h[k] = z[k] + h*s[k];
+			parameter = p + h;
+			const double forward = integrand(x_quad[i], &z_h[0]);
+
+			for (int k = 0; k < m_star; ++k)
+				z_h[k] = z[k] - h*s[k];
+			parameter = p - h;
+			const double backward = integrand(x_quad[i], &z_h[0]);
+
+			parameter = p;
+			dF[i] = (forward - backward)/(2.0*h);
+		}
+
+		I += integrate(final_mesh[j], final_mesh[j+1], w_quad, dF);
+	}
+
+	delete sensitivity;
+
+	derivative = I;
+	return true;
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::DAEWrapper::linearize_at (const double &x)
+{
+	if (x == linearization_x)
+		return;
+
+	std::vector<double> y(n_y + 1), f_forward(n_comp), f_backward(n_comp);
+	double x_eval = x;
+
+	prob->DAE_solution(x, &linearization_z[0], &y[0]);
+	dfsub(x_eval, &linearization_z[0], &y[0], &linearization_df[0]);
+
+	const double p = *sensitivity_parameter;
+	const double h = parameter_step(p);
+	*sensitivity_parameter = p + h;
+	fsub(x_eval, &linearization_z[0], &y[0], &f_forward[0]);
+	*sensitivity_parameter = p - h;
+	fsub(x_eval, &linearization_z[0], &y[0], &f_backward[0]);
+	*sensitivity_parameter = p;
+
+	for (int i = 0; i < n_comp; ++i)
+		linearization_dfdp[i] = (f_forward[i] - f_backward[i])/(2.0*h);
+
+	linearization_x = x;
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::DAEWrapper::sensitivity_fsub (double &x, double s[], double f[])
+{
+	linearize_at(x);
+
+	//The Jacobian is stored by columns, see c_to_for_matrix
+	for (int i = 0; i < n_comp; ++i)
+	{
+		f[i] = linearization_dfdp[i];
+		for (int j = 0; j < m_star; ++j)
+			f[i] += linearization_df[i + j*n_comp]*s[j];
+	}
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::DAEWrapper::sensitivity_dfsub (double &x, double df[])
+{
+	linearize_at(x);
+
+	for (unsigned int k = 0; k < linearization_df.size(); ++k)
+		df[k] = linearization_df[k];
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::DAEWrapper::sensitivity_gsub (int &i, double s[], double &g)
+{
+	std::vector<double> z(m_star), y(n_y + 1), dg(m_star);
+	prob->DAE_solution(zeta[i-1], &z[0], &y[0]);
+	dgsub(i, &z[0], &dg[0]);
+
+	const double p = *sensitivity_parameter;
+	const double h = parameter_step(p);
+	double g_forward, g_backward;
+	*sensitivity_parameter = p + h;
+	gsub(i, &z[0], g_forward);
+	*sensitivity_parameter = p - h;
+	gsub(i, &z[0], g_backward);
+	*sensitivity_parameter = p;
+
+	g = (g_forward - g_backward)/(2.0*h);
+	for (int k = 0; k < m_star; ++k)
+		g += dg[k]*s[k];
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::DAEWrapper::sensitivity_dgsub (int &i, double dg[])
+{
+	std::vector<double> z(m_star), y(n_y + 1);
+	prob->DAE_solution(zeta[i-1], &z[0], &y[0]);
+	dgsub(i, &z[0], dg);
+}
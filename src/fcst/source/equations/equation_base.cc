@@ -143,9 +143,7 @@ NAME::EquationBase<dim>::assemble_cell_matrix(FuelCell::ApplicationCore::MatrixV
                                               const typename FuelCell::ApplicationCore::DoFApplication<dim>::CellInfo& cell_info,
                                               FuelCellShop::Layer::BaseLayer<dim>* const              layer)
 {
-    if ((this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::NEWTONBASIC) || 
-        (this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::NEWTON3PP) || 
-        (this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::NEWTONLINESEARCH))
+    if (this->data->is_newton_solver(this->data->get_nonlinear_solver()))
     {
         this->assemble_cell_Jacobian_matrix(cell_matrices, cell_info, layer);
     }
@@ -169,9 +167,7 @@ NAME::EquationBase<dim>::assemble_cell_residual(FuelCell::ApplicationCore::FEVec
                                                 const typename FuelCell::ApplicationCore::DoFApplication<dim>::CellInfo& cell_info,
                                                 FuelCellShop::Layer::BaseLayer<dim>* const              layer)
 {
-    if ((this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::NEWTONBASIC) || 
-        (this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::NEWTON3PP) || 
-        (this->data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::NEWTONLINESEARCH))
+    if (this->data->is_newton_solver(this->data->get_nonlinear_solver()))
     {
         this->assemble_cell_residual_rhs(cell_residual, cell_info, layer);
     }
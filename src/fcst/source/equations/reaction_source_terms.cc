@@ -634,7 +634,7 @@ NAME::ReactionSourceTerms<dim>::make_assemblers_cell_variable_data(const typenam
 
             //------ Setting solution in the catalyst layer -----------------------------------------------
             ptr->set_solution(solution_variables);
-            ptr->set_cell_id(cell_info.dof_active_cell->index());
+            ptr->set_cell(cell_info.dof_active_cell);
             ptr->current_density( current_cell );
 
             //-------- Filling derivatives of source terms for cell_matrix assembly -----------------------
@@ -572,7 +572,7 @@ NAME::ReactionSourceTermsKG<dim>::make_assemblers_cell_variable_data(const typen
             derivative_flags.push_back(VariableNames::protonic_electrical_potential);
             
             ptr->set_solution(solution_variables);
-            ptr->set_cell_id(cell_info.dof_active_cell->index());
+            ptr->set_cell(cell_info.dof_active_cell);
             ptr->current_density( HOR_current_density );
             
             std::map< VariableNames, std::vector<double> > Dcurrent;
@@ -617,7 +617,7 @@ NAME::ReactionSourceTermsKG<dim>::make_assemblers_cell_variable_data(const typen
             derivative_flags.push_back(VariableNames::protonic_electrical_potential);
             
             ptr->set_solution(solution_variables);
-            ptr->set_cell_id(cell_info.dof_active_cell->index());
+            ptr->set_cell(cell_info.dof_active_cell);
             ptr->current_density( ORR_current_density );
             
             std::map< VariableNames, std::vector<double> > Dcurrent;
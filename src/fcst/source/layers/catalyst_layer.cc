@@ -128,6 +128,39 @@ NAME::CatalystLayer<dim>::initialize (ParameterHandler &param)
 
 }
 
+//---------------------------------------------------------------------------
+template <int dim>
+std::vector< FuelCellShop::SolutionVariable >
+NAME::CatalystLayer<dim>::get_solution() const
+{
+    std::vector<SolutionVariable> sols;
+
+    if (this->solutions.empty())
+        return sols;
+
+    // The temperature is always stored by set_solution:
+    const SolutionVariable& T = this->solutions.at(temperature_of_REV);
+
+    for (std::map<VariableNames, SolutionVariable>::const_iterator iter = this->solutions.begin(); iter != this->solutions.end(); ++iter)
+    {
+        // Concentrations are stored in the electrolyte, i.e., they are converted back to the gas phase:
+        if (iter->first == oxygen_concentration || iter->first == hydrogen_concentration)
+        {
+            const double H = (iter->first == oxygen_concentration) ? this->electrolyte->get_H_O2() : this->electrolyte->get_H_H2();
+
+            std::vector<double> c(iter->second.size());
+            for (unsigned int q = 0; q < c.size(); ++q)
+                c[q] = iter->second[q]*(H*1.0e-6)/(Constants::R()*T[q]);
+
+            sols.push_back(SolutionVariable(c, iter->first));
+        }
+        else
+            sols.push_back(iter->second);
+    }
+
+    return sols;
+}
+
 //---------------------------------------------------------------------------
 template <int dim>
 void
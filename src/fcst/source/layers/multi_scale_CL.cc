@@ -15,11 +15,17 @@
 //---------------------------------------------------------------------------
 
 #include <layers/multi_scale_CL.h>
+#include <utils/hybrid_parallelism.h>
+#include <contribs/DAE_solver.h>
+
+#include <functional>
+#include <algorithm>
+#include <chrono>
 
 #ifdef _OPENMP
 #include <omp.h>
 #define PARALLEL 1
-#define agg_threads() 9
+#define agg_threads() FcstUtilities::n_threads()
 #else
 #define omp_get_thread_num() 0
 #define agg_threads() 1
@@ -37,7 +43,12 @@ NAME::MultiScaleCL<dim> const* NAME::MultiScaleCL<dim>::PROTOTYPE =
 //---------------------------------------------------------------------------
 template<int dim>
 NAME::MultiScaleCL<dim>::MultiScaleCL() :
-NAME::ConventionalCL<dim>() 
+NAME::ConventionalCL<dim>(),
+active_cell_index_(numbers::invalid_unsigned_int),
+use_warm_start(false),
+warm_start_tria(NULL),
+use_batch(false),
+batch_state(batch_off)
 {
 
     this->get_mapFactory()->insert(
@@ -48,7 +59,12 @@ NAME::ConventionalCL<dim>()
 //---------------------------------------------------------------------------
 template<int dim>
 NAME::MultiScaleCL<dim>::MultiScaleCL(std::string cl_section_name) :
-NAME::ConventionalCL<dim>(cl_section_name) 
+NAME::ConventionalCL<dim>(cl_section_name),
+active_cell_index_(numbers::invalid_unsigned_int),
+use_warm_start(false),
+warm_start_tria(NULL),
+use_batch(false),
+batch_state(batch_off)
 {
 
 
@@ -57,7 +73,15 @@ NAME::ConventionalCL<dim>(cl_section_name)
 //---------------------------------------------------------------------------
 template<int dim>
 NAME::MultiScaleCL<dim>::~MultiScaleCL() {
+    warm_start_connection.disconnect();
     micro.clear();
+
+    for (std::map<unsigned int, boost::shared_ptr<FuelCellShop::MicroScale::AgglomerateSurrogate>>::const_iterator it = surrogate.begin();
+         it != surrogate.end(); ++it)
+        it->second->print_statistics();
+
+    // Peak use of the work arrays of the numerical agglomerates:
+    FuelCell::ApplicationCore::DAEWorkspacePool::print_statistics(FcstUtilities::log);
 }
 
 //---------------------------------------------------------------------------
@@ -80,6 +104,17 @@ void NAME::MultiScaleCL<dim>::declare_parameters(
                 param.declare_entry("Average current in cell", "false",
                         Patterns::Bool(),
                         "Decide whether to take the average current density in the cell");
+                param.declare_entry("Warm start microscale solves", "false",
+                        Patterns::Bool(),
+                        "Start each microscale solve from the solution at the same quadrature point in the previous assembly. "
+                        "Only used by numerical agglomerates. The solutions are stored for every quadrature point of the layer. "
+                        "Finite difference perturbations start from the stored solution without replacing it, and cell averaged solves are not warm started.");
+                param.declare_entry("Batch microscale solves", "false",
+                        Patterns::Bool(),
+                        "Collect the microscale problems at the quadrature points of all cells and solve them together, longest first, "
+                        "before the cells are assembled. Only supported by AppCathode, AppPemfc, AppPemfcNIThermal and AppPemfcTPSaturation, "
+                        "other applications stop with an error. Not used if the current is averaged in each cell.");
+                FuelCellShop::MicroScale::AgglomerateSurrogate::declare_parameters(param);
             }
             param.leave_subsection();
         }
@@ -101,7 +136,20 @@ void NAME::MultiScaleCL<dim>::initialize(ParameterHandler &param)
             param.enter_subsection(this->concrete_name);
             {
                 average_cell_current = param.get_bool("Average current in cell");
+                use_warm_start = param.get_bool("Warm start microscale solves");
+                use_batch = param.get_bool("Batch microscale solves");
+                batch_state = batch_off;
+                batch_points.clear();
+                clear_point_data();
                 initialize_micro_scale(param);
+
+                // One table per material id, since the microscale structure changes between sub layers:
+                surrogate.clear();
+                for (unsigned int i = 0; i < this->material_ids.size(); ++i)
+                {
+                    surrogate[this->material_ids.at(i)] = boost::shared_ptr<FuelCellShop::MicroScale::AgglomerateSurrogate>(new FuelCellShop::MicroScale::AgglomerateSurrogate());
+                    surrogate[this->material_ids.at(i)]->initialize(param);
+                }
             }
             param.leave_subsection();
         }
@@ -124,7 +172,7 @@ void NAME::MultiScaleCL<dim>::initialize_micro_scale(ParameterHandler &param) {
     //    micro.push_back(FuelCellShop::MicroScale::MicroScaleBase::create_MicroStructure(param,this));
 
     #ifdef _OPENMP
-        FcstUtilities::log << "MultiScaleCL running in OpenMP mode." << std::endl;
+        FcstUtilities::log << "MultiScaleCL running in OpenMP mode with " << agg_threads() << " threads." << std::endl;
     #endif
 
     for(unsigned int i = 0; i < this->material_ids.size(); i++){
@@ -162,12 +210,17 @@ void NAME::MultiScaleCL<dim>::current_density(std::vector<double>& current,
 
     //update_agglomerate_guess();
 
+    AssertThrow(!use_batch || this->batch_registered(),
+                ExcMessage("Batch microscale solves is only supported by applications that register the catalyst layers "
+                           "with DoFApplication::add_assembly_batch()."));
+
     current.clear();
     current.resize(this->solutions[this->reactant].size());
     Er.resize(this->solutions[this->reactant].size());
     coverage_map.clear();
     std::vector<double> coverage_OH(this->solutions[this->reactant].size(), 0.0);
     std::vector<double> coverage_O(this->solutions[this->reactant].size(), 0.0);
+    SolutionMap cell;
 
     if (average_cell_current)
     {
@@ -204,7 +257,8 @@ void NAME::MultiScaleCL<dim>::current_density(std::vector<double>& current,
         averagedSol[electronic_electrical_potential] = SolutionVariable(Vs, 1, electronic_electrical_potential);
         averagedSol[membrane_water_content] = SolutionVariable(lambda_cell, 1, membrane_water_content);
         averagedSol[temperature_of_REV]           = SolutionVariable(t_cell, 1, temperature_of_REV);
-        SolutionMap s = micro_scale_current(averagedSol, 0, 0);
+        // The averaged values do not belong to a quadrature point, hence they are not warm started:
+        SolutionMap s = micro_scale_current(averagedSol, 0, 0, warm_start_none);
         cell_current = s.at(VariableNames::current_density)[0];
         Eff = s.at(VariableNames::CL_effectiveness)[0];
 
@@ -227,11 +281,35 @@ void NAME::MultiScaleCL<dim>::current_density(std::vector<double>& current,
         }
 
     }
+    else if (batch_state == batch_collecting && active_cell_index_ != numbers::invalid_unsigned_int)
+    {
+        // The problems are solved by evaluate(), the current density is zero in the meantime:
+        collect_batch_points(false);
+        std::fill(current.begin(), current.end(), 0.0);
+        std::fill(Er.begin(), Er.end(), 0.0);
+    }
+    else if (batch_point(0) == NULL && micro_scale_batch(this->solutions, 0, cell))
+    {
+        // Closed form microscale models evaluate all quadrature points of the cell at once:
+        for (unsigned int i = 0; i < current.size(); ++i) {
+            current[i] = cell.at(VariableNames::current_density)[i];
+            Er[i] = cell.at(VariableNames::CL_effectiveness)[i];
+            if (cell.has(VariableNames::OH_coverage))
+                coverage_OH[i] = cell.at(VariableNames::OH_coverage)[i];
+
+            if (cell.has(VariableNames::O_coverage))
+                coverage_O[i] = cell.at(VariableNames::O_coverage)[i];
+
+            if (std::isnan(current[i]))
+                current[i] = 0.0;
+        }
+    }
     else
     {
         #pragma omp parallel for  shared(current, Er) num_threads(agg_threads())
         for (unsigned int i = 0; i < current.size(); ++i) {
-            SolutionMap s = micro_scale_current(this->solutions, i, i);
+            const BatchPoint* point = batch_point(i);
+            SolutionMap s = (point != NULL) ? point->answer : micro_scale_current(this->solutions, i, omp_get_thread_num());
             current[i] = s.at(VariableNames::current_density)[0];
             Er[i] = s.at(VariableNames::CL_effectiveness)[0];
             if (s.has(VariableNames::OH_coverage))
@@ -252,11 +330,398 @@ void NAME::MultiScaleCL<dim>::current_density(std::vector<double>& current,
 }
 
 
+//---------------------------------------------------------------------------
+template<int dim>
+void
+NAME::MultiScaleCL<dim>::set_cell(const typename DoFHandler<dim>::active_cell_iterator& cell)
+{
+    set_cell_id(cell->index());
+    active_cell_index_ = cell->active_cell_index();
+
+    if (!use_warm_start && !use_batch)
+        return;
+
+    // The warm starts and batch costs are indexed by active cell, hence they are removed whenever the mesh is refined or changed:
+    const Triangulation<dim>* tria = &cell->get_triangulation();
+    if (tria != warm_start_tria)
+    {
+        warm_start_connection.disconnect();
+        clear_point_data();
+        warm_start_connection = tria->signals.any_change.connect(std::bind(&NAME::MultiScaleCL<dim>::clear_point_data, this));
+        warm_start_tria = tria;
+    }
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+FuelCell::ApplicationCore::DAESolutionCoefficients*
+NAME::MultiScaleCL<dim>::warm_start_at(const unsigned int& sol_index)
+{
+    if (active_cell_index_ == numbers::invalid_unsigned_int)
+        return NULL;
+
+    return warm_start_at(active_cell_index_, sol_index);
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+FuelCell::ApplicationCore::DAESolutionCoefficients*
+NAME::MultiScaleCL<dim>::warm_start_at(const unsigned int& cell_index, const unsigned int& sol_index)
+{
+    if (!use_warm_start)
+        return NULL;
+
+    // std::map does not move its entries on insertion, hence the entry can be used after the lock is released:
+    std::lock_guard<std::mutex> lock(warm_start_mutex);
+    return &warm_starts[std::make_pair(cell_index, sol_index)];
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void
+NAME::MultiScaleCL<dim>::clear_point_data()
+{
+    std::lock_guard<std::mutex> lock(warm_start_mutex);
+    warm_starts.clear();
+    batch_cost.clear();
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+bool
+NAME::MultiScaleCL<dim>::batch_enabled() const
+{
+    return use_batch && !average_cell_current;
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+bool
+NAME::MultiScaleCL<dim>::batch_material(const unsigned int material_id) const
+{
+    return std::find(this->material_ids.begin(), this->material_ids.end(), material_id) != this->material_ids.end();
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void
+NAME::MultiScaleCL<dim>::begin_collect()
+{
+    batch_points.clear();
+    batch_state = batch_collecting;
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void
+NAME::MultiScaleCL<dim>::evaluate()
+{
+    if (batch_state != batch_collecting)
+        return;
+
+    typedef std::pair<unsigned int, unsigned int> Key;
+    typedef typename std::map<Key, BatchPoint>::iterator PointIterator;
+
+    // The microscale objects read the properties of the layer for the current material id, hence the points are
+    // solved one material at a time. Points that were not solved before are assumed to be the most expensive ones:
+    std::map< unsigned int, std::vector< std::pair<double, PointIterator> > > points;
+    for (PointIterator it = batch_points.begin(); it != batch_points.end(); ++it)
+    {
+        typename std::map<Key, double>::const_iterator cost = batch_cost.find(it->first);
+        points[it->second.material_id].push_back(std::make_pair(cost != batch_cost.end() ? cost->second : std::numeric_limits<double>::max(),
+                                                                it));
+    }
+
+    const unsigned int material_id = this->local_material_id_;
+
+    for (typename std::map< unsigned int, std::vector< std::pair<double, PointIterator> > >::iterator m = points.begin(); m != points.end(); ++m)
+    {
+        std::vector< std::pair<double, PointIterator> >& tasks = m->second;
+        std::stable_sort(tasks.begin(), tasks.end(),
+                         [](const std::pair<double, PointIterator>& a, const std::pair<double, PointIterator>& b) { return a.first > b.first; });
+
+        this->set_local_material_id(m->first);
+
+        // Closed form microscale models solve the points of each thread at once:
+        if (batch_micro_scale(0) != NULL)
+        {
+            const unsigned int n_chunks = std::min<unsigned int>(agg_threads(), tasks.size());
+
+            #pragma omp parallel for num_threads(agg_threads())
+            for (unsigned int c = 0; c < n_chunks; ++c)
+            {
+                std::vector<BatchPoint*> chunk;
+                for (unsigned int i = (c*tasks.size())/n_chunks; i < ((c + 1)*tasks.size())/n_chunks; ++i)
+                    chunk.push_back(&tasks[i].second->second);
+
+                solve_batch_points(chunk, omp_get_thread_num());
+            }
+            continue;
+        }
+
+        // Each idle thread takes the next most expensive point:
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(agg_threads())
+        for (unsigned int i = 0; i < tasks.size(); ++i)
+        {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            solve_batch_point(tasks[i].second->first, tasks[i].second->second, omp_get_thread_num());
+            tasks[i].first = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        for (unsigned int i = 0; i < tasks.size(); ++i)
+            batch_cost[tasks[i].second->first] = tasks[i].first;
+    }
+
+    this->local_material_id_ = material_id;
+    batch_state = batch_evaluated;
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void
+NAME::MultiScaleCL<dim>::end_batch()
+{
+    batch_points.clear();
+    batch_state = batch_off;
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void
+NAME::MultiScaleCL<dim>::collect_batch_points(const bool derivatives)
+{
+    for (unsigned int q = 0; q < this->solutions[this->reactant].size(); ++q)
+    {
+        BatchPoint& point = batch_points[std::make_pair(active_cell_index_, q)];
+        point.material_id = this->local_material_id();
+
+        // The solution variables usually point to the data of the cell, hence the values are copied:
+        point.solution.clear();
+        for (std::map<VariableNames, SolutionVariable>::const_iterator it = this->solutions.begin(); it != this->solutions.end(); ++it)
+            point.solution[it->first] = SolutionVariable(it->second[q], 1, it->first);
+
+        if (derivatives)
+        {
+            point.derivatives = true;
+            point.derivative_flags = this->derivative_flags;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+const typename NAME::MultiScaleCL<dim>::BatchPoint*
+NAME::MultiScaleCL<dim>::batch_point(const unsigned int& sol_index) const
+{
+    if (batch_state != batch_evaluated || active_cell_index_ == numbers::invalid_unsigned_int)
+        return NULL;
+
+    typename std::map<std::pair<unsigned int, unsigned int>, BatchPoint>::const_iterator point =
+            batch_points.find(std::make_pair(active_cell_index_, sol_index));
+    if (point == batch_points.end() || point->second.material_id != this->local_material_id()
+        || point->second.solution.size() != this->solutions.size())
+        return NULL;
+
+    // The point is only used if it was recorded with the same solution:
+    for (std::map<VariableNames, SolutionVariable>::const_iterator it = this->solutions.begin(); it != this->solutions.end(); ++it)
+    {
+        std::map<VariableNames, SolutionVariable>::const_iterator recorded = point->second.solution.find(it->first);
+        if (recorded == point->second.solution.end() || recorded->second[0] != it->second[sol_index])
+            return NULL;
+    }
+
+    return &point->second;
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+bool
+NAME::MultiScaleCL<dim>::batch_derivatives(std::map< VariableNames, std::vector<double> >& Dcurrent) const
+{
+    const unsigned int n_q_points = this->solutions.at(this->reactant).size();
+    std::vector<const BatchPoint*> points(n_q_points);
+
+    for (unsigned int j = 0; j < n_q_points; ++j)
+    {
+        points[j] = batch_point(j);
+        if (points[j] == NULL || !points[j]->derivatives || points[j]->derivative_flags != this->derivative_flags)
+            return false;
+    }
+
+    for (unsigned int j = 0; j < n_q_points; ++j)
+        for (unsigned int i = 0; i < this->derivative_flags.size(); ++i)
+            Dcurrent[this->derivative_flags[i]][j] = points[j]->Dcurrent.at(this->derivative_flags[i]);
+
+    return true;
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void
+NAME::MultiScaleCL<dim>::solve_batch_point(const std::pair<unsigned int, unsigned int>& key, BatchPoint& point,
+                                           const unsigned int& thread_index)
+{
+    FuelCell::ApplicationCore::DAESolutionCoefficients* warm_start = warm_start_at(key.first, key.second);
+
+    std::vector< std::vector<double> > gradients;
+    const bool interpolated = surrogate_current(point.solution, 0, thread_index, point.answer,
+                                                point.derivatives ? &gradients : NULL);
+    if (!interpolated)
+        point.answer = micro_scale_solve(point.solution, 0, thread_index, warm_start);
+
+    if (!point.derivatives)
+        return;
+
+    // Derivatives with respect to the reactant, protonic and electronic potentials, computed as in solve_current_derivatives_at_each_node():
+    const VariableNames variables[] = {this->reactant, protonic_electrical_potential, electronic_electrical_potential};
+    std::vector<double> dcurrent(3, 0.0);
+    bool computed = interpolated;
+
+    if (interpolated)
+    {
+        for (unsigned int d = 0; d < 3; ++d)
+            dcurrent[d] = gradients[0][d];
+    }
+    else if (micro.at(point.material_id).at(thread_index)->has_derivatives())
+    {
+        micro.at(point.material_id).at(thread_index)->set_warm_start(warm_start);
+        micro.at(point.material_id).at(thread_index)->set_solution(point.solution, this->reactant, 0);
+        const std::vector<double> dcurrent_micro = micro.at(point.material_id).at(thread_index)->compute_derivative_current();
+        micro.at(point.material_id).at(thread_index)->set_warm_start(NULL);
+
+        // An empty vector means that the derivatives could not be computed, finite differences are used instead:
+        computed = (dcurrent_micro.size() == 3);
+        for (unsigned int d = 0; computed && d < 3; ++d)
+            dcurrent[d] = dcurrent_micro[d]*(1.0 - this->epsilon_V.at(point.material_id));
+    }
+
+    if (!computed)
+    {
+        const double h = 1.0e-4;
+        const double current = point.answer.at(VariableNames::current_density)[0];
+
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+            if (std::find(point.derivative_flags.begin(), point.derivative_flags.end(), variables[d]) == point.derivative_flags.end())
+                continue;
+
+            std::map<VariableNames, SolutionVariable> perturbedSol = point.solution;
+            perturbedSol[variables[d]] = SolutionVariable(point.solution.at(variables[d])[0] + h, 1, variables[d]);
+
+            // The perturbed problem starts from the warm start of the point, but does not replace it:
+            SolutionMap s;
+            if (!surrogate_current(perturbedSol, 0, thread_index, s))
+            {
+                FuelCell::ApplicationCore::DAESolutionCoefficients initial_guess;
+                if (warm_start != NULL)
+                    initial_guess = *warm_start;
+                s = micro_scale_solve(perturbedSol, 0, thread_index, (warm_start != NULL) ? &initial_guess : NULL);
+            }
+
+            dcurrent[d] = (s.at(VariableNames::current_density)[0] - current) / h;
+        }
+    }
+
+    for (unsigned int i = 0; i < point.derivative_flags.size(); ++i)
+    {
+        double value = 0.0;
+        for (unsigned int d = 0; d < 3; ++d)
+            if (point.derivative_flags[i] == variables[d])
+                value = dcurrent[d];
+
+        point.Dcurrent[point.derivative_flags[i]] = std::isnan(value) ? 0.0 : value;
+    }
+}
+
+//---------------------------------------------------------------------------
+template<int dim>
+void
+NAME::MultiScaleCL<dim>::solve_batch_points(const std::vector<BatchPoint*>& points, const unsigned int& thread_index)
+{
+    if (points.empty())
+        return;
+
+    // Solution variables of all points, stored by variable:
+    std::map<VariableNames, std::vector<double> > values;
+    for (unsigned int j = 0; j < points.size(); ++j)
+        for (std::map<VariableNames, SolutionVariable>::const_iterator it = points[j]->solution.begin(); it != points[j]->solution.end(); ++it)
+            values[it->first].push_back(it->second[0]);
+
+    std::map<VariableNames, SolutionVariable> solutionMap;
+    for (std::map<VariableNames, std::vector<double> >::const_iterator it = values.begin(); it != values.end(); ++it)
+    {
+        AssertThrow(it->second.size() == points.size(), ExcMessage("All points of a batch should have the same solution variables."));
+        solutionMap[it->first] = SolutionVariable(it->second, it->first);
+    }
+
+    SolutionMap answer;
+    micro_scale_batch(solutionMap, thread_index, answer);
+
+    const VariableNames outputs[] = {VariableNames::current_density, VariableNames::CL_effectiveness,
+                                     VariableNames::OH_coverage, VariableNames::O_coverage};
+    for (unsigned int j = 0; j < points.size(); ++j)
+    {
+        points[j]->answer = SolutionMap();
+        for (unsigned int i = 0; i < 4; ++i)
+            if (answer.has(outputs[i]))
+                points[j]->answer.push_back(SolutionVariable(answer.at(outputs[i])[j], 1, outputs[i]));
+    }
+
+    // The derivatives are computed for all points if any point requests them:
+    typename std::vector<BatchPoint*>::const_iterator first = std::find_if(points.begin(), points.end(), [](const BatchPoint* point) { return point->derivatives; });
+    if (first == points.end())
+        return;
+
+    std::vector< std::vector<double> > dcurrent;
+    micro_scale_batch_derivatives(solutionMap, thread_index, (*first)->derivative_flags, dcurrent, &answer);
+
+    const VariableNames variables[] = {this->reactant, protonic_electrical_potential, electronic_electrical_potential};
+    for (unsigned int j = 0; j < points.size(); ++j)
+    {
+        if (!points[j]->derivatives)
+            continue;
+
+        for (unsigned int i = 0; i < points[j]->derivative_flags.size(); ++i)
+        {
+            double value = 0.0;
+            for (unsigned int d = 0; d < 3; ++d)
+                if (points[j]->derivative_flags[i] == variables[d])
+                    value = dcurrent[d][j];
+
+            points[j]->Dcurrent[points[j]->derivative_flags[i]] = std::isnan(value) ? 0.0 : value;
+        }
+    }
+}
+
 //---------------------------------------------------------------------------
 template<int dim>
 FuelCellShop::SolutionMap
 NAME::MultiScaleCL<dim>::micro_scale_current(std::map<VariableNames ,SolutionVariable>& solutionMap,
-        const unsigned int& sol_index, const unsigned int& thread_index){
+        const unsigned int& sol_index, const unsigned int& thread_index, const WarmStartMode warm_start_mode){
+
+    SolutionMap answer;
+    if (surrogate_current(solutionMap, sol_index, thread_index, answer))
+        return answer;
+
+    FuelCell::ApplicationCore::DAESolutionCoefficients* warm_start = (warm_start_mode == warm_start_none) ? NULL : warm_start_at(sol_index);
+
+    // The microscale solver replaces the warm start by its solution, so a copy is passed if it should be kept:
+    if (warm_start_mode == warm_start_read && warm_start != NULL)
+    {
+        FuelCell::ApplicationCore::DAESolutionCoefficients initial_guess(*warm_start);
+        return micro_scale_solve(solutionMap, sol_index, thread_index, &initial_guess);
+    }
+
+    return micro_scale_solve(solutionMap, sol_index, thread_index, warm_start);
+}
+
+
+//---------------------------------------------------------------------------
+template<int dim>
+FuelCellShop::SolutionMap
+NAME::MultiScaleCL<dim>::micro_scale_solve(std::map<VariableNames ,SolutionVariable>& solutionMap,
+        const unsigned int& sol_index, const unsigned int& thread_index,
+        FuelCell::ApplicationCore::DAESolutionCoefficients* warm_start){
 
     #ifdef _OPENMP
         unsigned int idx = thread_index;
@@ -265,8 +730,10 @@ NAME::MultiScaleCL<dim>::micro_scale_current(std::map<VariableNames ,SolutionVar
     #endif
 
     //Generate solutions from micro scale
+    micro.at(this->local_material_id()).at(idx)->set_warm_start(warm_start);
     micro.at(this->local_material_id()).at(idx)->set_solution(solutionMap, this->reactant, sol_index);
     SolutionMap answer = micro.at(this->local_material_id()).at(idx)->compute_current();
+    micro.at(this->local_material_id()).at(idx)->set_warm_start(NULL);
 
 
     //Make some additional checks when compiling in debug
@@ -283,6 +750,175 @@ NAME::MultiScaleCL<dim>::micro_scale_current(std::map<VariableNames ,SolutionVar
     return answer;
 }
 
+//---------------------------------------------------------------------------
+template<int dim>
+FuelCellShop::MicroScale::MicroScaleBase*
+NAME::MultiScaleCL<dim>::batch_micro_scale(const unsigned int& thread_index){
+
+    typename std::map<unsigned int, boost::shared_ptr<FuelCellShop::MicroScale::AgglomerateSurrogate>>::const_iterator table =
+            surrogate.find(this->local_material_id());
+    if (table != surrogate.end() && table->second->active())
+        return NULL;
+
+    #ifdef _OPENMP
+        unsigned int idx = thread_index;
+    #else
+        unsigned int idx = 0;
+    #endif
+
+    FuelCellShop::MicroScale::MicroScaleBase* object = micro.at(this->local_material_id()).at(idx).get();
+    return object->has_batch_current() ? object : NULL;
+}
+
+
+//---------------------------------------------------------------------------
+template<int dim>
+bool
+NAME::MultiScaleCL<dim>::micro_scale_batch(const std::map<VariableNames ,SolutionVariable>& solutionMap,
+        const unsigned int& thread_index, SolutionMap& answer){
+
+    FuelCellShop::MicroScale::MicroScaleBase* object = batch_micro_scale(thread_index);
+    if (object == NULL)
+        return false;
+
+    answer = object->compute_current_batch(solutionMap, this->reactant);
+
+    //Make some additional checks when compiling in debug
+    Assert(answer.has(VariableNames::current_density),
+              ExcMessage("Micro scale object does not supply necessary solution for VariableNames::current_density."));
+    Assert(answer.has(VariableNames::CL_effectiveness),
+              ExcMessage("Micro scale object does not supply necessary solution for VariableNames::CL_effectiveness."));
+
+    //Scale Current density
+    SolutionVariable curr = answer.pop(VariableNames::current_density);
+    std::vector<double> scaled(curr.size());
+    for (unsigned int i = 0; i < scaled.size(); ++i)
+        scaled[i] = curr[i]*(1.0 - this->epsilon_V.at(this->local_material_id()));
+    answer.push_back(SolutionVariable(scaled, VariableNames::current_density));
+
+    return true;
+}
+
+
+//---------------------------------------------------------------------------
+template<int dim>
+bool
+NAME::MultiScaleCL<dim>::micro_scale_batch_derivatives(const std::map<VariableNames ,SolutionVariable>& solutionMap,
+        const unsigned int& thread_index, const std::vector<VariableNames>& flags,
+        std::vector< std::vector<double> >& dcurrent, SolutionMap* answer){
+
+    FuelCellShop::MicroScale::MicroScaleBase* object = batch_micro_scale(thread_index);
+    if (object == NULL)
+        return false;
+
+    const unsigned int n_points = solutionMap.at(this->reactant).size();
+
+    if (object->has_derivatives())
+    {
+        dcurrent = object->compute_derivative_current_batch(solutionMap, this->reactant);
+        for (unsigned int d = 0; d < dcurrent.size(); ++d)
+            for (unsigned int j = 0; j < n_points; ++j)
+                dcurrent[d][j] *= (1.0 - this->epsilon_V.at(this->local_material_id()));
+
+        return true;
+    }
+
+    // Forward differences as in solve_current_derivatives_at_each_node(), perturbing all points at once:
+    const double h = 1.0e-4;
+    const VariableNames variables[] = {this->reactant, protonic_electrical_potential, electronic_electrical_potential};
+
+    SolutionMap current;
+    if (answer == NULL)
+    {
+        micro_scale_batch(solutionMap, thread_index, current);
+        answer = &current;
+    }
+
+    dcurrent.assign(3, std::vector<double>(n_points, 0.0));
+    for (unsigned int d = 0; d < 3; ++d)
+    {
+        if (std::find(flags.begin(), flags.end(), variables[d]) == flags.end())
+            continue;
+
+        std::vector<double> perturbed(n_points);
+        for (unsigned int j = 0; j < n_points; ++j)
+            perturbed[j] = solutionMap.at(variables[d])[j] + h;
+
+        std::map<VariableNames, SolutionVariable> perturbedSol = solutionMap;
+        perturbedSol[variables[d]] = SolutionVariable(perturbed, variables[d]);
+
+        SolutionMap s;
+        micro_scale_batch(perturbedSol, thread_index, s);
+
+        for (unsigned int j = 0; j < n_points; ++j)
+            dcurrent[d][j] = (s.at(VariableNames::current_density)[j] - answer->at(VariableNames::current_density)[j]) / h;
+    }
+
+    return true;
+}
+
+
+//---------------------------------------------------------------------------
+template<int dim>
+bool
+NAME::MultiScaleCL<dim>::surrogate_current(std::map<VariableNames ,SolutionVariable>& solutionMap,
+        const unsigned int& sol_index, const unsigned int& thread_index,
+        SolutionMap& answer, std::vector< std::vector<double> >* gradients){
+
+    typename std::map<unsigned int, boost::shared_ptr<FuelCellShop::MicroScale::AgglomerateSurrogate>>::iterator table =
+            surrogate.find(this->local_material_id());
+    if (table == surrogate.end() || !table->second->active())
+        return false;
+
+    // Inputs of the table, see FuelCellShop::MicroScale::AgglomerateSurrogate. Inputs missing in the solution are set to
+    // the lower bound of their range, i.e., the table is only used if their range is a single value.
+    const VariableNames inputs[] = {this->reactant, protonic_electrical_potential, electronic_electrical_potential,
+                                    membrane_water_content, temperature_of_REV};
+    const VariableNames outputs[] = {VariableNames::current_density, VariableNames::CL_effectiveness,
+                                     VariableNames::OH_coverage, VariableNames::O_coverage};
+
+    std::vector<double> x(5, 0.0);
+    std::vector<bool> present(5, false);
+    for (unsigned int d = 0; d < 5; ++d)
+    {
+        std::map<VariableNames ,SolutionVariable>::const_iterator it = solutionMap.find(inputs[d]);
+        present[d] = (it != solutionMap.end());
+        x[d] = present[d] ? it->second[sol_index] : table->second->lower_bound(d);
+    }
+
+    // Microscale solve at a point of the table, performed by this thread using its own microscale object:
+    FuelCellShop::MicroScale::AgglomerateSurrogate::Model model = [&](const std::vector<double>& point) {
+        std::map<VariableNames, SolutionVariable> pointSol;
+        for (unsigned int d = 0; d < 5; ++d)
+            if (present[d])
+                pointSol[inputs[d]] = SolutionVariable(point[d], 1, inputs[d]);
+
+        SolutionMap s = micro_scale_solve(pointSol, 0, thread_index);
+
+        // Values of the outputs followed by flags stating whether the microscale supplied them. The flags are interpolated as well,
+        // hence boxes where the outputs supplied change fail the tolerances and are not used:
+        std::vector<double> values(8, 0.0);
+        for (unsigned int i = 0; i < 4; ++i)
+            if (s.has(outputs[i]))
+            {
+                values[i] = s.at(outputs[i])[0];
+                values[4 + i] = 1.0;
+            }
+        return values;
+    };
+
+    std::vector<double> values;
+    if (!table->second->value(x, model, values, gradients))
+        return false;
+
+    answer = SolutionMap();
+    for (unsigned int i = 0; i < 4; ++i)
+        if (values[4 + i] > 0.5)
+            answer.push_back(SolutionVariable(values[i], 1, outputs[i]));
+
+    return true;
+}
+
 
 //---------------------------------------------------------------------------
 template<int dim>
@@ -347,21 +983,28 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_average(
     unsigned int location_phi_m = 0;
     unsigned int location_phi_s = 0;
 
+    // An empty vector means that the microscale model could not compute the derivatives, finite differences are used instead:
+    bool computed = false;
     if (micro.at(this->local_material_id()).at(0)->has_derivatives()) {
         micro.at(this->local_material_id()).at(0)->set_solution(averagedSol.at(0), this->reactant, 0);
-        dcurrent_cell = micro.at(this->local_material_id()).at(0)->compute_derivative_current(); //Derivatives are in the order x02, phi_s, phi_m
-        VariableNames name;
+        dcurrent_cell = micro.at(this->local_material_id()).at(0)->compute_derivative_current(); //Derivatives are in the order x02, phi_m, phi_s
+        computed = (dcurrent_cell.size() == 3);
+    }
+
+    if (computed) {
         for (unsigned int i = 0; i < this->derivative_flags.size(); ++i) {
-           if(i==0)
-               name = this->reactant;
-           else if(i==1)
-               name = protonic_electrical_potential;
-           else if(i==2)
-               name = electronic_electrical_potential;
+           const VariableNames name = this->derivative_flags[i];
+           double dcurrent_name = 0.0;
+           if (name == this->reactant)
+               dcurrent_name = dcurrent_cell[0];
+           else if (name == protonic_electrical_potential)
+               dcurrent_name = dcurrent_cell[1];
+           else if (name == electronic_electrical_potential)
+               dcurrent_name = dcurrent_cell[2];
 
            #pragma omp parallel for  shared(Dcurrent) num_threads(agg_threads())
            for (unsigned int j = 0; j < this->solutions[this->reactant].size(); ++j) {
-               Dcurrent[name][j] = dcurrent_cell[i] * (1.0 - this->epsilon_V.at(this->local_material_id())); //*(x_O2[j]/x);//*(kinetics_dcurrent[i][j]/ave_dcurrent[i]);// / Dcurrent[i].size();
+               Dcurrent[name][j] = dcurrent_name * (1.0 - this->epsilon_V.at(this->local_material_id())); //*(x_O2[j]/x);//*(kinetics_dcurrent[i][j]/ave_dcurrent[i]);// / Dcurrent[i].size();
                if (std::isnan(Dcurrent[name][j]))
                    Dcurrent[name][j] = 0.0;
            }
@@ -375,20 +1018,20 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_average(
             if (this->derivative_flags[i] == this->reactant) {
 
                 //Forward pertubation
-                averagedSol.at(i%agg_threads())[this->reactant] =
+                averagedSol.at(omp_get_thread_num())[this->reactant] =
                         SolutionVariable(x_R_h,1,this->reactant);
-                SolutionMap s = micro_scale_current(averagedSol.at(i%agg_threads()), 0, i);
+                SolutionMap s = micro_scale_current(averagedSol.at(omp_get_thread_num()), 0, omp_get_thread_num(), warm_start_none);
                 double Dcurrent_node = s.at(VariableNames::current_density)[0];
 
                 //Backward pertubation
-                averagedSol.at(i%agg_threads())[this->reactant] =
+                averagedSol.at(omp_get_thread_num())[this->reactant] =
                         SolutionVariable(x_R_h2,1,this->reactant);
 
-                s = micro_scale_current(averagedSol.at(i%agg_threads()), 0 ,i);
+                s = micro_scale_current(averagedSol.at(omp_get_thread_num()), 0, omp_get_thread_num(), warm_start_none);
                 cell_current = s.at(VariableNames::current_density)[0];
 
                 //Set value back to default averaged value
-                averagedSol.at(i%agg_threads())[this->reactant]=
+                averagedSol.at(omp_get_thread_num())[this->reactant]=
                         SolutionVariable(x_R,1,this->reactant);
 
                 for (unsigned int j = 0; j < this->solutions[this->reactant].size(); ++j) {
@@ -403,20 +1046,20 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_average(
 
 
                 //Forward pertubation
-                averagedSol.at(i%agg_threads())[electronic_electrical_potential] =
+                averagedSol.at(omp_get_thread_num())[electronic_electrical_potential] =
                         SolutionVariable(Vs_h, 1,electronic_electrical_potential);
 
-                SolutionMap s = micro_scale_current(averagedSol.at(i%agg_threads()), 0, i );
+                SolutionMap s = micro_scale_current(averagedSol.at(omp_get_thread_num()), 0, omp_get_thread_num(), warm_start_none);
                 double Dcurrent_node = s.at(VariableNames::current_density)[0];
 
                 //Backward pertubation
-                averagedSol.at(i%agg_threads())[electronic_electrical_potential] =
+                averagedSol.at(omp_get_thread_num())[electronic_electrical_potential] =
                         SolutionVariable(Vs_h2, 1,electronic_electrical_potential);
 
-                s = micro_scale_current(averagedSol.at(i%agg_threads()), 0, i);
+                s = micro_scale_current(averagedSol.at(omp_get_thread_num()), 0, omp_get_thread_num(), warm_start_none);
                 cell_current = s.at(VariableNames::current_density)[0];
                 //Set value back to default averaged value
-                averagedSol.at(i%agg_threads())[electronic_electrical_potential] =
+                averagedSol.at(omp_get_thread_num())[electronic_electrical_potential] =
                         SolutionVariable(Vs, 1,electronic_electrical_potential);
 
 
@@ -460,6 +1103,54 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_at_each_node(
 
     double Er_dummy;
 
+    // Derivatives of the surrogate table, used if all quadrature points are interpolated:
+    if (surrogate.count(this->local_material_id()) && surrogate.at(this->local_material_id())->active()) {
+        bool interpolated = true;
+
+        #pragma omp parallel for  shared(Dcurrent) reduction(&&:interpolated) num_threads(agg_threads())
+        for (unsigned int j = 0; j < this->solutions[this->reactant].size(); ++j) {
+            SolutionMap s;
+            std::vector< std::vector<double> > gradients;
+            if (!surrogate_current(this->solutions, j, omp_get_thread_num(), s, &gradients)) {
+                interpolated = false;
+                continue;
+            }
+
+            // Inputs of the table are the reactant, protonic and electronic potentials, membrane water content and temperature:
+            for (unsigned int i = 0; i < this->derivative_flags.size(); ++i) {
+                if (this->derivative_flags[i] == this->reactant)
+                    Dcurrent[this->reactant][j] = gradients[0][0];
+                else if (this->derivative_flags[i] == protonic_electrical_potential)
+                    Dcurrent[protonic_electrical_potential][j] = gradients[0][1];
+                else if (this->derivative_flags[i] == electronic_electrical_potential)
+                    Dcurrent[electronic_electrical_potential][j] = gradients[0][2];
+                else
+                    Dcurrent[this->derivative_flags[i]][j] = 0.0;
+            }
+        }
+
+        if (interpolated)
+            return;
+    }
+
+    // Closed form microscale models differentiate all quadrature points of the cell at once:
+    std::vector< std::vector<double> > dcurrent_cell;
+    if (micro_scale_batch_derivatives(this->solutions, 0, this->derivative_flags, dcurrent_cell)) {
+        const VariableNames variables[] = {this->reactant, protonic_electrical_potential, electronic_electrical_potential};
+
+        for (unsigned int j = 0; j < this->solutions[this->reactant].size(); ++j) {
+            for (unsigned int i = 0; i < this->derivative_flags.size(); ++i) {
+                double value = 0.0;
+                for (unsigned int d = 0; d < 3; ++d)
+                    if (this->derivative_flags[i] == variables[d])
+                        value = dcurrent_cell[d][j];
+
+                Dcurrent[this->derivative_flags[i]][j] = std::isnan(value) ? 0.0 : value;
+            }
+        }
+        return;
+    }
+
     if (micro.at(this->local_material_id()).at(0)->has_derivatives()) {
         #pragma omp parallel for  shared(Dcurrent) num_threads(agg_threads())
         for (unsigned int j = 0; j < this->solutions[this->reactant].size(); ++j) {
@@ -467,11 +1158,20 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_at_each_node(
 
 
             #ifdef _OPENMP
-            idx = j;
+            idx = omp_get_thread_num();
             #endif
 
+            // Numerical agglomerates solve the problem again before linearizing it, starting from the solution of the last assembly:
+            micro.at(this->local_material_id()).at(idx)->set_warm_start(warm_start_at(j));
             micro.at(this->local_material_id()).at(idx)->set_solution(this->solutions, this->reactant, j);
             std::vector<double> dcurrent_q_point = micro.at(this->local_material_id()).at(idx)->compute_derivative_current();
+            micro.at(this->local_material_id()).at(idx)->set_warm_start(NULL);
+
+            // The microscale problem or its linearization failed at this point:
+            if (dcurrent_q_point.size() != 3) {
+                solve_current_derivatives_fd_at_node(j, idx, Dcurrent);
+                continue;
+            }
             for (unsigned int i = 0; i < this->derivative_flags.size(); ++i) {
                 if (this->derivative_flags[i] == this->reactant)
                     Dcurrent[this->reactant][j] = dcurrent_q_point[0]
@@ -497,7 +1197,7 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_at_each_node(
         #pragma omp parallel for  shared(cell_current,x_R_h,phi_m_h,phi_s_h)  num_threads(agg_threads())
         for (unsigned int j = 0; j < this->solutions[this->reactant].size(); ++j) {
             //Compute mid points
-            SolutionMap s = micro_scale_current(this->solutions, j, j);
+            SolutionMap s = micro_scale_current(this->solutions, j, omp_get_thread_num());
             cell_current[j] = s.at(VariableNames::current_density)[0];
 
             //Fill Forward Pertubations
@@ -518,7 +1218,7 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_at_each_node(
                 for (unsigned int j = 0; j < this->solutions[this->reactant].size(); ++j) {
                     //Compute forward point for Oxygen_molar_fraction
 
-                    SolutionMap s = micro_scale_current(perturbedSol, j, j);
+                    SolutionMap s = micro_scale_current(perturbedSol, j, omp_get_thread_num(), warm_start_read);
                     double Dcurrent_node = s.at(VariableNames::current_density)[0];
 
                     //Compute Derivative
@@ -537,7 +1237,7 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_at_each_node(
                 #pragma omp parallel for  shared(Dcurrent) num_threads(agg_threads())
                 for (unsigned int j = 0; j < this->solutions[protonic_electrical_potential].size(); ++j) {
                     //Compute forward point for Protonic_electrical_potential
-                    SolutionMap s = micro_scale_current(perturbedSol, j, j);
+                    SolutionMap s = micro_scale_current(perturbedSol, j, omp_get_thread_num(), warm_start_read);
                     double Dcurrent_node = s.at(VariableNames::current_density)[0];
 
                     //Compute Derivative
@@ -555,7 +1255,7 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_at_each_node(
                 #pragma omp parallel for  shared(Dcurrent) num_threads(agg_threads())
                 for (unsigned int j = 0; j < this->solutions[electronic_electrical_potential].size(); ++j) {
                     //Compute forward point for Electronic_electrical_potential
-                    SolutionMap s = micro_scale_current(perturbedSol, j, j);
+                    SolutionMap s = micro_scale_current(perturbedSol, j, omp_get_thread_num(), warm_start_read);
                     double Dcurrent_node = s.at(VariableNames::current_density)[0];
 
                     //Compute Derivative
@@ -570,6 +1270,37 @@ void NAME::MultiScaleCL<dim>::solve_current_derivatives_at_each_node(
 }
 
 
+//---------------------------------------------------------------------------
+template<int dim>
+void NAME::MultiScaleCL<dim>::solve_current_derivatives_fd_at_node(const unsigned int& sol_index, const unsigned int& thread_index,
+        std::map< VariableNames, std::vector<double> >& Dcurrent) {
+
+    const double h = 1.0e-4; //Same step as in solve_current_derivatives_at_each_node
+    SolutionMap s = micro_scale_current(this->solutions, sol_index, thread_index);
+    const double current = s.at(VariableNames::current_density)[0];
+
+    for (unsigned int i = 0; i < this->derivative_flags.size(); ++i) {
+        const VariableNames name = this->derivative_flags[i];
+        Dcurrent[name][sol_index] = 0.0;
+
+        if (name != this->reactant && name != protonic_electrical_potential && name != electronic_electrical_potential)
+            continue;
+
+        std::vector<double> values(this->solutions[name].size());
+        for (unsigned int j = 0; j < values.size(); ++j)
+            values[j] = this->solutions[name][j];
+        values[sol_index] += h;
+
+        std::map<VariableNames, SolutionVariable > perturbedSol = this->solutions;
+        perturbedSol[name] = SolutionVariable(values, name);
+
+        s = micro_scale_current(perturbedSol, sol_index, thread_index, warm_start_read);
+        const double value = (s.at(VariableNames::current_density)[0] - current) / h;
+        Dcurrent[name][sol_index] = std::isnan(value) ? 0.0 : value;
+    }
+}
+
+
 //---------------------------------------------------------------------------
 template<int dim>
 void NAME::MultiScaleCL<dim>::derivative_current_density(
@@ -585,7 +1316,9 @@ void NAME::MultiScaleCL<dim>::derivative_current_density(
 
     if (average_cell_current)
         solve_current_derivatives_average(Dcurrent);
-    else
+    else if (batch_state == batch_collecting && active_cell_index_ != numbers::invalid_unsigned_int)
+        collect_batch_points(true);     // The derivatives are zero until evaluate() is called
+    else if (!batch_derivatives(Dcurrent))
         solve_current_derivatives_at_each_node(Dcurrent);
 
 }
@@ -164,6 +164,12 @@ NAME::ICCP::compute_current()
         sols.push_back(SolutionVariable(0, 1, current_density));
         sols.push_back(SolutionVariable(0,1, CL_effectiveness));
 
+        //Zero coverages, as returned by compute_current_batch at these points
+        if(this->kinetics->has_coverage(OH_coverage))
+            sols.push_back(SolutionVariable(0,1, OH_coverage));
+        if(this->kinetics->has_coverage(O_coverage))
+            sols.push_back(SolutionVariable(0,1, O_coverage));
+
         return sols; //To stabalize FEM solution
     }
 
@@ -244,6 +250,165 @@ NAME::ICCP::compute_current()
 
 }
 
+//---------------------------------------------------------------------------
+FuelCellShop::SolutionMap
+NAME::ICCP::compute_current_batch(const std::map<VariableNames,SolutionVariable>& sols, const VariableNames& react)
+{
+    //Checks, reactant and properties at the first point
+    set_solution(sols, react, 0);
+
+    const SolutionVariable& T = sols.at(temperature_of_REV);
+    const SolutionVariable& x_R = sols.at(react);
+    const unsigned int n_points = x_R.size();
+
+    //The electrolyte properties are only evaluated again if the temperature changes
+    std::vector<double> c_outer(n_points, 0.0);
+    std::vector<double> D_R(n_points, 0.0);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        if (i > 0 && T[i] != T[i-1])
+        {
+            electrolyte->set_T(T[i]);
+            if (reactant == oxygen_concentration)
+            {
+                electrolyte->oxygen_diffusivity(D_R_N);
+                H_R_N = electrolyte->get_H_O2();
+            }
+            else
+            {
+                electrolyte->hydrogen_diffusivity(D_R_N);
+                H_R_N = electrolyte->get_H_H2();
+            }
+        }
+
+        D_R[i] = D_R_N;
+        c_outer[i] = (react == reactant) ? x_R[i] : x_R[i]*(P/H_R_N);
+    }
+
+    //Get surface reaction rate
+    std::vector<double> J_ideal(n_points, 0.0);
+    std::vector<SolutionVariable> temp_react;
+    temp_react.push_back(SolutionVariable(c_outer, reactant));
+    kinetics->set_reactant_concentrations(temp_react);
+    kinetics->set_electrolyte_potential(sols.at(protonic_electrical_potential));
+    kinetics->set_solid_potential(sols.at(electronic_electrical_potential));
+    kinetics->set_temperature(T);
+    kinetics->current_density(J_ideal);
+    std::vector<double> J(J_ideal);
+
+    if(delta_agg > 0.0){
+        //Newton loop of compute_current for all points together. A point is no longer updated once it has
+        //converged, hence it takes the same steps as in compute_current. Points without reactant are skipped.
+        std::vector<double> c_inner(c_outer);
+        std::vector<double> c_plus(n_points), c_minus(n_points);
+        std::vector<double> f_x, f_plus, f_minus;
+        std::vector<bool> active(n_points);
+        const double perc_change = 1.0e-5;
+        unsigned int loops = 0;
+
+        residual(c_inner, c_outer, D_R, f_x);
+
+        while(true)
+        {
+            bool converged = true;
+            for (unsigned int i = 0; i < n_points; ++i)
+            {
+                active[i] = (c_outer[i] > 0.0) && (std::abs(f_x[i]) > 1e-12);
+                converged = converged && !active[i];
+            }
+
+            if (converged)
+                break;
+
+            for (unsigned int i = 0; i < n_points; ++i)
+            {
+                c_plus[i] = c_inner[i]*(1.0+perc_change);
+                c_minus[i] = c_inner[i]*(1.0-perc_change);
+            }
+            residual(c_plus, c_outer, D_R, f_plus);
+            residual(c_minus, c_outer, D_R, f_minus);
+
+            for (unsigned int i = 0; i < n_points; ++i)
+            {
+                if (!active[i])
+                    continue;
+
+                const double f_x_ = (f_plus[i] - f_minus[i])/(2.0*perc_change*c_inner[i]); //First derivative
+
+                double step_factor = 1.0;
+
+                // Apply over-relaxation for first 10 steps
+                if (loops < 20)
+                    step_factor *= 0.05*loops;
+
+                while(c_inner[i] - step_factor*(f_x[i]/f_x_) < 0.0)
+                {
+                    //if the step will take c_inner below 0 then reduce it
+                    step_factor /=2.0;
+
+                    if(step_factor < 1e-5) //Something has gone really wrong...
+                    {
+                        FcstUtilities::log<<"ICCP inner CO2 value failed to converge (Step reduction loop). Residual is "<<std::abs(f_x[i])<<" C_inner is "<<c_inner[i]<<std::endl;
+                        AssertThrow (false, ExcMessage ("ICCP inner CO2 value failed to converge (Step reduction loop)."));
+                    }
+                }
+
+                c_inner[i] -= step_factor*(f_x[i]/f_x_);
+            }
+
+            //The residual of the points that have already converged is evaluated again at the same concentration
+            residual(c_inner, c_outer, D_R, f_x);
+
+            if(loops++ > 2000) {
+                FcstUtilities::log<<"ICCP inner CO2 value failed to converge for a batch of "<<n_points<<" points."<<std::endl;
+                AssertThrow (false, ExcMessage ("ICCP inner CO2 value failed to converge."));
+            }
+        }
+
+        //CO_2 inner solved, get current density
+        temp_react.clear();
+        temp_react.push_back(SolutionVariable(c_inner, reactant));
+        kinetics->set_reactant_concentrations(temp_react);
+        kinetics->current_density(J);
+    }
+
+    const double volume = (4.0/3.0)*pi*std::pow(r_agg,3.0);
+    std::vector<double> current(n_points, 0.0);
+    std::vector<double> effectiveness(n_points, 0.0);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        if(c_outer[i] <= 0.0)
+            continue; //To stabalize FEM solution
+
+        current[i] = J[i]*ActiveArea/volume;
+        effectiveness[i] = J[i]/J_ideal[i];
+    }
+
+    SolutionMap sols_out;
+    sols_out.push_back(SolutionVariable(current, current_density));
+    sols_out.push_back(SolutionVariable(effectiveness, CL_effectiveness));
+
+    if(this->kinetics->has_coverage(OH_coverage)){
+        std::vector<double> OH_c;
+        this->kinetics->OH_coverage(OH_c);
+        for (unsigned int i = 0; i < n_points; ++i)
+            if (c_outer[i] <= 0.0)
+                OH_c[i] = 0.0;
+        sols_out.push_back(SolutionVariable(OH_c,OH_coverage));
+    }
+
+    if(this->kinetics->has_coverage(O_coverage)){
+        std::vector<double> O_c;
+        this->kinetics->O_coverage(O_c);
+        for (unsigned int i = 0; i < n_points; ++i)
+            if (c_outer[i] <= 0.0)
+                O_c[i] = 0.0;
+        sols_out.push_back(SolutionVariable(O_c,O_coverage));
+    }
+
+    return sols_out;
+}
+
 
 //---------------------------------------------------------------------------
 double
@@ -273,6 +438,32 @@ NAME::ICCP::residual(const double & c_inner, const double & c_outer){
     return answer;
 }
 
+//---------------------------------------------------------------------------
+void
+NAME::ICCP::residual(const std::vector<double> & c_inner, const std::vector<double> & c_outer,
+                     const std::vector<double> & D_R, std::vector<double> & answer){
+
+    std::vector<double> J(c_inner.size(), 0.0);
+    std::vector<SolutionVariable> temp_react;
+    temp_react.push_back(SolutionVariable(c_inner, reactant));
+    kinetics->set_reactant_concentrations(temp_react);
+    kinetics->current_density(J);
+
+    answer.resize(c_inner.size());
+    for (unsigned int i = 0; i < c_inner.size(); ++i)
+    {
+        const double b = (delta_agg/(r_agg*(r_agg+delta_agg)))*((J[i]*ActiveArea)/(4*molarNumerator*F*pi*D_R[i]));
+
+        if (non_eq_BC)
+        {
+            const double a = ((J[i]*ActiveArea)/(4*molarNumerator*F*pi*std::pow(r_agg + delta_agg,2.0)*non_eq_BC_coeff));
+            answer[i] = c_inner[i] + a + b - c_outer[i];
+        }
+        else
+            answer[i] = c_inner[i] - c_outer[i] + b;
+    }
+}
+
 
 //---------------------------------------------------------------------------
 void
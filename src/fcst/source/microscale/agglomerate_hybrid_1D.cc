@@ -12,11 +12,6 @@
 //---------------------------------------------------------------------------
 
 #include <microscale/agglomerate_hybrid_1D.h>
-#ifdef _OPENMP
-	#include <omp.h>
-#else
-	#define omp_get_thread_num() 0
-#endif
 
 
 namespace NAME = FuelCellShop::MicroScale;
@@ -251,22 +246,6 @@ NAME::HybridAgglomerate::dfsub(double &x, double z[], double [], double df[])
 
 
 
-//---------------------------------------------------------------------------
-void
-NAME::HybridAgglomerate::fsub_wrapper (double &x, double z[], double y[], double f[])
-{
-	HybridAgglomerate *ptr_Agglomerate = ((HybridAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));
-	ptr_Agglomerate->fsub(x, z, y, f);
-}
-
-//---------------------------------------------------------------------------
-void
-NAME::HybridAgglomerate::dfsub_wrapper (double &x, double z[], double y[], double f[])
-{
-	HybridAgglomerate *ptr_Agglomerate = ((HybridAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));
-	ptr_Agglomerate->dfsub(x, z, y, f);
-}
-
 //---------------------------------------------------------------------------
 
 
@@ -19,11 +19,6 @@
 #include <typeinfo>
 #include <chrono>
 
-#ifdef _OPENMP
-	#include <omp.h>
-#else
-	#define omp_get_thread_num() 0
-#endif
 // #define _1_EQ_
 namespace NAME = FuelCellShop::MicroScale;
 
@@ -47,7 +42,7 @@ uFD(true)
 {
     R_tol = 1.e-20;
 	verbosity(1);
-	this->has_derivatives_ = false;
+	this->has_derivatives_ = true;
 
 	column_names.push_back("x"); column_names.push_back("z0");
 	column_names.push_back("z1");  column_names.push_back("z2");
@@ -77,6 +72,22 @@ NAME::IonomerAgglomerate::set_structure()
 //---------------------------------------------------------------------------
 FuelCellShop::SolutionMap
 NAME::IonomerAgglomerate::compute_current ( )
+{
+    return solve_current(NULL);
+}
+
+//---------------------------------------------------------------------------
+std::vector<double>
+NAME::IonomerAgglomerate::compute_derivative_current ( )
+{
+    std::vector<double> dI(3, 0.0);
+    solve_current(&dI);
+    return dI;
+}
+
+//---------------------------------------------------------------------------
+FuelCellShop::SolutionMap
+NAME::IonomerAgglomerate::solve_current (std::vector<double>* dI)
 {
 
 
@@ -154,14 +165,26 @@ NAME::IonomerAgglomerate::compute_current ( )
 
 
     //Solve the problem
-    prob->set_integer_space(1e5);//was at 100000 1e5
-    prob->set_float_space(1e6);//was at 1000000 1e6
+    //Limit our meshsize for the first attempt, the work arrays are taken from the pool of this thread
+    prob->set_max_mesh_size(2000);//was 1e5 integers and 1e6 doubles, i.e., about 1900 subintervals
 //     if (this->non_equil_bc)
 //         uFD = false;
 //     else
         uFD = true;
 
-    flag = prob->DAE_solve();
+    //If the problem was already solved at these inputs, e.g., by compute_current() before compute_derivative_current(),
+    //only the linearized problems are solved at the converged solution
+    FuelCell::ApplicationCore::DAESolutionCoefficients& converged = (warm_start != NULL) ? *warm_start : converged_solution;
+    const std::vector<double> inputs = local_inputs();
+    const bool linearize_only = (dI != NULL) && (converged.inputs == inputs) && prob->set_initial_solution(converged);
+
+    //Start from the solution converged at this point in the previous call, if any
+    const bool warm_started = !linearize_only && (warm_start != NULL) && prob->set_initial_solution(*warm_start);
+
+    if (linearize_only)
+        flag = 1;
+    else
+        flag = prob->DAE_solve();
 
     if (flag <= 0)
     {
@@ -176,6 +199,10 @@ NAME::IonomerAgglomerate::compute_current ( )
             FcstUtilities::log << "First attempt failed, using a continuation strategy.\n";
         #endif
 
+        //Do not start from this solution again unless the continuation replaces it
+        if (warm_started)
+            warm_start->clear();
+
         clear_memory();
         if (cont_tolerance(1.e-2,endTol))
             obtained_solution = true;
@@ -314,11 +341,31 @@ NAME::IonomerAgglomerate::compute_current ( )
             C_OH += integrate(left,right,w_quad,c_OH);
         }
 
-
-
+        //Derivatives of the current from the problem linearized at the converged solution,
+        //in the order of sol_names, i.e., reactant, protonic and electronic potentials
+        if (dI != NULL)
+        {
+            double* parameters[3] = {&c_R, &phi_M, &phi_S};
+            for (unsigned int p = 0; p < 3; ++p)
+            {
+                //The derivatives are not available, the caller falls back to finite differences
+                if (!integral_derivative(*parameters[p], interface, (*dI)[p]))
+                {
+                    dI->clear();
+                    break;
+                }
+                (*dI)[p] /= volume/cm3_to_m3;
+            }
+            if (!dI->empty())
+                (*dI)[0] *= P/H_R_N; // c_R = x_R*P/H_R_N
+        }
 
         save_initial_solution();
 
+        //Keep the solution as the warm start of the next solve at this point
+        prob->get_solution_coefficients(converged);
+        converged.inputs = inputs;
+
         double volume_cm = volume/cm3_to_m3;
         double I_avg = I/volume_cm;
         delete [] mesh;
@@ -339,12 +386,39 @@ NAME::IonomerAgglomerate::compute_current ( )
         sols.push_back(SolutionVariable(I_max*prev_effectiveness, 1, current_density));
         sols.push_back(SolutionVariable(E_r,1, CL_effectiveness));
 
+        //No converged solution to linearize
+        if (dI != NULL)
+            dI->clear();
+        converged_solution.clear();
+
         DAE_Error(flag);
         return sols;
 //
     }
 }
 
+//---------------------------------------------------------------------------
+double
+NAME::IonomerAgglomerate::integrand (const double &x, double z[])
+{
+    //Same volumetric current as in the integration in solve_current
+    if ((x > interface) or ((z[0]*cm3_to_m3) < R_tol))
+        return 0.0;
+
+    std::vector<double> J(1, 0.0);
+    std::vector<SolutionVariable> c_reactants;
+    c_reactants.push_back(SolutionVariable (z[0]*cm3_to_m3, 1, tempReactantName));
+    SolutionVariable v_membrane(z[2], 1, protonic_electrical_potential);
+    SolutionVariable v_solid(phi_S, 1, electronic_electrical_potential);
+
+    this->kinetics->set_reactant_concentrations(c_reactants);
+    this->kinetics->set_electrolyte_potential(v_membrane);
+    this->kinetics->set_solid_potential(v_solid);
+    this->kinetics->current_density(J);
+
+    return getAV(x) * (J[0]/cm2_to_m2) * (4.0*pi*pow(x,2.0));
+}
+
 //---------------------------------------------------------------------------
 int 
 NAME::IonomerAgglomerate::cont_tolerance (double start_tol, double end_tol)
@@ -362,8 +436,8 @@ NAME::IonomerAgglomerate::cont_tolerance (double start_tol, double end_tol)
 // 	else
 	    uFD = true;
 	setup_DAE_solver();
- 	prob->set_integer_space(1e6);// was at 10000000, 1e7
- 	prob->set_float_space(1e7);// was at 100000000, 1e8
+	//A larger mesh will have to be used for continuation
+	prob->set_max_mesh_size(20000);// was 1e6 integers and 1e7 doubles
 	//Set initial tolerances
 	new_tol=1e-3;
 	for (int i=0; i<n_comp;i++) tol[i] = new_tol;
@@ -479,24 +553,16 @@ NAME::IonomerAgglomerate::setup_DAE_solver ()
 
 	
 	
-	// WARNING!!  This must be done in other implementations using the DAEWrapper class
-	//	Failing to do so will cause runtime errors that are difficult to locate.
-	// Assign the global object pointer to the IonomerAgglomerate object!!!
-	ptr_DAE_object[omp_get_thread_num()] = (void*) this;
 	
-	//Create an instance of the DAE solver class.  
-	prob = new FuelCell::ApplicationCore::DAESolver
-	(n_comp,  //Number of ODES
-	 n_y, // Number of algebraic constraints (0 for a BVP)
-	 mm, // Array that holds the order of each of the ODEs
-	 boundary_0, // Leftmost boundary point
-	 boundary_1, // Rightmost boundary point
-	 zeta, // Location of boundary points
-	 &fsub_wrapper,  // ptr to ODE function
-	 &dfsub_wrapper, //ptr to Jacobian of ODE function
-	 &gsub_wrapper, //ptr to boundary-condition function
-	 &dgsub_wrapper, //ptr to derivatives of boundary-condition function
-	 &guess_wrapper //ptr to optional initial guess function
+	//Create an instance of the DAE solver class, COLDAE or the native collocation solver, for the
+	//problem defined by n_comp, n_y, mm, boundary_0, boundary_1 and zeta. This object is the context passed to the functions below.
+	prob = create_BVP_solver
+	(native_BVP_solver, //Solve with CollocationBVPSolver instead of COLDAE
+	 &fsub_callback,  // ptr to ODE function
+	 &dfsub_callback, //ptr to Jacobian of ODE function
+	 &gsub_callback, //ptr to boundary-condition function
+	 &dgsub_callback, //ptr to derivatives of boundary-condition function
+	 &guess_callback //ptr to optional initial guess function
 	);
 	
 	/* 
@@ -515,11 +581,6 @@ NAME::IonomerAgglomerate::setup_DAE_solver ()
 	//-1 is full output
 	//0 is selected output
 	//1 is no output
-	
-	//Limit our meshsize for the first attempt
-	//A larger mesh will have to be used for continuation
-	prob->set_integer_space(1e6);//was at 100000000 1e8
-	prob->set_float_space(1e7);//was at 100000000  1e8
 }
 
 //---------------------------------------------------------------------------
@@ -840,46 +901,3 @@ NAME::IonomerAgglomerate::guess (double &x, double z[], double [], double df[])
 }
 
 
-//---------------------------------------------------------------------------
-void
-NAME::IonomerAgglomerate::fsub_wrapper (double &x, double z[], double y[], double f[])
-{
-	IonomerAgglomerate *ptr_Agglomerate = ((IonomerAgglomerate*)  (ptr_DAE_object[omp_get_thread_num()]));
-	ptr_Agglomerate->fsub(x, z, y, f);
-}
-
-
-//---------------------------------------------------------------------------
-void
-NAME::IonomerAgglomerate::dfsub_wrapper (double &x, double z[], double y[], double f[])
-{
-	IonomerAgglomerate *ptr_Agglomerate = ((IonomerAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));;
-	ptr_Agglomerate->dfsub(x, z, y, f);
-}
-
-
-//---------------------------------------------------------------------------
-void
-NAME::IonomerAgglomerate::gsub_wrapper (int &i, double z[], double &g)
-{
-	IonomerAgglomerate *ptr_Agglomerate = ((IonomerAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));;
-	ptr_Agglomerate->gsub(i, z, g);
-}
-
-
-//---------------------------------------------------------------------------
-void
-NAME::IonomerAgglomerate::dgsub_wrapper (int &i, double z[], double dg[])
-{
-	IonomerAgglomerate *ptr_Agglomerate = ((IonomerAgglomerate*)(ptr_DAE_object[omp_get_thread_num()]));;
-	ptr_Agglomerate->dgsub(i, z, dg);
-}
-
-
-//---------------------------------------------------------------------------
-void
-NAME::IonomerAgglomerate::guess_wrapper (double &x, double z[], double y[], double df[])
-{
-	IonomerAgglomerate *ptr_Agglomerate = ((IonomerAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));;
-	ptr_Agglomerate->guess(x, z, y, df);
-}
@@ -127,6 +127,12 @@ NAME::IonomerAgglomerateAnalytical::compute_current ()
         sols.push_back(SolutionVariable(0, 1, current_density));
         sols.push_back(SolutionVariable(0,1, CL_effectiveness));
 
+        //Zero coverages, as returned by compute_current_batch at these points
+        if(this->kinetics->has_coverage(OH_coverage))
+            sols.push_back(SolutionVariable(0,1, OH_coverage));
+        if(this->kinetics->has_coverage(O_coverage))
+            sols.push_back(SolutionVariable(0,1, O_coverage));
+
         return sols; //To stabalize FEM solution
     }
 
@@ -231,7 +237,7 @@ NAME::IonomerAgglomerateAnalytical::compute_current ()
 
     if(this->kinetics->has_coverage(O_coverage)){
         std::vector<double> O_c;
-        this->kinetics->OH_coverage(O_c);
+        this->kinetics->O_coverage(O_c);
         sols.push_back(SolutionVariable(O_c,O_coverage));
     }
 
@@ -334,6 +340,214 @@ NAME::IonomerAgglomerateAnalytical::compute_derivative_current ()
 }
 
 
+//---------------------------------------------------------------------------
+double
+NAME::IonomerAgglomerateAnalytical::set_batch_kinetics (std::vector<double>& c_R,
+                                                        std::vector<double>& D,
+                                                        std::vector<double>& H)
+{
+    const SolutionVariable& x_R = this->solutions.at(this->reactant);
+    const SolutionVariable& T = this->solutions.at(temperature_of_REV);
+    const SolutionVariable& lambda = this->solutions.at(membrane_water_content);
+    const bool oxygen = (x_R.get_variablename() == oxygen_molar_fraction);
+
+    tempReactantName = oxygen ? oxygen_concentration : hydrogen_concentration;
+
+    c_R.resize(x_R.size());
+    D.resize(x_R.size());
+    H.resize(x_R.size());
+
+    // The electrolyte properties only depend on the temperature and water content, which are usually the same at all points:
+    for (unsigned int i = 0; i < x_R.size(); ++i)
+    {
+        if (i > 0 && T[i] == T[i-1] && lambda[i] == lambda[i-1])
+        {
+            D[i] = D[i-1];
+            H[i] = H[i-1];
+        }
+        else
+        {
+            electrolyte->set_T(T[i]);
+            electrolyte->set_lambda(lambda[i]);
+
+            if (oxygen)
+            {
+                electrolyte->oxygen_diffusivity(D[i]);
+                H[i] = electrolyte->get_H_O2();
+            }
+            else
+            {
+                electrolyte->hydrogen_diffusivity(D[i]);
+                H[i] = electrolyte->get_H_H2();
+            }
+        }
+
+        c_R[i] = (x_R[i]*P)/H[i];
+    }
+
+    std::vector<SolutionVariable> c_reactants;
+    c_reactants.push_back(SolutionVariable(c_R, tempReactantName));
+
+    this->kinetics->set_reactant_concentrations(c_reactants);
+    this->kinetics->set_electrolyte_potential(this->solutions.at(protonic_electrical_potential));
+    this->kinetics->set_solid_potential(this->solutions.at(electronic_electrical_potential));
+    this->kinetics->set_temperature(T);
+    this->kinetics->set_p_t(P);
+
+    return oxygen ? 4.0 : 2.0;
+}
+
+
+//---------------------------------------------------------------------------
+FuelCellShop::SolutionMap
+NAME::IonomerAgglomerateAnalytical::compute_current_batch (const std::map<VariableNames,SolutionVariable>& sols,
+                                                           const VariableNames& react)
+{
+    this->set_solution(sols, react, 0);
+
+    if(not checked_kinetics)
+        check_kinetics();
+
+    P= this->layer->get_properties()[CLPropNames::pressure];
+
+    std::vector<double> c, D, H;
+    const double molarFactor = set_batch_kinetics(c, D, H);
+    const unsigned int n_points = c.size();
+
+    std::vector<double> r_rate(n_points, 0.0);
+    this->kinetics->current_density(r_rate);
+
+    // Same expressions as in compute_current, with the constant factors taken out of the loop:
+    const double volume_ratio = pow(interface,3.0); // agg_volume/volume
+    const double nF = molarFactor*F;
+    const double D_factor = pow(epsilon_agg,1.5);
+    const double film = (pow(r_agg,2)*delta_agg)/(3*(r_agg + delta_agg));
+
+    std::vector<double> I_avg(n_points, 0.0);
+    std::vector<double> E_r(n_points, 0.0);
+
+    const double* c_ = c.data();
+    const double* D_ = D.data();
+    const double* rate_ = r_rate.data();
+    double* I_ = I_avg.data();
+    double* E_ = E_r.data();
+
+    #pragma omp simd
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        const double k_c = AV*(rate_[i]/c_[i]) / (nF*volume_ratio);
+        const double phi_L = (r_agg/3.0)*std::sqrt(k_c/(D_factor*D_[i]));
+        const double E_agg = (1.0/phi_L)*(1.0/std::tanh(3.0*phi_L) - 1.0/(3.0*phi_L));
+        const double I = nF*c_[i] / (1.0/(E_agg*k_c) + film/D_[i]);
+
+        I_[i] = I*volume_ratio;
+        E_[i] = I_[i]/(nF*c_[i]*k_c*volume_ratio);
+    }
+
+    const SolutionVariable& x_R = this->solutions.at(this->reactant);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        //To stabalize FEM solution
+        if (x_R[i] <= 0.0 || std::isnan(I_avg[i]))
+            I_avg[i] = 0.0;
+        if (x_R[i] <= 0.0 || std::isnan(E_r[i]))
+            E_r[i] = 0.0;
+    }
+
+    SolutionMap sols_out;
+    sols_out.push_back(SolutionVariable(I_avg, current_density));
+    sols_out.push_back(SolutionVariable(E_r, CL_effectiveness));
+
+    if(this->kinetics->has_coverage(OH_coverage)){
+        std::vector<double> OH_c;
+        this->kinetics->OH_coverage(OH_c);
+        for (unsigned int i = 0; i < n_points; ++i)
+            if (x_R[i] <= 0.0)
+                OH_c[i] = 0.0;
+        sols_out.push_back(SolutionVariable(OH_c,OH_coverage));
+    }
+
+    if(this->kinetics->has_coverage(O_coverage)){
+        std::vector<double> O_c;
+        this->kinetics->O_coverage(O_c);
+        for (unsigned int i = 0; i < n_points; ++i)
+            if (x_R[i] <= 0.0)
+                O_c[i] = 0.0;
+        sols_out.push_back(SolutionVariable(O_c,O_coverage));
+    }
+
+    return sols_out;
+}
+
+
+//---------------------------------------------------------------------------
+std::vector< std::vector<double> >
+NAME::IonomerAgglomerateAnalytical::compute_derivative_current_batch (const std::map<VariableNames,SolutionVariable>& sols,
+                                                                      const VariableNames& react)
+{
+    this->set_solution(sols, react, 0);
+
+    if(not checked_kinetics)
+        check_kinetics();
+
+    //The derivatives can be requested before any current, hence the pressure is read here as well
+    P= this->layer->get_properties()[CLPropNames::pressure];
+
+    std::vector<double> c, D, H;
+    const double molarFactor = set_batch_kinetics(c, D, H);
+    const unsigned int n_points = c.size();
+
+    std::vector<double> r_rate(n_points, 0.0);
+    this->kinetics->current_density(r_rate);
+
+    std::map< VariableNames, std::vector<double> > derivatives;
+    this->kinetics->set_derivative_flags(this->sol_names);
+    this->kinetics->derivative_current(derivatives);
+
+    // Same expressions as in compute_derivative_current and compute_dEr:
+    const double volume_ratio = pow(interface,3.0); // agg_volume/volume
+    const double nF = molarFactor*F;
+    const double D_factor = pow(epsilon_agg,1.5);
+    const double film = (pow(r_agg,2)*delta_agg)/(3*(r_agg + delta_agg));
+
+    std::vector< std::vector<double> > dI(3, std::vector<double>(n_points, 0.0));
+
+    const double* c_ = c.data();
+    const double* D_ = D.data();
+    const double* H_ = H.data();
+    const double* rate_ = r_rate.data();
+    const double* dphi_m_ = derivatives[protonic_electrical_potential].data();
+    const double* dphi_s_ = derivatives[electronic_electrical_potential].data();
+    double* dI_dx = dI[0].data();
+    double* dI_dphi_m = dI[1].data();
+    double* dI_dphi_s = dI[2].data();
+
+    #pragma omp simd
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        const double D_eff = D_factor*D_[i];
+        const double k_c = AV*(rate_[i]/c_[i]) / (nF*volume_ratio);
+        const double dkc_dphi_m = AV*dphi_m_[i] / (c_[i]*nF);
+        const double dkc_dphi_s = AV*dphi_s_[i] / (c_[i]*nF);
+
+        const double phi_L = (r_agg/3.0)*std::sqrt(k_c/D_eff);
+        const double dphiL_dkc = (r_agg/3.0)*(0.5/D_eff)/std::sqrt(k_c/D_eff);
+        const double tanh_L = std::tanh(3.0*phi_L);
+        const double E_agg = (1.0/phi_L)*(1.0/tanh_L - 1.0/(3.0*phi_L));
+        const double dEr_dphiL = -1.0/(phi_L*phi_L*tanh_L) - 3.0*(1.0 - tanh_L*tanh_L)/(phi_L*tanh_L*tanh_L) + 2.0/(3.0*phi_L*phi_L*phi_L);
+
+        const double resistance = 1.0/(E_agg*k_c) + film/D_[i];
+        const double factor = nF*c_[i]/(resistance*resistance*(E_agg*k_c)*(E_agg*k_c));
+
+        dI_dx[i] = nF*(P/H_[i])/resistance * volume_ratio;
+        dI_dphi_m[i] = factor*(dEr_dphiL*dphiL_dkc*dkc_dphi_m*k_c + E_agg*dkc_dphi_m) * volume_ratio;
+        dI_dphi_s[i] = factor*(dEr_dphiL*dphiL_dkc*dkc_dphi_s*k_c + E_agg*dkc_dphi_s) * volume_ratio;
+    }
+
+    return dI;
+}
+
+
 //---------------------------------------------------------------------------
 double
 NAME::IonomerAgglomerateAnalytical::compute_Er (const double k_c, const double D)
@@ -0,0 +1,485 @@
+// ----------------------------------------------------------------------------
+//
+// FCST: Fuel Cell Simulation Toolbox
+//
+// Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+// This software is distributed under the MIT License
+// For more information, see the README file in /doc/LICENSE
+//
+// - Class: AgglomerateSurrogate
+// - Description: Adaptive interpolation table for the results of micro scale solves
+// - Developers: OpenFCST contributors, University of Alberta
+//
+// ----------------------------------------------------------------------------
+
+#include <microscale/agglomerate_surrogate.h>
+#include <utils/fcst_utilities.h>
+#include <utils/logging.h>
+
+#include <cmath>
+
+namespace NAME = FuelCellShop::MicroScale;
+
+namespace
+{
+    /**
+     * Names of the parameters holding the range of each input, in the order of the inputs.
+     */
+    const char* range_names[] = {"Reactant molar fraction range",
+                                 "Protonic potential range",
+                                 "Electronic potential range",
+                                 "Membrane water content range",
+                                 "Temperature range"};
+    const char* range_defaults[] = {"0.0, 1.0",
+                                    "-0.5, 0.5",
+                                    "0.0, 1.2",
+                                    "0.0, 25.0",
+                                    "273.0, 373.0"};
+    const unsigned int n_ranges = 5;
+}
+
+//---------------------------------------------------------------------------
+NAME::AgglomerateSurrogate::AgglomerateSurrogate()
+:
+use_table(false),
+rel_tol(1e-3),
+abs_tol(1e-6),
+max_level(12),
+n_hits(0),
+n_misses(0)
+{}
+
+//---------------------------------------------------------------------------
+void
+NAME::AgglomerateSurrogate::declare_parameters(ParameterHandler& param)
+{
+    param.enter_subsection("Surrogate table");
+    {
+        param.declare_entry("Use surrogate table",
+                            "false",
+                            Patterns::Bool(),
+                            "Interpolate the results of the micro scale solves in an adaptively refined table built from the "
+                            "solves performed during the simulation. Points outside the input ranges below are always solved. "
+                            "Checking a box of the table requires up to 3^n micro scale solves, where n is the number of inputs "
+                            "whose range is not a single value, i.e., 243 solves per box if all five inputs are interpolated. "
+                            "Fix the inputs that are constant in the simulation by setting their range to a single value.");
+        param.declare_entry("Relative tolerance",
+                            "1e-3",
+                            Patterns::Double(0.0),
+                            "Interpolation error allowed in a box of the table, relative to the values solved in the box.");
+        param.declare_entry("Absolute tolerance",
+                            "1e-6",
+                            Patterns::Double(0.0),
+                            "Interpolation error allowed in a box of the table for values close to zero.");
+        param.declare_entry("Maximum refinement level",
+                            "12",
+                            Patterns::Integer(1, 20),
+                            "Maximum number of bisections of the range of each input.");
+
+        for (unsigned int d = 0; d < n_ranges; ++d)
+            param.declare_entry(range_names[d],
+                                range_defaults[d],
+                                Patterns::List(Patterns::Double(), 2, 2),
+                                "Lower and upper bound of the input in the table. If they are equal, the table is only used "
+                                "for this value of the input.");
+    }
+    param.leave_subsection();
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::AgglomerateSurrogate::initialize(ParameterHandler& param)
+{
+    std::vector<double> lower_bounds(n_ranges), upper_bounds(n_ranges);
+    double relative, absolute;
+    unsigned int level;
+
+    param.enter_subsection("Surrogate table");
+    {
+        for (unsigned int d = 0; d < n_ranges; ++d)
+        {
+            std::vector<double> range = FcstUtilities::string_to_number<double>( Utilities::split_string_list( param.get(range_names[d]) ) );
+            AssertThrow(range[0] <= range[1],
+                        ExcMessage(std::string("The lower bound of the ") + range_names[d] + " is larger than the upper bound."));
+            lower_bounds[d] = range[0];
+            upper_bounds[d] = range[1];
+        }
+
+        relative = param.get_double("Relative tolerance");
+        absolute = param.get_double("Absolute tolerance");
+        level = param.get_integer("Maximum refinement level");
+
+        initialize(lower_bounds, upper_bounds, relative, absolute, level);
+        use_table = param.get_bool("Use surrogate table");
+    }
+    param.leave_subsection();
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::AgglomerateSurrogate::initialize(const std::vector<double>& lower_bounds,
+                                       const std::vector<double>& upper_bounds,
+                                       const double relative,
+                                       const double absolute,
+                                       const unsigned int level)
+{
+    AssertThrow(lower_bounds.size() == upper_bounds.size(),
+                ExcDimensionMismatch(lower_bounds.size(), upper_bounds.size()));
+    AssertThrow(level >= 1 && level <= 20,
+                ExcMessage("The maximum refinement level of the surrogate table must be between 1 and 20."));
+
+    std::lock_guard<std::mutex> lock(table_mutex);
+
+    use_table = true;
+    lower = lower_bounds;
+    upper = upper_bounds;
+    rel_tol = relative;
+    abs_tol = absolute;
+    max_level = level;
+
+    // The lattice has one more level than the boxes so that the midpoints of the smallest boxes are lattice points:
+    n_intervals.resize(lower.size());
+    for (unsigned int d = 0; d < lower.size(); ++d)
+        n_intervals[d] = (upper[d] > lower[d]) ? (1u << (max_level + 1)) : 0;
+
+    boxes.clear();
+    samples.clear();
+    n_hits = 0;
+    n_misses = 0;
+
+    Box root;
+    root.lower = LatticePoint(lower.size(), 0);
+    root.upper = n_intervals;
+    root.children[0] = root.children[1] = -1;
+    root.split_dim = 0;
+    root.trusted = false;
+    root.rejected = false;
+    boxes.push_back(root);
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::AgglomerateSurrogate::clear()
+{
+    const bool used = use_table;
+    initialize(std::vector<double>(lower), std::vector<double>(upper), rel_tol, abs_tol, max_level);
+    use_table = used;
+}
+
+//---------------------------------------------------------------------------
+bool
+NAME::AgglomerateSurrogate::value(const std::vector<double>& x,
+                                  const Model& model,
+                                  std::vector<double>& values,
+                                  std::vector< std::vector<double> >* gradients)
+{
+    if (!use_table)
+        return false;
+
+    Assert(x.size() == lower.size(), ExcDimensionMismatch(x.size(), lower.size()));
+
+    // Lattice coordinates of the point:
+    std::vector<double> xi(x.size(), 0.0);
+    bool inside = true;
+    for (unsigned int d = 0; d < x.size(); ++d)
+    {
+        if (n_intervals[d] == 0)
+            inside = inside && std::fabs(x[d] - lower[d]) <= 1e-12*std::max(1.0, std::fabs(lower[d]));
+        else
+        {
+            xi[d] = (x[d] - lower[d])/(upper[d] - lower[d])*n_intervals[d];
+            inside = inside && xi[d] >= 0.0 && xi[d] <= n_intervals[d];
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(table_mutex);
+
+    if (!inside)
+    {
+        ++n_misses;
+        return false;
+    }
+
+    while (true)
+    {
+        const unsigned int b = find_leaf(xi);
+
+        if (boxes[b].trusted)
+        {
+            interpolate(boxes[b], xi, values, gradients);
+            ++n_hits;
+            return true;
+        }
+        if (boxes[b].rejected)
+        {
+            ++n_misses;
+            return false;
+        }
+
+        // Solve the micro scale problem at the lattice points that are missing, without holding the lock:
+        std::vector<LatticePoint> points;
+        check_points(boxes[b], points);
+
+        std::vector<LatticePoint> missing;
+        for (unsigned int p = 0; p < points.size(); ++p)
+            if (samples.find(points[p]) == samples.end())
+                missing.push_back(points[p]);
+
+        lock.unlock();
+
+        std::vector< std::vector<double> > solved;
+        bool failed = false;
+        for (unsigned int p = 0; p < missing.size() && !failed; ++p)
+        {
+            std::vector<double> input(missing[p].size());
+            for (unsigned int d = 0; d < input.size(); ++d)
+                input[d] = to_input(d, missing[p][d]);
+
+            std::vector<double> result = model(input);
+
+            // A failed solve can not be stored in the table:
+            for (unsigned int i = 0; i < result.size(); ++i)
+                failed = failed || !std::isfinite(result[i]);
+
+            if (!failed)
+                solved.push_back(result);
+        }
+
+        lock.lock();
+
+        // The samples solved before a failure are kept for the neighbouring boxes:
+        for (unsigned int p = 0; p < solved.size(); ++p)
+            samples.insert(std::make_pair(missing[p], solved[p]));
+
+        // The box can not be checked, hence it is not used and its points are not solved again:
+        if (failed)
+        {
+            if (boxes[b].children[0] < 0 && !boxes[b].trusted)
+                boxes[b].rejected = true;
+            ++n_misses;
+            return false;
+        }
+
+        // Another thread might have refined the box in the meantime:
+        if (boxes[b].children[0] < 0 && !boxes[b].trusted && !boxes[b].rejected)
+            refine(b);
+    }
+}
+
+//---------------------------------------------------------------------------
+double
+NAME::AgglomerateSurrogate::to_input(const unsigned int d, const unsigned int i) const
+{
+    if (n_intervals[d] == 0)
+        return lower[d];
+
+    return lower[d] + (upper[d] - lower[d])*double(i)/double(n_intervals[d]);
+}
+
+//---------------------------------------------------------------------------
+unsigned int
+NAME::AgglomerateSurrogate::find_leaf(const std::vector<double>& xi) const
+{
+    unsigned int b = 0;
+    while (boxes[b].children[0] >= 0)
+    {
+        const unsigned int d = boxes[b].split_dim;
+        const unsigned int mid = boxes[boxes[b].children[0]].upper[d];
+        b = (xi[d] < mid) ? boxes[b].children[0] : boxes[b].children[1];
+    }
+
+    return b;
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::AgglomerateSurrogate::check_points(const Box& box,
+                                         std::vector<LatticePoint>& points) const
+{
+    std::vector<unsigned int> active;
+    for (unsigned int d = 0; d < box.lower.size(); ++d)
+        if (n_intervals[d] > 0)
+            active.push_back(d);
+
+    points.clear();
+    for (unsigned int c = 0; c < (1u << active.size()); ++c)
+    {
+        LatticePoint corner(box.lower);
+        for (unsigned int a = 0; a < active.size(); ++a)
+            if (c & (1u << a))
+                corner[active[a]] = box.upper[active[a]];
+        points.push_back(corner);
+    }
+
+    // Points with at least one coordinate at the midpoint of the box, i.e., the midpoints of the edges, the centres of the faces and
+    // the centre. Digit a of c in base 3 selects the lower bound, the upper bound or the midpoint of the active input a:
+    unsigned int n_points = 1;
+    for (unsigned int a = 0; a < active.size(); ++a)
+        n_points *= 3;
+
+    for (unsigned int c = 0; c < n_points; ++c)
+    {
+        LatticePoint point(box.lower);
+        bool midpoint = false;
+        for (unsigned int a = 0, digits = c; a < active.size(); ++a, digits /= 3)
+        {
+            const unsigned int d = active[a];
+            if (digits % 3 == 1)
+                point[d] = box.upper[d];
+            else if (digits % 3 == 2)
+            {
+                point[d] = (box.lower[d] + box.upper[d])/2;
+                midpoint = true;
+            }
+        }
+        if (midpoint)
+            points.push_back(point);
+    }
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::AgglomerateSurrogate::interpolate(const Box& box,
+                                        const std::vector<double>& xi,
+                                        std::vector<double>& values,
+                                        std::vector< std::vector<double> >* gradients) const
+{
+    std::vector<unsigned int> active;
+    for (unsigned int d = 0; d < box.lower.size(); ++d)
+        if (n_intervals[d] > 0)
+            active.push_back(d);
+
+    // Local coordinates in the box:
+    std::vector<double> t(active.size());
+    for (unsigned int a = 0; a < active.size(); ++a)
+    {
+        const unsigned int d = active[a];
+        t[a] = (xi[d] - box.lower[d])/double(box.upper[d] - box.lower[d]);
+    }
+
+    std::vector<LatticePoint> points;
+    check_points(box, points);
+
+    const unsigned int n_values = samples.find(points[0])->second.size();
+    values.assign(n_values, 0.0);
+    if (gradients != NULL)
+        gradients->assign(n_values, std::vector<double>(box.lower.size(), 0.0));
+
+    // Corner c has the upper coordinate in the active inputs given by the bits of c, see check_points():
+    for (unsigned int c = 0; c < (1u << active.size()); ++c)
+    {
+        const std::vector<double>& corner_values = samples.find(points[c])->second;
+
+        double weight = 1.0;
+        for (unsigned int a = 0; a < active.size(); ++a)
+            weight *= (c & (1u << a)) ? t[a] : 1.0 - t[a];
+
+        for (unsigned int i = 0; i < n_values; ++i)
+            values[i] += weight*corner_values[i];
+
+        if (gradients == NULL)
+            continue;
+
+        for (unsigned int a = 0; a < active.size(); ++a)
+        {
+            const unsigned int d = active[a];
+
+            double dweight = (c & (1u << a)) ? 1.0 : -1.0;
+            for (unsigned int e = 0; e < active.size(); ++e)
+                if (e != a)
+                    dweight *= (c & (1u << e)) ? t[e] : 1.0 - t[e];
+
+            // Derivative with respect to the input, not the local coordinate:
+            dweight /= to_input(d, box.upper[d]) - to_input(d, box.lower[d]);
+
+            for (unsigned int i = 0; i < n_values; ++i)
+                (*gradients)[i][d] += dweight*corner_values[i];
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::AgglomerateSurrogate::refine(const unsigned int b)
+{
+    std::vector<LatticePoint> points;
+    check_points(boxes[b], points);
+
+    // Compare the interpolant with the micro scale solves at all points that are not corners. Checking the centre alone is not
+    // enough, e.g., the interpolant of (x - 1/2)^2 - (y - 1/2)^2 on the unit square is exact at the centre but wrong by 1/4 at the
+    // midpoints of the edges:
+    unsigned int n_active = 0;
+    for (unsigned int d = 0; d < n_intervals.size(); ++d)
+        if (n_intervals[d] > 0)
+            ++n_active;
+
+    bool trusted = true;
+    std::vector<double> interpolated;
+    for (unsigned int p = (1u << n_active); p < points.size() && trusted; ++p)
+    {
+        const std::vector<double> xi(points[p].begin(), points[p].end());
+        interpolate(boxes[b], xi, interpolated, NULL);
+        trusted = within_tolerance(interpolated, samples[points[p]]);
+    }
+
+    if (trusted)
+    {
+        boxes[b].trusted = true;
+        return;
+    }
+
+    // Bisect the widest input. All inputs have the same number of lattice intervals, hence the widths are relative to the ranges:
+    int split_dim = -1;
+    unsigned int width = 2;
+    for (unsigned int d = 0; d < n_intervals.size(); ++d)
+        if (n_intervals[d] > 0 && boxes[b].upper[d] - boxes[b].lower[d] > width)
+        {
+            split_dim = d;
+            width = boxes[b].upper[d] - boxes[b].lower[d];
+        }
+
+    if (split_dim < 0)
+    {
+        boxes[b].rejected = true;
+        return;
+    }
+
+    Box left = boxes[b];
+    left.children[0] = left.children[1] = -1;
+    left.trusted = false;
+    left.rejected = false;
+    Box right = left;
+    left.upper[split_dim] = right.lower[split_dim] = (boxes[b].lower[split_dim] + boxes[b].upper[split_dim])/2;
+
+    boxes[b].split_dim = split_dim;
+    boxes[b].children[0] = boxes.size();
+    boxes[b].children[1] = boxes.size() + 1;
+    boxes.push_back(left);
+    boxes.push_back(right);
+}
+
+//---------------------------------------------------------------------------
+bool
+NAME::AgglomerateSurrogate::within_tolerance(const std::vector<double>& a,
+                                             const std::vector<double>& b) const
+{
+    for (unsigned int i = 0; i < a.size(); ++i)
+        if (!(std::fabs(a[i] - b[i]) <= rel_tol*std::fabs(b[i]) + abs_tol))
+            return false;
+
+    return true;
+}
+
+//---------------------------------------------------------------------------
+void
+NAME::AgglomerateSurrogate::print_statistics() const
+{
+    std::lock_guard<std::mutex> lock(table_mutex);
+
+    if (!use_table)
+        return;
+
+    FcstUtilities::log << "Surrogate table: " << samples.size() << " micro scale solves stored in " << boxes.size() << " boxes, "
+                       << n_hits << " points interpolated and " << n_misses << " points solved" << std::endl;
+}
@@ -12,11 +12,6 @@
 //---------------------------------------------------------------------------
 
 #include <microscale/agglomerate_water_1D.h>
-#ifdef _OPENMP
-	#include <omp.h>
-#else
-	#define omp_get_thread_num() 0
-#endif
 
 
 namespace NAME = FuelCellShop::MicroScale;
@@ -43,7 +38,7 @@ lambda2(1.0)
 {
     R_tol =1e-12;
 	verbosity(verbose);
-	this->has_derivatives_ = false;
+	this->has_derivatives_ = true;
 	sol_names.resize(4);
 
 	column_names.push_back("x"); column_names.push_back("z0");
@@ -72,6 +67,22 @@ NAME::WaterAgglomerate::set_structure()
 //---------------------------------------------------------------------------
 FuelCellShop::SolutionMap
 NAME::WaterAgglomerate::compute_current ()
+{
+    return solve_current(NULL);
+}
+
+//---------------------------------------------------------------------------
+std::vector<double>
+NAME::WaterAgglomerate::compute_derivative_current ()
+{
+    std::vector<double> dI(3, 0.0);
+    solve_current(&dI);
+    return dI;
+}
+
+//---------------------------------------------------------------------------
+FuelCellShop::SolutionMap
+NAME::WaterAgglomerate::solve_current (std::vector<double>* dI)
 {
 
     //In water filled case will have changed because the
@@ -154,8 +165,20 @@ NAME::WaterAgglomerate::compute_current ()
     lambda = 1.0; // try full solution first
     setup_DAE_solver();
 
+    //If the problem was already solved at these inputs, e.g., by compute_current() before compute_derivative_current(),
+    //only the linearized problems are solved at the converged solution
+    FuelCell::ApplicationCore::DAESolutionCoefficients& converged = (warm_start != NULL) ? *warm_start : converged_solution;
+    const std::vector<double> inputs = local_inputs();
+    const bool linearize_only = (dI != NULL) && (converged.inputs == inputs) && prob->set_initial_solution(converged);
+
+    //Start from the solution converged at this point in the previous call, if any
+    const bool warm_started = !linearize_only && (warm_start != NULL) && prob->set_initial_solution(*warm_start);
+
     //Solve the problem
-    flag = prob->DAE_solve();
+    if (linearize_only)
+        flag = 1;
+    else
+        flag = prob->DAE_solve();
     if (flag <= 0)
     {
         //Solver failed
@@ -169,6 +192,10 @@ NAME::WaterAgglomerate::compute_current ()
             FcstUtilities::log << get_name () + "attempting Continuation." << std::endl;
         #endif
 
+        //Do not start from this solution again unless the continuation replaces it
+        if (warm_started)
+            warm_start->clear();
+
         clear_memory();
         // a simple continuation strategy based on tolerance
         if (cont_tolerance(1e-3,1e-9)) //cont_tolerance(0.1,1e-4,1e-9)
@@ -318,9 +345,31 @@ NAME::WaterAgglomerate::compute_current ()
 
         }
 
+        //Derivatives of the current from the problem linearized at the converged solution,
+        //in the order of the reactant, protonic and electronic potentials
+        if (dI != NULL)
+        {
+            double* parameters[3] = {&c_R, &phi_M, &phi_S};
+            for (unsigned int p = 0; p < 3; ++p)
+            {
+                //The derivatives are not available, the caller falls back to finite differences
+                if (!integral_derivative(*parameters[p], interface, (*dI)[p]))
+                {
+                    dI->clear();
+                    break;
+                }
+                (*dI)[p] /= volume;
+            }
+            if (!dI->empty())
+                (*dI)[0] *= P/HO2N; // c_R = x_R*P/HO2N
+        }
+
         //Necessary call to base save solution functions
         save_initial_solution();
 
+        //Keep the solution as the warm start of the next solve at this point
+        prob->get_solution_coefficients(converged);
+        converged.inputs = inputs;
 
         delete [] mesh;
         clear_memory();
@@ -341,12 +390,40 @@ NAME::WaterAgglomerate::compute_current ()
         sols.push_back(SolutionVariable(I_max, 1, current_density));
         sols.push_back(SolutionVariable(E_r,1, CL_effectiveness));
 
+        //No converged solution to linearize
+        if (dI != NULL)
+            dI->clear();
+        converged_solution.clear();
+
         DAE_Error(flag);
         return sols;
     }
 
 }
 
+//---------------------------------------------------------------------------
+double
+NAME::WaterAgglomerate::integrand (const double &x, double z[])
+{
+    //Same volumetric current as in the integration in solve_current
+    if ((x > interface) or (z[0] < R_tol) or (z[2] < H_tol))
+        return 0.0;
+
+    std::vector<double> J(1, 0.0);
+    std::vector<SolutionVariable> c_reactants;
+    c_reactants.push_back(SolutionVariable (z[0], 1, oxygen_concentration)); //TODO: make this generic
+    c_reactants.push_back(SolutionVariable (z[2], 1, proton_concentration));
+    SolutionVariable v_membrane(z[4], 1, protonic_electrical_potential);
+    SolutionVariable v_solid(phi_S, 1, electronic_electrical_potential);
+
+    this->kinetics->set_reactant_concentrations(c_reactants);
+    this->kinetics->set_electrolyte_potential(v_membrane);
+    this->kinetics->set_solid_potential(v_solid);
+    this->kinetics->current_density(J);
+
+    return getAV(x) * J[0] * (4.0*pi*pow(x,2.0));
+}
+
 //---------------------------------------------------------------------------
 int 
 NAME::WaterAgglomerate::cont_tolerance (double start_tol, double end_tol)
@@ -530,24 +607,16 @@ for (int i=0; i<n_comp;++i)
 }
 tol[4] = 1e-6;
 
-// WARNING!!  This must be done in other implementations using the DAEWrapper class
-//	Failing to do so will cause runtime errors that are difficult to locate.
-// Assign the global object pointer to the WaterAgglomerate object!!!
-ptr_DAE_object[omp_get_thread_num()] = (void*) this;
-
-//Create an instance of the DAE solver class.  
-prob = new FuelCell::ApplicationCore::DAESolver
-(n_comp,  //Number of ODES
-n_y, // Number of algebraic constraints (0 for a BVP)
-mm, // Array that holds the order of each of the ODEs
-boundary_0, // Leftmost boundary point
-boundary_1, // Rightmost boundary point
-zeta, // Location of boundary points
-&fsub_wrapper,  // ptr to ODE function
-&dfsub_wrapper, //ptr to Jacobian of ODE function
-&gsub_wrapper, //ptr to boundary-condition function
-&dgsub_wrapper, //ptr to derivatives of boundary-condition function
-&guess_wrapper //ptr to optional initial guess function
+
+//Create an instance of the DAE solver class, COLDAE or the native collocation solver, for the
+//problem defined by n_comp, n_y, mm, boundary_0, boundary_1 and zeta. This object is the context passed to the functions below.
+prob = create_BVP_solver
+(native_BVP_solver, //Solve with CollocationBVPSolver instead of COLDAE
+&fsub_callback,  // ptr to ODE function
+&dfsub_callback, //ptr to Jacobian of ODE function
+&gsub_callback, //ptr to boundary-condition function
+&dgsub_callback, //ptr to derivatives of boundary-condition function
+&guess_callback //ptr to optional initial guess function
 );
 
 /* 
@@ -559,6 +628,7 @@ for every problem.
 
 prob->set_collocation_points(n_colloc); //Set the number of collocation points 
 prob->set_initial_mesh_size(n_mesh); //Set the initial mesh size
+prob->set_max_mesh_size(20000); //Size the work arrays, the default sizes allow about 1e5 subintervals
 if (set_fixpoint) prob->set_fixpnts(1, fixpnt);
 prob->set_tolerance(n_comp,ltol,tol);
 prob->set_output(n_output); //Set the output level 
@@ -843,48 +913,6 @@ NAME::WaterAgglomerate::guess (double &x, double z[], double [], double dz[])
    }
 }
 
-//---------------------------------------------------------------------------
-void
-NAME::WaterAgglomerate::fsub_wrapper (double &x, double z[], double y[], double f[])
-{
-	WaterAgglomerate *ptr_Agglomerate = ((WaterAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));
-	ptr_Agglomerate->fsub(x, z, y, f);
-}
-
-//---------------------------------------------------------------------------
-void
-NAME::WaterAgglomerate::dfsub_wrapper (double &x, double z[], double y[], double f[])
-{
-	WaterAgglomerate *ptr_Agglomerate = ((WaterAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));
-	ptr_Agglomerate->dfsub(x, z, y, f);
-}
-
-//---------------------------------------------------------------------------
-void
-NAME::WaterAgglomerate::gsub_wrapper (int &i, double z[], double &g)
-{
-	WaterAgglomerate *ptr_Agglomerate = ((WaterAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));
-	ptr_Agglomerate->gsub(i, z, g);
-}
-
-//---------------------------------------------------------------------------
-void
-NAME::WaterAgglomerate::dgsub_wrapper (int &i, double z[], double dg[])
-{
-	WaterAgglomerate *ptr_Agglomerate = ((WaterAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));
-	ptr_Agglomerate->dgsub(i, z, dg);
-}
-
-//---------------------------------------------------------------------------
-void
-NAME::WaterAgglomerate::guess_wrapper (double &x, double z[], double y[], double df[])
-{
-	WaterAgglomerate *ptr_Agglomerate = ((WaterAgglomerate*) (ptr_DAE_object[omp_get_thread_num()]));
-	ptr_Agglomerate->guess(x, z, y, df);
-}
-
-
-
 double NAME::WaterAgglomerate::compute_thickness_agg()
 {
     //set default and starting values
@@ -18,10 +18,14 @@
 
 namespace NAME = FuelCellShop::MicroScale;
 
+std::mutex NAME::NumericalAgglomerateBase::db_mutex;
+
 NAME::NumericalAgglomerateBase::NumericalAgglomerateBase(){
     maxRadialDimension = 1.0;
     push_next = false;
     thread_id = 0;
+    warm_start = NULL;
+    native_BVP_solver = false;
 }
 
 //---------------------------------------------------------
@@ -35,7 +39,8 @@ NAME::NumericalAgglomerateBase::update_initial_solution(){
     FcstUtilities::DatabaseOC snap_shot = create_OC_snapshot();
 
     if (guess_no_longer_valid(snap_shot)){
-        if(db.connect(db_address,true)){
+        //The connection is kept open, so that the prepared lookups are reused at every quadrature point
+        if(db.is_connected() or db.connect(db_address,true)){
 
             unsigned int i = 0;
 
@@ -52,8 +57,6 @@ NAME::NumericalAgglomerateBase::update_initial_solution(){
 
             if(i>0) //If it took more than one attempt to get the data
                 push_next = true; //Next time when asked, we will push new data
-
-            db.disconnect();
         }
 
     }
@@ -70,20 +73,32 @@ NAME::NumericalAgglomerateBase::save_initial_solution(){
            return;
 
     if(push_next){
-        if(db.connect(db_address,true)){
+        std::lock_guard<std::mutex> lock(db_mutex);
+
+        if(db.is_connected() or db.connect(db_address,true)){
             database_OC = create_OC_snapshot();
 
             if(not db.has_data(this->get_name(),database_OC, tolerance)){
                 db.commit_data(this->get_name(), database_OC, column_names, final_results);
             }
-
-            db.disconnect();
         }
 
         push_next = false;
     }
 }
 
+//---------------------------------------------------------
+std::vector<double>
+NAME::NumericalAgglomerateBase::local_inputs() const
+{
+    std::vector<double> inputs;
+    for (std::map<VariableNames, SolutionVariable>::const_iterator it = this->solutions.begin(); it != this->solutions.end(); ++it)
+        if (it->second.size() > (unsigned int)this->sol_index)
+            inputs.push_back(it->second[this->sol_index]);
+    inputs.push_back(this->P);
+    return inputs;
+}
+
 //---------------------------------------------------------
 bool
 NAME::NumericalAgglomerateBase::guess_no_longer_valid(const FcstUtilities::DatabaseOC& OC){
@@ -222,6 +237,9 @@ NAME::NumericalAgglomerateBase::declare_parameters (ParameterHandler &param) con
                 "The name of the database that reside in FCST root");
         param.declare_entry("Agglomerate Loading Profile", "1",
                 Patterns::List(Patterns::Double()));
+        param.declare_entry("BVP solver", "COLDAE", Patterns::Selection("COLDAE|Collocation"),
+                "Solver of the agglomerate problem: COLDAE or the native collocation solver, "
+                "which avoids the setup of COLDAE for every solve");
     }
     param.leave_subsection();
 
@@ -238,6 +256,7 @@ NAME::NumericalAgglomerateBase::initialize(ParameterHandler &param){
         tolerance = param.get_double("Initial condition tolerance factor");
         db_address = FcstUtilities::find_fcst_root() + "databases/" + param.get("Database name");
         loadingWeigths = FcstUtilities::string_to_number<double>( Utilities::split_string_list( param.get("Agglomerate Loading Profile")));
+        native_BVP_solver = (param.get("BVP solver") == "Collocation");
     }
     param.leave_subsection();
 }
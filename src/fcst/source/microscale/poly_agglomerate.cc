@@ -15,6 +15,11 @@
 //---------------------------------------------------------------------------
 
 #include <microscale/poly_agglomerate.h>
+#include <utils/hybrid_parallelism.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace NAME = FuelCellShop::MicroScale;
 
@@ -29,7 +34,7 @@ NAME::PolyAgglomerate const* NAME::PolyAgglomerate::PROTOTYPE = new NAME::PolyAg
 
 
 //---------------------------------------------------------------------------------//
-NAME::PolyAgglomerate::PolyAgglomerate(std::string concrete_name) {
+NAME::PolyAgglomerate::PolyAgglomerate(std::string concrete_name): thread_safe(false) {
     this->get_mapFactory()->insert(std::pair<std::string, NAME::PolyAgglomerate*>(
             concrete_name, this));
 }
@@ -56,11 +61,12 @@ NAME::PolyAgglomerate::compute_current (){
     double C_OH = 0.0;
     double C_O = 0.0;
 
-
+    std::vector<SolutionMap> class_sols(micro.size());
+    solve_classes(class_sols);
 
     for(unsigned int i = 0; i < micro.size(); i++){
         double vol = micro.volAt(i);
-        SolutionMap sol = micro.at(i)->compute_current();
+        SolutionMap& sol = class_sols[i];
 
         curr += vol*sol.at(current_density)[0];
         eff += vol*sol.at(CL_effectiveness)[0];
@@ -85,6 +91,81 @@ NAME::PolyAgglomerate::compute_current (){
 
 }
 
+//---------------------------------------------------------------------------------//
+void
+NAME::PolyAgglomerate::solve_classes(std::vector<SolutionMap>& class_sols){
+
+    #ifdef _OPENMP
+    if(thread_safe and micro.size() > 1){
+
+        if(omp_in_parallel()){
+            //Each size class is a task, the tasks of all quadrature points are shared by the threads of the enclosing loop
+            for(unsigned int i = 0; i < micro.size(); i++){
+                #pragma omp task default(shared) firstprivate(i)
+                class_sols[i] = micro.at(i)->compute_current();
+            }
+            #pragma omp taskwait
+        }
+        else{
+            #pragma omp parallel for schedule(dynamic, 1) num_threads(FcstUtilities::n_threads())
+            for(unsigned int i = 0; i < micro.size(); i++)
+                class_sols[i] = micro.at(i)->compute_current();
+        }
+
+        return;
+    }
+    #endif
+
+    for(unsigned int i = 0; i < micro.size(); i++)
+        class_sols[i] = micro.at(i)->compute_current();
+}
+
+//---------------------------------------------------------------------------------//
+bool
+NAME::PolyAgglomerate::has_batch_current(){
+
+    for(unsigned int i = 0; i < micro.size(); i++)
+        if(not micro.at(i)->has_batch_current())
+            return false;
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------//
+FuelCellShop::SolutionMap
+NAME::PolyAgglomerate::compute_current_batch (const std::map<VariableNames,SolutionVariable>& sols, const VariableNames& name){
+
+    //Add contributions
+    const unsigned int n_points = sols.at(name).size();
+    std::vector<double> curr(n_points, 0.0);
+    std::vector<double> eff(n_points, 0.0);
+    std::vector<double> C_OH(n_points, 0.0);
+    std::vector<double> C_O(n_points, 0.0);
+
+    for(unsigned int i = 0; i < micro.size(); i++){
+        double vol = micro.volAt(i);
+        SolutionMap sol = micro.at(i)->compute_current_batch(sols, name);
+
+        for(unsigned int j = 0; j < n_points; j++){
+            curr[j] += vol*sol.at(current_density)[j];
+            eff[j] += vol*sol.at(CL_effectiveness)[j];
+
+            if(sol.has(OH_coverage))
+                C_OH[j] += vol*sol.at(OH_coverage)[j];
+            if(sol.has(O_coverage))
+                C_O[j] += vol*sol.at(O_coverage)[j];
+        }
+    }
+
+    SolutionMap answer;
+    answer.push_back(SolutionVariable(curr, current_density));
+    answer.push_back(SolutionVariable(eff, CL_effectiveness));
+    answer.push_back(SolutionVariable(C_OH, OH_coverage));
+    answer.push_back(SolutionVariable(C_O, O_coverage));
+
+    return answer;
+}
+
 //---------------------------------------------------------------------------------//
 double
 NAME::PolyAgglomerate::aux_volume_fraction(){
@@ -209,5 +290,6 @@ NAME::PolyAgglomerate::make_thread_safe(ParameterHandler &param, unsigned int th
     for(unsigned int i = 0; i < micro.size(); i++)
         micro.at(i)->make_thread_safe(param, thread_index);
 
+    thread_safe = true;
 
 }
@@ -116,7 +116,7 @@ NAME::ORRCurrentDensityResponse<dim>::compute_responses(std::vector< FuelCellSho
     FuelCellShop::Layer::CatalystLayer<dim>* catalyst_layer = dynamic_cast< FuelCellShop::Layer::CatalystLayer<dim>* >(layer);
 
     catalyst_layer->set_solution(solution_variables);
-    catalyst_layer->set_cell_id(info.dof_active_cell->index());
+    catalyst_layer->set_cell(info.dof_active_cell);
     catalyst_layer->set_local_material_id(info.dof_active_cell->material_id());
     catalyst_layer->current_density(values);
     
@@ -262,7 +262,7 @@ NAME::HORCurrentDensityResponse<dim>::compute_responses(std::vector< FuelCellSho
     FuelCellShop::Layer::CatalystLayer<dim>* catalyst_layer = dynamic_cast< FuelCellShop::Layer::CatalystLayer<dim>* >(layer);
 
     catalyst_layer->set_solution(solution_variables);
-    catalyst_layer->set_cell_id(info.dof_active_cell->index());
+    catalyst_layer->set_cell(info.dof_active_cell);
     catalyst_layer->current_density(values);
 
     for (unsigned int q=0; q<n_q_points_cell; ++q)
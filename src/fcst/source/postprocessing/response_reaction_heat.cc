@@ -87,7 +87,7 @@ NAME::ORRReactionHeatResponse<dim>::compute_responses(const typename DoFApplicat
         if (base_layer == CatalystLayer)
         {
             FuelCellShop::Layer::CatalystLayer<dim>* ptr = dynamic_cast< FuelCellShop::Layer::CatalystLayer<dim>* >(layer);
-            ptr->set_cell_id(info.dof_active_cell->index());
+            ptr->set_cell(info.dof_active_cell);
             
             // Creating a vector to store current and a map to store heat values.
             std::vector<double> current_vec;
@@ -250,7 +250,7 @@ NAME::HORReactionHeatResponse<dim>::compute_responses(const typename DoFApplicat
         if (base_layer == CatalystLayer)
         {
             FuelCellShop::Layer::CatalystLayer<dim>* ptr = dynamic_cast< FuelCellShop::Layer::CatalystLayer<dim>* >(layer);
-            ptr->set_cell_id(info.dof_active_cell->index());
+            ptr->set_cell(info.dof_active_cell);
             
             // Creating a vector to store current and a map to store heat values.
             std::vector<double> current_vec;
@@ -87,6 +87,26 @@ FuelCell::ApplicationCore::AdaptiveRefinement<dim>::declare_parameters(Parameter
                              Patterns::Bool(),
                             "Internal option for developers. Set this value always to false.");
         
+        param.enter_subsection("Nonlinear tolerance schedule");
+        {
+            param.declare_entry("Use tolerance schedule",
+                                "false",
+                                Patterns::Bool(),
+                                "Solve all refinement cycles except the last one to a looser Newton tolerance based on the estimated discretization error.");
+            param.declare_entry("Initial cycle tolerance",
+                                "1e-4",
+                                Patterns::Double(0.0),
+                                "Newton tolerance used in the first refinement cycle.");
+            param.declare_entry("Error estimate scaling",
+                                "1e-2",
+                                Patterns::Double(0.0),
+                                "The Newton tolerance of the intermediate cycles is this value times the global error estimate of the previous mesh.");
+            param.declare_entry("Maximum intermediate tolerance",
+                                "1e-3",
+                                Patterns::Double(0.0),
+                                "Upper bound for the Newton tolerance in the intermediate cycles.");
+        }
+        param.leave_subsection();
     }
     param.leave_subsection();
 
@@ -128,6 +148,14 @@ FuelCell::ApplicationCore::AdaptiveRefinement<dim>::initialize(ParameterHandler&
         L1_L2_error_and_convergence_rate    = param.get_bool("Compute errors and convergence rates");
         nonlinear_solver_for_linear_problem = param.get_bool("Use nonlinear solver for linear problem");
 
+        param.enter_subsection("Nonlinear tolerance schedule");
+        {
+            tolerance_schedule = param.get_bool("Use tolerance schedule");
+            initial_cycle_tolerance = param.get_double("Initial cycle tolerance");
+            error_estimate_scaling = param.get_double("Error estimate scaling");
+            max_intermediate_tolerance = param.get_double("Maximum intermediate tolerance");
+        }
+        param.leave_subsection();
     }
     param.leave_subsection();
 //     param.enter_subsection("Application");
@@ -214,6 +242,13 @@ FuelCell::ApplicationCore::AdaptiveRefinement<dim>::run_app( std::vector<double>
 
     // Send n_ref to the data object
     this->data->enter("n_ref",this->n_ref);        
+
+    // --- Newton tolerance schedule ---
+    FuelCell::ApplicationCore::newtonBase* newton = dynamic_cast<FuelCell::ApplicationCore::newtonBase*>(app);
+    const double final_tolerance = (newton != NULL) ? newton->control.tolerance() : 0.0;
+    double error_estimate = 0.0;
+    if (tolerance_schedule && newton == NULL)
+        FcstUtilities::log << "Nonlinear tolerance schedule is only available for Newton solvers. Ignoring it." << std::endl;
         
     // --- adaptive refinement loop
     for(unsigned int cycle = 0; cycle < this->n_ref; ++cycle)
@@ -247,7 +282,7 @@ FuelCell::ApplicationCore::AdaptiveRefinement<dim>::run_app( std::vector<double>
             // The custom implementation is usually given in the actual linear application class
             // using KellyErrorEstimator<dim>::estimate() function.
             FcstUtilities::log << "Entering estimate..."<<std::endl;
-            app->estimate(vectors);                
+            error_estimate = app->estimate(vectors);                
             FcstUtilities::log << "Exited estimate"<<std::endl;
             
             if( nonlinear_solver_for_linear_problem )
@@ -271,6 +306,13 @@ FuelCell::ApplicationCore::AdaptiveRefinement<dim>::run_app( std::vector<double>
                 last_cycle = true;
                 this->data->enter_flag("last_cycle",true);
             }     
+
+            if (tolerance_schedule && newton != NULL)
+            {
+                const double tolerance = cycle_tolerance(cycle, last_cycle, final_tolerance, error_estimate);
+                newton->control.set_tolerance(tolerance);
+                FcstUtilities::log << "Newton tolerance for cycle " << cycle << " = " << tolerance << std::endl;
+            }
             
             app->solve(solution, vectors);
             
@@ -318,6 +360,10 @@ FuelCell::ApplicationCore::AdaptiveRefinement<dim>::run_app( std::vector<double>
         FcstUtilities::log.pop();
         
     } // ARM LOOP
+
+    // Restore the Newton tolerance for the next call, e.g. the next point in a polarization curve:
+    if (tolerance_schedule && newton != NULL)
+        newton->control.set_tolerance(final_tolerance);
     
     
     if (gradients == true)
@@ -395,6 +441,24 @@ FuelCell::ApplicationCore::AdaptiveRefinement<dim>::print_parameters() const
                            ParameterHandler::Text);
 }
 
+//---------------------------------------------------------------------------
+template <int dim>
+double
+FuelCell::ApplicationCore::AdaptiveRefinement<dim>::cycle_tolerance(const unsigned int cycle,
+                                                                    const bool         last_cycle,
+                                                                    const double       final_tolerance,
+                                                                    const double       error_estimate) const
+{
+    if (last_cycle)
+        return final_tolerance;
+
+    double tolerance = initial_cycle_tolerance;
+    if (cycle > 0)
+        tolerance = std::min(max_intermediate_tolerance, error_estimate_scaling*error_estimate);
+
+    return std::max(final_tolerance, tolerance);
+}
+
 //---------------------------------------------------------------------------
 template <int dim>
 void
@@ -0,0 +1,245 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: newton_pseudo_transient.cc
+//    - Description: Pseudo-transient continuation variant of the Newton-Raphson solver
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <solvers/newton_pseudo_transient.h>
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/lac/block_vector.h>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+using namespace FuelCell::ApplicationCore;
+
+namespace
+{
+    /**
+     * Registers the inverse of the pseudo time step in ApplicationData on construction and removes it
+     * on destruction, i.e., also if the solver is left with an exception.
+     */
+    class PseudoTimeStepRegistration
+    {
+    public:
+        PseudoTimeStepRegistration(ApplicationData& data,
+                                   double&          inv_time_step)
+        :
+        data(data),
+        inv_time_step(inv_time_step)
+        {
+            data.enter("Pseudo time step inverse", inv_time_step);
+        }
+
+        ~PseudoTimeStepRegistration()
+        {
+            data.erase_scalar("Pseudo time step inverse");
+            inv_time_step = 0.0;
+        }
+
+    private:
+        ApplicationData& data;
+        double& inv_time_step;
+    };
+}
+
+//---------------------------------------------------------------------------
+const Event NewtonPseudoTransient::bad_derivative = Event::assign("Newton");
+
+//---------------------------------------------------------------------------
+NewtonPseudoTransient::NewtonPseudoTransient(ApplicationBase& app)
+    : newtonBase(app),
+      initial_time_step(1e-3),
+      min_time_step(1e-12),
+      max_time_step(1e12),
+      ser_exponent(1.0),
+      max_residual_growth(10.0),
+      time_step_reduction(0.1),
+      inv_time_step(0.0)
+{
+  FcstUtilities::log << "->NewtonPseudoTransient";
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonPseudoTransient::declare_parameters(ParameterHandler& param)
+{
+    param.enter_subsection("Newton");
+    {
+        param.enter_subsection("Pseudo-transient continuation");
+        {
+            param.declare_entry("Initial time step",
+                                "1e-3",
+                                Patterns::Double(0.0),
+                                "Initial pseudo time step.");
+            param.declare_entry("Minimum time step",
+                                "1e-12",
+                                Patterns::Double(0.0),
+                                "If the pseudo time step is reduced below this value, the solver stops.");
+            param.declare_entry("Maximum time step",
+                                "1e12",
+                                Patterns::Double(0.0),
+                                "Upper limit for the pseudo time step. For large values the method reduces to Newton's method.");
+            param.declare_entry("SER exponent",
+                                "1.0",
+                                Patterns::Double(0.0),
+                                "Exponent of the residual ratio in the switched evolution relaxation time step update.");
+            param.declare_entry("Maximum residual growth",
+                                "10.0",
+                                Patterns::Double(1.0),
+                                "Steps that increase the residual by more than this factor are rejected.");
+            param.declare_entry("Time step reduction",
+                                "0.1",
+                                Patterns::Double(0.0, 1.0),
+                                "Factor multiplying the pseudo time step after a rejected step.");
+        }
+        param.leave_subsection();
+    }
+    param.leave_subsection();
+
+    newtonBase::declare_parameters(param);
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonPseudoTransient::_initialize (ParameterHandler& param)
+{
+    param.enter_subsection("Newton");
+    {
+        param.enter_subsection("Pseudo-transient continuation");
+        {
+            initial_time_step = param.get_double("Initial time step");
+            min_time_step = param.get_double("Minimum time step");
+            max_time_step = param.get_double("Maximum time step");
+            ser_exponent = param.get_double("SER exponent");
+            max_residual_growth = param.get_double("Maximum residual growth");
+            time_step_reduction = param.get_double("Time step reduction");
+        }
+        param.leave_subsection();
+    }
+    param.leave_subsection ();
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonPseudoTransient::initialize (ParameterHandler& param)
+{
+    newtonBase::initialize(param);
+    _initialize(param);
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonPseudoTransient::solve (FuelCell::ApplicationCore::FEVector& u, const FuelCell::ApplicationCore::FEVectors& in_vectors)
+{
+    this->step = 0;
+
+    if (debug>2)
+        FcstUtilities::log << "u: " << u.l2_norm() << std::endl;
+
+    FEVector Du;
+    FEVector res;
+    FEVector res_old;
+
+    res.reinit(u);
+    Du.reinit(u);
+    FEVectors src1;
+    FEVectors src2;
+    src1.add_vector(u, "Newton iterate");
+    src1.merge(in_vectors);
+    src2.add_vector(res, "Newton residual");
+    src2.merge(src1);
+
+    // Register the inverse of the pseudo time step so that the application adds the pseudo-transient term:
+    double time_step = initial_time_step;
+    inv_time_step = 1.0/time_step;
+    const PseudoTimeStepRegistration registration(*this->get_data(), inv_time_step);
+
+    // fill res with (f(u), v)
+    double residual = app->residual(res, src1);
+    FcstUtilities::log << "Overall residual at iteration "<<this->step<<" = " << residual << std::endl;
+    double old_residual = residual;
+
+    // Output the solution at the Newton iteration if residual debug is on
+    this->debug_output(u, Du, res);
+
+    bool reassemble = true;
+    bool step_rejected = false;
+
+    while (control.check(this->step++, residual) == SolverControl::iterate)
+    {
+        // assemble (Df(u), v). After a rejected step the Jacobian is still evaluated at u, only the pseudo-transient term changes.
+        if (reassemble || (!step_rejected && residual/old_residual >= assemble_threshold))
+            app->notify (bad_derivative);
+        reassemble = false;
+        step_rejected = false;
+
+        inv_time_step = 1.0/time_step;
+        FcstUtilities::log << "Pseudo time step = " << time_step << std::endl;
+
+        Du.reinit(u);
+
+        try
+        {
+            app->solve (Du, src2);
+        }
+        catch (SolverControl::NoConvergence& e)
+        {
+            FcstUtilities::log << "Inner iteration failed after "
+            << e.last_step << " steps with residual "
+            << e.last_residual << std::endl;
+        }
+
+        // Backward Euler step
+        res_old = res;
+        u.add(-1.0, Du);
+        const double new_residual = app->residual(res, src1);
+
+        if (std::isnan(new_residual) || new_residual > max_residual_growth*residual)
+        {
+            // Reject the step and reduce the pseudo time step
+            u.add(1.0, Du);
+            res = res_old;
+            time_step *= time_step_reduction;
+
+            FcstUtilities::log << "Pseudo-transient step rejected (residual = " << new_residual
+                               << "). Reducing pseudo time step." << std::endl;
+
+            AssertThrow (time_step >= min_time_step, ExcMessage ("Pseudo time step is smaller than the minimum time step in NewtonPseudoTransient"));
+
+            step_rejected = true;
+            continue;
+        }
+
+        old_residual = residual;
+        residual = new_residual;
+
+        // Switched evolution relaxation (SER) time step update:
+        time_step *= std::pow(old_residual/residual, ser_exponent);
+        time_step = std::min(std::max(time_step, min_time_step), max_time_step);
+
+        // Output the global residual and the equation specific residual:
+        for (unsigned int i = 0; i<res.n_blocks(); i++)
+            FcstUtilities::log << "Residual for equation "<<i<<" is: "<<res.block(i).l2_norm() << std::endl;
+        FcstUtilities::log << "Overall residual at iteration "<<this->step<<" = " << residual << std::endl;
+
+        // Debug output options:
+        this->debug_output(u, Du, res);
+    }
+
+    // in case of failure: throw exception
+    if (control.last_check() != SolverControl::success)
+        AssertThrow (false, ExcMessage ("No convergence in pseudo-transient continuation solver"));
+}
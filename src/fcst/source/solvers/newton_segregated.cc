@@ -0,0 +1,277 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: newton_segregated.cc
+//    - Description: Segregated (nonlinear block Gauss-Seidel) variant of the Newton-Raphson solver
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <solvers/newton_segregated.h>
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/lac/block_vector.h>
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+#include <algorithm>
+
+using namespace FuelCell::ApplicationCore;
+
+namespace
+{
+    /**
+     * Registers the index of the stage being solved in ApplicationData on construction and removes it
+     * on destruction, i.e., also if the sweep is left with an exception.
+     */
+    class SegregatedStageRegistration
+    {
+    public:
+        SegregatedStageRegistration(ApplicationData& data,
+                                    double&          stage)
+        :
+        data(data)
+        {
+            data.enter("Segregated solve stage", stage);
+        }
+
+        ~SegregatedStageRegistration()
+        {
+            data.erase_scalar("Segregated solve stage");
+        }
+
+    private:
+        ApplicationData& data;
+    };
+}
+
+//---------------------------------------------------------------------------
+const Event NewtonSegregated::bad_derivative = Event::assign("Newton");
+
+//---------------------------------------------------------------------------
+NewtonSegregated::NewtonSegregated(ApplicationBase& app)
+    : newtonBase(app),
+      max_inner_steps(5),
+      inner_reduction(1e-2),
+      aitken(true),
+      initial_relaxation(1.0),
+      min_relaxation(0.1),
+      max_relaxation(1.5),
+      stage(0.0)
+{
+  FcstUtilities::log << "->NewtonSegregated";
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonSegregated::declare_parameters(ParameterHandler& param)
+{
+    param.enter_subsection("Newton");
+    {
+        param.enter_subsection("Segregated solve");
+        {
+            param.declare_entry("Maximum inner iterations",
+                                "5",
+                                Patterns::Integer(1),
+                                "Maximum number of Newton iterations performed for each stage at every outer iteration.");
+            param.declare_entry("Inner residual reduction",
+                                "1e-2",
+                                Patterns::Double(0.0, 1.0),
+                                "Newton iterations for a stage stop once the stage residual is reduced by this factor.");
+            param.declare_entry("Aitken relaxation",
+                                "true",
+                                Patterns::Bool(),
+                                "Accelerate the outer iterations using Aitken's dynamic relaxation. If false, the outer "
+                                "iterations are relaxed using the initial relaxation factor.");
+            param.declare_entry("Initial relaxation",
+                                "1.0",
+                                Patterns::Double(0.0),
+                                "Relaxation factor used in the first outer iteration.");
+            param.declare_entry("Minimum relaxation",
+                                "0.1",
+                                Patterns::Double(0.0),
+                                "Lower limit for the Aitken relaxation factor.");
+            param.declare_entry("Maximum relaxation",
+                                "1.5",
+                                Patterns::Double(0.0),
+                                "Upper limit for the Aitken relaxation factor.");
+        }
+        param.leave_subsection();
+    }
+    param.leave_subsection();
+
+    newtonBase::declare_parameters(param);
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonSegregated::_initialize (ParameterHandler& param)
+{
+    param.enter_subsection("Newton");
+    {
+        param.enter_subsection("Segregated solve");
+        {
+            max_inner_steps = param.get_integer("Maximum inner iterations");
+            inner_reduction = param.get_double("Inner residual reduction");
+            aitken = param.get_bool("Aitken relaxation");
+            initial_relaxation = param.get_double("Initial relaxation");
+            min_relaxation = param.get_double("Minimum relaxation");
+            max_relaxation = param.get_double("Maximum relaxation");
+        }
+        param.leave_subsection();
+    }
+    param.leave_subsection ();
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonSegregated::initialize (ParameterHandler& param)
+{
+    newtonBase::initialize(param);
+    _initialize(param);
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonSegregated::solve (FuelCell::ApplicationCore::FEVector& u, const FuelCell::ApplicationCore::FEVectors& in_vectors)
+{
+    this->step = 0;
+
+    const double* n_stages_ptr = this->get_data()->scalar("Number of segregated stages");
+    AssertThrow (n_stages_ptr != NULL,
+                 ExcMessage ("The application does not register <Number of segregated stages>, i.e., it does not support the segregated solver"));
+    const unsigned int n_stages = static_cast<unsigned int>(*n_stages_ptr + 0.5);
+
+    if (debug>2)
+        FcstUtilities::log << "u: " << u.l2_norm() << std::endl;
+
+    FEVector res;
+    FEVector u_old;
+    FEVector d;
+    FEVector d_old;
+
+    res.reinit(u);
+    d.reinit(u);
+    FEVectors src1;
+    FEVectors src2;
+    src1.add_vector(u, "Newton iterate");
+    src1.merge(in_vectors);
+    src2.add_vector(res, "Newton residual");
+    src2.merge(src1);
+
+    // fill res with (f(u), v) for the coupled problem
+    double residual = app->residual(res, src1);
+    FcstUtilities::log << "Overall residual at iteration "<<this->step<<" = " << residual << std::endl;
+
+    // Output the solution at the Newton iteration if residual debug is on
+    this->debug_output(u, d, res);
+
+    double omega = initial_relaxation;
+    bool has_previous = false;
+
+    while (control.check(this->step++, residual) == SolverControl::iterate)
+    {
+        u_old = u;
+
+        // Gauss-Seidel sweep over the stages:
+        {
+            const SegregatedStageRegistration registration(*this->get_data(), stage);
+            for (unsigned int s = 0; s < n_stages; ++s)
+            {
+                stage = s;
+                solve_stage(u, res, src1, src2);
+            }
+        }
+
+        // Relaxation of the outer iteration:
+        d = u;
+        d.add(-1.0, u_old);
+
+        if (aitken && has_previous)
+        {
+            FEVector dd(d);
+            dd.add(-1.0, d_old);
+            const double denominator = dd.norm_sqr();
+
+            if (denominator > 0.0)
+                omega = -omega*(d_old*dd)/denominator;
+
+            omega = std::min(std::max(omega, min_relaxation), max_relaxation);
+        }
+
+        if (omega != 1.0)
+        {
+            u = u_old;
+            u.add(omega, d);
+        }
+
+        d_old = d;
+        has_previous = true;
+
+        FcstUtilities::log << "Outer iteration relaxation factor = " << omega << std::endl;
+
+        residual = app->residual(res, src1);
+
+        // Output the global residual and the equation specific residual:
+        for (unsigned int i = 0; i<res.n_blocks(); i++)
+            FcstUtilities::log << "Residual for equation "<<i<<" is: "<<res.block(i).l2_norm() << std::endl;
+        FcstUtilities::log << "Overall residual at iteration "<<this->step<<" = " << residual << std::endl;
+
+        // Debug output options:
+        this->debug_output(u, d, res);
+    }
+
+    // in case of failure: throw exception
+    if (control.last_check() != SolverControl::success)
+        AssertThrow (false, ExcMessage ("No convergence in segregated solver"));
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonSegregated::solve_stage (FuelCell::ApplicationCore::FEVector& u,
+                               FuelCell::ApplicationCore::FEVector& res,
+                               const FuelCell::ApplicationCore::FEVectors& src1,
+                               const FuelCell::ApplicationCore::FEVectors& src2)
+{
+    FEVector Du;
+
+    // Residual of the equations in the current stage:
+    double residual = app->residual(res, src1);
+    const double target = std::max(inner_reduction*residual, control.tolerance());
+
+    FcstUtilities::log << "Stage " << stage << ": initial residual = " << residual << std::endl;
+
+    for (unsigned int i = 0; i < max_inner_steps && residual > target; ++i)
+    {
+        // The stage changes the equations assembled, hence the Jacobian is always rebuilt:
+        app->notify (bad_derivative);
+
+        Du.reinit(u);
+
+        try
+        {
+            app->solve (Du, src2);
+        }
+        catch (SolverControl::NoConvergence& e)
+        {
+            FcstUtilities::log << "Inner iteration failed after "
+            << e.last_step << " steps with residual "
+            << e.last_residual << std::endl;
+        }
+
+        u.add(-1.0, Du);
+        residual = app->residual(res, src1);
+
+        if (std::isnan(residual))
+            AssertThrow (false, ExcMessage ("The residual is NaN in segregated solver"));
+
+        FcstUtilities::log << "Stage " << stage << ": residual at inner iteration " << i+1 << " = " << residual << std::endl;
+    }
+}
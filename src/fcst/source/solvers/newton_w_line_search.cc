@@ -23,6 +23,7 @@
 #include <string>
 #include <sstream>
 #include <cmath>
+#include <vector>
 
 using namespace FuelCell::ApplicationCore;
 
@@ -31,7 +32,9 @@ const Event NewtonLineSearch::bad_derivative = Event::assign("Newton");
 
 //---------------------------------------------------------------------------
 NewtonLineSearch::NewtonLineSearch(ApplicationBase& app)
-    : newtonBase(app)
+    : newtonBase(app),
+      broyden(false),
+      max_broyden_updates(10)
 {
   FcstUtilities::log << "->NewtonLineSearch";
 }
@@ -60,6 +63,15 @@ NewtonLineSearch::declare_parameters(ParameterHandler& param)
                             "0", 
                             Patterns::Integer(),
                             "This enforces a given solution variable to be positive. If it goes negative, step size is reduced.");        
+        param.declare_entry("Broyden updates",
+                            "false",
+                            Patterns::Bool(),
+                            "Apply Broyden updates to the last assembled Jacobian in the iterations where the matrix is not reassembled, "
+                            "i.e., if the residual reduction is smaller than the Assemble threshold.");
+        param.declare_entry("Max Broyden updates",
+                            "10",
+                            Patterns::Integer(1),
+                            "Number of Broyden updates stored before the Jacobian is assembled anew.");
     }
     param.leave_subsection();
 
@@ -75,6 +87,8 @@ NewtonLineSearch::_initialize (ParameterHandler& param)
     overrelax = param.get_double("Initial Overrelaxation");
     overrelax_steps = param.get_integer("Number of iterations with overrelaxation");
     block_to_fix = param.get_integer("Solution variable not allowed to be negative");    
+    broyden = param.get_bool("Broyden updates");
+    max_broyden_updates = param.get_integer("Max Broyden updates");
     param.leave_subsection ();
 }
 
@@ -115,12 +129,29 @@ NewtonLineSearch::solve (FuelCell::ApplicationCore::FEVector& u, const FuelCell:
     // Output the solution at the Newton iteration if residual debug is on
     this->debug_output(u, Du, res);
 
+    // Data used for the Broyden updates:
+    FEVector u_old;
+    FEVector Du_old;
+    FEVector s_old;
+    bool previous_step = false;
+    bool broyden_failed = false;
+    broyden_u.clear();
+    broyden_s.clear();
+
     //
     while (control.check(this->step++, residual) == SolverControl::iterate)
     {
         // assemble (Df(u), v)
-        if (residual/old_residual >= assemble_threshold)
+        bool reassemble = (residual/old_residual >= assemble_threshold);
+        if (broyden)
+            reassemble = reassemble || !previous_step || broyden_failed || (broyden_s.size() >= max_broyden_updates);
+
+        if (reassemble)
+        {
             app->notify (bad_derivative);
+            broyden_u.clear();
+            broyden_s.clear();
+        }
 
         Du.reinit(u);
 
@@ -135,6 +166,15 @@ NewtonLineSearch::solve (FuelCell::ApplicationCore::FEVector& u, const FuelCell:
             << e.last_residual << std::endl;
         }
 
+        if (broyden)
+        {
+            if (!reassemble)
+                broyden_update(Du, Du_old, s_old);
+            Du_old = Du;
+            u_old = u;
+        }
+        const double residual_before_step = residual;
+
         ////////////////////////////////////////////////////////////
         //-- Step size control
         ////////////////////////////////////////////////////////////
@@ -248,6 +288,16 @@ NewtonLineSearch::solve (FuelCell::ApplicationCore::FEVector& u, const FuelCell:
             }
         }
 
+        if (broyden)
+        {
+            s_old = u;
+            s_old -= u_old;
+            previous_step = true;
+            broyden_failed = !(residual < residual_before_step);
+            if (broyden_failed && !reassemble)
+                FcstUtilities::log << "Broyden step did not reduce the residual. The Jacobian will be reassembled." << std::endl;
+        }
+
         // Output the global residual and the equation specific residual:
         for (unsigned int i = 0; i<res.n_blocks(); i++)
             FcstUtilities::log << "Residual for equation "<<i<<" is: "<<res.block(i).l2_norm() << std::endl;
@@ -283,4 +333,41 @@ NewtonLineSearch::find_negative_values(const FEVector& u)
     */
     return negative_values;
     
-}
\ No newline at end of file
+}
+
+//---------------------------------------------------------------------------
+void
+NewtonLineSearch::broyden_update(FEVector& Du,
+                                 const FEVector& Du_old,
+                                 const FEVector& s_old)
+{
+    // The solver returns Du = H_0 F(x_k), where H_0 is the inverse of the last assembled Jacobian, and
+    // the solution is updated with -Du. Apply the stored updates, i.e., Du = H_{k-1} F(x_k):
+    for (unsigned int j = 0; j < broyden_u.size(); ++j)
+        Du.add(broyden_s[j]*Du, broyden_u[j]);
+
+    // Update corresponding to the last step: w = H_{k-1} y_{k-1} = H_{k-1} F(x_k) - H_{k-1} F(x_{k-1})
+    FEVector w(Du);
+    w -= Du_old;
+
+    const double denominator = s_old*w;
+
+    if (std::fabs(denominator) <= 1.0e-12*s_old.l2_norm()*w.l2_norm() || std::isnan(denominator))
+    {
+        FcstUtilities::log << "Broyden update skipped: secant condition is degenerate." << std::endl;
+        return;
+    }
+
+    // H_k = (I + u s^T) H_{k-1} with u = (s - H_{k-1} y)/(s^T H_{k-1} y), such that H_k y = s
+    FEVector u_new(s_old);
+    u_new -= w;
+    u_new /= denominator;
+
+    broyden_s.push_back(s_old);
+    broyden_u.push_back(u_new);
+
+    Du.add(broyden_s.back()*Du, broyden_u.back());
+
+    if (debug>0)
+        FcstUtilities::log << "Number of Broyden updates applied: " << broyden_s.size() << std::endl;
+}
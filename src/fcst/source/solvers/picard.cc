@@ -16,6 +16,7 @@
 #include <solvers/picard.h> 
 #include <deal.II/base/data_out_base.h>
 #include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/full_matrix.h>
 
 #include <iomanip>
 #include <iostream>
@@ -23,6 +24,8 @@
 #include <string>
 #include <sstream>
 #include <cmath>
+#include <limits>
+#include <algorithm>
 
 using namespace FuelCell::ApplicationCore;
 
@@ -30,7 +33,15 @@ using namespace FuelCell::ApplicationCore;
 //---------------------------------------------------------------------------
 Picard::Picard(ApplicationBase& app)
     : PicardBase(app),
-    underrelaxation(false)
+    underrelaxation(false),
+    anderson(false),
+    anderson_depth(5),
+    anderson_mixing(1.0),
+    anderson_restart_when_full(false),
+    anderson_safeguard(2.0),
+    anderson_regularization(1e-10),
+    anderson_f_old_norm(0.0),
+    anderson_has_previous(false)
 {
   FcstUtilities::log << "->Picard";
 }
@@ -54,6 +65,30 @@ Picard::declare_parameters(ParameterHandler& param)
                             "0.6", 
                             Patterns::Double(),
                             "Gamma min value for underrelaxation;Range of 0.1-0.6 works best");
+        param.declare_entry("Anderson acceleration",
+                            "false",
+                            Patterns::Bool(),
+                            "Use Anderson acceleration of the fixed-point iterations. Ignored if Under-relaxation is used.");
+        param.declare_entry("Anderson depth",
+                            "5",
+                            Patterns::Integer(1),
+                            "Number of residual differences stored for Anderson acceleration");
+        param.declare_entry("Anderson mixing",
+                            "1.0",
+                            Patterns::Double(0.0, 1.0),
+                            "Mixing parameter for Anderson acceleration; 1.0 corresponds to no damping");
+        param.declare_entry("Anderson restart",
+                            "false",
+                            Patterns::Bool(),
+                            "Clear the complete history once it reaches the Anderson depth, instead of discarding the oldest entry");
+        param.declare_entry("Anderson safeguard factor",
+                            "2.0",
+                            Patterns::Double(1.0),
+                            "Restart Anderson acceleration if the fixed-point residual grows by more than this factor in one iteration");
+        param.declare_entry("Anderson regularization",
+                            "1e-10",
+                            Patterns::Double(std::numeric_limits<double>::epsilon()),
+                            "Relative regularization added to the diagonal of the Anderson least-squares problem. Must be positive so that the normal matrix is not singular.");
     }
     param.leave_subsection();      
 }
@@ -68,8 +103,20 @@ Picard::initialize (ParameterHandler& param)
         underrelaxation = param.get_bool("Under-relaxation");
         alpha = param.get_double("Alpha");
         gamma_min = param.get_double("Gamma min");
+        anderson = param.get_bool("Anderson acceleration");
+        anderson_depth = param.get_integer("Anderson depth");
+        anderson_mixing = param.get_double("Anderson mixing");
+        anderson_restart_when_full = param.get_bool("Anderson restart");
+        anderson_safeguard = param.get_double("Anderson safeguard factor");
+        anderson_regularization = param.get_double("Anderson regularization");
     }
     param.leave_subsection();
+
+    AssertThrow(anderson_regularization > 0.0,
+                ExcMessage("Anderson regularization has to be strictly positive."));
+
+    if (underrelaxation && anderson)
+        FcstUtilities::log << "Both under-relaxation and Anderson acceleration are selected for Picard. Only under-relaxation will be used." << std::endl;
 }
 
 //---------------------------------------------------------------------------
@@ -102,6 +149,8 @@ Picard::solve (FuelCell::ApplicationCore::FEVector& u, const FuelCell::Applicati
     this->debug_output(u, u_n, res);
     app->notify(Event::assign("Picard"));
     double old_error = 1e5;
+
+    this->anderson_restart();
     
     //
     while ((abs_error > this->abs_tolerance) && (rel_error > this->rel_tolerance) && (this->step < this->maxsteps))
@@ -162,6 +211,9 @@ Picard::solve (FuelCell::ApplicationCore::FEVector& u, const FuelCell::Applicati
             for(unsigned int i=0; i<u_n.size();i++)
                 u(i)=u(i)+gamma*(u_n(i)-u(i));
         }
+        // Anderson accelerated scheme
+        else if (this->anderson)
+            this->anderson_update(u, u_n);
         //Pure Picard scheme
         else
             u=u_n;
@@ -217,4 +269,125 @@ Picard::compute_errors ( FEVector &u, FEVector &u_n, FEVector &error, double &ab
     rel_error = error.l2_norm()/u_n.l2_norm();
     if (flag)
         FcstUtilities::log<<"Negative values in solution were set to zero!!!"<<std::endl;
+}
+
+//---------------------------------------------------------------------------
+void
+Picard::anderson_update(FEVector& u, const FEVector& u_n)
+{
+    // Fixed-point residual f = G(u) - u
+    FEVector f(u_n);
+    f -= u;
+    const double f_norm = f.l2_norm();
+
+    if (this->anderson_has_previous)
+    {
+        if (f_norm > this->anderson_safeguard*this->anderson_f_old_norm)
+        {
+            FcstUtilities::log << "Anderson: fixed-point residual grew from " << this->anderson_f_old_norm
+                               << " to " << f_norm << ". Restarting history." << std::endl;
+            this->anderson_restart();
+        }
+        else
+        {
+            // A full history is cleared before the newest difference is added, so that it is kept after a restart
+            if (this->anderson_restart_when_full && this->anderson_dF.size() >= this->anderson_depth)
+            {
+                this->anderson_dF.clear();
+                this->anderson_dG.clear();
+            }
+
+            this->anderson_dF.push_back(f);
+            this->anderson_dF.back() -= this->anderson_f_old;
+            this->anderson_dG.push_back(u_n);
+            this->anderson_dG.back() -= this->anderson_g_old;
+
+            if (this->anderson_dF.size() > this->anderson_depth)
+            {
+                this->anderson_dF.pop_front();
+                this->anderson_dG.pop_front();
+            }
+        }
+    }
+
+    this->anderson_f_old = f;
+    this->anderson_g_old = u_n;
+    this->anderson_f_old_norm = f_norm;
+    this->anderson_has_previous = true;
+
+    const unsigned int m = this->anderson_dF.size();
+
+    Vector<double> gamma(m);
+    if (m > 0)
+    {
+        // Least-squares problem min || f - dF gamma || solved using the regularized normal equations
+        FullMatrix<double> A(m, m);
+        Vector<double> rhs(m);
+        double trace = 0.0;
+        for (unsigned int i = 0; i < m; ++i)
+        {
+            rhs(i) = this->anderson_dF[i]*f;
+            for (unsigned int j = 0; j <= i; ++j)
+            {
+                A(i,j) = this->anderson_dF[i]*this->anderson_dF[j];
+                A(j,i) = A(i,j);
+            }
+            trace += A(i,i);
+        }
+
+        const double reg = this->anderson_regularization*std::max(trace/m, std::numeric_limits<double>::min());
+        for (unsigned int i = 0; i < m; ++i)
+            A(i,i) += reg;
+
+        A.gauss_jordan();
+        A.vmult(gamma, rhs);
+
+        if (!std::isfinite(gamma.l2_norm()) || gamma.linfty_norm() > 1.0/std::sqrt(this->anderson_regularization + std::numeric_limits<double>::epsilon()))
+        {
+            FcstUtilities::log << "Anderson: ill-conditioned least-squares problem. Restarting history." << std::endl;
+            this->anderson_restart();
+            this->anderson_f_old = f;
+            this->anderson_g_old = u_n;
+            this->anderson_f_old_norm = f_norm;
+            this->anderson_has_previous = true;
+            gamma.reinit(0);
+        }
+    }
+
+    // u^{N+1} = G(u^N) - dG gamma - (1-beta)(f^N - dF gamma)
+    u = u_n;
+    for (unsigned int i = 0; i < gamma.size(); ++i)
+        u.add(-gamma(i), this->anderson_dG[i]);
+
+    if (this->anderson_mixing < 1.0)
+    {
+        FEVector r(f);
+        for (unsigned int i = 0; i < gamma.size(); ++i)
+            r.add(-gamma(i), this->anderson_dF[i]);
+        u.add(-(1.0 - this->anderson_mixing), r);
+    }
+
+    if (debug>1)
+        FcstUtilities::log << "Anderson: depth used = " << gamma.size() << ", |f| = " << f_norm << std::endl;
+
+    // Same positivity treatment as for the plain Picard update
+    bool flag = false;
+    for (unsigned int i = 0; i < u.size(); ++i)
+        if (u(i) < 0)
+        {
+            flag = true;
+            u(i) = 0;
+        }
+    if (flag)
+        FcstUtilities::log<<"Negative values in accelerated solution were set to zero!!!"<<std::endl;
+}
+
+//---------------------------------------------------------------------------
+void
+Picard::anderson_restart()
+{
+    this->anderson_dF.clear();
+    this->anderson_dG.clear();
+    this->anderson_has_previous = false;
+    this->anderson_f_old_norm = 0.0;
 }
\ No newline at end of file
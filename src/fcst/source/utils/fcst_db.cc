@@ -105,6 +105,7 @@ NAME::FCSTdatabase::FCSTdatabase() {
     //In event of database lock, db interface may reattempt for up to max_lock*max_mill ~ 4 seconds
     max_milli = 100;
     lock_time = 0.0;
+    cleaning_up = false;
 
     //set default db path;
     db_path = FcstUtilities::find_fcst_root() + "databases/main_db";
@@ -166,6 +167,12 @@ NAME::FCSTdatabase::connect(const std::string&  db_path_, const bool& create_if_
         request(sqlCmd);
         //To debug journal_mode print temp[0][0] now, if change of mode was successfull repsonse will be "wal". Make sure Sqlite3 version is 3.7 or greater.
 
+        //In WAL mode, syncing at checkpoints only is safe against corruption and avoids a sync per commit
+        request_no_callback("PRAGMA synchronous=NORMAL;");
+
+        //Databases created by older versions of this class do not have the HEAD_PARAM table
+        if(not index_head())
+            FcstUtilities::log << "FCSTdatabase: Operating conditions could not be indexed." << std::endl;
     }
     else{
         FcstUtilities::log << "FCSTdatabase:Database not found; connection not established." << std::endl;
@@ -183,6 +190,8 @@ NAME::FCSTdatabase::disconnect(){
     int rc;
 
     if (connected){
+        finalize_statements(); //the connection can not be closed while there are prepared statements
+
         rc = sqlite3_close(db); //sqlite returns true if it remains connected
 
         if(rc == SQLITE_OK)
@@ -217,7 +226,6 @@ std::vector<std::vector<double>>
 NAME::FCSTdatabase::get_data(const std::string&  model_name, const DatabaseOC& OC, const double& tolerance, const std::string&  orderby){
 
     std::vector<std::vector<double>> answer;
-    std::vector<double> temp_line;
     //Check for data
     std::string table_name = find_table(model_name, OC, tolerance);
     if(table_name !="NONE"){
@@ -225,27 +233,23 @@ NAME::FCSTdatabase::get_data(const std::string&  model_name, const DatabaseOC& O
 
         if(orderby != "")
             table_name += " ORDER BY " + orderby;
-        //Get everything from the table
-        std::vector<std::vector<std::string>> string_answer = request("SELECT * FROM " + table_name);
 
-        //Change type from string to double
-        for(int i = 0; i != string_answer.size(); i++){
-            temp_line.clear();
-            for(int j = 0; j != string_answer[i].size(); j++){
+        //Get everything from the table. Each data set is read once, hence the statement is not kept.
+        sqlite3_stmt* stmt = prepare("SELECT * FROM " + table_name, false);
 
-                try
-                {
-                    temp_line.push_back(std::atof(string_answer[i][j].c_str()));
-                }
-                catch (std::exception e)
-                {
-                    FcstUtilities::log << "FCSTdatabase:function get_data() cannot return value of double type./n";
-                    FcstUtilities::log << e.what() << std::endl;
-                    exit(1);
-                }
+        if(stmt != NULL){
+            const int columns = sqlite3_column_count(stmt);
+            std::vector<double> temp_line(columns);
+
+            //Values are read as doubles, tables created by older versions of this class store them as text
+            while(step(stmt) == SQLITE_ROW){
+                for(int j = 0; j < columns; j++)
+                    temp_line[j] = sqlite3_column_double(stmt, j);
 
+                answer.push_back(temp_line);
             }
-            answer.push_back(temp_line);
+
+            sqlite3_finalize(stmt);
         }
 
     }
@@ -300,12 +304,8 @@ NAME::FCSTdatabase::request(const std::string&  sqlCmd, const bool& useCallBack,
                 FcstUtilities::log << "FCSTdatabase: Reattempting request(" << lockCounter << ")\n";
                 #endif
 
-                std::srand(std::time(0));                                //Seed the random number gen
-                unsigned int t = std::rand()%max_milli;                  //
-                std::chrono::milliseconds dura(t);                       //up to max_milli milliseconds pause
-                std::this_thread::sleep_for(dura);                       //wait for this time
+                wait_for_lock();
                 answer = request(sqlCmd, useCallBack, lockCounter -1);   //decrement lockCounter so that we only make a limited amount of attempts
-                lock_time += double(t)/1000.0;
             }
             else{
 
@@ -346,6 +346,86 @@ NAME::FCSTdatabase::request_no_callback(const std::string&  sqlCmd){
     return request(sqlCmd, false);
 }
 
+//------------------------------------------------------------------------------------//
+void
+NAME::FCSTdatabase::wait_for_lock(){
+    std::srand(std::time(0));                                //Seed the random number gen
+    unsigned int t = std::rand()%max_milli;                  //
+    std::chrono::milliseconds dura(t);                       //up to max_milli milliseconds pause
+    std::this_thread::sleep_for(dura);                       //wait for this time
+    lock_time += double(t)/1000.0;
+}
+
+//------------------------------------------------------------------------------------//
+sqlite3_stmt*
+NAME::FCSTdatabase::prepare(const std::string&  sqlCmd, const bool& keep){
+
+    if(!connected){
+        FcstUtilities::log << "FCSTdatabase:Database connection not established." << std::endl;;
+        throw std::exception();
+    }
+
+    if(keep){
+        std::map<std::string, sqlite3_stmt*>::iterator it = statements.find(sqlCmd);
+
+        if(it != statements.end()){
+            sqlite3_reset(it->second);
+            sqlite3_clear_bindings(it->second);
+            return it->second;
+        }
+    }
+
+    sqlite3_stmt* stmt = NULL;
+    int status = sqlite3_prepare_v2(db, sqlCmd.c_str(), -1, &stmt, NULL);
+
+    //Preparing reads the schema, which may be locked
+    for(int lockCounter = max_lock; (status == SQLITE_BUSY) && (lockCounter > 0); lockCounter--){
+        wait_for_lock();
+        status = sqlite3_prepare_v2(db, sqlCmd.c_str(), -1, &stmt, NULL);
+    }
+
+    if(status != SQLITE_OK){
+        FcstUtilities::log << "FCSTdatabase: SQL error: " << sqlite3_errmsg(db) << ",error code:" << status << "\n" ;
+        sqlite3_finalize(stmt);
+        return NULL;
+    }
+
+    if(keep)
+        statements[sqlCmd] = stmt;
+
+    return stmt;
+}
+
+//------------------------------------------------------------------------------------//
+int
+NAME::FCSTdatabase::step(sqlite3_stmt* stmt){
+
+    int status = sqlite3_step(stmt);
+
+    for(int lockCounter = max_lock; (status == SQLITE_BUSY) && (lockCounter > 0); lockCounter--){
+        //Bindings are kept by reset, hence the statement is simply executed again
+        wait_for_lock();
+        sqlite3_reset(stmt);
+        status = sqlite3_step(stmt);
+    }
+
+    if(status == SQLITE_BUSY)
+        FcstUtilities::log << "FCSTdatabase: A unresolved database lock occurred. \n";
+    else if((status != SQLITE_ROW) && (status != SQLITE_DONE))
+        FcstUtilities::log << "FCSTdatabase: SQL error: " << sqlite3_errmsg(db) << ",error code:" << status << "\n" ;
+
+    return status;
+}
+
+//------------------------------------------------------------------------------------//
+void
+NAME::FCSTdatabase::finalize_statements(){
+    for(std::map<std::string, sqlite3_stmt*>::iterator it = statements.begin(); it != statements.end(); ++it)
+        sqlite3_finalize(it->second);
+
+    statements.clear();
+}
+
 //------------------------------------------------------------------------------------//
 
 bool
@@ -384,6 +464,10 @@ NAME::FCSTdatabase::commit_data(const std::string&  model_name, const DatabaseOC
         FcstUtilities::log << "FCSTdatabase:Data for " + model_name + " already exists in db." << std::endl;
     }
     else{
+        //The head entry, the table and the data are committed in a single transaction, i.e., either all or none of them are stored
+        if(not request_no_callback("BEGIN IMMEDIATE;"))
+            return answer;
+
         //insert new entry to head
 
         std::string table_name = make_new_head_entry(model_name,OC);
@@ -393,12 +477,14 @@ NAME::FCSTdatabase::commit_data(const std::string&  model_name, const DatabaseOC
                 if (fill_empty_table(table_name, data, column_names))
                     answer = true;
             }
+        }
 
-            if (answer == false){
-                //Tidy up the table entry we made in the head since we failed to commit the data
-                std::string  sqlCmd = "delete from head where table_ref ='" + table_name + "'";
-                request_no_callback(sqlCmd);
-            }
+        if (answer)
+            answer = request_no_callback("COMMIT;");
+
+        if (answer == false){
+            //Tidy up the table entry we made in the head since we failed to commit the data
+            request_no_callback("ROLLBACK;");
         }
     }
 
@@ -414,40 +500,146 @@ std::string
 NAME::FCSTdatabase::make_new_head_entry(const std::string&  model_name, const DatabaseOC& OC){
     std::string answer = "NONE"; //the answer is either the new table name or NONE
 
+    if(OC.param_data.size() == 0){
+        FcstUtilities::log << "FCSTdatabase:Cannot commit entry with zero operating condition information." << std::endl;;
+        return answer;
+    }
+
     //Find how many results there are for the model name
 
     //Counting head entry method
-    std::vector<std::vector<std::string>> string_answer = request("SELECT COUNT(MODEL_NAME) FROM HEAD WHERE MODEL_NAME = '" + model_name + "'");
-    int num = std::atoi(string_answer[0][0].c_str());
+    sqlite3_stmt* stmt = prepare("SELECT COUNT(Model_name) FROM HEAD WHERE Model_name = ?;");
+    if(stmt == NULL)
+        return answer;
+
+    sqlite3_bind_text(stmt, 1, model_name.c_str(), -1, SQLITE_TRANSIENT);
+
+    int num = 0;
+    if(step(stmt) == SQLITE_ROW)
+        num = sqlite3_column_int(stmt, 0);
+    sqlite3_reset(stmt);
     num++;
 
-    if(OC.param_data.size() == 0){
-        FcstUtilities::log << "FCSTdatabase:Cannot commit entry with zero operating condition information." << std::endl;;
+    //Add your process id to the start of the string and the counting number to the end. This should ensure uniquness.
+    const std::string table_ref =  model_name + std::to_string(num) + "_" + std::to_string(getpid());
+
+    //Build  the command to create the new head entry, i.e., model name, max_param pairs of OC names and values, and table reference
+    std::string  sqlCmd = "INSERT INTO HEAD VALUES(?";
+    for(int i = 0; i < 2*OC.max_param + 1; i++)
+        sqlCmd += ", ?";
+    sqlCmd += ");";
+
+    stmt = prepare(sqlCmd);
+    if(stmt == NULL)
         return answer;
+
+    sqlite3_bind_text(stmt, 1, model_name.c_str(), -1, SQLITE_TRANSIENT);
+
+    for(int i = 0; i < OC.max_param; i++){
+        //we need to fill in all the blanks for OC
+        const std::string name = (i < OC.param_data.size()) ? OC.param_data[i][0] : "";
+        const std::string value = (i < OC.param_data.size()) ? OC.param_data[i][1] : "";
+
+        sqlite3_bind_text(stmt, 2*i + 2, name.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2*i + 3, value.c_str(), -1, SQLITE_TRANSIENT);
     }
 
-    //Add your process id to the start of the string and the counting number to the end. This should ensure uniquness.
-    answer =  model_name + std::to_string(num) + "_" + std::to_string(getpid());
+    sqlite3_bind_text(stmt, 2*OC.max_param + 2, table_ref.c_str(), -1, SQLITE_TRANSIENT);
+
+    //Execute the command
+    const int status = step(stmt);
+    sqlite3_reset(stmt);
+
+    if((status == SQLITE_DONE) && add_head_params(model_name, table_ref, OC.param_data))
+        answer = table_ref;
+
+    return answer;
+}
+
+//------------------------------------------------------------------------------------//
+bool
+NAME::FCSTdatabase::add_head_params(const std::string&  model_name, const std::string&  table_ref,
+                                    const std::vector<std::vector<std::string>>& param_data){
+
+    sqlite3_stmt* stmt = prepare("INSERT INTO HEAD_PARAM VALUES(?, ?, ?, ?, ?);");
+    if(stmt == NULL)
+        return false;
+
+    for(unsigned int i = 0; i < param_data.size(); i++){
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
 
-    //Build  the command to create the new head entry
-    std::string  sqlCmd = "INSERT INTO HEAD VALUES('" + model_name + "', '";
-    int blank_OC_counter = 10; //TODO: refactor this hard coded variable to constructor
+        sqlite3_bind_text(stmt, 1, model_name.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 2, table_ref.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(stmt, 3, param_data[i][0].c_str(), -1, SQLITE_TRANSIENT);
 
-    for(int i =0; i < OC.param_data.size(); i++){
-        sqlCmd += OC.param_data[i][0] + "', '" + OC.param_data[i][1]  + "','";
-        blank_OC_counter--;
+        //Numerical values are stored in the REAL column so that they can be compared with range queries, the others as text
+        if(FcstUtilities::is_number(param_data[i][1]))
+            sqlite3_bind_double(stmt, 4, std::atof(param_data[i][1].c_str()));
+        else
+            sqlite3_bind_text(stmt, 5, param_data[i][1].c_str(), -1, SQLITE_TRANSIENT);
+
+        if(step(stmt) != SQLITE_DONE){
+            sqlite3_reset(stmt);
+            return false;
+        }
     }
 
-    //we need to fill in all the blanks for OC
-    for(int j =0; j < blank_OC_counter; j++){
-        sqlCmd +=  "', '','";
+    sqlite3_reset(stmt);
+    return true;
+}
+
+//------------------------------------------------------------------------------------//
+bool
+NAME::FCSTdatabase::index_head(){
+
+    bool answer = request_no_callback("CREATE TABLE IF NOT EXISTS 'head_param' ('Model_name' TEXT NOT NULL, 'Table_REF' TEXT NOT NULL, "
+                                      "'Name' TEXT NOT NULL, 'Value' REAL, 'Text' TEXT);")
+               && request_no_callback("CREATE INDEX IF NOT EXISTS head_param_value ON head_param (Model_name, Name, Value);")
+               && request_no_callback("CREATE INDEX IF NOT EXISTS head_param_text ON head_param (Model_name, Name, Text);")
+               && request_no_callback("CREATE INDEX IF NOT EXISTS head_param_ref ON head_param (Table_REF, Name);");
+
+    if(not answer)
+        return false;
+
+    //Find the head entries whose operating conditions are not indexed. This is only the case for databases created by older versions
+    //of this class, hence the write lock is only taken, and the query repeated under it, if there are any.
+    const std::string sqlCmd = "SELECT * FROM HEAD WHERE Table_REF NOT IN (SELECT Table_REF FROM HEAD_PARAM);";
+
+    if(request(sqlCmd).empty())
+        return true;
+
+    if(not request_no_callback("BEGIN IMMEDIATE;"))
+        return false;
+
+    std::vector<std::vector<std::string>> head_info = request(sqlCmd);
+
+    for(unsigned int h = 0; h < head_info.size(); h++){
+        //A line of the head info is the model name, the pairs of OC names and values, and the table reference
+        const std::vector<std::string>& head_line = head_info[h];
+        std::vector<std::vector<std::string>> param_data;
+
+        for(unsigned int i = 1; i + 2 < head_line.size(); i += 2){
+            if((head_line[i] != "") && (head_line[i] != "NULL")){
+                std::vector<std::string> param;
+                param.push_back(head_line[i]);
+                param.push_back(head_line[i+1]);
+                param_data.push_back(param);
+            }
+        }
+
+        if(not add_head_params(head_line.front(), head_line.back(), param_data)){
+            answer = false;
+            break;
+        }
     }
-    //Finish the command string
-    sqlCmd += "" + answer + "');";
 
-    //Execute the command
-    if(!request_no_callback(sqlCmd))
-        answer = "NONE";
+    if(answer)
+        answer = request_no_callback("COMMIT;");
+
+    if(not answer)
+        request_no_callback("ROLLBACK;");
+
     return answer;
 }
 
@@ -460,10 +652,10 @@ NAME::FCSTdatabase::create_table(const std::string&  table_name, const std::vect
     if(column_names.size() >0){
 
         //Build the command to create the table
-        sqlCmd += column_names[0] + " varchar(255) ";
+        sqlCmd += column_names[0] + " REAL ";
 
         for (int i = 1; i < column_names.size(); i++)
-            sqlCmd += ", " + column_names[i] + " varchar(255) ";
+            sqlCmd += ", " + column_names[i] + " REAL ";
 
         sqlCmd += ");";
 
@@ -482,6 +674,12 @@ NAME::FCSTdatabase::create_table(const std::string&  table_name, const std::vect
 void
 NAME::FCSTdatabase::cleanUp(){
 
+    //Errors in the requests below would otherwise call this function again
+    if(cleaning_up)
+        return;
+
+    cleaning_up = true;
+
     #ifdef DEBGUG
         FcstUtilities::log << "FCSTdatabase: Cleaning up database. \n";
     #endif
@@ -509,6 +707,10 @@ NAME::FCSTdatabase::cleanUp(){
             request_no_callback("DELETE FROM HEAD WHERE TABLE_REF = '" + h[0] +"';");
     }
 
+    //Remove the operating conditions of the removed head entries
+    request_no_callback("DELETE FROM HEAD_PARAM WHERE TABLE_REF NOT IN (SELECT TABLE_REF FROM HEAD);");
+
+    cleaning_up = false;
 
 }
 //------------------------------------------------------------------------------------//
@@ -524,46 +726,38 @@ NAME::FCSTdatabase::fill_empty_table(const std::string&  table_name, const std::
     //Check Dimensions of table and data match & make sure table is empty
     if ((rows == 0) && (columns == data[0].size())){
 
-        bool finished = false;
-        int chunk_size = 480/data[0].size(); //ensure that number of selects is under 500 (SQLITE restriction)
-        for(int c = 0; c < data.size() ; c+=chunk_size){
-            //Create the first line of the sql command to add a row of data
-            sqlCmd = "INSERT INTO "+  table_name + " SELECT ";
+        //Create the sql command to add a row of data. It is prepared once and executed for each row with the values bound
+        //as doubles. The rows are stored in the transaction opened by commit_data, hence they are written to disc once.
+        sqlCmd = "INSERT INTO "+  table_name + " VALUES(?";
+        for(int a = 1; a < columns; a++)
+            sqlCmd += ", ?";
+        sqlCmd += ");";
+
+        sqlite3_stmt* stmt = prepare(sqlCmd, false);
 
-            for(int a = 0; a < data[c].size(); a++){
-                           sqlCmd += "'" + FcstUtilities::number_to_string(data[c][a]) + "' as '" + column_names[a] + "',";
-            }
-            sqlCmd.resize(sqlCmd.length() -1); //remove the last ","
+        if (stmt != NULL){
+            answer = true;
 
-            //Add the data progressively
-            for(int i = c+1; i < (c + chunk_size); i++){
+            for(int i = 0; i < data.size(); i++){
 
-                //Ensure chunk does not go out of bounds
-                if (i == data.size()){
-                    finished = true;
+                if (data[i].size() != columns){
+                    answer = false;
                     break;
                 }
 
+                for(int j = 0; j < columns; j++)
+                    sqlite3_bind_double(stmt, j + 1, data[i][j]);
 
-                sqlCmd += " UNION SELECT ";
-
-                for(int j = 0; j < data[i].size(); j++){
-                    sqlCmd += "'" + FcstUtilities::number_to_string(data[i][j]) + "',";
+                if (step(stmt) != SQLITE_DONE){
+                    answer = false;
+                    break;
                 }
-                sqlCmd.resize(sqlCmd.length() -1); //remove the last ","
-
 
+                sqlite3_reset(stmt);
             }
 
-            if (request_no_callback(sqlCmd))
-                answer = true;
-
-            if (finished){
-                break;
-            }
+            sqlite3_finalize(stmt);
         }
-
-
     }
 
 
@@ -583,6 +777,10 @@ NAME::FCSTdatabase::clear_data(const std::string&  model_name, const DatabaseOC&
         if (request_no_callback(sqlCmd))
             answer = true;
 
+        sqlCmd = "DELETE FROM HEAD_PARAM WHERE TABLE_REF ='"+table_name +"';";
+        if (!request_no_callback(sqlCmd))
+            answer = false;
+
 
         //Drop the table
         sqlCmd = "DROP TABLE "+table_name +";";
@@ -603,78 +801,66 @@ NAME::FCSTdatabase::find_table(const std::string&  model_name, const DatabaseOC&
 std::string
 NAME::FCSTdatabase::find_table(const std::string&  model_name, const DatabaseOC& OC, const double& tolerance){
 
-    //Get the relavent head data
-    std::string sqlCmd = "SELECT * FROM HEAD WHERE MODEL_NAME = '" + model_name + "'";
-
-    std::vector<std::vector<std::string>> head_info = request(sqlCmd);
-    std::vector<std::string> head_line; // A line of the head info
-
-    bool term_found;
-    std::string table_ref;
+    //Build the query. The candidate entries are selected with the index on the first OC, and the other OCs are
+    //looked up for each candidate with the index on the table reference. Numerical values are matched within
+    //tolerance, i.e. |OC value - head value| <= tolerance*|OC value|, and strings exactly.
+    std::string sqlCmd;
 
-    //for each line in head_info
-    for(int i = 0; i != head_info.size(); i++) {
-
-        head_line = head_info[i];
-        //note the line's table_ref
-        table_ref = head_line.back();
+    if(OC.param_data.size() == 0){
+        sqlCmd = "SELECT Table_REF FROM HEAD WHERE Model_name = ? LIMIT 1;";
+    }
+    else{
+        std::string tables = "HEAD_PARAM p0";
+        std::string conditions = "p0.Model_name = ?";
 
-        //for each oc in OC
         for(int j = 0; j != OC.param_data.size(); j++) { //for all the OCs
-           term_found = true;
+            const std::string p = "p" + std::to_string(j);
 
-            if (!find_matching_head_term(OC.param_data[j], head_line, tolerance))
-            {
-                term_found = false;
-                break;
+            if(j > 0){
+                tables += ", HEAD_PARAM " + p;
+                conditions += " AND " + p + ".Table_REF = p0.Table_REF";
             }
-        }
 
-        if(term_found){ //We  found matching operating conditions
-            return table_ref;
+            conditions += " AND " + p + ".Name = ?";
+
+            if(FcstUtilities::is_number(OC.param_data[j][1]))
+                conditions += " AND " + p + ".Value BETWEEN ? AND ?";
+            else
+                conditions += " AND " + p + ".Text = ?";
         }
+
+        sqlCmd = "SELECT p0.Table_REF FROM " + tables + " WHERE " + conditions + " LIMIT 1;";
     }
 
-    return "NONE";
-}
+    //The statement only depends on which OCs are numeric, hence it is prepared once for each kind of lookup
+    sqlite3_stmt* stmt = prepare(sqlCmd);
+    if(stmt == NULL)
+        return "NONE";
 
-//------------------------------------------------------------------------------------//
-bool
-NAME::FCSTdatabase::find_matching_head_term(const std::vector<std::string>& OCparam, const std::vector<std::string>& head_line, const double& tolerance){
+    int index = 1;
+    sqlite3_bind_text(stmt, index++, model_name.c_str(), -1, SQLITE_TRANSIENT);
 
-    double diff;
-    //For all the elements in head_line
-    for(int i =0; i < head_line.size() -1; i++){
-        //If the OCparam name is equal to the element
-        if (OCparam[0] == head_line[i]){
-
-            //Is the data entry numeric?
-            if(FcstUtilities::is_number(OCparam[1])){
-                //Yes we are comparing numeric values
-
-                //Zero value case
-                if(std::atof(OCparam[1].c_str()) == 0.0){
-                    if (std::atof(head_line[i+1].c_str()) == 0.0)
-                        diff = 0;
-                }
-                else
-                    diff =((std::abs(std::atof(OCparam[1].c_str()) - std::atof(head_line[i+1].c_str())))/std::abs(std::atof(OCparam[1].c_str())));
+    for(int j = 0; j != OC.param_data.size(); j++) {
+        sqlite3_bind_text(stmt, index++, OC.param_data[j][0].c_str(), -1, SQLITE_TRANSIENT);
 
-                //check if the value is equal within tolerance
+        if(FcstUtilities::is_number(OC.param_data[j][1])){
+            const double value = std::atof(OC.param_data[j][1].c_str());
+            sqlite3_bind_double(stmt, index++, value - tolerance*std::abs(value));
+            sqlite3_bind_double(stmt, index++, value + tolerance*std::abs(value));
+        }
+        else
+            sqlite3_bind_text(stmt, index++, OC.param_data[j][1].c_str(), -1, SQLITE_TRANSIENT);
+    }
 
-                if(diff < tolerance) //if the values match within tolerance
-                    return true;
-            }
-            else {
-                //We are comparing strings
-                if (OCparam[1] == head_line[i+1])
-                    return true;
-            }
+    std::string table_ref = "NONE";
 
+    if(step(stmt) == SQLITE_ROW) //We  found matching operating conditions
+        table_ref = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
 
-        }
-    }
-    return false;
+    //Release the read lock held by the statement
+    sqlite3_reset(stmt);
+
+    return table_ref;
 }
 
 //------------------------------------------------------------------------------------//
@@ -707,7 +893,7 @@ NAME::FCSTdatabase::create_new_db(const std::string& file_path){
                 " 'OC6_dat' TEXT, 'OC7_name' TEXT, 'OC7_dat' TEXT, 'OC8_name' REAL, 'OC8_dat' TEXT, 'OC9_name' TEXT, 'OC9_dat' TEXT, 'OC10_name' TEXT,"
                 " 'OC10_dat' TEXT, 'Table_REF' TEXT NOT NULL)";
 
-        if(request_no_callback(sqlCMD)){ //True means head table was created
+        if(request_no_callback(sqlCMD) && index_head()){ //True means head table was created
 
             //If the head table was created successfully create a test data entry
             DatabaseOC oc;
@@ -731,6 +917,7 @@ NAME::FCSTdatabase::create_new_db(const std::string& file_path){
         }
 
     }
+    finalize_statements();
     sqlite3_close(db);
     connected = false;
 
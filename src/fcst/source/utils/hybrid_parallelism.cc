@@ -0,0 +1,183 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: hybrid_parallelism.cc
+//    - Description: Number of threads per MPI process and thread pinning for hybrid MPI + threads runs
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <utils/hybrid_parallelism.h>
+#include <utils/logging.h>
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace
+{
+    /**
+     * Number of threads per MPI process.
+     */
+    unsigned int threads_per_rank = 1;
+
+#ifdef __linux__
+    /**
+     * Restrict the calling thread, and the threads it creates afterwards, to cores [first, first + n).
+     */
+    bool pin_to_cores (const unsigned int first,
+                       const unsigned int n)
+    {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        for (unsigned int c = first; c < first + n; ++c)
+            CPU_SET(c, &mask);
+
+        return sched_setaffinity(0, sizeof(cpu_set_t), &mask) == 0;
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------
+void
+FcstUtilities::declare_thread_parameters(ParameterHandler& param)
+{
+    param.enter_subsection("Simulator");
+    {
+        param.enter_subsection("Parallel execution");
+        {
+            param.declare_entry("Ranks per node",
+                                "0",
+                                Patterns::Integer(0),
+                                "Number of MPI processes running on each node. If zero, the processes sharing "
+                                "the node are detected using MPI. If it is given, the processes are assumed to be placed "
+                                "on the nodes by blocks of consecutive ranks.");
+            param.declare_entry("Threads per rank",
+                                "0",
+                                Patterns::Integer(0),
+                                "Number of threads used by each MPI process for the microscale solves of the multiscale "
+                                "catalyst layer during assembly and for postprocessing. The macroscale cell loops are not "
+                                "threaded. If zero, the cores of the node are divided among the MPI processes running on the node.");
+            param.declare_entry("Pin threads to cores",
+                                "false",
+                                Patterns::Bool(),
+                                "Pin the threads of each MPI process to a block of consecutive cores so that the processes "
+                                "on a node do not share cores. Only available on Linux.");
+        }
+        param.leave_subsection();
+    }
+    param.leave_subsection();
+}
+
+//---------------------------------------------------------------------------
+void
+FcstUtilities::initialize_threads(ParameterHandler& param)
+{
+    unsigned int ranks_per_node = 0;
+    unsigned int requested_threads = 0;
+    bool pin_threads = false;
+
+    param.enter_subsection("Simulator");
+    {
+        param.enter_subsection("Parallel execution");
+        {
+            ranks_per_node = param.get_integer("Ranks per node");
+            requested_threads = param.get_integer("Threads per rank");
+            pin_threads = param.get_bool("Pin threads to cores");
+        }
+        param.leave_subsection();
+    }
+    param.leave_subsection();
+
+    // Rank of this process among the processes on the node:
+    unsigned int node_rank = 0;
+    unsigned int n_node_ranks = 1;
+
+    if (ranks_per_node > 0)
+    {
+        node_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) % ranks_per_node;
+        n_node_ranks = ranks_per_node;
+    }
+#ifdef DEAL_II_WITH_MPI
+    else
+    {
+        MPI_Comm node_communicator;
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED,
+                            Utilities::MPI::this_mpi_process(MPI_COMM_WORLD), MPI_INFO_NULL, &node_communicator);
+        node_rank = Utilities::MPI::this_mpi_process(node_communicator);
+        n_node_ranks = Utilities::MPI::n_mpi_processes(node_communicator);
+        MPI_Comm_free(&node_communicator);
+    }
+#endif
+
+    const unsigned int n_cores = MultithreadInfo::n_cores();
+
+    if (requested_threads > 0)
+        threads_per_rank = requested_threads;
+    else
+        threads_per_rank = std::max(n_cores/n_node_ranks, 1u);
+
+    if (threads_per_rank*n_node_ranks > n_cores)
+        FcstUtilities::log << "WARNING: " << n_node_ranks << " MPI processes with " << threads_per_rank
+                           << " threads each oversubscribe the " << n_cores << " cores of the node" << std::endl;
+
+    // Both thread pools use the same number of threads:
+    MultithreadInfo::set_thread_limit(threads_per_rank);
+#ifdef _OPENMP
+    omp_set_dynamic(0);
+    omp_set_num_threads(threads_per_rank);
+#endif
+
+    FcstUtilities::log << "Parallel execution: " << n_node_ranks << " MPI processes on this node, "
+                       << threads_per_rank << " threads per process" << std::endl;
+
+    if (!pin_threads)
+        return;
+
+#ifdef __linux__
+    const unsigned int first_core = (node_rank*threads_per_rank) % n_cores;
+    const unsigned int n_block_cores = std::min(threads_per_rank, n_cores - first_core);
+    bool pinned = true;
+
+#ifdef _OPENMP
+    // Each OpenMP thread is pinned to one core of the block. The threads are kept by the OpenMP runtime, hence
+    // the same threads are used by the parallel loops in the microscale:
+    #pragma omp parallel num_threads(threads_per_rank) reduction(&&:pinned)
+    {
+        pinned = pin_to_cores(first_core + omp_get_thread_num() % n_block_cores, 1);
+    }
+#endif
+
+    // The master thread, and the deal.II threads it creates, can run on any core of the block:
+    pinned = pin_to_cores(first_core, n_block_cores) && pinned;
+
+    if (pinned)
+        FcstUtilities::log << "Threads pinned to cores " << first_core << " to " << first_core + n_block_cores - 1 << std::endl;
+    else
+        FcstUtilities::log << "WARNING: Threads could not be pinned to cores" << std::endl;
+#else
+    FcstUtilities::log << "WARNING: Pinning threads to cores is only available on Linux" << std::endl;
+#endif
+}
+
+//---------------------------------------------------------------------------
+unsigned int
+FcstUtilities::n_threads()
+{
+    return threads_per_rank;
+}
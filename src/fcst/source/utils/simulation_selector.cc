@@ -200,6 +200,16 @@ SimulationSelector<dim>::select_solver(FuelCell::ApplicationCore::OptimizationBl
         FcstUtilities::log << "YOU ARE USING NewtonLineSearch NEWTON SOLVER FOR STEADY-STATE PROBLEM" << std::endl;
         return shared_ptr<FuelCell::ApplicationCore::NewtonLineSearch> (new FuelCell::ApplicationCore::NewtonLineSearch(*app_lin));
     }
+    else if( data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::PSEUDOTRANSIENT )
+    {
+        FcstUtilities::log << "YOU ARE USING PSEUDO-TRANSIENT CONTINUATION SOLVER FOR STEADY-STATE PROBLEM" << std::endl;
+        return shared_ptr<FuelCell::ApplicationCore::NewtonPseudoTransient> (new FuelCell::ApplicationCore::NewtonPseudoTransient(*app_lin));
+    }
+    else if( data->get_nonlinear_solver() == FuelCell::ApplicationCore::NonLinearSolver::SEGREGATED )
+    {
+        FcstUtilities::log << "YOU ARE USING SEGREGATED NEWTON SOLVER FOR STEADY-STATE PROBLEM" << std::endl;
+        return shared_ptr<FuelCell::ApplicationCore::NewtonSegregated> (new FuelCell::ApplicationCore::NewtonSegregated(*app_lin));
+    }
     
     else
     {
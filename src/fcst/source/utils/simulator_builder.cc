@@ -281,6 +281,8 @@ void SimulatorBuilder<dim>::declare_parameters(ParameterHandler& param) const
     }
     param.leave_subsection();
     
+    FcstUtilities::declare_thread_parameters(param);
+    
     param_study.declare_parameters(param);
     
     curve.declare_parameters(param);
@@ -334,6 +336,9 @@ void SimulatorBuilder<dim>::initialize(ParameterHandler& param)
     }
     param.leave_subsection();
     
+    // Set the number of threads before the application, i.e., the microscale objects, are created:
+    FcstUtilities::initialize_threads(param);
+    
     data->initialize(param);
 }
 
@@ -0,0 +1,729 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: through_plane_mea_model.cc
+//    - Description: One-dimensional through-plane MEA model used to generate initial solutions
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <utils/through_plane_mea_model.h>
+
+#include <cmath>
+#include <algorithm>
+
+namespace
+{
+    /**
+     * Save the state of the layer objects that ThroughPlaneMEAModel modifies, i.e., the solution of the catalyst layers,
+     * the temperature and membrane water content of the electrolytes and the temperature of the cathode porous layers,
+     * and restore it when the object goes out of scope, also if the one-dimensional model throws.
+     *
+     * Variables that were never set cannot be unset again. They, and the gas diffusion coefficients computed in the
+     * non-isothermal case, are set again at every cell by the equation classes during assembly.
+     */
+    template <int dim>
+    class LayerStateGuard
+    {
+    public:
+        LayerStateGuard(FuelCellShop::Layer::CatalystLayer<dim>* ACL,
+                        FuelCellShop::Layer::MembraneLayer<dim>* ML,
+                        FuelCellShop::Layer::CatalystLayer<dim>* CCL,
+                        const std::vector<FuelCellShop::Layer::PorousLayer<dim>*>& porous_layers)
+        :
+        ACL(ACL),
+        CCL(CCL),
+        porous_layers(porous_layers),
+        ACL_solution(ACL->get_solution()),
+        CCL_solution(CCL->get_solution())
+        {
+            electrolytes.push_back(ACL->get_electrolyte());
+            electrolytes.push_back(ML->get_electrolyte());
+            electrolytes.push_back(CCL->get_electrolyte());
+
+            for (unsigned int i = 0; i < electrolytes.size(); ++i)
+            {
+                electrolyte_lambda.push_back(electrolytes[i]->get_membrane_water_content());
+                electrolyte_T.push_back(electrolytes[i]->get_temperature());
+            }
+
+            for (unsigned int i = 0; i < porous_layers.size(); ++i)
+                porous_T.push_back(porous_layers[i]->get_temperature());
+        }
+
+        ~LayerStateGuard()
+        {
+            try
+            {
+                ACL->unset_local_material_id();
+                CCL->unset_local_material_id();
+
+                if (!ACL_solution.empty())
+                    ACL->set_solution(ACL_solution);
+                if (!CCL_solution.empty())
+                    CCL->set_solution(CCL_solution);
+
+                for (unsigned int i = 0; i < electrolytes.size(); ++i)
+                {
+                    if (electrolyte_lambda[i].is_initialized())
+                        electrolytes[i]->set_membrane_water_content(electrolyte_lambda[i]);
+                    if (electrolyte_T[i].is_initialized())
+                        electrolytes[i]->set_temperature(electrolyte_T[i]);
+                }
+
+                for (unsigned int i = 0; i < porous_layers.size(); ++i)
+                    if (porous_T[i].is_initialized())
+                        porous_layers[i]->set_temperature(porous_T[i]);
+            }
+            catch (const std::exception& e)
+            {
+                FcstUtilities::log << "Through-plane MEA model could not restore the state of the layers: " << e.what() << std::endl;
+            }
+        }
+
+    private:
+        FuelCellShop::Layer::CatalystLayer<dim>* ACL;
+        FuelCellShop::Layer::CatalystLayer<dim>* CCL;
+        std::vector<FuelCellShop::Layer::PorousLayer<dim>*> porous_layers;
+        std::vector<FuelCellShop::Material::PolymerElectrolyteBase*> electrolytes;
+
+        std::vector<FuelCellShop::SolutionVariable> ACL_solution;
+        std::vector<FuelCellShop::SolutionVariable> CCL_solution;
+        std::vector<FuelCellShop::SolutionVariable> electrolyte_lambda;
+        std::vector<FuelCellShop::SolutionVariable> electrolyte_T;
+        std::vector<FuelCellShop::SolutionVariable> porous_T;
+    };
+
+    /**
+     * Solve the block tridiagonal system \f$ A_c x_{c-1} + B_c x_c + C_c x_{c+1} = r_c \f$ with the block Thomas algorithm.
+     * The diagonal blocks \p B and right hand side \p r are overwritten.
+     */
+    void solve_block_tridiagonal(const std::vector< FullMatrix<double> >& A,
+                                 std::vector< FullMatrix<double> >& B,
+                                 const std::vector< FullMatrix<double> >& C,
+                                 std::vector< Vector<double> >& r,
+                                 std::vector< Vector<double> >& x)
+    {
+        const unsigned int n_blocks = B.size();
+        const unsigned int m = (n_blocks > 0) ? B[0].m() : 0;
+
+        FullMatrix<double> L(m, m), LC(m, m);
+        Vector<double> tmp(m);
+
+        // Forward elimination, B is replaced by the inverse of the eliminated diagonal block:
+        for (unsigned int c = 0; c < n_blocks; ++c)
+        {
+            if (c > 0)
+            {
+                A[c].mmult(L, B[c-1]);
+                L.mmult(LC, C[c-1]);
+                B[c].add(-1.0, LC);
+                L.vmult(tmp, r[c-1]);
+                r[c].add(-1.0, tmp);
+            }
+            B[c].gauss_jordan();
+        }
+
+        // Back substitution:
+        x.resize(n_blocks, Vector<double>(m));
+        for (unsigned int c = n_blocks; c-- > 0; )
+        {
+            if (c+1 < n_blocks)
+            {
+                C[c].vmult(tmp, x[c+1]);
+                r[c].add(-1.0, tmp);
+            }
+            B[c].vmult(x[c], r[c]);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+FuelCell::InitialSolution::ThroughPlaneMEAModel<dim>::ThroughPlaneMEAModel(FuelCell::OperatingConditions* OC,
+                                                                           boost::shared_ptr< FuelCellShop::Geometry::GridBase<dim> > grid,
+                                                                           FuelCell::SystemManagement* system_mgmt,
+                                                                           std::shared_ptr< Function<dim> > base_function,
+                                                                           FuelCellShop::Layer::GasDiffusionLayer<dim>* AGDL,
+                                                                           FuelCellShop::Layer::MicroPorousLayer<dim>* AMPL,
+                                                                           FuelCellShop::Layer::CatalystLayer<dim>* ACL,
+                                                                           FuelCellShop::Layer::MembraneLayer<dim>* ML,
+                                                                           FuelCellShop::Layer::CatalystLayer<dim>* CCL,
+                                                                           FuelCellShop::Layer::MicroPorousLayer<dim>* CMPL,
+                                                                           FuelCellShop::Layer::GasDiffusionLayer<dim>* CGDL,
+                                                                           FuelCellShop::Material::PureGas* oxygen,
+                                                                           FuelCellShop::Material::PureGas* nitrogen,
+                                                                           const unsigned int n_cells_per_layer)
+:
+Function<dim> (base_function->n_components),
+OC(OC),
+grid(grid),
+system(system_mgmt),
+base_function(base_function),
+AGDL(AGDL),
+AMPL(AMPL),
+ACL(ACL),
+ML(ML),
+CCL(CCL),
+CMPL(CMPL),
+CGDL(CGDL),
+oxygen(oxygen),
+nitrogen(nitrogen),
+n_cells_per_layer(n_cells_per_layer),
+solved(false),
+has_lambda(false),
+has_temperature(false),
+component_index(n_unknowns, -1)
+{
+    AssertThrow( n_cells_per_layer > 0, ExcMessage("At least one cell per layer is required in ThroughPlaneMEAModel.") );
+
+    has_lambda = system->solution_in_userlist("membrane_water_content");
+    has_temperature = system->solution_in_userlist("temperature_of_REV");
+
+    if (system->solution_in_userlist("electronic_electrical_potential"))
+        component_index[phi_s] = system->solution_name_to_index("electronic_electrical_potential");
+    if (system->solution_in_userlist("protonic_electrical_potential"))
+        component_index[phi_m] = system->solution_name_to_index("protonic_electrical_potential");
+    if (system->solution_in_userlist("oxygen_molar_fraction"))
+        component_index[x_o2] = system->solution_name_to_index("oxygen_molar_fraction");
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+FuelCell::InitialSolution::ThroughPlaneMEAModel<dim>::~ThroughPlaneMEAModel()
+{}
+
+//---------------------------------------------------------------------------
+template <int dim>
+bool
+FuelCell::InitialSolution::ThroughPlaneMEAModel<dim>::is_active(const Unknown unknown,
+                                                                const Region region) const
+{
+    switch (unknown)
+    {
+        case phi_s:
+            return region != ML_region;
+        case phi_m:
+            return region == ACL_region || region == ML_region || region == CCL_region;
+        case x_o2:
+            return region == CCL_region || region == CMPL_region || region == CGDL_region;
+        default:
+            return false;
+    }
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+void
+FuelCell::InitialSolution::ThroughPlaneMEAModel<dim>::make_cells()
+{
+    cell_region.clear();
+    cell_material_id.clear();
+    cell_width.clear();
+    cell_center.clear();
+
+    // Layers and sublayers from the anode to the cathode:
+    std::vector<Region> regions;
+    std::vector<double> thicknesses;
+    std::vector<unsigned int> material_ids;
+
+    regions.push_back(AGDL_region);
+    thicknesses.push_back(grid->L_gdl_a());
+    material_ids.push_back(AGDL->get_material_ids()[0]);
+
+    if (AMPL != NULL && grid->L_mpl_a() > 0.0)
+    {
+        regions.push_back(AMPL_region);
+        thicknesses.push_back(grid->L_mpl_a());
+        material_ids.push_back(AMPL->get_material_ids()[0]);
+    }
+
+    regions.push_back(ACL_region);
+    thicknesses.push_back(grid->L_cat_a());
+    material_ids.push_back(ACL->get_material_ids()[0]);
+
+    regions.push_back(ML_region);
+    thicknesses.push_back(grid->L_mem());
+    material_ids.push_back(ML->get_material_ids()[0]);
+
+    // The cathode catalyst layer can be graded, i.e., made up of several sublayers with different material ids:
+    const std::vector<double> l_cat_c = grid->L_cat_c();
+    const std::vector<unsigned int> ccl_ids = CCL->get_material_ids();
+    for (unsigned int i = 0; i < l_cat_c.size(); ++i)
+    {
+        regions.push_back(CCL_region);
+        thicknesses.push_back(l_cat_c[i]);
+        material_ids.push_back(ccl_ids.size() == l_cat_c.size() ? ccl_ids[i] : ccl_ids[0]);
+    }
+
+    if (CMPL != NULL && grid->L_mpl_c() > 0.0)
+    {
+        regions.push_back(CMPL_region);
+        thicknesses.push_back(grid->L_mpl_c());
+        material_ids.push_back(CMPL->get_material_ids()[0]);
+    }
+
+    regions.push_back(CGDL_region);
+    thicknesses.push_back(grid->L_gdl_c());
+    material_ids.push_back(CGDL->get_material_ids()[0]);
+
+    double x = 0.0;
+    for (unsigned int l = 0; l < regions.size(); ++l)
+    {
+        const double h = thicknesses[l]/n_cells_per_layer;
+        for (unsigned int i = 0; i < n_cells_per_layer; ++i)
+        {
+            cell_region.push_back(regions[l]);
+            cell_material_id.push_back(material_ids[l]);
+            cell_width.push_back(h);
+            cell_center.push_back(x + 0.5*h);
+            x += h;
+        }
+    }
+
+    const unsigned int n_cells = cell_region.size();
+
+    // Initial guess, temperature and membrane water content from the base function:
+    cell_temperature.assign(n_cells, OC->get_T());
+    cell_lambda.assign(n_cells, 0.0);
+    cell_x_h2.assign(n_cells, OC->get_x_h2());
+    solution.assign(n_unknowns*n_cells, 0.0);
+
+    Vector<double> values(this->n_components);
+    Point<dim> p;
+
+    for (unsigned int c = 0; c < n_cells; ++c)
+    {
+        p(0) = cell_center[c];
+        base_function->vector_value(p, values);
+
+        if (has_temperature)
+            cell_temperature[c] = values(system->solution_name_to_index("temperature_of_REV"));
+        if (has_lambda)
+            cell_lambda[c] = values(system->solution_name_to_index("membrane_water_content"));
+
+        if (system->solution_in_userlist("hydrogen_molar_fraction"))
+            cell_x_h2[c] = values(system->solution_name_to_index("hydrogen_molar_fraction"));
+        else if (system->solution_in_userlist("water_molar_fraction"))
+            cell_x_h2[c] = 1.0 - values(system->solution_name_to_index("water_molar_fraction"));
+
+        solution[n_unknowns*c + x_o2] = OC->get_x_o2();
+        for (unsigned int q = 0; q < n_unknowns; ++q)
+            if (component_index[q] >= 0)
+                solution[n_unknowns*c + q] = values(component_index[q]);
+    }
+
+    // Effective transport properties:
+    cell_property.assign(n_unknowns, std::vector<double>(n_cells, 0.0));
+
+    const double p_c = OC->get_pc_Pa();
+
+    for (unsigned int c = 0; c < n_cells; ++c)
+    {
+        const FuelCellShop::SolutionVariable T(cell_temperature[c], 1, temperature_of_REV);
+        const FuelCellShop::SolutionVariable lambda(cell_lambda[c], 1, membrane_water_content);
+        Tensor<2,dim> sigma_s;
+        std::vector<double> sigma_m(1, 0.0);
+
+        FuelCellShop::Layer::PorousLayer<dim>* porous = NULL;
+
+        switch (cell_region[c])
+        {
+            case AGDL_region:
+                AGDL->effective_electron_conductivity(sigma_s);
+                break;
+            case CGDL_region:
+                CGDL->effective_electron_conductivity(sigma_s);
+                porous = CGDL;
+                break;
+            case AMPL_region:
+                AMPL->effective_electron_conductivity(sigma_s);
+                break;
+            case CMPL_region:
+                CMPL->effective_electron_conductivity(sigma_s);
+                porous = CMPL;
+                break;
+            case ACL_region:
+            case CCL_region:
+            {
+                FuelCellShop::Layer::CatalystLayer<dim>* CL = (cell_region[c] == ACL_region) ? ACL : CCL;
+                CL->set_local_material_id(cell_material_id[c]);
+                CL->effective_electron_conductivity(sigma_s);
+
+                if (has_lambda)
+                    CL->get_electrolyte()->set_membrane_water_content(lambda);
+                if (has_temperature)
+                    CL->get_electrolyte()->set_temperature(T);
+                if (has_lambda || has_temperature)
+                    CL->effective_proton_conductivity(sigma_m);
+                else
+                    CL->effective_proton_conductivity(sigma_m[0]);
+
+                if (cell_region[c] == CCL_region)
+                    porous = CCL;
+                break;
+            }
+            case ML_region:
+                if (has_lambda)
+                    ML->get_electrolyte()->set_membrane_water_content(lambda);
+                if (has_temperature)
+                    ML->get_electrolyte()->set_temperature(T);
+                if (has_lambda || has_temperature)
+                    ML->effective_proton_conductivity(sigma_m);
+                else
+                    ML->effective_proton_conductivity(sigma_m[0]);
+                break;
+        }
+
+        if (is_active(phi_s, cell_region[c]))
+            cell_property[phi_s][c] = sigma_s[0][0];
+        if (is_active(phi_m, cell_region[c]))
+            cell_property[phi_m][c] = sigma_m[0];
+
+        // Oxygen transport, i.e., c_tot D_eff in mol/(cm s):
+        if (porous != NULL)
+        {
+            const double concentration = (p_c/(Constants::R()*cell_temperature[c]))*Units::convert(1.,Units::PER_C_UNIT3, Units::PER_UNIT3);
+            double D_eff = 0.0;
+
+            if (has_temperature)
+            {
+                std::vector< Tensor<2,dim> > D;
+                porous->set_temperature(T);
+                porous->compute_gas_diffusion(oxygen, nitrogen);
+                porous->effective_gas_diffusivity(D);
+                D_eff = D[0][0][0];
+            }
+            else
+            {
+                Table<2, double> D;
+                int index_gas, index_solvent;
+                porous->effective_gas_diffusivity(D);
+                porous->get_gas_index(oxygen, index_gas);
+                porous->get_gas_index(nitrogen, index_solvent);
+                D_eff = D(index_gas, index_solvent);
+            }
+
+            cell_property[x_o2][c] = concentration*D_eff*Units::convert(1.,Units::C_UNIT2, Units::UNIT2);
+        }
+    }
+
+    ACL->unset_local_material_id();
+    CCL->unset_local_material_id();
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+void
+FuelCell::InitialSolution::ThroughPlaneMEAModel<dim>::current_density(const std::vector<double>& u,
+                                                                      std::vector<double>& current)
+{
+    const unsigned int n_cells = cell_region.size();
+    current.assign(n_cells, 0.0);
+
+    // Cells with the same material id in a catalyst layer are evaluated together:
+    unsigned int c = 0;
+    while (c < n_cells)
+    {
+        if (cell_region[c] != ACL_region && cell_region[c] != CCL_region)
+        {
+            ++c;
+            continue;
+        }
+
+        unsigned int end = c;
+        while (end < n_cells && cell_region[end] == cell_region[c] && cell_material_id[end] == cell_material_id[c])
+            ++end;
+
+        const unsigned int n = end - c;
+        std::vector<double> phi_s_values(n), phi_m_values(n), reactant(n), T(n), lambda(n);
+        for (unsigned int i = 0; i < n; ++i)
+        {
+            phi_s_values[i] = u[n_unknowns*(c+i) + phi_s];
+            phi_m_values[i] = u[n_unknowns*(c+i) + phi_m];
+            reactant[i] = (cell_region[c] == CCL_region) ? u[n_unknowns*(c+i) + x_o2] : cell_x_h2[c+i];
+            T[i] = cell_temperature[c+i];
+            lambda[i] = cell_lambda[c+i];
+        }
+
+        std::vector<FuelCellShop::SolutionVariable> sols;
+        sols.push_back(FuelCellShop::SolutionVariable(phi_s_values, electronic_electrical_potential));
+        sols.push_back(FuelCellShop::SolutionVariable(phi_m_values, protonic_electrical_potential));
+        sols.push_back(FuelCellShop::SolutionVariable(reactant, (cell_region[c] == CCL_region) ? oxygen_molar_fraction : hydrogen_molar_fraction));
+        if (has_lambda)
+            sols.push_back(FuelCellShop::SolutionVariable(lambda, membrane_water_content));
+        if (has_temperature)
+            sols.push_back(FuelCellShop::SolutionVariable(T, temperature_of_REV));
+
+        FuelCellShop::Layer::CatalystLayer<dim>* CL = (cell_region[c] == ACL_region) ? ACL : CCL;
+        std::vector<double> j(n, 0.0);
+        CL->set_local_material_id(cell_material_id[c]);
+        CL->set_solution(sols);
+        CL->current_density(j);
+        CL->unset_local_material_id();
+
+        for (unsigned int i = 0; i < n; ++i)
+            current[c+i] = j[i];
+
+        c = end;
+    }
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+void
+FuelCell::InitialSolution::ThroughPlaneMEAModel<dim>::residual(const std::vector<double>& u,
+                                                               std::vector<double>& res)
+{
+    const unsigned int n_cells = cell_region.size();
+    res.assign(u.size(), 0.0);
+
+    std::vector<double> current;
+    current_density(u, current);
+
+    const double V_cell = std::fabs(OC->get_V());
+    const double x_o2_channel = OC->get_x_o2();
+    const double F = Constants::F();
+
+    for (unsigned int q = 0; q < n_unknowns; ++q)
+    {
+        const Unknown unknown = static_cast<Unknown>(q);
+        const std::vector<double>& k = cell_property[q];
+
+        for (unsigned int c = 0; c < n_cells; ++c)
+        {
+            const unsigned int i = n_unknowns*c + q;
+
+            // Unknowns that are not solved for in the layer are set to zero:
+            if (!is_active(unknown, cell_region[c]) || k[c] <= 0.0)
+            {
+                res[i] = u[i];
+                continue;
+            }
+
+            double r = 0.0;
+
+            // Fluxes through the faces, the conductance is the harmonic mean of the cell values:
+            if (c > 0 && is_active(unknown, cell_region[c-1]) && k[c-1] > 0.0)
+                r += (u[i - n_unknowns] - u[i])/(0.5*cell_width[c-1]/k[c-1] + 0.5*cell_width[c]/k[c]);
+            if (c+1 < n_cells && is_active(unknown, cell_region[c+1]) && k[c+1] > 0.0)
+                r += (u[i + n_unknowns] - u[i])/(0.5*cell_width[c+1]/k[c+1] + 0.5*cell_width[c]/k[c]);
+
+            // Dirichlet boundary conditions at the GDL/channel interfaces:
+            if (unknown == phi_s && c == 0)
+                r += (0.0 - u[i])*2.0*k[c]/cell_width[c];
+            if (unknown == phi_s && c == n_cells-1)
+                r += (V_cell - u[i])*2.0*k[c]/cell_width[c];
+            if (unknown == x_o2 && c == n_cells-1)
+                r += (x_o2_channel - u[i])*2.0*k[c]/cell_width[c];
+
+            // Source terms:
+            if (cell_region[c] == ACL_region)
+            {
+                if (unknown == phi_m)
+                    r += current[c]*cell_width[c];
+                else if (unknown == phi_s)
+                    r -= current[c]*cell_width[c];
+            }
+            else if (cell_region[c] == CCL_region)
+            {
+                if (unknown == phi_m)
+                    r -= current[c]*cell_width[c];
+                else if (unknown == phi_s)
+                    r += current[c]*cell_width[c];
+                else if (unknown == x_o2)
+                    r -= current[c]/(4.0*F)*cell_width[c];
+            }
+
+            res[i] = r;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+bool
+FuelCell::InitialSolution::ThroughPlaneMEAModel<dim>::solve()
+{
+    solved = false;
+
+    const unsigned int max_iterations = 50;
+    const double max_potential_update = 0.1;
+
+    std::vector<FuelCellShop::Layer::PorousLayer<dim>*> porous_layers;
+    porous_layers.push_back(CCL);
+    porous_layers.push_back(CGDL);
+    if (CMPL != NULL)
+        porous_layers.push_back(CMPL);
+
+    // The layers are shared with the application, their state is restored when the model returns:
+    LayerStateGuard<dim> layer_state(ACL, ML, CCL, porous_layers);
+
+    try
+    {
+        make_cells();
+
+        const unsigned int n_cells = cell_region.size();
+        const unsigned int n = solution.size();
+        std::vector<double> res, res_trial, u_trial, delta(n_cells);
+        std::vector<double> scaling(n, 1.0);
+        Vector<double> du(n);
+
+        // Blocks of the Jacobian coupling cell c to cells c-1, c and c+1, respectively:
+        std::vector< FullMatrix<double> > A(n_cells, FullMatrix<double>(n_unknowns, n_unknowns));
+        std::vector< FullMatrix<double> > B(n_cells, FullMatrix<double>(n_unknowns, n_unknowns));
+        std::vector< FullMatrix<double> > C(n_cells, FullMatrix<double>(n_unknowns, n_unknowns));
+        std::vector< Vector<double> > rhs(n_cells, Vector<double>(n_unknowns)), du_cell;
+
+        residual(solution, res);
+
+        for (unsigned int it = 0; it < max_iterations; ++it)
+        {
+            // Finite difference Jacobian. The residual of a cell only depends on the cell and its two neighbours,
+            // hence every third cell can be perturbed at once and the Jacobian is obtained from 3*n_unknowns residuals:
+            for (unsigned int colour = 0; colour < 3; ++colour)
+                for (unsigned int q = 0; q < n_unknowns; ++q)
+                {
+                    u_trial = solution;
+                    for (unsigned int c = colour; c < n_cells; c += 3)
+                    {
+                        delta[c] = 1e-7*std::max(1.0, std::fabs(solution[n_unknowns*c + q]));
+                        u_trial[n_unknowns*c + q] += delta[c];
+                    }
+
+                    residual(u_trial, res_trial);
+
+                    for (unsigned int c = colour; c < n_cells; c += 3)
+                        for (unsigned int p = 0; p < n_unknowns; ++p)
+                        {
+                            B[c](p,q) = (res_trial[n_unknowns*c + p] - res[n_unknowns*c + p])/delta[c];
+                            if (c > 0)
+                                C[c-1](p,q) = (res_trial[n_unknowns*(c-1) + p] - res[n_unknowns*(c-1) + p])/delta[c];
+                            if (c+1 < n_cells)
+                                A[c+1](p,q) = (res_trial[n_unknowns*(c+1) + p] - res[n_unknowns*(c+1) + p])/delta[c];
+                        }
+                }
+
+            // The equations are scaled with the diagonal of the Jacobian to compare residuals of different units:
+            double norm = 0.0;
+            for (unsigned int c = 0; c < n_cells; ++c)
+                for (unsigned int p = 0; p < n_unknowns; ++p)
+                {
+                    const unsigned int i = n_unknowns*c + p;
+                    scaling[i] = (std::fabs(B[c](p,p)) > 0.0) ? 1.0/std::fabs(B[c](p,p)) : 1.0;
+                    norm += std::pow(scaling[i]*res[i], 2);
+                    rhs[c](p) = -res[i];
+                }
+
+            solve_block_tridiagonal(A, B, C, rhs, du_cell);
+
+            for (unsigned int c = 0; c < n_cells; ++c)
+                for (unsigned int p = 0; p < n_unknowns; ++p)
+                    du(n_unknowns*c + p) = du_cell[c](p);
+
+            // Limit the potential updates:
+            double max_du = 0.0;
+            for (unsigned int c = 0; c < cell_region.size(); ++c)
+            {
+                max_du = std::max(max_du, std::fabs(du(n_unknowns*c + phi_s)));
+                max_du = std::max(max_du, std::fabs(du(n_unknowns*c + phi_m)));
+            }
+            double step = (max_du > max_potential_update) ? max_potential_update/max_du : 1.0;
+
+            // Backtracking on the scaled residual:
+            double norm_trial = 0.0;
+            for (unsigned int k = 0; k < 10; ++k)
+            {
+                u_trial = solution;
+                for (unsigned int i = 0; i < n; ++i)
+                    u_trial[i] += step*du(i);
+
+                residual(u_trial, res_trial);
+
+                norm_trial = 0.0;
+                for (unsigned int i = 0; i < n; ++i)
+                    norm_trial += std::pow(scaling[i]*res_trial[i], 2);
+
+                if (norm_trial < norm)
+                    break;
+                step *= 0.5;
+            }
+
+            AssertThrow( !std::isnan(norm_trial), ExcMessage("NaN in the through-plane MEA model.") );
+
+            solution = u_trial;
+            res = res_trial;
+
+            if (step*du.linfty_norm() < 1e-10)
+            {
+                solved = true;
+                FcstUtilities::log << "Through-plane MEA model converged in " << it+1 << " iterations." << std::endl;
+                break;
+            }
+        }
+
+        if (!solved)
+            FcstUtilities::log << "Through-plane MEA model did not converge. The pre-defined initial solution is used instead." << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        FcstUtilities::log << "Through-plane MEA model failed: " << e.what() << std::endl
+                           << "The pre-defined initial solution is used instead." << std::endl;
+        solved = false;
+    }
+
+    return solved;
+}
+
+//---------------------------------------------------------------------------
+template <int dim>
+void
+FuelCell::InitialSolution::ThroughPlaneMEAModel<dim>::vector_value(const Point<dim> &p,
+                                                                   Vector<double> &v) const
+{
+    Assert(v.size() == this->n_components,
+           ExcDimensionMismatch (v.size(), this->n_components));
+
+    base_function->vector_value(p, v);
+
+    if (!solved)
+        return;
+
+    // Find the cell containing the point:
+    const double x = p(0);
+    const unsigned int n_cells = cell_region.size();
+    unsigned int c = 0;
+    while (c+1 < n_cells && x > cell_center[c] + 0.5*cell_width[c])
+        ++c;
+
+    // Neighbouring cell used for linear interpolation:
+    const unsigned int nb = (x < cell_center[c]) ? ((c > 0) ? c-1 : c) : ((c+1 < n_cells) ? c+1 : c);
+
+    for (unsigned int q = 0; q < n_unknowns; ++q)
+    {
+        const Unknown unknown = static_cast<Unknown>(q);
+
+        if (component_index[q] < 0 || !is_active(unknown, cell_region[c]))
+            continue;
+
+        double value = solution[n_unknowns*c + q];
+
+        if (nb != c && is_active(unknown, cell_region[nb]))
+        {
+            const double w = (x - cell_center[c])/(cell_center[nb] - cell_center[c]);
+            value += w*(solution[n_unknowns*nb + q] - solution[n_unknowns*c + q]);
+        }
+
+        v(component_index[q]) = value;
+    }
+}
+
+//---------------------------------------------------------------------------
+// Explicit instantiations.
+template class FuelCell::InitialSolution::ThroughPlaneMEAModel<deal_II_dimension>;
@@ -70,12 +70,18 @@
 #include <GasMixture_test.h>
 #include <water_pore_agglomerate_test.h>
 #include <numerical_agglomerate_base_test.h>
+#include <agglomerate_surrogate_test.h>
+#include <collocation_BVP_solver_test.h>
 #include <porous_layer_test.h>
 #include <PSD_HI_test.h>
 #include <PSD_HO_test.h>
 //#include <fevectors_test.h>
 #include <application_step3_test.h>
 #include <application_step8_test.h>
+#include <dof_application_test.h>
+#include <picard_test.h>
+#include <newton_test.h>
+#include <through_plane_mea_model_test.h>
 
 namespace FcstTestSuite
 {
@@ -24,6 +24,7 @@ public:
         //Add a number of tests that will be called during Test::Suite.run()
         //Generic cases
         TEST_ADD(MultiScaleCLTest::testSetSolution);
+        TEST_ADD(MultiScaleCLTest::testBatchedAssembly);
         
     }
 protected:
@@ -38,6 +39,17 @@ private:
     ParameterHandler param;
     
     void testSetSolution();
+
+    /**
+     * The current density and its derivatives of a cell returned after the microscale problems of the cell were collected
+     * and solved by MultiScaleCL::evaluate() are the ones computed cell by cell without batching. While collecting, they are zero.
+     */
+    void testBatchedAssembly();
+
+    /**
+     * Set the kinetics and the solution at the quadrature points used by the tests.
+     */
+    void set_layer_solution(FuelCellShop::Layer::CatalystLayer<dim>& catalyst_layer);
     
     
 };
@@ -0,0 +1,77 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: agglomerate_surrogate_test.h
+//    - Description: Unit testing class for the surrogate table of micro scale objects
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+/**
+ * A unit test class for FuelCellShop::MicroScale::AgglomerateSurrogate. A smooth analytical function of the
+ * reactant molar fraction and the overpotential is used instead of a micro scale solve.
+ */
+
+#ifndef _FCST_AgglomerateSurrogate_TESTSUITE
+#define _FCST_AgglomerateSurrogate_TESTSUITE
+
+#include <cpptest.h>
+#include <microscale/agglomerate_surrogate.h>
+
+class AgglomerateSurrogateTest: public Test::Suite
+{
+public:
+    AgglomerateSurrogateTest()
+    {
+        //Add a number of tests that will be called during Test::Suite.run()
+        TEST_ADD(AgglomerateSurrogateTest::testInterpolation);
+        TEST_ADD(AgglomerateSurrogateTest::testDerivatives);
+        TEST_ADD(AgglomerateSurrogateTest::testOutsideRange);
+        TEST_ADD(AgglomerateSurrogateTest::testReuse);
+        TEST_ADD(AgglomerateSurrogateTest::testSaddle);
+        TEST_ADD(AgglomerateSurrogateTest::testFailedSolve);
+    }
+protected:
+    virtual void setup(); // setup resources... called before each test
+    virtual void tear_down(){} // remove resources...called after Test::Suite.run()  ..not implemented for this test suite
+private:
+    /**
+     * Interpolated values agree with the function within the tolerance.
+     */
+    void testInterpolation();
+    /**
+     * Derivatives of the interpolant agree with the derivatives of the function.
+     */
+    void testDerivatives();
+    /**
+     * Points outside the trusted region are not interpolated.
+     */
+    void testOutsideRange();
+    /**
+     * Points in boxes already checked do not require new solves.
+     */
+    void testReuse();
+    /**
+     * A saddle whose interpolant is exact at the centre of the box is still refined.
+     */
+    void testSaddle();
+    /**
+     * A box where a solve fails is rejected, the values solved before the failure are kept and the box is not solved again.
+     */
+    void testFailedSolve();
+
+    /** Table tested */
+    FuelCellShop::MicroScale::AgglomerateSurrogate table;
+    /** Function replacing the micro scale solve */
+    FuelCellShop::MicroScale::AgglomerateSurrogate::Model model;
+    /** Number of calls to the function */
+    unsigned int n_calls;
+};
+
+#endif
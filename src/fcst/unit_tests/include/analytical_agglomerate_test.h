@@ -12,6 +12,8 @@
 #include <cpptest.h>
 #include <string>
 #include <layers/catalyst_layer.h>
+#include <layers/multi_scale_CL.h>
+#include <microscale/micro_scale_base.h>
 #include <reactions/tafel_kinetics.h>
 #include <utils/operating_conditions.h>
 #include <boost/shared_ptr.hpp>
@@ -28,6 +30,10 @@ public:
 	   //Generic cases
         TEST_ADD(AnalyticalAgglomerateTest::testO2CurrentDensity);
         TEST_ADD(AnalyticalAgglomerateTest::test02CurrentDerivative);
+        TEST_ADD(AnalyticalAgglomerateTest::testO2CurrentDensityCell);
+        TEST_ADD(AnalyticalAgglomerateTest::testO2CurrentBatch);
+        TEST_ADD(AnalyticalAgglomerateTest::testICCPCurrentBatch);
+        TEST_ADD(AnalyticalAgglomerateTest::testPolyAgglomerateThreadSafe);
         #ifndef _OPENMP // The following tests are removed for parallel execution
             TEST_ADD(AnalyticalAgglomerateTest::testInvalidKineticsDT);
             TEST_ADD(AnalyticalAgglomerateTest::testInvalidKineticsORR);
@@ -43,9 +49,20 @@ private:
 
     void testO2CurrentDensity();
     void test02CurrentDerivative();
+    void testO2CurrentDensityCell();
+    void testO2CurrentBatch();
+    void testICCPCurrentBatch();
+    void testPolyAgglomerateThreadSafe();
     void testInvalidKineticsDT();
     void testInvalidKineticsORR();
 
+    //Create #CCL with the micro scale type \p micro_type and return a micro scale object of the layer, made thread safe
+    //as in MultiScaleCL if \p thread_safe is set. A PolyAgglomerate has two analytical size classes.
+    boost::shared_ptr<FuelCellShop::MicroScale::MicroScaleBase> create_micro_scale(const std::string& micro_type, const bool thread_safe = false);
+
+    //Check that the batched current (and derivatives if \p derivatives is set) of \p micro match the values computed one point at a time
+    void check_batch(FuelCellShop::MicroScale::MicroScaleBase& micro, const bool derivatives);
+
     FuelCell::OperatingConditions OC;
     boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> > CCL;
 };
@@ -24,6 +24,27 @@ namespace FuelCell
 {
     namespace UnitTest
     {
+        /**
+         * Step-8 without the blocks coupling the two displacement components, so that the solution of the
+         * system restricted to one block is the corresponding block of the solution of the whole system.
+         * The blocks solved are set in #blocks, see BlockMatrixApplication::stage_blocks().
+         */
+        class DecoupledAppStep8 : public FuelCell::Application::AppStep8<deal_II_dimension>
+        {
+        public:
+            virtual void cell_matrix(MatrixVector& cell_matrices,
+                                     const DoFApplication<deal_II_dimension>::CellInfo& cell);
+
+            virtual std::vector<unsigned int> stage_blocks() const
+            {
+                return blocks;
+            }
+
+            /**
+             * Blocks solved by solve(), all blocks if empty.
+             */
+            std::vector<unsigned int> blocks;
+        };
         
         class ApplicationStep8Test: public Test::Suite
         {
@@ -33,6 +54,7 @@ namespace FuelCell
                 //Add a number of tests that will be called during Test::Suite.run()
                 //Generic cases
                 TEST_ADD(ApplicationStep8Test::runApplication);
+                TEST_ADD(ApplicationStep8Test::testStageSolve);
             }
         protected:
             virtual void setup()     {} // setup resources... called before Test::Suite.run() ..not implemented for this test suite
@@ -40,6 +62,12 @@ namespace FuelCell
         private:
             //Generic cases
             void runApplication();
+            /**
+             * Solving the linear system of each block separately, see BlockMatrixApplication::stage_blocks(),
+             * gives the solution of the whole system if the blocks are decoupled, and the blocks that are not
+             * solved are zero.
+             */
+            void testStageSolve();
             
             
         };
@@ -0,0 +1,56 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: collocation_BVP_solver_test.h
+//    - Description: Unit testing class for the native collocation BVP solver
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+/**
+ * A unit test class for FuelCell::ApplicationCore::CollocationBVPSolver. The problem \f$ u'' = k(x) u \f$ on
+ * \f$ (0, 1) \f$, with \f$ u(0) = 1 \f$, \f$ u(1) = 2 \f$ and \f$ k \f$ jumping from 100 to 1 at a fixed point,
+ * has a closed form solution whose second derivative is discontinuous at the fixed point, as the core/film interface
+ * of the ionomer agglomerate.
+ */
+
+#ifndef _FCST_CollocationBVPSolver_TESTSUITE
+#define _FCST_CollocationBVPSolver_TESTSUITE
+
+#include <cpptest.h>
+#include <contribs/collocation_BVP_solver.h>
+
+class CollocationBVPSolverTest: public Test::Suite
+{
+public:
+    CollocationBVPSolverTest()
+    {
+        //Add a number of tests that will be called during Test::Suite.run()
+        TEST_ADD(CollocationBVPSolverTest::testFixpoint);
+        TEST_ADD(CollocationBVPSolverTest::testFixpointContinuation);
+    }
+protected:
+    virtual void setup() {} // setup resources... called before Test::Suite.run() ..not implemented for this test suite
+    virtual void tear_down() {} // remove resources...called after Test::Suite.run()  ..not implemented for this test suite
+private:
+    /**
+     * The fixed point is a mesh point and the solution agrees with the closed form solution.
+     */
+    void testFixpoint();
+    /**
+     * The fixed point stays a mesh point when the tolerance is reduced in several solves with use_simple_cont(), starting
+     * from a mesh where the fixed point is at an odd index.
+     */
+    void testFixpointContinuation();
+
+    /** Check the final mesh and the solution of \p solver */
+    void check_solution(FuelCell::ApplicationCore::BVPSolver& solver, const double tolerance);
+};
+
+#endif
@@ -0,0 +1,145 @@
+// ----------------------------------------------------------------------------
+//
+// FCST: Fuel Cell Simulation Toolbox
+//
+// Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+// This software is distributed under the MIT License
+// For more information, see the README file in /doc/LICENSE
+//
+// - Class: dof_application_test.h
+// - Description: Test for the parallel data management of DoFApplication
+// - Developers: OpenFCST contributors, University of Alberta
+//
+// ----------------------------------------------------------------------------
+
+#ifndef _DOF_APPLICATION_TESTSUITE
+#define _DOF_APPLICATION_TESTSUITE
+
+#include <cpptest.h>
+#include <applications/app_step8.h>
+#include <application_core/subdomain_data_out.h>
+#include <application_core/assembly_batch.h>
+
+#include <stdexcept>
+
+namespace FuelCell
+{
+    namespace UnitTest
+    {
+        /**
+         * Assembly batch collecting all cells that records the calls made by DoFApplication. If \p fail is set,
+         * evaluate() throws an exception, i.e., the assembly fails after the collect pass.
+         */
+        class TestAssemblyBatch : public FuelCell::ApplicationCore::AssemblyBatch
+        {
+        public:
+            TestAssemblyBatch(const bool fail)
+            :
+            fail(fail),
+            collecting(false),
+            n_collects(0),
+            n_ends(0)
+            {}
+
+            virtual bool batch_enabled() const
+            {
+                return true;
+            }
+
+            virtual bool batch_material(const unsigned int ) const
+            {
+                return true;
+            }
+
+            virtual void begin_collect()
+            {
+                collecting = true;
+                ++n_collects;
+            }
+
+            virtual void evaluate()
+            {
+                if (fail)
+                    throw std::runtime_error("TestAssemblyBatch::evaluate failed");
+            }
+
+            virtual void end_batch()
+            {
+                collecting = false;
+                ++n_ends;
+            }
+
+            /** Throw in evaluate()? */
+            const bool fail;
+            /** Between begin_collect() and end_batch()? */
+            bool collecting;
+            /** Number of calls to begin_collect() */
+            unsigned int n_collects;
+            /** Number of calls to end_batch() */
+            unsigned int n_ends;
+        };
+
+        class DoFApplicationTest: public Test::Suite
+        {
+        public:
+            DoFApplicationTest()
+            {
+                //Add a number of tests that will be called during Test::Suite.run()
+                TEST_ADD(DoFApplicationTest::testVectorTransfer);
+                TEST_ADD(DoFApplicationTest::testOwnedDofs);
+                TEST_ADD(DoFApplicationTest::testResidual);
+                TEST_ADD(DoFApplicationTest::testAssemblyBatchGuard);
+                TEST_ADD(DoFApplicationTest::testSubdomainDataOut);
+                TEST_ADD(DoFApplicationTest::testDataOutFilename);
+                TEST_ADD(DoFApplicationTest::testMeasuredPartitionWeights);
+            }
+        protected:
+            virtual void setup()     {} // setup resources... called before Test::Suite.run() ..not implemented for this test suite
+            virtual void tear_down() {} // remove resources...called after Test::Suite.run()  ..not implemented for this test suite
+        private:
+            /**
+             * The degrees of freedom owned by the process are stored once per mesh, and a vector exported to a
+             * PETSc vector with them and imported back is unchanged. Only tested if OpenFCST is compiled with PETSc.
+             */
+            void testVectorTransfer();
+            /**
+             * With the cells split in two subdomains, the degrees of freedom owned by process zero are the first rows of
+             * the PETSc objects, whose number is the number of degrees of freedom associated with subdomain zero. A cell is interior
+             * if and only if all its degrees of freedom are owned. Only tested if OpenFCST is compiled with PETSc.
+             */
+            void testOwnedDofs();
+            /**
+             * The residual is the sum of the residuals of all the cells, i.e., the contributions of interior cells assembled
+             * while the other contributions are sent are added exactly once.
+             */
+            void testResidual();
+            /**
+             * A registered batch collects its computations once per residual and leaves batch mode after the residual,
+             * also if the assembly throws an exception.
+             */
+            void testAssemblyBatchGuard();
+            /**
+             * SubdomainDataOut only visits the cells of the subdomain that is set, and all the cells by default.
+             */
+            void testSubdomainDataOut();
+            /**
+             * The data is written to a single file unless the parallel output is set. In parallel output,
+             * the number of the process is appended to the file name. Only process zero exists in the unit tests.
+             */
+            void testDataOutFilename();
+            /**
+             * The measured partition weights are the assembly time per cell of each material scaled by the cheapest
+             * material. Materials without measurements keep the weight one, and the measurements are reset.
+             */
+            void testMeasuredPartitionWeights();
+
+            /**
+             * Initialize Step-8 with the default parameters and distribute the degrees of freedom.
+             */
+            void initialize(FuelCell::Application::AppStep8<deal_II_dimension>& app);
+        };
+    }
+}
+
+#endif
@@ -31,6 +31,8 @@ class FCSTdatabaseTest: public Test::Suite
         TEST_ADD(FCSTdatabaseTest::testValidColumnNames);
         TEST_ADD(FCSTdatabaseTest::testCompareOC);
         TEST_ADD(FCSTdatabaseTest::testCleanUp);
+        TEST_ADD(FCSTdatabaseTest::testSignedTolerance);
+        TEST_ADD(FCSTdatabaseTest::testOldHead);
 
 
     }
@@ -51,6 +53,9 @@ class FCSTdatabaseTest: public Test::Suite
         void testValidColumnNames();
         void testCompareOC();
         void testCleanUp();
+        void testSignedTolerance();
+        /** A database created before the operating conditions were indexed, i.e., with HEAD rows only, is indexed on connection. */
+        void testOldHead();
 
 };
 
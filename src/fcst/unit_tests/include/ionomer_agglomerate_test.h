@@ -28,6 +28,8 @@ public:
 
         TEST_ADD(IonomerAgglomerateTest::testO2CurrentDensity);
         TEST_ADD(IonomerAgglomerateTest::testO2CurrentDerivative);
+        TEST_ADD(IonomerAgglomerateTest::testO2CurrentDensityCollocation);
+        TEST_ADD(IonomerAgglomerateTest::testO2CurrentDensitySolvers);
         //TEST_ADD(IonomerAgglomerateTest::testH2CurrentDensity);
     }
 protected:
@@ -38,7 +40,12 @@ private:
 
     void testO2CurrentDensity();
     void testO2CurrentDerivative();
+    void testO2CurrentDensityCollocation();
+    void testO2CurrentDensitySolvers();
     void testH2CurrentDensity();
+
+    //Create a catalyst layer with ionomer filled agglomerates, with an ionomer film, solved by \p bvp_solver
+    boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> > create_layer(const std::string& bvp_solver);
     //Layer
     boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> > CCL;
     FuelCell::OperatingConditions OC;
@@ -0,0 +1,183 @@
+// ----------------------------------------------------------------------------
+//
+// FCST: Fuel Cell Simulation Toolbox
+//
+// Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+// This software is distributed under the MIT License
+// For more information, see the README file in /doc/LICENSE
+//
+// - Class: newton_test.h
+// - Description: Test for the variants of the Newton solver
+// - Developers: OpenFCST contributors, University of Alberta
+//
+// ----------------------------------------------------------------------------
+
+#ifndef _NEWTON_TESTSUITE
+#define _NEWTON_TESTSUITE
+
+#include <cpptest.h>
+#include <application_core/application_base.h>
+#include <application_core/application_data.h>
+#include <solvers/newton_w_line_search.h>
+#include <solvers/newton_pseudo_transient.h>
+#include <solvers/newton_segregated.h>
+#include <solvers/adaptive_refinement.h>
+
+#include <deal.II/lac/full_matrix.h>
+
+namespace FuelCell
+{
+    namespace UnitTest
+    {
+        /**
+         * Application for the nonlinear system \f$ \mathbf{F}(\mathbf{u}) = \mathbf{A} \mathbf{u} + \frac{1}{2} \mathbf{u}^3 - \mathbf{b} = 0 \f$,
+         * where \f$ \mathbf{A} \f$ is the tridiagonal matrix with 4 on the diagonal and -1 on the off-diagonals and the cube is taken
+         * component-wise. The solution is \f$ \mathbf{u} = 1 \f$.
+         *
+         * If \p arctan is set in the constructor, the system is \f$ F_i(\mathbf{u}) = \arctan(u_i - 3) = 0 \f$ instead.
+         * Newton's method diverges for this system if the initial guess is zero.
+         *
+         * As BlockMatrixApplication, solve() only assembles the Jacobian if a notification was received, i.e., the last
+         * assembled Jacobian is reused otherwise, and adds the scalar "Pseudo time step inverse" to the diagonal
+         * if it is registered in ApplicationData. The number of residual evaluations, of linear solves and of
+         * Jacobian assemblies is counted. The application has a single stage for NewtonSegregated.
+         */
+        class NonlinearTestApplication : public FuelCell::ApplicationCore::ApplicationBase
+        {
+        public:
+            NonlinearTestApplication(const bool arctan = false);
+
+            virtual void initialize(ParameterHandler& )
+            {}
+
+            virtual void init_vector(FuelCell::ApplicationCore::FEVector& dst) const;
+
+            virtual double residual(FuelCell::ApplicationCore::FEVector&        dst,
+                                    const FuelCell::ApplicationCore::FEVectors& src,
+                                    bool apply_boundaries = true);
+
+            virtual void solve(FuelCell::ApplicationCore::FEVector&        dst,
+                               const FuelCell::ApplicationCore::FEVectors& src);
+
+            /**
+             * Number of calls to residual().
+             */
+            unsigned int n_residuals;
+
+            /**
+             * Number of calls to solve().
+             */
+            unsigned int n_solves;
+
+            /**
+             * Number of Jacobian assemblies.
+             */
+            unsigned int n_assemblies;
+
+            /**
+             * Value of "Pseudo time step inverse" in each call to solve(), zero if not registered.
+             */
+            std::vector<double> shifts;
+
+            /**
+             * Value of "Segregated solve stage" in each call to solve(), -1 if not registered.
+             */
+            std::vector<double> stages;
+
+        private:
+            /**
+             * Solve the arctan system instead of the cubic one?
+             */
+            const bool arctan;
+
+            /**
+             * Refinement level registered in ApplicationData, read by NewtonLineSearch.
+             */
+            double refinement;
+
+            /**
+             * Number of stages registered in ApplicationData, read by NewtonSegregated.
+             */
+            double n_stages;
+
+            /**
+             * Last assembled Jacobian.
+             */
+            FullMatrix<double> jacobian;
+        };
+
+        class NewtonTest: public Test::Suite
+        {
+        public:
+            NewtonTest()
+            {
+                //Add a number of tests that will be called during Test::Suite.run()
+                TEST_ADD(NewtonTest::testBroydenUpdates);
+                TEST_ADD(NewtonTest::testPseudoTransient);
+                TEST_ADD(NewtonTest::testPseudoTransientFailure);
+                TEST_ADD(NewtonTest::testToleranceSchedule);
+                TEST_ADD(NewtonTest::testSegregated);
+                TEST_ADD(NewtonTest::testSegregatedFailure);
+            }
+        protected:
+            virtual void setup()     {} // setup resources... called before Test::Suite.run() ..not implemented for this test suite
+            virtual void tear_down() {} // remove resources...called after Test::Suite.run()  ..not implemented for this test suite
+        private:
+            /**
+             * With a Jacobian that is never reassembled, NewtonLineSearch with Broyden updates converges to the solution
+             * in fewer iterations than without them, i.e., than the chord method, and still assembles the Jacobian only once.
+             */
+            void testBroydenUpdates();
+            /**
+             * NewtonPseudoTransient converges for the arctan system starting from zero, where Newton's method diverges.
+             * The first linear system uses the initial pseudo time step, the time step then grows such that the
+             * last systems are close to Newton's method. The pseudo time step is unregistered after the solve.
+             */
+            void testPseudoTransient();
+            /**
+             * The pseudo time step is also unregistered if NewtonPseudoTransient fails.
+             */
+            void testPseudoTransientFailure();
+            /**
+             * The Newton tolerance schedule of AdaptiveRefinement uses the initial cycle tolerance in the first cycle,
+             * the scaled error estimate bounded by the maximum intermediate tolerance and the final tolerance in the
+             * intermediate cycles, and the final tolerance in the last cycle.
+             */
+            void testToleranceSchedule();
+            /**
+             * NewtonSegregated converges to the solution, registers the stage while the linear systems are solved
+             * and unregisters it after the solve.
+             */
+            void testSegregated();
+            /**
+             * The stage is also unregistered if NewtonSegregated fails.
+             */
+            void testSegregatedFailure();
+
+            /**
+             * Solve the test problem with NewtonLineSearch starting from zero, reassembling the Jacobian only if
+             * the residual is not reduced. Returns the max-norm of the error of the result.
+             */
+            double run_newton_line_search(NonlinearTestApplication& app,
+                                          const bool                broyden);
+
+            /**
+             * Solve the arctan system with NewtonPseudoTransient starting from zero with at most \p max_steps
+             * iterations. Returns the max-norm of the error of the result.
+             */
+            double run_pseudo_transient(NonlinearTestApplication& app,
+                                        const unsigned int        max_steps);
+
+            /**
+             * Solve the test problem with NewtonSegregated starting from zero with at most \p max_steps
+             * outer iterations. Returns the max-norm of the error of the result with respect to \p exact.
+             */
+            double run_segregated(NonlinearTestApplication& app,
+                                  const unsigned int        max_steps,
+                                  const double              exact);
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,99 @@
+// ----------------------------------------------------------------------------
+//
+// FCST: Fuel Cell Simulation Toolbox
+//
+// Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+// This software is distributed under the MIT License
+// For more information, see the README file in /doc/LICENSE
+//
+// - Class: picard_test.h
+// - Description: Test for the Picard solver and its Anderson acceleration
+// - Developers: OpenFCST contributors, University of Alberta
+//
+// ----------------------------------------------------------------------------
+
+#ifndef _PICARD_TESTSUITE
+#define _PICARD_TESTSUITE
+
+#include <cpptest.h>
+#include <application_core/application_base.h>
+#include <solvers/picard.h>
+
+namespace FuelCell
+{
+    namespace UnitTest
+    {
+        /**
+         * Application whose solve() evaluates the linear contraction \f$ G(u) = M u + b \f$ with a diagonal
+         * matrix \f$ M \f$. The fixed point of \f$ G \f$ is \f$ u = 1 \f$. The number of calls to solve(),
+         * i.e., of fixed-point iterations, is counted.
+         */
+        class LinearContractionApplication : public FuelCell::ApplicationCore::ApplicationBase
+        {
+        public:
+            LinearContractionApplication();
+
+            virtual void initialize(ParameterHandler& )
+            {}
+
+            virtual void init_vector(FuelCell::ApplicationCore::FEVector& dst) const;
+
+            virtual double residual(FuelCell::ApplicationCore::FEVector&        dst,
+                                    const FuelCell::ApplicationCore::FEVectors& src,
+                                    bool apply_boundaries = true);
+
+            virtual void solve(FuelCell::ApplicationCore::FEVector&        dst,
+                               const FuelCell::ApplicationCore::FEVectors& src);
+
+            /**
+             * Number of calls to solve().
+             */
+            unsigned int n_solves;
+
+        private:
+            /**
+             * Diagonal of the contraction matrix.
+             */
+            Vector<double> diagonal;
+        };
+
+        class PicardTest: public Test::Suite
+        {
+        public:
+            PicardTest()
+            {
+                //Add a number of tests that will be called during Test::Suite.run()
+                TEST_ADD(PicardTest::testPlainPicard);
+                TEST_ADD(PicardTest::testAndersonAcceleration);
+                TEST_ADD(PicardTest::testAndersonRestart);
+            }
+        protected:
+            virtual void setup()     {} // setup resources... called before Test::Suite.run() ..not implemented for this test suite
+            virtual void tear_down() {} // remove resources...called after Test::Suite.run()  ..not implemented for this test suite
+        private:
+            /**
+             * Plain Picard iterations converge to the fixed point.
+             */
+            void testPlainPicard();
+            /**
+             * AA(m) converges to the same fixed point in fewer iterations than plain Picard.
+             */
+            void testAndersonAcceleration();
+            /**
+             * AA(m) with restarts also converges in fewer iterations than plain Picard.
+             */
+            void testAndersonRestart();
+
+            /**
+             * Solve the contraction with Picard using the given Anderson settings, starting from zero.
+             * Returns the number of fixed-point iterations and the max-norm of the error of the result.
+             */
+            unsigned int run_picard(const bool anderson,
+                                    const bool restart,
+                                    double& error);
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,92 @@
+// ----------------------------------------------------------------------------
+//
+// FCST: Fuel Cell Simulation Toolbox
+//
+// Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+// This software is distributed under the MIT License
+// For more information, see the README file in /doc/LICENSE
+//
+// - Class: through_plane_mea_model_test.h
+// - Description: Test for the one-dimensional through-plane MEA model used to generate initial solutions
+// - Developers: OpenFCST contributors, University of Alberta
+//
+// ----------------------------------------------------------------------------
+
+#ifndef _THROUGH_PLANE_MEA_MODEL_TESTSUITE
+#define _THROUGH_PLANE_MEA_MODEL_TESTSUITE
+
+#include <cpptest.h>
+#include <applications/app_pemfc.h>
+#include <utils/through_plane_mea_model.h>
+
+namespace FuelCell
+{
+    namespace UnitTest
+    {
+        /**
+         * AppPemfc that gives access to the objects needed to build a ThroughPlaneMEAModel.
+         */
+        class ThroughPlaneMEAModelApplication : public FuelCell::Application::AppPemfc<deal_II_dimension>
+        {
+        public:
+            /**
+             * Create the one-dimensional model for the MEA of the application with \p n_cells cells per layer.
+             * The base function, i.e., the pre-defined initial solution, is returned in \p base_function.
+             */
+            std::shared_ptr< FuelCell::InitialSolution::ThroughPlaneMEAModel<deal_II_dimension> >
+            create_model(const unsigned int n_cells,
+                         std::shared_ptr< Function<deal_II_dimension> >& base_function);
+
+            /**
+             * Index of the solution variable \p name in the application.
+             */
+            unsigned int index(const std::string& name)
+            {
+                return this->system_management.solution_name_to_index(name);
+            }
+
+            /** Operating conditions */
+            const FuelCell::OperatingConditions& get_operating_conditions() const
+            {
+                return this->OC;
+            }
+
+            /** Geometry */
+            boost::shared_ptr< FuelCellShop::Geometry::GridBase<deal_II_dimension> > get_grid() const
+            {
+                return this->mesh_generator;
+            }
+
+            /** Cathode catalyst layer */
+            FuelCellShop::Layer::CatalystLayer<deal_II_dimension>* get_CCL() const
+            {
+                return this->CCL.get();
+            }
+        };
+
+        class ThroughPlaneMEAModelTest: public Test::Suite
+        {
+        public:
+            ThroughPlaneMEAModelTest()
+            {
+                //Add a number of tests that will be called during Test::Suite.run()
+                TEST_ADD(ThroughPlaneMEAModelTest::testSmallMEA);
+            }
+        protected:
+            virtual void setup()     {} // setup resources... called before Test::Suite.run() ..not implemented for this test suite
+            virtual void tear_down() {} // remove resources...called after Test::Suite.run()  ..not implemented for this test suite
+        private:
+            /**
+             * Solve the model on the default MEA with a few cells per layer. The profile must be finite, the oxygen
+             * molar fraction must decrease from the cathode channel, the protonic potential must be monotone in the
+             * membrane and the electronic potential must match the cell voltage at the cathode. The solution must be
+             * extruded in the in-plane direction, the base function must be used for all other variables and the
+             * state of the cathode catalyst layer must be restored.
+             */
+            void testSmallMEA();
+        };
+    }
+}
+
+#endif
@@ -28,6 +28,12 @@
 #include <boost/lexical_cast.hpp>
 #include <string.h>
 #include <utils/fcst_utilities.h>
+#include <utils/hybrid_parallelism.h>
+#include <deal.II/base/multithread_info.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 class UtilsTest: public Test::Suite
 {
@@ -40,6 +46,7 @@ public:
         TEST_ADD(UtilsTest::testModify_parameter_file_double);
         TEST_ADD(UtilsTest::testModify_parameter_file);
         TEST_ADD(UtilsTest::testModify_parameter_file_list);
+        TEST_ADD(UtilsTest::testThreadSettings);
 
     }
 protected:
@@ -62,6 +69,11 @@ private:
      * Check when there is a list of values
      */
     void testModify_parameter_file_list();
+    /**
+     * The number of threads per MPI process is the one requested, or the cores of the node divided by the
+     * number of processes on the node, and it limits the deal.II thread pool.
+     */
+    void testThreadSettings();
     
 };
 
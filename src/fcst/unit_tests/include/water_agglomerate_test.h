@@ -27,6 +27,7 @@ public:
 
         TEST_ADD(WaterAgglomerateTest::testO2CurrentDensity);
         TEST_ADD(WaterAgglomerateTest::test02CurrentDerivative);
+        TEST_ADD(WaterAgglomerateTest::testO2CurrentDensitySolvers);
     }
 protected:
     virtual void setup() {} // setup resources... called before Test::Suite.run() ..not implemented for this test suite
@@ -36,6 +37,10 @@ private:
 
     void testO2CurrentDensity();
     void test02CurrentDerivative();
+    void testO2CurrentDensitySolvers();
+
+    //Create a catalyst layer with water filled agglomerates solved by \p bvp_solver
+    boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> > create_layer(const std::string& bvp_solver);
 
     //Layer
     boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> > CCL;
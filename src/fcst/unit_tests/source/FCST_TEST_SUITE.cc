@@ -29,10 +29,16 @@ bool FcstTestSuite::run_tests()
     ts.add(std::auto_ptr<Test::Suite>(new PSD_HO_Test));
     //ts.add(std::auto_ptr<Test::Suite>(new WaterPoreAgglomerateTest)); //under development
     ts.add(std::auto_ptr<Test::Suite>(new NumericalAgglomerateBaseTest));
+    ts.add(std::auto_ptr<Test::Suite>(new AgglomerateSurrogateTest));
+    ts.add(std::auto_ptr<Test::Suite>(new CollocationBVPSolverTest));
     ts.add(std::auto_ptr<Test::Suite>(new PorousLayerTest)); ///under development
     //ts.add(std::auto_ptr<Test::Suite>(new FuelCell::UnitTest::FEVectorsTest)); ///under development
     ts.add(std::auto_ptr<Test::Suite>(new FuelCell::UnitTest::ApplicationStep3Test));
-    ts.add(std::auto_ptr<Test::Suite>(new FuelCell::UnitTest::ApplicationStep8Test));    
+    ts.add(std::auto_ptr<Test::Suite>(new FuelCell::UnitTest::ApplicationStep8Test));
+    ts.add(std::auto_ptr<Test::Suite>(new FuelCell::UnitTest::DoFApplicationTest));
+    ts.add(std::auto_ptr<Test::Suite>(new FuelCell::UnitTest::PicardTest));    
+    ts.add(std::auto_ptr<Test::Suite>(new FuelCell::UnitTest::NewtonTest));
+    ts.add(std::auto_ptr<Test::Suite>(new FuelCell::UnitTest::ThroughPlaneMEAModelTest));
     
     Test::TextOutput output(Test::TextOutput::Verbose);
     return ts.run(output);
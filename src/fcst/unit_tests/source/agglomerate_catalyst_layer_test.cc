@@ -15,6 +15,11 @@
 //---------------------------------------------------------------------------
 
 #include <agglomerate_catalyst_layer_test.h>
+#include <layers/multi_scale_CL.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
 
 void
 MultiScaleCLTest::setup()
@@ -53,9 +58,15 @@ MultiScaleCLTest::setup()
     
     layer = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("Cathode catalyst layer", param);
 
-    layer->set_reaction_kinetics(ORR);
-    layer->set_constant_solution(101325., total_pressure);
-    layer->set_constant_solution(353., temperature_of_REV);
+    set_layer_solution(*layer);
+}
+
+void
+MultiScaleCLTest::set_layer_solution(FuelCellShop::Layer::CatalystLayer<dim>& catalyst_layer)
+{
+    catalyst_layer.set_reaction_kinetics(ORR);
+    catalyst_layer.set_constant_solution(101325., total_pressure);
+    catalyst_layer.set_constant_solution(353., temperature_of_REV);
     
     
     std::vector<FuelCellShop::SolutionVariable> sols;
@@ -71,7 +82,7 @@ MultiScaleCLTest::setup()
     sols.push_back( phi_m);
     sols.push_back( x_O2 );
     
-    layer->set_solution(sols);
+    catalyst_layer.set_solution(sols);
 }
 
 void
@@ -93,3 +104,90 @@ MultiScaleCLTest::testSetSolution()
     TEST_ASSERT_MSG( layer->solutions[membrane_water_content].size() == 8, "lambda size failure !!");
     TEST_ASSERT_DELTA_MSG( layer->solutions[membrane_water_content][7], 12., 1.e-6,  "lambda last element failure !!");
 }
+
+void
+MultiScaleCLTest::testBatchedAssembly()
+{
+    Triangulation<dim> tria;
+    GridGenerator::hyper_cube(tria);
+    FE_Q<dim> fe(1);
+    DoFHandler<dim> dof_handler(tria);
+    dof_handler.distribute_dofs(fe);
+
+    std::vector<VariableNames> flags;
+    flags.push_back(oxygen_molar_fraction);
+    flags.push_back(protonic_electrical_potential);
+    flags.push_back(electronic_electrical_potential);
+
+    // Current and derivatives computed cell by cell:
+    FuelCellShop::Layer::MultiScaleCL<dim>* cell_layer = dynamic_cast<FuelCellShop::Layer::MultiScaleCL<dim>*>(layer.get());
+    TEST_ASSERT_MSG(cell_layer != NULL, "MultiScaleCLTest::testBatchedAssembly failed, the layer is not a MultiScaleCL");
+    cell_layer->set_local_material_id(4);
+    cell_layer->set_derivative_flags(flags);
+    cell_layer->set_cell(dof_handler.begin_active());
+
+    std::vector<double> current(8);
+    std::map< VariableNames, std::vector<double> > dcurrent;
+    cell_layer->current_density(current);
+    cell_layer->derivative_current_density(dcurrent);
+
+    // Same layer with batched microscale solves, registered as by DoFApplication::add_assembly_batch():
+    param.enter_subsection("Fuel cell data");
+    {
+        param.enter_subsection("Cathode catalyst layer");
+        {
+            param.enter_subsection("MultiScaleCL");
+            param.set("Batch microscale solves", "true");
+            param.leave_subsection();
+        }
+        param.leave_subsection();
+    }
+    param.leave_subsection();
+
+    boost::shared_ptr< FuelCellShop::Layer::CatalystLayer<dim> > batched =
+        FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("Cathode catalyst layer", param);
+    set_layer_solution(*batched);
+
+    FuelCellShop::Layer::MultiScaleCL<dim>* batch_layer = dynamic_cast<FuelCellShop::Layer::MultiScaleCL<dim>*>(batched.get());
+    batch_layer->set_batch_registered();
+    batch_layer->set_local_material_id(4);
+    batch_layer->set_derivative_flags(flags);
+    TEST_ASSERT_MSG(batch_layer->batch_enabled(), "MultiScaleCLTest::testBatchedAssembly failed, batch not enabled");
+
+    // Collect pass:
+    std::vector<double> batch_current(8);
+    std::map< VariableNames, std::vector<double> > batch_dcurrent;
+    batch_layer->begin_collect();
+    batch_layer->set_cell(dof_handler.begin_active());
+    batch_layer->current_density(batch_current);
+    batch_layer->derivative_current_density(batch_dcurrent);
+
+    TEST_ASSERT_MSG(batch_layer->batch_points.size() == 8, "MultiScaleCLTest::testBatchedAssembly failed, wrong number of collected points");
+    for (unsigned int q = 0; q < 8; ++q)
+    {
+        TEST_ASSERT_MSG(batch_current[q] == 0.0, "MultiScaleCLTest::testBatchedAssembly failed, nonzero current while collecting");
+        for (unsigned int i = 0; i < flags.size(); ++i)
+            TEST_ASSERT_MSG(batch_dcurrent[flags[i]][q] == 0.0, "MultiScaleCLTest::testBatchedAssembly failed, nonzero derivative while collecting");
+    }
+
+    // Assembly pass with the results of evaluate():
+    batch_layer->evaluate();
+    TEST_ASSERT_MSG(batch_layer->batch_state == FuelCellShop::Layer::MultiScaleCL<dim>::batch_evaluated, "MultiScaleCLTest::testBatchedAssembly failed, points not evaluated");
+
+    batch_layer->set_cell(dof_handler.begin_active());
+    batch_layer->current_density(batch_current);
+    batch_layer->derivative_current_density(batch_dcurrent);
+    TEST_ASSERT_MSG(batch_layer->batch_point(0) != NULL, "MultiScaleCLTest::testBatchedAssembly failed, recorded point not used");
+
+    for (unsigned int q = 0; q < 8; ++q)
+    {
+        TEST_ASSERT_MSG(current[q] != 0.0, "MultiScaleCLTest::testBatchedAssembly failed, zero current");
+        TEST_ASSERT_DELTA_MSG(batch_current[q], current[q], 1.e-10*std::fabs(current[q]), "MultiScaleCLTest::testBatchedAssembly failed, wrong batched current");
+        for (unsigned int i = 0; i < flags.size(); ++i)
+            TEST_ASSERT_DELTA_MSG(batch_dcurrent[flags[i]][q], dcurrent[flags[i]][q], 1.e-10*std::fabs(dcurrent[flags[i]][q]) + 1.e-14,
+                                  "MultiScaleCLTest::testBatchedAssembly failed, wrong batched derivative");
+    }
+
+    batch_layer->end_batch();
+    TEST_ASSERT_MSG(batch_layer->batch_points.empty(), "MultiScaleCLTest::testBatchedAssembly failed, points kept after the batch");
+}
@@ -0,0 +1,154 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: agglomerate_surrogate_test.cc
+//    - Description: Unit testing class for the surrogate table of micro scale objects
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <agglomerate_surrogate_test.h>
+
+#include <cmath>
+
+void
+AgglomerateSurrogateTest::setup()
+{
+    // Inputs: x_O2, phi_m, phi_s, lambda and T. The last two are not interpolated.
+    std::vector<double> lower = {0.0, -0.1, 0.5, 10.0, 353.0};
+    std::vector<double> upper = {0.5,  0.1, 0.9, 10.0, 353.0};
+    table.initialize(lower, upper, 1e-4, 1e-10, 10);
+
+    n_calls = 0;
+    model = [this](const std::vector<double>& x) {
+        ++n_calls;
+        std::vector<double> values(2);
+        values[0] = x[0]*std::exp(5.0*(x[2] - x[1] - 0.7));
+        values[1] = 1.0/(1.0 + x[0]);
+        return values;
+    };
+}
+
+//---------------------------------------------------------------------------
+void
+AgglomerateSurrogateTest::testInterpolation()
+{
+    for (unsigned int k = 0; k < 50; ++k)
+    {
+        const double x_O2 = 0.1 + 0.3*(k%10)/10.0;
+        const double eta = 0.65 + 0.1*(k/10)/5.0;
+        std::vector<double> x = {x_O2, 0.0, eta, 10.0, 353.0};
+
+        std::vector<double> values;
+        TEST_ASSERT(table.value(x, model, values));
+
+        const double current = x_O2*std::exp(5.0*(eta - 0.7));
+        TEST_ASSERT_DELTA(values[0], current, 1e-3*current);
+        TEST_ASSERT_DELTA(values[1], 1.0/(1.0 + x_O2), 1e-3);
+    }
+}
+
+//---------------------------------------------------------------------------
+void
+AgglomerateSurrogateTest::testDerivatives()
+{
+    std::vector<double> x = {0.21, 0.02, 0.72, 10.0, 353.0};
+    std::vector<double> values;
+    std::vector< std::vector<double> > gradients;
+    TEST_ASSERT(table.value(x, model, values, &gradients));
+
+    const double current = x[0]*std::exp(5.0*(x[2] - x[1] - 0.7));
+    TEST_ASSERT_DELTA(gradients[0][0], current/x[0], 2e-2*current/x[0]);
+    TEST_ASSERT_DELTA(gradients[0][1], -5.0*current, 2e-2*5.0*current);
+    TEST_ASSERT_DELTA(gradients[0][2], 5.0*current, 2e-2*5.0*current);
+
+    // Inputs that are not interpolated have no derivative:
+    TEST_ASSERT_DELTA(gradients[0][3], 0.0, 1e-12);
+    TEST_ASSERT_DELTA(gradients[0][4], 0.0, 1e-12);
+}
+
+//---------------------------------------------------------------------------
+void
+AgglomerateSurrogateTest::testOutsideRange()
+{
+    std::vector<double> values;
+
+    std::vector<double> x = {0.6, 0.0, 0.7, 10.0, 353.0};
+    TEST_ASSERT(!table.value(x, model, values));
+
+    x = {0.2, 0.0, 0.7, 12.0, 353.0};
+    TEST_ASSERT(!table.value(x, model, values));
+
+    TEST_ASSERT(n_calls == 0);
+}
+
+//---------------------------------------------------------------------------
+void
+AgglomerateSurrogateTest::testReuse()
+{
+    std::vector<double> x = {0.21, 0.0, 0.7, 10.0, 353.0};
+    std::vector<double> values;
+    TEST_ASSERT(table.value(x, model, values));
+
+    const unsigned int n_first = n_calls;
+    TEST_ASSERT(n_first > 0);
+
+    x[0] += 1e-6;
+    TEST_ASSERT(table.value(x, model, values));
+    TEST_ASSERT(n_calls == n_first);
+}
+
+//---------------------------------------------------------------------------
+void
+AgglomerateSurrogateTest::testSaddle()
+{
+    std::vector<double> lower = {0.0, 0.0, 0.0, 10.0, 353.0};
+    std::vector<double> upper = {1.0, 0.0, 1.0, 10.0, 353.0};
+    table.initialize(lower, upper, 0.0, 1e-3, 10);
+
+    FuelCellShop::MicroScale::AgglomerateSurrogate::Model saddle = [](const std::vector<double>& x) {
+        return std::vector<double>(1, (x[0] - 0.5)*(x[0] - 0.5) - (x[2] - 0.5)*(x[2] - 0.5));
+    };
+
+    // The corners and the centre of the root box all give zero:
+    for (unsigned int k = 0; k < 25; ++k)
+    {
+        std::vector<double> x = {0.1 + 0.2*(k%5), 0.0, 0.1 + 0.2*(k/5), 10.0, 353.0};
+
+        std::vector<double> values;
+        TEST_ASSERT(table.value(x, saddle, values));
+        TEST_ASSERT_DELTA(values[0], saddle(x)[0], 2e-3);
+    }
+}
+
+//---------------------------------------------------------------------------
+void
+AgglomerateSurrogateTest::testFailedSolve()
+{
+    std::vector<double> lower = {0.0, 0.0, 0.7, 10.0, 353.0};
+    std::vector<double> upper = {1.0, 0.0, 0.7, 10.0, 353.0};
+    table.initialize(lower, upper, 1e-4, 1e-10, 10);
+
+    // The solve fails at the upper corner of the root box, which is solved after the lower corner:
+    FuelCellShop::MicroScale::AgglomerateSurrogate::Model failing = [this](const std::vector<double>& x) {
+        ++n_calls;
+        return std::vector<double>(1, (x[0] > 0.9) ? std::nan("") : x[0]);
+    };
+
+    std::vector<double> x = {0.2, 0.0, 0.7, 10.0, 353.0};
+    std::vector<double> values;
+    TEST_ASSERT(!table.value(x, failing, values));
+    TEST_ASSERT(n_calls == 2);
+    TEST_ASSERT(table.samples.size() == 1);
+    TEST_ASSERT(table.boxes[0].rejected);
+
+    x[0] = 0.4;
+    TEST_ASSERT(!table.value(x, failing, values));
+    TEST_ASSERT(n_calls == 2);
+}
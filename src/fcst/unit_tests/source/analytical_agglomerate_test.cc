@@ -120,6 +120,269 @@ void AnalyticalAgglomerateTest::test02CurrentDerivative(){
 }
 
 
+void AnalyticalAgglomerateTest::testO2CurrentDensityCell()
+{
+    ParameterHandler param;
+    FuelCellShop::Layer::CatalystLayer<dim>::declare_CatalystLayer_parameters("CathodeCL", param);
+    FuelCellShop::Material::PolymerElectrolyteBase::declare_PolymerElectrolyte_parameters(param);
+    FuelCellShop::Material::CatalystSupportBase::declare_CatalystSupport_parameters(param);
+    FuelCellShop::Material::CatalystBase::declare_Catalyst_parameters(param);
+    OC.declare_parameters(param);
+
+    param.enter_subsection("Fuel cell data");
+        param.enter_subsection("CathodeCL");
+        param.set("Material id", "4");
+        param.set("Catalyst layer type", "MultiScaleCL");
+
+            param.enter_subsection("ConventionalCL");
+            param.set("Platinum loading on support (%wt)", "4:0.46");
+            param.set("Platinum loading per unit volume (mg/cm3)", "4:400");
+            param.set("Electrolyte loading (%wt)", "4:0.30");
+            param.set("Active area [cm^2/cm^3]", "4:2.0e5");
+            param.leave_subsection();
+
+        param.enter_subsection("MultiScaleCL");
+            param.enter_subsection("MicroScale");
+            param.set("Microscale type", "IonomerAgglomerateAnalytical");
+            param.leave_subsection();
+        param.leave_subsection();
+
+        param.leave_subsection();
+    param.leave_subsection();
+
+    CCL = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("CathodeCL", param);
+    CCL->set_local_material_id(4);
+    OC.initialize(param);
+
+    CCL->set_reaction_kinetics(ORR);
+    CCL->set_constant_solution(OC.get_pc_Pa(), total_pressure);
+    CCL->set_constant_solution(OC.get_T(), temperature_of_REV);
+
+    // All quadrature points of a cell are evaluated at once. The reaction is first order, hence the current is
+    // proportional to the oxygen molar fraction:
+    std::vector<double> x_O2;
+    x_O2.push_back(0.1);
+    x_O2.push_back(0.05);
+    x_O2.push_back(0.0);
+
+    std::vector<FuelCellShop::SolutionVariable> sols;
+    sols.push_back(FuelCellShop::SolutionVariable(x_O2,oxygen_molar_fraction));
+    sols.push_back(FuelCellShop::SolutionVariable(0.625,3,electronic_electrical_potential));
+    sols.push_back(FuelCellShop::SolutionVariable(-0.1,3,protonic_electrical_potential));
+    sols.push_back(FuelCellShop::SolutionVariable(8,3,membrane_water_content));
+    CCL->set_solution(sols);
+
+    std::vector<double> current(3, 0.0);
+    CCL->current_density(current);
+
+    double expected = 2113.66;
+    std::string msg = "Current at the first point does not match expected results! Value obtained is " + std::to_string(current[0]);
+    TEST_ASSERT_DELTA_MSG(expected, current[0], expected*0.05, msg.c_str());
+
+    msg = "Current at the second point is not half the current at the first point! Value obtained is " + std::to_string(current[1]);
+    TEST_ASSERT_DELTA_MSG(0.5*current[0], current[1], 1.0e-8*current[0], msg.c_str());
+
+    msg = "Current without oxygen is not zero! Value obtained is " + std::to_string(current[2]);
+    TEST_ASSERT_MSG(current[2] == 0.0, msg.c_str());
+}
+
+
+void AnalyticalAgglomerateTest::testO2CurrentBatch()
+{
+    boost::shared_ptr<FuelCellShop::MicroScale::MicroScaleBase> micro = create_micro_scale("IonomerAgglomerateAnalytical");
+    check_batch(*micro, true);
+}
+
+
+void AnalyticalAgglomerateTest::testICCPCurrentBatch()
+{
+    boost::shared_ptr<FuelCellShop::MicroScale::MicroScaleBase> micro = create_micro_scale("ICCP");
+    check_batch(*micro, false);
+}
+
+
+void AnalyticalAgglomerateTest::testPolyAgglomerateThreadSafe()
+{
+    boost::shared_ptr<FuelCellShop::MicroScale::MicroScaleBase> serial = create_micro_scale("PolyAgglomerate");
+    //Keep the layer of the serial object alive
+    boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> > serial_CCL = CCL;
+    boost::shared_ptr<FuelCellShop::MicroScale::MicroScaleBase> threaded = create_micro_scale("PolyAgglomerate", true);
+
+    const unsigned int n_points = 4;
+    const double x_O2[] = {0.1, 0.05, 0.2, 0.15};
+    const double phi_s[] = {0.625, 0.7, 0.6, 0.8};
+    const double phi_m[] = {-0.1, -0.05, 0.0, -0.1};
+    const double lambda[] = {8.0, 8.0, 10.0, 12.0};
+
+    std::map<VariableNames, FuelCellShop::SolutionVariable> sols;
+    sols[oxygen_molar_fraction] = FuelCellShop::SolutionVariable(std::vector<double>(x_O2, x_O2 + n_points), oxygen_molar_fraction);
+    sols[electronic_electrical_potential] = FuelCellShop::SolutionVariable(std::vector<double>(phi_s, phi_s + n_points), electronic_electrical_potential);
+    sols[protonic_electrical_potential] = FuelCellShop::SolutionVariable(std::vector<double>(phi_m, phi_m + n_points), protonic_electrical_potential);
+    sols[membrane_water_content] = FuelCellShop::SolutionVariable(std::vector<double>(lambda, lambda + n_points), membrane_water_content);
+    sols[temperature_of_REV] = FuelCellShop::SolutionVariable(OC.get_T(), n_points, temperature_of_REV);
+
+    const VariableNames outputs[] = {current_density, CL_effectiveness};
+    const std::string output_names[] = {"current density", "effectiveness"};
+    for (unsigned int p = 0; p < n_points; ++p)
+    {
+        serial->set_solution(sols, oxygen_molar_fraction, p);
+        threaded->set_solution(sols, oxygen_molar_fraction, p);
+
+        FuelCellShop::SolutionMap reference = serial->compute_current();
+
+        //Size classes distributed by a parallel loop
+        FuelCellShop::SolutionMap loop = threaded->compute_current();
+
+        //Size classes solved as tasks of an enclosing parallel region, as in MultiScaleCL
+        FuelCellShop::SolutionMap tasks;
+        #pragma omp parallel
+        {
+            #pragma omp single
+            tasks = threaded->compute_current();
+        }
+
+        for (unsigned int k = 0; k < 2; ++k)
+        {
+            const double expected = reference.at(outputs[k])[0];
+            std::string msg = "The thread safe PolyAgglomerate " + output_names[k] + " differs at point " + std::to_string(p)
+                            + "! Values obtained are " + std::to_string(loop.at(outputs[k])[0]) + " and " + std::to_string(tasks.at(outputs[k])[0])
+                            + ", expected " + std::to_string(expected);
+            TEST_ASSERT_DELTA_MSG(expected, loop.at(outputs[k])[0], 1.0e-10*std::fabs(expected), msg.c_str());
+            TEST_ASSERT_DELTA_MSG(expected, tasks.at(outputs[k])[0], 1.0e-10*std::fabs(expected), msg.c_str());
+        }
+    }
+
+    check_batch(*threaded, false);
+}
+
+
+boost::shared_ptr<FuelCellShop::MicroScale::MicroScaleBase>
+AnalyticalAgglomerateTest::create_micro_scale(const std::string& micro_type, const bool thread_safe)
+{
+    ParameterHandler param;
+    FuelCellShop::Layer::CatalystLayer<dim>::declare_CatalystLayer_parameters("CathodeCL", param);
+    FuelCellShop::Material::PolymerElectrolyteBase::declare_PolymerElectrolyte_parameters(param);
+    FuelCellShop::Material::CatalystSupportBase::declare_CatalystSupport_parameters(param);
+    FuelCellShop::Material::CatalystBase::declare_Catalyst_parameters(param);
+    OC.declare_parameters(param);
+
+    param.enter_subsection("Fuel cell data");
+        param.enter_subsection("CathodeCL");
+        param.set("Material id", "4");
+        param.set("Catalyst layer type", "MultiScaleCL");
+
+            param.enter_subsection("ConventionalCL");
+            param.set("Platinum loading on support (%wt)", "4:0.46");
+            param.set("Platinum loading per unit volume (mg/cm3)", "4:400");
+            param.set("Electrolyte loading (%wt)", "4:0.30");
+            param.set("Active area [cm^2/cm^3]", "4:2.0e5");
+            param.leave_subsection();
+
+        param.enter_subsection("MultiScaleCL");
+            param.enter_subsection("MicroScale");
+            param.set("Microscale type", micro_type);
+
+                //Two analytical size classes of different radius
+                param.enter_subsection("PolyAgglomerate");
+                const std::string volumes[] = {"0.6", "0.4"};
+                const std::string radii[] = {"100", "300"};
+                for (unsigned int i = 0; i < 2; ++i)
+                {
+                    param.enter_subsection("MicroStructure" + std::to_string(i));
+                    param.set("Volume fraction", volumes[i]);
+                        param.enter_subsection("MicroScale");
+                        param.set("Microscale type", "IonomerAgglomerateAnalytical");
+                            param.enter_subsection("AgglomerateBase");
+                            param.set("Radius of the agglomerate [nm]", radii[i]);
+                            param.leave_subsection();
+                        param.leave_subsection();
+                    param.leave_subsection();
+                }
+                param.leave_subsection();
+
+            param.leave_subsection();
+        param.leave_subsection();
+
+        param.leave_subsection();
+    param.leave_subsection();
+
+    CCL = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("CathodeCL", param);
+    CCL->set_local_material_id(4);
+    OC.initialize(param);
+
+    CCL->set_reaction_kinetics(ORR);
+    CCL->set_constant_solution(OC.get_pc_Pa(), total_pressure);
+    CCL->set_constant_solution(OC.get_T(), temperature_of_REV);
+
+    //A micro scale object of the layer, created as in MultiScaleCL
+    boost::shared_ptr<FuelCellShop::MicroScale::MicroScaleBase> micro;
+    param.enter_subsection("Fuel cell data");
+        param.enter_subsection("CathodeCL");
+            param.enter_subsection("MultiScaleCL");
+            micro = FuelCellShop::MicroScale::MicroScaleBase::create_MicroStructure(param, dynamic_cast<FuelCellShop::Layer::MultiScaleCL<dim>*>(CCL.get()));
+            param.leave_subsection();
+
+        if (thread_safe)
+            micro->make_thread_safe(param, 0);
+        param.leave_subsection();
+    param.leave_subsection();
+
+    return micro;
+}
+
+
+void AnalyticalAgglomerateTest::check_batch(FuelCellShop::MicroScale::MicroScaleBase& micro, const bool derivatives)
+{
+    //Points with different reactant, potentials and water content, and a point without reactant
+    const unsigned int n_points = 5;
+    const double x_O2[] = {0.1, 0.05, 0.2, 0.15, 0.0};
+    const double phi_s[] = {0.625, 0.7, 0.6, 0.8, 0.625};
+    const double phi_m[] = {-0.1, -0.05, 0.0, -0.1, -0.1};
+    const double lambda[] = {8.0, 8.0, 10.0, 12.0, 8.0};
+
+    std::map<VariableNames, FuelCellShop::SolutionVariable> sols;
+    sols[oxygen_molar_fraction] = FuelCellShop::SolutionVariable(std::vector<double>(x_O2, x_O2 + n_points), oxygen_molar_fraction);
+    sols[electronic_electrical_potential] = FuelCellShop::SolutionVariable(std::vector<double>(phi_s, phi_s + n_points), electronic_electrical_potential);
+    sols[protonic_electrical_potential] = FuelCellShop::SolutionVariable(std::vector<double>(phi_m, phi_m + n_points), protonic_electrical_potential);
+    sols[membrane_water_content] = FuelCellShop::SolutionVariable(std::vector<double>(lambda, lambda + n_points), membrane_water_content);
+    sols[temperature_of_REV] = FuelCellShop::SolutionVariable(OC.get_T(), n_points, temperature_of_REV);
+
+    TEST_ASSERT(micro.has_batch_current());
+
+    FuelCellShop::SolutionMap batch = micro.compute_current_batch(sols, oxygen_molar_fraction);
+
+    const VariableNames outputs[] = {current_density, CL_effectiveness, OH_coverage, O_coverage};
+    const std::string output_names[] = {"current density", "effectiveness", "OH coverage", "O coverage"};
+    for (unsigned int p = 0; p < n_points; ++p)
+    {
+        micro.set_solution(sols, oxygen_molar_fraction, p);
+        FuelCellShop::SolutionMap point = micro.compute_current();
+
+        for (unsigned int k = 0; k < 4; ++k)
+        {
+            std::string msg = "The batched and the per point " + output_names[k] + " differ at point " + std::to_string(p);
+            TEST_ASSERT_MSG(batch.has(outputs[k]) == point.has(outputs[k]), msg.c_str());
+
+            if (batch.has(outputs[k]) && point.has(outputs[k]))
+                TEST_ASSERT_DELTA_MSG(point.at(outputs[k])[0], batch.at(outputs[k])[p], 1.0e-8*std::fabs(point.at(outputs[k])[0]) + 1.0e-12, msg.c_str());
+        }
+
+        //Derivatives are not defined without reactant
+        if (!derivatives || x_O2[p] <= 0.0)
+            continue;
+
+        std::vector<double> dI = micro.compute_derivative_current();
+        std::vector< std::vector<double> > dI_batch = micro.compute_derivative_current_batch(sols, oxygen_molar_fraction);
+
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+            std::string msg = "The batched and the per point current derivative " + std::to_string(d) + " differ at point " + std::to_string(p)
+                            + "! Values obtained are " + std::to_string(dI_batch[d][p]) + " and " + std::to_string(dI[d]);
+            TEST_ASSERT_DELTA_MSG(dI[d], dI_batch[d][p], 1.0e-8*std::fabs(dI[d]), msg.c_str());
+        }
+    }
+}
+
 void AnalyticalAgglomerateTest::testInvalidKineticsDT(){
     ParameterHandler param;
     FuelCellShop::Layer::CatalystLayer<dim>::declare_CatalystLayer_parameters("CathodeCL", param);
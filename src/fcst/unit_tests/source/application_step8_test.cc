@@ -126,3 +126,64 @@ NAME::ApplicationStep8Test::runApplication()
     
 
 }
+
+//---------------------------------------------
+void
+NAME::DecoupledAppStep8::cell_matrix(MatrixVector& cell_matrices,
+                                     const DoFApplication<deal_II_dimension>::CellInfo& info)
+{
+    FuelCell::Application::AppStep8<deal_II_dimension>::cell_matrix(cell_matrices, info);
+
+    for (unsigned int m = 0; m < cell_matrices.size(); ++m)
+        if (cell_matrices[m].row != cell_matrices[m].column)
+            cell_matrices[m].matrix = 0.;
+}
+
+//---------------------------------------------
+void
+NAME::ApplicationStep8Test::testStageSolve()
+{
+    ParameterHandler param;
+    DecoupledAppStep8 app;
+
+    app.declare_parameters(param);
+    param.enter_subsection("Discretization");{
+        param.set("Element","FESystem[FE_Q(1)^2]");
+    }
+    param.leave_subsection();
+
+    app.initialize(param);
+    app.get_data()->set_nonlinear_solver("None");
+    app.get_data()->set_linear_solver("CG");
+
+    app.remesh_dofs();
+    app.remesh_matrices();
+
+    FEVector rhs;
+    app.init_vector(rhs);
+    FEVectors data;
+    data.add_vector(rhs, "residual");
+    data.add_vector(rhs, "Solution");
+    app.residual(rhs, data);
+
+    // Whole system, first block and second block:
+    std::vector<FEVector> u(3);
+    for (unsigned int s = 0; s < u.size(); ++s)
+    {
+        app.blocks.clear();
+        if (s > 0)
+            app.blocks.push_back(s - 1);
+
+        app.init_vector(u[s]);
+        app.notify(Event::assign("LinearAssembly"));
+        app.solve(u[s], data);
+    }
+
+    TEST_ASSERT_MSG(u[0].block(0).linfty_norm() > 0.0 && u[0].block(1).linfty_norm() > 0.0, "ApplicationStep8Test::testStageSolve failed, the solution is zero");
+    TEST_ASSERT_DELTA_MSG(u[1].block(1).linfty_norm(), 0.0, 1e-15, "ApplicationStep8Test::testStageSolve failed, a block that is not solved was modified");
+    TEST_ASSERT_DELTA_MSG(u[2].block(0).linfty_norm(), 0.0, 1e-15, "ApplicationStep8Test::testStageSolve failed, a block that is not solved was modified");
+
+    for (unsigned int b = 0; b < 2; ++b)
+        for (unsigned int i = 0; i < u[0].block(b).size(); ++i)
+            TEST_ASSERT_DELTA_MSG(u[b+1].block(b)(i), u[0].block(b)(i), 1e-8, "ApplicationStep8Test::testStageSolve failed, the solution of a block differs from the whole system");
+}
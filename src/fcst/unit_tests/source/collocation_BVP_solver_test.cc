@@ -0,0 +1,132 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: collocation_BVP_solver_test.cc
+//    - Description: Unit testing class for the native collocation BVP solver
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <collocation_BVP_solver_test.h>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    /** Fixed point where the coefficient jumps */
+    double fixpoint = 0.37;
+
+    /** u'' = k(x) u */
+    void fsub(void*, double& x, double z[], double[], double f[])
+    {
+        f[0] = (x < fixpoint ? 100.0 : 1.0)*z[0];
+    }
+
+    void dfsub(void*, double& x, double[], double[], double df[])
+    {
+        df[0] = (x < fixpoint ? 100.0 : 1.0);
+        df[1] = 0.0;
+    }
+
+    /** u(0) = 1 and u(1) = 2 */
+    void gsub(void*, int& i, double z[], double& g)
+    {
+        g = (i == 1) ? z[0] - 1.0 : z[0] - 2.0;
+    }
+
+    void dgsub(void*, int&, double[], double dg[])
+    {
+        dg[0] = 1.0;
+        dg[1] = 0.0;
+    }
+
+    /** Closed form solution */
+    double exact(const double x)
+    {
+        const double p = 10.0;
+        const double c = fixpoint;
+
+        // u = cosh(p x) + B sinh(p x) in the first part, u = C cosh(x - c) + D sinh(x - c) in the second:
+        const double C0 = std::cosh(p*c), C1 = std::sinh(p*c);
+        const double D0 = p*std::sinh(p*c), D1 = p*std::cosh(p*c);
+        const double B = (2.0 - C0*std::cosh(1.0 - c) - D0*std::sinh(1.0 - c))/(C1*std::cosh(1.0 - c) + D1*std::sinh(1.0 - c));
+
+        if (x < c)
+            return std::cosh(p*x) + B*std::sinh(p*x);
+
+        return (C0 + B*C1)*std::cosh(x - c) + (D0 + B*D1)*std::sinh(x - c);
+    }
+}
+
+//---------------------------------------------------------------------------
+void
+CollocationBVPSolverTest::testFixpoint()
+{
+    int m[] = {2};
+    double zeta[] = {0.0, 1.0};
+    FuelCell::ApplicationCore::CollocationBVPSolver<2> solver(1, 0, m, 0.0, 1.0, zeta, NULL, &fsub, &dfsub, &gsub, &dgsub);
+
+    int ltol[] = {1, 2};
+    double tol[] = {1e-6, 1e-6};
+    solver.set_tolerance(2, ltol, tol);
+    solver.set_fixpnts(1, &fixpoint);
+
+    TEST_ASSERT(solver.DAE_solve() == 1);
+    check_solution(solver, 1e-5);
+}
+
+//---------------------------------------------------------------------------
+void
+CollocationBVPSolverTest::testFixpointContinuation()
+{
+    int m[] = {2};
+    double zeta[] = {0.0, 1.0};
+    FuelCell::ApplicationCore::CollocationBVPSolver<2> solver(1, 0, m, 0.0, 1.0, zeta, NULL, &fsub, &dfsub, &gsub, &dgsub);
+
+    int ltol[] = {1, 2};
+    double tol[] = {1e-1, 1e-1};
+    solver.set_tolerance(2, ltol, tol);
+    solver.set_fixpnts(1, &fixpoint);
+
+    // First solve on a mesh where the fixed point is at an odd index, i.e., it is not kept by taking every other point:
+    const double mesh[] = {0.0, 0.1, 0.2, fixpoint, 0.7, 1.0};
+    TEST_ASSERT(solver.set_fixed_mesh(5, mesh));
+    TEST_ASSERT(solver.DAE_solve() == 1);
+
+    // Reduce the tolerance as the numerical agglomerates do, each solve starts from every other point of the previous mesh:
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        tol[0] = tol[1] = tol[0]/10.0;
+        solver.use_simple_cont();
+        TEST_ASSERT(solver.DAE_solve() == 1);
+        check_solution(solver, 10.0*tol[0]);
+    }
+}
+
+//---------------------------------------------------------------------------
+void
+CollocationBVPSolverTest::check_solution(FuelCell::ApplicationCore::BVPSolver& solver, const double tolerance)
+{
+    std::vector<double> mesh(solver.get_size_final_mesh());
+    solver.get_copy_final_mesh(&mesh[0]);
+
+    bool has_fixpoint = false;
+    for (unsigned int i = 0; i < mesh.size(); ++i)
+        has_fixpoint = has_fixpoint || mesh[i] == fixpoint;
+    TEST_ASSERT_MSG(has_fixpoint, "The fixed point is not a point of the final mesh");
+
+    for (unsigned int i = 0; i <= 20; ++i)
+    {
+        const double x = i/20.0;
+        double z[2], y[1];
+        solver.DAE_solution(x, z, y);
+        TEST_ASSERT_DELTA(z[0], exact(x), tolerance*(1.0 + std::fabs(exact(x))));
+    }
+}
@@ -0,0 +1,289 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: dof_application_test.cc
+//    - Description: Test for the parallel data management of DoFApplication
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <dof_application_test.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/dofs/dof_tools.h>
+
+namespace NAME = FuelCell::UnitTest;
+
+//---------------------------------------------
+void
+NAME::DoFApplicationTest::initialize(FuelCell::Application::AppStep8<deal_II_dimension>& app)
+{
+    ParameterHandler param;
+
+    app.declare_parameters(param);
+    param.enter_subsection("Discretization");{
+        param.set("Element","FESystem[FE_Q(1)^2]");
+    }
+    param.leave_subsection();
+
+    app.initialize(param);
+    app.remesh_dofs();
+}
+
+//---------------------------------------------
+void
+NAME::DoFApplicationTest::testVectorTransfer()
+{
+#ifdef OPENFCST_WITH_PETSC
+    FuelCell::Application::AppStep8<deal_II_dimension> app;
+    initialize(app);
+
+    const types::global_dof_index n_dofs = app.dof->n_dofs();
+
+    // The unit tests run on a single process, which owns all the degrees of freedom:
+    TEST_ASSERT_MSG(app.locally_owned_dofs.n_elements() == n_dofs, "DoFApplicationTest::testVectorTransfer failed, wrong number of owned dofs");
+    TEST_ASSERT_MSG(app.locally_owned_dof_indices.size() == n_dofs, "DoFApplicationTest::testVectorTransfer failed, wrong number of owned dof indices");
+
+    FEVector u;
+    app.init_vector(u);
+    for (unsigned int i = 0; i < u.size(); ++i)
+        u(i) = 1.0 + i;
+
+    PETScWrappers::MPI::Vector distributed_u(app.mpi_communicator, n_dofs, app.locally_owned_dofs.n_elements());
+    app.export_to_distributed_vector(u, distributed_u);
+
+    FEVector v;
+    app.init_vector(v);
+    app.import_distributed_vector(distributed_u, v);
+
+    for (unsigned int i = 0; i < u.size(); ++i)
+    {
+        TEST_ASSERT_DELTA_MSG(distributed_u(i), u(i), 1e-15, "DoFApplicationTest::testVectorTransfer failed, wrong exported entry");
+        TEST_ASSERT_DELTA_MSG(v(i), u(i), 1e-15, "DoFApplicationTest::testVectorTransfer failed, wrong imported entry");
+    }
+#endif
+}
+
+//---------------------------------------------
+void
+NAME::DoFApplicationTest::testOwnedDofs()
+{
+#ifdef OPENFCST_WITH_PETSC
+    FuelCell::Application::AppStep8<deal_II_dimension> app;
+    initialize(app);
+
+    // The first half of the cells belongs to subdomain 1:
+    const unsigned int n_cells = app.tr->n_active_cells();
+    unsigned int index = 0;
+    for (Triangulation<deal_II_dimension>::active_cell_iterator cell = app.tr->begin_active(); cell != app.tr->end(); ++cell, ++index)
+        cell->set_subdomain_id( (index < n_cells/2) ? 1 : 0 );
+
+    app.remesh_dofs();
+
+    const types::global_dof_index n_dofs_0 = DoFTools::count_dofs_with_subdomain_association(*app.dof, 0);
+    const types::global_dof_index n_dofs_1 = DoFTools::count_dofs_with_subdomain_association(*app.dof, 1);
+
+    TEST_ASSERT_MSG(n_dofs_0 + n_dofs_1 == app.dof->n_dofs(), "DoFApplicationTest::testOwnedDofs failed, wrong subdomain association");
+    TEST_ASSERT_MSG(app.locally_owned_dofs.n_elements() == n_dofs_0, "DoFApplicationTest::testOwnedDofs failed, wrong number of owned dofs");
+    TEST_ASSERT_MSG(app.locally_owned_dofs.is_contiguous(), "DoFApplicationTest::testOwnedDofs failed, owned dofs not contiguous");
+    TEST_ASSERT_MSG(app.locally_owned_dof_indices.size() == n_dofs_0 && app.locally_owned_dof_indices[0] == 0,
+                    "DoFApplicationTest::testOwnedDofs failed, owned dofs are not the first rows");
+
+    std::vector<types::global_dof_index> cell_indices(app.element->dofs_per_cell);
+    bool wrong_interior = false;
+    for (DoFHandler<deal_II_dimension>::active_cell_iterator cell = app.dof->begin_active(); cell != app.dof->end(); ++cell)
+    {
+        if (cell->subdomain_id() != 0)
+            continue;
+
+        cell->get_dof_indices(cell_indices);
+
+        bool owned = true;
+        for (unsigned int i = 0; i < cell_indices.size(); ++i)
+            owned = owned && (cell_indices[i] < n_dofs_0);
+
+        if (app.is_interior_cell(cell_indices) != owned)
+            wrong_interior = true;
+    }
+    TEST_ASSERT_MSG(!wrong_interior, "DoFApplicationTest::testOwnedDofs failed, wrong interior cell");
+#endif
+}
+
+//---------------------------------------------
+void
+NAME::DoFApplicationTest::testResidual()
+{
+    FuelCell::Application::AppStep8<deal_II_dimension> app;
+    initialize(app);
+
+    FEVector rhs;
+    app.init_vector(rhs);
+    FEVectors data;
+    data.add_vector(rhs, "residual");
+    data.add_vector(rhs, "Solution");
+
+    FEVector dst;
+    app.residual(dst, data, false);
+
+    // Sum of the residuals of the cells:
+    typedef FuelCell::ApplicationCore::DoFApplication<deal_II_dimension> DoFApp;
+    FEValues<deal_II_dimension>*     fe_values      = 0;
+    FEFaceValues<deal_II_dimension>* fe_face_values = 0;
+    DoFApp::CellInfo cell_info(data, app.block_info);
+    DoFApp::FaceInfo bdry_info(data, app.block_info);
+    cell_info.initialize(fe_values, *app.element, *app.mapping, app.quadrature_residual_cell,
+                         UpdateFlags(update_q_points | update_values | update_gradients | update_JxW_values));
+    bdry_info.initialize(fe_face_values, *app.element, *app.mapping, app.quadrature_residual_bdry,
+                         UpdateFlags(update_q_points | update_values | update_gradients | update_normal_vectors | update_JxW_values));
+
+    FEVector local_residual(app.block_info.local);
+    FEVector expected;
+    app.init_vector(expected);
+    for (DoFHandler<deal_II_dimension>::active_cell_iterator cell = app.dof->begin_active(); cell != app.dof->end(); ++cell)
+    {
+        app.cell_and_bdry_residual(local_residual, cell_info, bdry_info, cell);
+        for (unsigned int i = 0; i < app.element->dofs_per_cell; ++i)
+            expected(cell_info.indices[i]) += local_residual(i);
+    }
+
+    TEST_ASSERT_MSG(expected.l2_norm() > 0.0, "DoFApplicationTest::testResidual failed, zero residual");
+    for (unsigned int i = 0; i < dst.size(); ++i)
+        TEST_ASSERT_DELTA_MSG(dst(i), expected(i), 1e-14, "DoFApplicationTest::testResidual failed, wrong residual entry");
+}
+
+//---------------------------------------------
+void
+NAME::DoFApplicationTest::testAssemblyBatchGuard()
+{
+    FuelCell::Application::AppStep8<deal_II_dimension> app;
+    initialize(app);
+
+    FEVector rhs;
+    app.init_vector(rhs);
+    FEVectors data;
+    data.add_vector(rhs, "residual");
+    data.add_vector(rhs, "Solution");
+
+    TestAssemblyBatch batch(false);
+    TestAssemblyBatch failing_batch(true);
+    app.add_assembly_batch(&batch);
+    TEST_ASSERT_MSG(batch.batch_registered(), "DoFApplicationTest::testAssemblyBatchGuard failed, batch not registered");
+
+    FEVector dst;
+    app.residual(dst, data, false);
+    TEST_ASSERT_MSG(batch.n_collects == 1 && batch.n_ends == 1 && !batch.collecting, "DoFApplicationTest::testAssemblyBatchGuard failed, batch not ended after the residual");
+
+    // The second batch throws after the collect pass:
+    app.add_assembly_batch(&failing_batch);
+    bool thrown = false;
+    try
+    {
+        app.residual(dst, data, false);
+    }
+    catch (const std::runtime_error& )
+    {
+        thrown = true;
+    }
+
+    TEST_ASSERT_MSG(thrown, "DoFApplicationTest::testAssemblyBatchGuard failed, exception not propagated");
+    TEST_ASSERT_MSG(batch.n_collects == 2 && !batch.collecting, "DoFApplicationTest::testAssemblyBatchGuard failed, batch left in batch mode by the exception");
+    TEST_ASSERT_MSG(failing_batch.n_collects == 1 && failing_batch.n_ends == 1 && !failing_batch.collecting,
+                    "DoFApplicationTest::testAssemblyBatchGuard failed, failing batch left in batch mode by the exception");
+}
+
+//---------------------------------------------
+void
+NAME::DoFApplicationTest::testSubdomainDataOut()
+{
+    Triangulation<deal_II_dimension> tr;
+    GridGenerator::hyper_cube(tr);
+    tr.refine_global(2);
+
+    // The first half of the cells belongs to subdomain 1:
+    const unsigned int n_cells = tr.n_active_cells();
+    unsigned int index = 0;
+    for (Triangulation<deal_II_dimension>::active_cell_iterator cell = tr.begin_active(); cell != tr.end(); ++cell, ++index)
+        cell->set_subdomain_id( (index < n_cells/2) ? 1 : 0 );
+
+    FE_Q<deal_II_dimension> fe(1);
+    DoFHandler<deal_II_dimension> dof_handler(tr);
+    dof_handler.distribute_dofs(fe);
+
+    FuelCell::ApplicationCore::SubdomainDataOut<deal_II_dimension> data_out;
+    data_out.attach_dof_handler(dof_handler);
+
+    // Cells visited by the patches for each subdomain, where the last one stands for all the cells:
+    const types::subdomain_id subdomains[3] = {0, 1, numbers::invalid_subdomain_id};
+    const unsigned int expected_cells[3] = {n_cells - n_cells/2, n_cells/2, n_cells};
+
+    for (unsigned int s = 0; s < 3; ++s)
+    {
+        data_out.set_subdomain_id(subdomains[s]);
+
+        unsigned int n_visited = 0;
+        bool other_subdomain = false;
+        for (FuelCell::ApplicationCore::SubdomainDataOut<deal_II_dimension>::cell_iterator cell = data_out.first_cell(); cell != dof_handler.end(); cell = data_out.next_cell(cell))
+        {
+            ++n_visited;
+            if (subdomains[s] != numbers::invalid_subdomain_id && cell->subdomain_id() != subdomains[s])
+                other_subdomain = true;
+        }
+
+        TEST_ASSERT_MSG(n_visited == expected_cells[s], "DoFApplicationTest::testSubdomainDataOut failed, wrong number of cells");
+        TEST_ASSERT_MSG(!other_subdomain, "DoFApplicationTest::testSubdomainDataOut failed, a cell of another subdomain was visited");
+    }
+}
+
+//---------------------------------------------
+void
+NAME::DoFApplicationTest::testDataOutFilename()
+{
+    FuelCell::Application::AppStep8<deal_II_dimension> app;
+    initialize(app);
+
+    const std::string suffix = app.d_out.default_suffix();
+
+    TEST_ASSERT_MSG(!app.write_data_in_parallel(), "DoFApplicationTest::testDataOutFilename failed, parallel output by default");
+    TEST_ASSERT_MSG(app.data_out_filename("solution") == "solution" + suffix, "DoFApplicationTest::testDataOutFilename failed, wrong serial file name");
+
+#ifdef OPENFCST_WITH_PETSC
+    app.parallel_output = true;
+
+    TEST_ASSERT_MSG(app.write_data_in_parallel(), "DoFApplicationTest::testDataOutFilename failed, parallel output not used");
+    TEST_ASSERT_MSG(app.data_out_filename("solution") == "solution.0000" + suffix, "DoFApplicationTest::testDataOutFilename failed, wrong parallel file name");
+#endif
+}
+
+//---------------------------------------------
+void
+NAME::DoFApplicationTest::testMeasuredPartitionWeights()
+{
+    FuelCell::Application::AppStep8<deal_II_dimension> app;
+    initialize(app);
+
+    TEST_ASSERT_DELTA_MSG(app.cell_weight(4), 1.0, 1e-15, "DoFApplicationTest::testMeasuredPartitionWeights failed, wrong default weight");
+
+    // Material 4 costs 0.1 per cell and material 1 costs 0.001 per cell:
+    app.record_cell_cost(4, 0.15);
+    app.record_cell_cost(4, 0.05);
+    for (unsigned int c = 0; c < 10; ++c)
+        app.record_cell_cost(1, 0.001);
+
+    app.update_measured_partition_weights();
+
+    TEST_ASSERT_DELTA_MSG(app.cell_weight(4), 100.0, 1e-10, "DoFApplicationTest::testMeasuredPartitionWeights failed, wrong weight of the expensive material");
+    TEST_ASSERT_DELTA_MSG(app.cell_weight(1), 1.0, 1e-10, "DoFApplicationTest::testMeasuredPartitionWeights failed, wrong weight of the cheapest material");
+    TEST_ASSERT_DELTA_MSG(app.cell_weight(2), 1.0, 1e-15, "DoFApplicationTest::testMeasuredPartitionWeights failed, wrong weight of a material that was not measured");
+    TEST_ASSERT_MSG(app.measured_material_time.empty() && app.measured_material_cells.empty(), "DoFApplicationTest::testMeasuredPartitionWeights failed, measurements not reset");
+
+    // Without new measurements, the weights are kept:
+    app.update_measured_partition_weights();
+    TEST_ASSERT_DELTA_MSG(app.cell_weight(4), 100.0, 1e-10, "DoFApplicationTest::testMeasuredPartitionWeights failed, weights lost without measurements");
+}
@@ -257,5 +257,84 @@ void FCSTdatabaseTest::testCleanUp(){
 
 }
 
+void FCSTdatabaseTest::testSignedTolerance(){
+    testDb.connect(addr);
+
+    //Commit data for negative and zero operating conditions
+    std::string model_name = "SignedTest";
+    FcstUtilities::DatabaseOC OC;
+    OC.add_param("phi_m", -0.5);
+    OC.add_param("x_O2", 0.0);
+
+    std::vector<std::string> columnNames;
+    columnNames.push_back("col1");
+
+    std::vector<std::vector<double>> data;
+    std::vector<double> line;
+    line.push_back(0.123456789012345);
+    data.push_back(line);
+
+    testDb.clear_data(model_name, OC);
+    testDb.commit_data(model_name, OC, columnNames, data);
+
+    //Negative values are matched within tolerance
+    FcstUtilities::DatabaseOC close_OC;
+    close_OC.add_param("phi_m", -0.52);
+    close_OC.add_param("x_O2", 0.0);
+    TEST_ASSERT_MSG(testDb.has_data(model_name, close_OC, 0.05) == true, "According to db, data does not exist (but in reality it does).");
+    TEST_ASSERT_MSG(testDb.has_data(model_name, close_OC, 0.01) == false, "According to db, data exits (but in reality it doesn't).");
+
+    //Zero values are only matched by zero
+    FcstUtilities::DatabaseOC nonzero_OC;
+    nonzero_OC.add_param("phi_m", -0.5);
+    nonzero_OC.add_param("x_O2", 0.001);
+    TEST_ASSERT_MSG(testDb.has_data(model_name, nonzero_OC, 0.05) == false, "According to db, data exits (but in reality it doesn't).");
+
+    //Data is returned as it was committed
+    TEST_ASSERT_MSG(testDb.get_data(model_name, close_OC, 0.05) == data, "Data from table SignedTest does not match expected results.");
+
+    testDb.clear_data(model_name, OC);
+    TEST_ASSERT_MSG(testDb.has_data(model_name, OC) == false , "According to db, data exits (but it should have been cleared).");
+
+    testDb.disconnect();
+}
 
+void FCSTdatabaseTest::testOldHead(){
+    std::string tempAddr = FcstUtilities::find_fcst_root();
+    tempAddr += "databases/old_head_db";
+
+    //Delete the file if it exists
+    remove(tempAddr.c_str());
+
+    //Create a database with the HEAD table of older versions of FCSTdatabase, without HEAD_PARAM
+    sqlite3* old_db;
+    TEST_ASSERT_MSG(sqlite3_open(tempAddr.c_str(), &old_db) == SQLITE_OK, "Old database could not be created.");
+
+    const std::string sqlCmd = "CREATE TABLE 'head' ('Model_name' TEXT NOT NULL, 'OC1_name' TEXT NOT NULL, 'OC1_dat' TEXT NOT NULL, 'OC2_name' TEXT,"
+            " 'OC2_dat' TEXT, 'OC3_name' TEXT, 'OC3_dat' TEXT, 'OC4_name' TEXT, 'OC4_dat' TEXT, 'OC5_name' TEXT, 'OC5_dat' TEXT, 'OC6_name' TEXT,"
+            " 'OC6_dat' TEXT, 'OC7_name' TEXT, 'OC7_dat' TEXT, 'OC8_name' REAL, 'OC8_dat' TEXT, 'OC9_name' TEXT, 'OC9_dat' TEXT, 'OC10_name' TEXT,"
+            " 'OC10_dat' TEXT, 'Table_REF' TEXT NOT NULL);"
+            "INSERT INTO head (Model_name, OC1_name, OC1_dat, OC2_name, OC2_dat, Table_REF) VALUES ('OldTest', 'OCV', '1', 'lambda', '3', 'OldTest_1');"
+            "CREATE TABLE OldTest_1 (col1 REAL);"
+            "INSERT INTO OldTest_1 VALUES (0.5);";
+    TEST_ASSERT_MSG(sqlite3_exec(old_db, sqlCmd.c_str(), NULL, NULL, NULL) == SQLITE_OK, "Old database could not be filled.");
+    sqlite3_close(old_db);
+
+    TEST_ASSERT_MSG(testDb.connect(tempAddr), "Error connecting to the old database");
+
+    FcstUtilities::DatabaseOC OC;
+    OC.add_param("OCV", 1);
+    OC.add_param("lambda", 3);
+    TEST_ASSERT_MSG(testDb.find_table("OldTest", OC) == "OldTest_1", "The table of an old HEAD row was not found.");
+
+    std::vector<std::vector<double>> data = testDb.get_data("OldTest", OC);
+    TEST_ASSERT_MSG(data.size() == 1 && data[0].size() == 1 && data[0][0] == 0.5, "Data from table OldTest_1 does not match expected results.");
 
+    OC.add_param("T", 353);
+    TEST_ASSERT_MSG(testDb.has_data("OldTest", OC) == false, "According to db, data exits (but in reality it doesn't).");
+
+    testDb.disconnect();
+
+    //Clean up
+    remove(tempAddr.c_str());
+}
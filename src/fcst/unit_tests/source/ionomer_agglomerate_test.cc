@@ -115,6 +115,66 @@ void  IonomerAgglomerateTest::testH2CurrentDensity()
 }
 
 
+void  IonomerAgglomerateTest::testO2CurrentDensityCollocation()
+{
+    ParameterHandler param;
+    FuelCellShop::Layer::CatalystLayer<dim>::declare_CatalystLayer_parameters("CathodeCL", param);
+    FuelCellShop::Material::PolymerElectrolyteBase::declare_PolymerElectrolyte_parameters(param);
+    FuelCellShop::Material::CatalystSupportBase::declare_CatalystSupport_parameters(param);
+    FuelCellShop::Material::CatalystBase::declare_Catalyst_parameters(param);
+    OC.declare_parameters(param);
+
+    param.enter_subsection("Fuel cell data");
+		param.enter_subsection("CathodeCL");
+		param.set("Material id", "4");
+		param.set("Catalyst layer type", "MultiScaleCL");
+
+		param.enter_subsection("ConventionalCL");
+		param.set("Platinum loading on support (%wt)", "4:0.46");
+		param.set("Platinum loading per unit volume (mg/cm3)", "4:400");
+		param.set("Electrolyte loading (%wt)", "4:0.30");
+		param.set("Active area [cm^2/cm^3]", "4:2.0e5");
+		param.leave_subsection();
+
+		param.enter_subsection("MultiScaleCL");
+			param.enter_subsection("MicroScale");
+			param.set("Microscale type", "IonomerAgglomerateNumerical");
+				param.enter_subsection("NumericalAgglomerateBase");
+				param.set("BVP solver", "Collocation");
+				param.leave_subsection();
+			param.leave_subsection();
+		param.leave_subsection();
+		param.leave_subsection();
+    param.leave_subsection();
+
+    CCL = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("CathodeCL", param);
+    CCL->set_local_material_id(4);
+
+    OC.initialize(param);
+
+    CCL->set_reaction_kinetics(ORR);
+    CCL->set_constant_solution(OC.get_pc_Pa(), total_pressure);
+    CCL->set_constant_solution(OC.get_T(), temperature_of_REV);
+
+    std::vector<FuelCellShop::SolutionVariable> sols;
+    sols.push_back(FuelCellShop::SolutionVariable(0.1,1,oxygen_molar_fraction));
+    sols.push_back(FuelCellShop::SolutionVariable(0.625,1,electronic_electrical_potential));
+    sols.push_back(FuelCellShop::SolutionVariable(-0.1,1,protonic_electrical_potential));
+    sols.push_back(FuelCellShop::SolutionVariable(8,1,membrane_water_content));
+    CCL->set_solution(sols);
+
+    std::vector<double> current(1, 0.0);
+    CCL->current_density(current);
+
+    //The native collocation solver must give the same current as COLDAE, see testO2CurrentDensity
+    double expected = 2113.46;
+    double match = expected*0.05;
+    std::string msg = "Current from model ionomer numerical with the collocation solver does not match expected results (" + std::to_string(std::abs(100*(expected-current[0])/expected)) + "% wrong)! Current value: " + std::to_string(current[0]);
+
+    TEST_ASSERT_DELTA_MSG(expected, current[0], match, msg.c_str());
+
+}
+
 void IonomerAgglomerateTest::testO2CurrentDerivative(){
     std::map< VariableNames, std::vector<double> > derivatives;
     std::vector<VariableNames> sol_names;
@@ -142,3 +202,91 @@ void IonomerAgglomerateTest::testO2CurrentDerivative(){
     TEST_ASSERT_DELTA_MSG(dCurrentdPhi_s, expDCurrentPhi_s, diffDCurrentPhi_s, msg_3.c_str());
 
 }
+
+//---------------------------------------------------------------------------
+boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> >
+IonomerAgglomerateTest::create_layer(const std::string& bvp_solver)
+{
+    ParameterHandler param;
+    FuelCellShop::Layer::CatalystLayer<dim>::declare_CatalystLayer_parameters("CathodeCL", param);
+    FuelCellShop::Material::PolymerElectrolyteBase::declare_PolymerElectrolyte_parameters(param);
+    FuelCellShop::Material::CatalystSupportBase::declare_CatalystSupport_parameters(param);
+    FuelCellShop::Material::CatalystBase::declare_Catalyst_parameters(param);
+    OC.declare_parameters(param);
+
+    param.enter_subsection("Fuel cell data");
+    {
+        param.enter_subsection("CathodeCL");
+        {
+            param.set("Material id", "4");
+            param.set("Catalyst layer type", "MultiScaleCL");
+
+            param.enter_subsection("ConventionalCL");
+            {
+                param.set("Platinum loading on support (%wt)", "4:0.46");
+                param.set("Platinum loading per unit volume (mg/cm3)", "4:400");
+                param.set("Electrolyte loading (%wt)", "4:0.30");
+                param.set("Active area [cm^2/cm^3]", "4:2.0e5");
+            }
+            param.leave_subsection();
+
+            param.enter_subsection("MultiScaleCL");
+            {
+                param.enter_subsection("MicroScale");
+                {
+                    param.set("Microscale type", "IonomerAgglomerateNumerical");
+                    param.enter_subsection("NumericalAgglomerateBase");
+                    param.set("BVP solver", bvp_solver);
+                    param.leave_subsection();
+                }
+                param.leave_subsection();
+            }
+            param.leave_subsection();
+        }
+        param.leave_subsection();
+    }
+    param.leave_subsection();
+
+    boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> > layer = FuelCellShop::Layer::CatalystLayer<dim>::create_CatalystLayer("CathodeCL", param);
+    layer->set_local_material_id(4);
+
+    OC.initialize(param);
+
+    layer->set_reaction_kinetics(ORR);
+    layer->set_constant_solution(OC.get_pc_Pa(), total_pressure);
+    layer->set_constant_solution(OC.get_T(), temperature_of_REV);
+
+    return layer;
+}
+
+//---------------------------------------------------------------------------
+void IonomerAgglomerateTest::testO2CurrentDensitySolvers()
+{
+    boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> > coldae = create_layer("COLDAE");
+    boost::shared_ptr<FuelCellShop::Layer::CatalystLayer<dim> > collocation = create_layer("Collocation");
+
+    //The collocation solver must give the same current as COLDAE from low to high overpotentials, where the
+    //first solve fails and the tolerance continuation is used
+    const double potentials[] = {0.9, 0.8, 0.7, 0.6, 0.5};
+    for (unsigned int i = 0; i < 5; ++i)
+    {
+        std::vector<FuelCellShop::SolutionVariable> sols;
+        sols.push_back(FuelCellShop::SolutionVariable(0.1,1,oxygen_molar_fraction));
+        sols.push_back(FuelCellShop::SolutionVariable(potentials[i],1,electronic_electrical_potential));
+        sols.push_back(FuelCellShop::SolutionVariable(-0.1,1,protonic_electrical_potential));
+        sols.push_back(FuelCellShop::SolutionVariable(8,1,membrane_water_content));
+
+        std::vector<double> expected(1, 0.0);
+        coldae->set_solution(sols);
+        coldae->current_density(expected);
+
+        std::vector<double> current(1, 0.0);
+        collocation->set_solution(sols);
+        collocation->current_density(current);
+
+        std::string msg = "Current with the collocation solver does not match COLDAE at phi_s = " + std::to_string(potentials[i])
+                        + " (" + std::to_string(std::abs(100*(expected[0]-current[0])/expected[0])) + "% wrong)! Current value: " + std::to_string(current[0]);
+
+        TEST_ASSERT_DELTA_MSG(expected[0], current[0], 0.01*std::fabs(expected[0]), msg.c_str());
+    }
+}
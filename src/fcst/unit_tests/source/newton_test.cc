@@ -0,0 +1,321 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: newton_test.cc
+//    - Description: Test for the variants of the Newton solver
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <newton_test.h>
+
+namespace NAME = FuelCell::UnitTest;
+
+//---------------------------------------------
+NAME::NonlinearTestApplication::NonlinearTestApplication(const bool arctan)
+:
+FuelCell::ApplicationCore::ApplicationBase(boost::shared_ptr<FuelCell::ApplicationCore::ApplicationData>(new FuelCell::ApplicationCore::ApplicationData)),
+n_residuals(0),
+n_solves(0),
+n_assemblies(0),
+arctan(arctan),
+refinement(0.0),
+n_stages(1.0),
+jacobian(6, 6)
+{
+    this->get_data()->enter("Refinement", refinement);
+    this->get_data()->enter("Number of segregated stages", n_stages);
+}
+
+//---------------------------------------------
+void
+NAME::NonlinearTestApplication::init_vector(FuelCell::ApplicationCore::FEVector& dst) const
+{
+    std::vector<types::global_dof_index> sizes(2);
+    sizes[0] = 4;
+    sizes[1] = 2;
+    dst.reinit(sizes);
+}
+
+//---------------------------------------------
+double
+NAME::NonlinearTestApplication::residual(FuelCell::ApplicationCore::FEVector&        dst,
+                                         const FuelCell::ApplicationCore::FEVectors& src,
+                                         bool )
+{
+    const FuelCell::ApplicationCore::FEVector& u = src.vector(src.find_vector("Newton iterate"));
+
+    dst.reinit(u);
+    for (unsigned int i = 0; i < u.size(); ++i)
+    {
+        if (arctan)
+        {
+            dst(i) = std::atan(u(i) - 3.0);
+            continue;
+        }
+
+        // F(u) = A (u - 1) + (u^3 - 1)/2
+        dst(i) = 4.0*(u(i) - 1.0) + 0.5*(u(i)*u(i)*u(i) - 1.0);
+        if (i > 0)
+            dst(i) -= u(i-1) - 1.0;
+        if (i + 1 < u.size())
+            dst(i) -= u(i+1) - 1.0;
+    }
+
+    ++n_residuals;
+    return dst.l2_norm();
+}
+
+//---------------------------------------------
+void
+NAME::NonlinearTestApplication::solve(FuelCell::ApplicationCore::FEVector&        dst,
+                                      const FuelCell::ApplicationCore::FEVectors& src)
+{
+    const FuelCell::ApplicationCore::FEVector& u = src.vector(src.find_vector("Newton iterate"));
+    const FuelCell::ApplicationCore::FEVector& res = src.vector(src.find_vector("Newton residual"));
+
+    // Only assemble the Jacobian if requested:
+    if (this->notifications.any())
+    {
+        jacobian = 0.0;
+        for (unsigned int i = 0; i < u.size(); ++i)
+        {
+            if (arctan)
+            {
+                jacobian(i, i) = 1.0/(1.0 + (u(i) - 3.0)*(u(i) - 3.0));
+                continue;
+            }
+
+            jacobian(i, i) = 4.0 + 1.5*u(i)*u(i);
+            if (i > 0)
+                jacobian(i, i-1) = -1.0;
+            if (i + 1 < u.size())
+                jacobian(i, i+1) = -1.0;
+        }
+        ++n_assemblies;
+        this->notifications.clear();
+    }
+
+    // Pseudo-transient term with the identity as mass matrix:
+    const double* inv_time_step = this->get_data()->scalar("Pseudo time step inverse");
+    shifts.push_back((inv_time_step != NULL) ? *inv_time_step : 0.0);
+
+    const double* stage = this->get_data()->scalar("Segregated solve stage");
+    stages.push_back((stage != NULL) ? *stage : -1.0);
+
+    FullMatrix<double> shifted_jacobian(jacobian);
+    for (unsigned int i = 0; i < u.size(); ++i)
+        shifted_jacobian(i, i) += shifts.back();
+
+    FullMatrix<double> inverse(u.size(), u.size());
+    inverse.invert(shifted_jacobian);
+
+    dst.reinit(u);
+    for (unsigned int i = 0; i < u.size(); ++i)
+        for (unsigned int j = 0; j < u.size(); ++j)
+            dst(i) += inverse(i, j)*res(j);
+
+    ++n_solves;
+}
+
+//---------------------------------------------
+double
+NAME::NewtonTest::run_newton_line_search(NonlinearTestApplication& app,
+                                         const bool                broyden)
+{
+    FuelCell::ApplicationCore::NewtonLineSearch newton(app);
+
+    ParameterHandler param;
+    newton.declare_parameters(param);
+    param.enter_subsection("Newton");
+    {
+        param.set("Max steps", "200");
+        param.set("Tolerance", "1e-10");
+        param.set("Reduction", "1e-14");
+        // Only reassemble the Jacobian if a step does not reduce the residual:
+        param.set("Assemble threshold", "1.0");
+        param.set("Broyden updates", broyden);
+        param.set("Max Broyden updates", "20");
+    }
+    param.leave_subsection();
+    newton.initialize(param);
+
+    FuelCell::ApplicationCore::FEVector u;
+    app.init_vector(u);
+    FuelCell::ApplicationCore::FEVectors in_vectors;
+    newton.solve(u, in_vectors);
+
+    double error = 0.0;
+    for (unsigned int i = 0; i < u.size(); ++i)
+        error = std::max(error, std::fabs(u(i) - 1.0));
+
+    return error;
+}
+
+//---------------------------------------------
+double
+NAME::NewtonTest::run_pseudo_transient(NonlinearTestApplication& app,
+                                       const unsigned int        max_steps)
+{
+    FuelCell::ApplicationCore::NewtonPseudoTransient newton(app);
+
+    ParameterHandler param;
+    newton.declare_parameters(param);
+    param.enter_subsection("Newton");
+    {
+        param.set("Max steps", std::to_string(max_steps));
+        param.set("Tolerance", "1e-10");
+        param.set("Reduction", "1e-14");
+        param.enter_subsection("Pseudo-transient continuation");
+        {
+            param.set("Initial time step", "1.0");
+        }
+        param.leave_subsection();
+    }
+    param.leave_subsection();
+    newton.initialize(param);
+
+    FuelCell::ApplicationCore::FEVector u;
+    app.init_vector(u);
+    FuelCell::ApplicationCore::FEVectors in_vectors;
+    newton.solve(u, in_vectors);
+
+    double error = 0.0;
+    for (unsigned int i = 0; i < u.size(); ++i)
+        error = std::max(error, std::fabs(u(i) - 3.0));
+
+    return error;
+}
+
+//---------------------------------------------
+double
+NAME::NewtonTest::run_segregated(NonlinearTestApplication& app,
+                                 const unsigned int        max_steps,
+                                 const double              exact)
+{
+    FuelCell::ApplicationCore::NewtonSegregated newton(app);
+
+    ParameterHandler param;
+    newton.declare_parameters(param);
+    param.enter_subsection("Newton");
+    {
+        param.set("Max steps", std::to_string(max_steps));
+        param.set("Tolerance", "1e-10");
+        param.set("Reduction", "1e-14");
+    }
+    param.leave_subsection();
+    newton.initialize(param);
+
+    FuelCell::ApplicationCore::FEVector u;
+    app.init_vector(u);
+    FuelCell::ApplicationCore::FEVectors in_vectors;
+    newton.solve(u, in_vectors);
+
+    double error = 0.0;
+    for (unsigned int i = 0; i < u.size(); ++i)
+        error = std::max(error, std::fabs(u(i) - exact));
+
+    return error;
+}
+
+//---------------------------------------------
+void
+NAME::NewtonTest::testBroydenUpdates()
+{
+    NonlinearTestApplication chord_app;
+    const double error_chord = run_newton_line_search(chord_app, false);
+
+    NonlinearTestApplication broyden_app;
+    const double error_broyden = run_newton_line_search(broyden_app, true);
+
+    TEST_ASSERT_DELTA_MSG(error_chord, 0.0, 1e-8, "Newton with a frozen Jacobian did not converge to the solution");
+    TEST_ASSERT_DELTA_MSG(error_broyden, 0.0, 1e-8, "Newton with Broyden updates did not converge to the solution");
+
+    TEST_ASSERT_MSG(broyden_app.n_solves < chord_app.n_solves/3, "Broyden updates did not reduce the number of Newton iterations");
+    TEST_ASSERT_MSG(broyden_app.n_assemblies == 1, "Broyden updates did not keep the Jacobian of the first iteration");
+}
+
+//---------------------------------------------
+void
+NAME::NewtonTest::testPseudoTransient()
+{
+    NonlinearTestApplication app(true);
+    const double error = run_pseudo_transient(app, 50);
+
+    TEST_ASSERT_DELTA_MSG(error, 0.0, 1e-8, "Pseudo-transient continuation did not converge to the solution");
+
+    TEST_ASSERT_DELTA_MSG(app.shifts.front(), 1.0, 1e-12, "The first linear system does not use the initial pseudo time step");
+    TEST_ASSERT_MSG(app.shifts.back() < 1e-3, "The pseudo time step did not grow towards Newton's method");
+
+    TEST_ASSERT_MSG(app.get_data()->scalar("Pseudo time step inverse") == NULL, "The pseudo time step is still registered after the solve");
+}
+
+//---------------------------------------------
+void
+NAME::NewtonTest::testPseudoTransientFailure()
+{
+    NonlinearTestApplication app(true);
+    TEST_THROWS_ANYTHING_MSG(run_pseudo_transient(app, 2), "Pseudo-transient continuation converged in two iterations");
+
+    TEST_ASSERT_MSG(app.get_data()->scalar("Pseudo time step inverse") == NULL, "The pseudo time step is still registered after a failed solve");
+}
+
+//---------------------------------------------
+void
+NAME::NewtonTest::testToleranceSchedule()
+{
+    FuelCell::ApplicationCore::OptimizationBlockMatrixApplication<deal_II_dimension> app_linear;
+    FuelCell::ApplicationCore::ApplicationWrapper app(app_linear);
+    FuelCell::ApplicationCore::AdaptiveRefinement<deal_II_dimension> refinement(app_linear, app);
+
+    refinement.tolerance_schedule = true;
+    refinement.initial_cycle_tolerance = 1e-4;
+    refinement.error_estimate_scaling = 1e-2;
+    refinement.max_intermediate_tolerance = 1e-3;
+
+    const double final_tolerance = 1e-8;
+
+    TEST_ASSERT_DELTA_MSG(refinement.cycle_tolerance(0, false, final_tolerance, 0.0), 1e-4, 1e-16,
+                          "The first cycle does not use the initial cycle tolerance");
+    TEST_ASSERT_DELTA_MSG(refinement.cycle_tolerance(1, false, final_tolerance, 1e-3), 1e-5, 1e-16,
+                          "The intermediate tolerance is not the scaled error estimate");
+    TEST_ASSERT_DELTA_MSG(refinement.cycle_tolerance(1, false, final_tolerance, 10.0), 1e-3, 1e-16,
+                          "The intermediate tolerance is not bounded by the maximum intermediate tolerance");
+    TEST_ASSERT_DELTA_MSG(refinement.cycle_tolerance(2, false, final_tolerance, 1e-9), final_tolerance, 1e-16,
+                          "The intermediate tolerance is smaller than the final tolerance");
+    TEST_ASSERT_DELTA_MSG(refinement.cycle_tolerance(3, true, final_tolerance, 10.0), final_tolerance, 1e-16,
+                          "The last cycle does not use the final tolerance");
+}
+
+//---------------------------------------------
+void
+NAME::NewtonTest::testSegregated()
+{
+    NonlinearTestApplication app;
+    const double error = run_segregated(app, 50, 1.0);
+
+    TEST_ASSERT_DELTA_MSG(error, 0.0, 1e-8, "The segregated solver did not converge to the solution");
+
+    TEST_ASSERT_MSG(!app.stages.empty(), "The segregated solver did not solve a linear system");
+    for (unsigned int i = 0; i < app.stages.size(); ++i)
+        TEST_ASSERT_DELTA_MSG(app.stages[i], 0.0, 1e-12, "A linear system was solved without the stage being registered");
+
+    TEST_ASSERT_MSG(app.get_data()->scalar("Segregated solve stage") == NULL, "The stage is still registered after the solve");
+}
+
+//---------------------------------------------
+void
+NAME::NewtonTest::testSegregatedFailure()
+{
+    // Newton's method diverges for the arctan system:
+    NonlinearTestApplication app(true);
+    TEST_THROWS_ANYTHING_MSG(run_segregated(app, 1, 3.0), "The segregated solver converged in one outer iteration");
+
+    TEST_ASSERT_MSG(app.get_data()->scalar("Segregated solve stage") == NULL, "The stage is still registered after a failed solve");
+}
@@ -0,0 +1,144 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: picard_test.cc
+//    - Description: Test for the Picard solver and its Anderson acceleration
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <picard_test.h>
+
+namespace NAME = FuelCell::UnitTest;
+
+//---------------------------------------------
+NAME::LinearContractionApplication::LinearContractionApplication()
+:
+FuelCell::ApplicationCore::ApplicationBase(),
+n_solves(0),
+diagonal(6)
+{
+    diagonal(0) = 0.95;
+    diagonal(1) = 0.9;
+    diagonal(2) = 0.8;
+    diagonal(3) = 0.6;
+    diagonal(4) = 0.4;
+    diagonal(5) = 0.1;
+}
+
+//---------------------------------------------
+void
+NAME::LinearContractionApplication::init_vector(FuelCell::ApplicationCore::FEVector& dst) const
+{
+    std::vector<types::global_dof_index> sizes(2);
+    sizes[0] = 4;
+    sizes[1] = 2;
+    dst.reinit(sizes);
+}
+
+//---------------------------------------------
+double
+NAME::LinearContractionApplication::residual(FuelCell::ApplicationCore::FEVector&        dst,
+                                             const FuelCell::ApplicationCore::FEVectors& src,
+                                             bool )
+{
+    const FuelCell::ApplicationCore::FEVector& u = src.vector(src.find_vector("Solution"));
+
+    // Fixed-point residual G(u) - u = (M - I)(u - 1)
+    dst.reinit(u);
+    for (unsigned int i = 0; i < u.size(); ++i)
+        dst(i) = (diagonal(i) - 1.0)*(u(i) - 1.0);
+
+    return dst.l2_norm();
+}
+
+//---------------------------------------------
+void
+NAME::LinearContractionApplication::solve(FuelCell::ApplicationCore::FEVector&        dst,
+                                          const FuelCell::ApplicationCore::FEVectors& src)
+{
+    const FuelCell::ApplicationCore::FEVector& u = src.vector(src.find_vector("Solution"));
+
+    // G(u) = M u + (I - M) 1
+    dst.reinit(u);
+    for (unsigned int i = 0; i < u.size(); ++i)
+        dst(i) = diagonal(i)*u(i) + (1.0 - diagonal(i));
+
+    ++n_solves;
+}
+
+//---------------------------------------------
+unsigned int
+NAME::PicardTest::run_picard(const bool anderson,
+                             const bool restart,
+                             double& error)
+{
+    LinearContractionApplication app;
+    FuelCell::ApplicationCore::Picard picard(app);
+
+    ParameterHandler param;
+    picard.declare_parameters(param);
+    param.enter_subsection("Picard");
+    {
+        param.set("Max steps", "1000");
+        param.set("Absolute tolerance", "1e-20");
+        param.set("Relative tolerance", "1e-10");
+        param.set("Anderson acceleration", anderson);
+        param.set("Anderson depth", "4");
+        param.set("Anderson restart", restart);
+    }
+    param.leave_subsection();
+    picard.initialize(param);
+
+    FuelCell::ApplicationCore::FEVector u;
+    app.init_vector(u);
+    FuelCell::ApplicationCore::FEVectors in_vectors;
+    picard.solve(u, in_vectors);
+
+    error = 0.0;
+    for (unsigned int i = 0; i < u.size(); ++i)
+        error = std::max(error, std::fabs(u(i) - 1.0));
+
+    return app.n_solves;
+}
+
+//---------------------------------------------
+void
+NAME::PicardTest::testPlainPicard()
+{
+    double error;
+    const unsigned int n = run_picard(false, false, error);
+
+    TEST_ASSERT_DELTA_MSG(error, 0.0, 1e-6, "Plain Picard did not converge to the fixed point");
+    TEST_ASSERT_MSG(n > 100, "Plain Picard converged faster than the contraction rate allows");
+}
+
+//---------------------------------------------
+void
+NAME::PicardTest::testAndersonAcceleration()
+{
+    double error_picard, error_anderson;
+    const unsigned int n_picard = run_picard(false, false, error_picard);
+    const unsigned int n_anderson = run_picard(true, false, error_anderson);
+
+    TEST_ASSERT_DELTA_MSG(error_anderson, 0.0, 1e-6, "AA(m) did not converge to the fixed point");
+    TEST_ASSERT_MSG(n_anderson < n_picard/4, "AA(m) did not reduce the number of fixed-point iterations");
+}
+
+//---------------------------------------------
+void
+NAME::PicardTest::testAndersonRestart()
+{
+    double error_picard, error_anderson;
+    const unsigned int n_picard = run_picard(false, false, error_picard);
+    const unsigned int n_anderson = run_picard(true, true, error_anderson);
+
+    TEST_ASSERT_DELTA_MSG(error_anderson, 0.0, 1e-6, "AA(m) with restarts did not converge to the fixed point");
+    TEST_ASSERT_MSG(n_anderson < n_picard/2, "AA(m) with restarts did not reduce the number of fixed-point iterations");
+}
@@ -0,0 +1,140 @@
+//---------------------------------------------------------------------------
+//
+//    FCST: Fuel Cell Simulation Toolbox
+//
+//    Copyright (C) 2026 by Energy Systems Design Laboratory, University of Alberta
+//
+//    This software is distributed under the MIT License.
+//    For more information, see the README file in /doc/LICENSE
+//
+//    - Class: through_plane_mea_model_test.cc
+//    - Description: Test for the one-dimensional through-plane MEA model used to generate initial solutions
+//    - Developers: OpenFCST contributors, University of Alberta
+//
+//---------------------------------------------------------------------------
+
+#include <through_plane_mea_model_test.h>
+
+#include <cmath>
+
+namespace NAME = FuelCell::UnitTest;
+
+//---------------------------------------------
+std::shared_ptr< FuelCell::InitialSolution::ThroughPlaneMEAModel<deal_II_dimension> >
+NAME::ThroughPlaneMEAModelApplication::create_model(const unsigned int n_cells,
+                                                    std::shared_ptr< Function<deal_II_dimension> >& base_function)
+{
+    base_function.reset(new FuelCell::InitialSolution::AppPemfcIC<deal_II_dimension> (&this->OC, this->mesh_generator));
+
+    return std::shared_ptr< FuelCell::InitialSolution::ThroughPlaneMEAModel<deal_II_dimension> >
+        (new FuelCell::InitialSolution::ThroughPlaneMEAModel<deal_II_dimension> (&this->OC, this->mesh_generator, &this->system_management, base_function,
+                                                                                 this->AGDL.get(), this->AMPL.get(), this->ACL.get(), this->ML.get(),
+                                                                                 this->CCL.get(), this->CMPL.get(), this->CGDL.get(),
+                                                                                 &this->oxygen, &this->nitrogen, n_cells));
+}
+
+//---------------------------------------------
+void
+NAME::ThroughPlaneMEAModelTest::testSmallMEA()
+{
+    ParameterHandler param;
+    ThroughPlaneMEAModelApplication app;
+
+    app.declare_parameters(param);
+    param.enter_subsection("Grid generation");{
+        param.set("Type of mesh","PemfcMPL");
+    }
+    param.leave_subsection();
+
+    app.initialize(param);
+
+    // State of the cathode catalyst layer set by the application before the model is solved:
+    std::vector<FuelCellShop::SolutionVariable> ccl_solution;
+    ccl_solution.push_back(FuelCellShop::SolutionVariable(0.7, 2, electronic_electrical_potential));
+    ccl_solution.push_back(FuelCellShop::SolutionVariable(-0.05, 2, protonic_electrical_potential));
+    ccl_solution.push_back(FuelCellShop::SolutionVariable(0.15, 2, oxygen_molar_fraction));
+    app.get_CCL()->set_solution(ccl_solution);
+
+    std::shared_ptr< Function<deal_II_dimension> > base_function;
+    std::shared_ptr< FuelCell::InitialSolution::ThroughPlaneMEAModel<deal_II_dimension> > model = app.create_model(4, base_function);
+
+    TEST_ASSERT_MSG(model->solve(), "ThroughPlaneMEAModelTest::testSmallMEA: the model did not converge");
+
+    // The cathode catalyst layer is restored:
+    const std::vector<FuelCellShop::SolutionVariable> restored = app.get_CCL()->get_solution();
+    bool found_phi_s = false;
+    for (unsigned int s = 0; s < restored.size(); ++s)
+        if (restored[s].get_variablename() == electronic_electrical_potential)
+        {
+            found_phi_s = true;
+            TEST_ASSERT_MSG(restored[s].size() == 2, "ThroughPlaneMEAModelTest::testSmallMEA: catalyst layer solution not restored");
+            TEST_ASSERT_DELTA_MSG(0.7, restored[s][0], 1e-12, "ThroughPlaneMEAModelTest::testSmallMEA: catalyst layer solution not restored");
+        }
+    TEST_ASSERT_MSG(found_phi_s, "ThroughPlaneMEAModelTest::testSmallMEA: catalyst layer solution not restored");
+
+    // Layer interfaces in the through-plane direction:
+    const boost::shared_ptr< FuelCellShop::Geometry::GridBase<deal_II_dimension> > grid = app.get_grid();
+    const std::vector<double> l_cat_c = grid->L_cat_c();
+    const double x_mem_begin = grid->L_gdl_a() + grid->L_mpl_a() + grid->L_cat_a();
+    const double x_mem_end = x_mem_begin + grid->L_mem();
+    double x_ccl_end = x_mem_end;
+    for (unsigned int i = 0; i < l_cat_c.size(); ++i)
+        x_ccl_end += l_cat_c[i];
+    const double L = x_ccl_end + grid->L_mpl_c() + grid->L_gdl_c();
+
+    const unsigned int i_phi_s = app.index("electronic_electrical_potential");
+    const unsigned int i_phi_m = app.index("protonic_electrical_potential");
+    const unsigned int i_x_o2 = app.index("oxygen_molar_fraction");
+    const double x_o2_channel = app.get_operating_conditions().get_x_o2();
+    const double V_cell = std::fabs(app.get_operating_conditions().get_V());
+
+    const unsigned int n_components = base_function->n_components;
+    Vector<double> v(n_components), v_shifted(n_components), v_base(n_components);
+    Point<deal_II_dimension> p, p_shifted;
+
+    // Sample the profile from the cathode channel to the anode channel:
+    const unsigned int n_samples = 200;
+    double x_o2_previous = x_o2_channel;
+    std::vector<double> phi_m_membrane;
+
+    for (unsigned int s = 0; s <= n_samples; ++s)
+    {
+        p(0) = L*(1.0 - double(s)/n_samples);
+        p_shifted = p;
+        p_shifted(1) = p(1) + 0.05;
+
+        model->vector_value(p, v);
+        model->vector_value(p_shifted, v_shifted);
+        base_function->vector_value(p_shifted, v_base);
+
+        for (unsigned int i = 0; i < n_components; ++i)
+        {
+            TEST_ASSERT_MSG(std::isfinite(v(i)), "ThroughPlaneMEAModelTest::testSmallMEA: solution is not finite");
+
+            // The one-dimensional solution is extruded, all other variables are given by the base function:
+            if (i == i_phi_s || i == i_phi_m || i == i_x_o2)
+                TEST_ASSERT_DELTA_MSG(v(i), v_shifted(i), 1e-12, "ThroughPlaneMEAModelTest::testSmallMEA: solution is not extruded");
+            else
+                TEST_ASSERT_DELTA_MSG(v_base(i), v_shifted(i), 1e-12, "ThroughPlaneMEAModelTest::testSmallMEA: base function not used");
+        }
+
+        if (p(0) > x_mem_end)
+        {
+            TEST_ASSERT_MSG(v(i_x_o2) <= x_o2_previous + 1e-12, "ThroughPlaneMEAModelTest::testSmallMEA: oxygen molar fraction increases into the MEA");
+            TEST_ASSERT_MSG(v(i_x_o2) >= 0.0, "ThroughPlaneMEAModelTest::testSmallMEA: negative oxygen molar fraction");
+            x_o2_previous = v(i_x_o2);
+        }
+
+        if (p(0) > x_mem_begin && p(0) < x_mem_end)
+            phi_m_membrane.push_back(v(i_phi_m));
+
+        if (s == 0)
+            TEST_ASSERT_DELTA_MSG(V_cell, v(i_phi_s), 1e-3, "ThroughPlaneMEAModelTest::testSmallMEA: wrong electronic potential at the cathode");
+    }
+
+    // The protonic potential is monotone in the membrane:
+    TEST_ASSERT_MSG(phi_m_membrane.size() > 1, "ThroughPlaneMEAModelTest::testSmallMEA: no samples in the membrane");
+    const double sign = (phi_m_membrane.back() >= phi_m_membrane.front()) ? 1.0 : -1.0;
+    for (unsigned int i = 1; i < phi_m_membrane.size(); ++i)
+        TEST_ASSERT_MSG(sign*(phi_m_membrane[i] - phi_m_membrane[i-1]) >= -1e-12, "ThroughPlaneMEAModelTest::testSmallMEA: protonic potential is not monotone in the membrane");
+}
@@ -187,4 +187,33 @@ UtilsTest::testModify_parameter_file_list()
     
     TEST_ASSERT_MSG(expectedAnswer == answer[4], "testModify_parameter_file_list failed! You loose :(");
     TEST_ASSERT_MSG(expectedAnswer2 == answer[5], "testModify_parameter_file_list failed! You loose :(");
-}
\ No newline at end of file
+}
+
+//================================================
+//================================================
+void
+UtilsTest::testThreadSettings()
+{
+    ParameterHandler thread_param;
+    FcstUtilities::declare_thread_parameters(thread_param);
+
+    // Requested number of threads:
+    FcstUtilities::modify_parameter_file("Simulator>>Parallel execution>>Threads per rank", 2L, thread_param);
+    FcstUtilities::initialize_threads(thread_param);
+
+    TEST_ASSERT_MSG(FcstUtilities::n_threads() == 2, "testThreadSettings failed, wrong number of requested threads");
+    TEST_ASSERT_MSG(MultithreadInfo::n_threads() <= 2, "testThreadSettings failed, deal.II thread pool not limited");
+#ifdef _OPENMP
+    TEST_ASSERT_MSG(omp_get_max_threads() == 2, "testThreadSettings failed, OpenMP thread pool not limited");
+#endif
+
+    // One process per core leaves a single thread per process:
+    FcstUtilities::modify_parameter_file("Simulator>>Parallel execution>>Threads per rank", 0L, thread_param);
+    FcstUtilities::modify_parameter_file("Simulator>>Parallel execution>>Ranks per node", static_cast<long int>(MultithreadInfo::n_cores()), thread_param);
+    FcstUtilities::initialize_threads(thread_param);
+
+    TEST_ASSERT_MSG(FcstUtilities::n_threads() == 1, "testThreadSettings failed, wrong number of threads per process");
+
+    // Restore the default deal.II thread pool for the other tests:
+    MultithreadInfo::set_thread_limit();
+}
@@ -59,6 +59,7 @@ ADD_TEST(AppOhmic>>Analysis "../examples/ohmic/analysis/regression/run_test.sh"
 ## -- Parallel tests
 IF(PETSc_FLAG GREATER -1)
     ADD_TEST(AppCathode>>PolarizationCurve>>Parallel "../examples/cathode/parallel/regression/run_test.sh" COMMAND "--cores=${Cores_FLAG}")
+    ADD_TEST(AppCathode>>NumericalJacobian>>Parallel "../examples/cathode/numerical_jacobian/regression/run_test.sh" COMMAND "--cores=${Cores_FLAG}")
 ENDIF() # PETSc_FLAG
 
 # -- Dakota integration test: